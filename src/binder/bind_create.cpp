@@ -129,7 +129,39 @@ auto Binder::BindIndex(duckdb_libpgquery::PGIndexStmt *stmt) -> std::unique_ptr<
     }
   }
 
-  return std::make_unique<IndexStatement>(stmt->idxname, std::move(table), std::move(cols));
+  // The grammar has no INCLUDE clause, so the included columns are given as a storage option instead:
+  // CREATE INDEX ... WITH (include = 'col1, col2').
+  std::vector<std::unique_ptr<BoundColumnRef>> include_cols;
+  if (stmt->options != nullptr) {
+    for (auto cell = stmt->options->head; cell != nullptr; cell = cell->next) {
+      auto option = reinterpret_cast<duckdb_libpgquery::PGDefElem *>(cell->data.ptr_value);
+      if (StringUtil::Lower(option->defname) != "include") {
+        throw NotImplementedException(fmt::format("index option {} is not supported", option->defname));
+      }
+      if (option->arg == nullptr || option->arg->type != duckdb_libpgquery::T_PGString) {
+        throw bustub::Exception("the include option of an index should be a string of column names");
+      }
+      auto names = reinterpret_cast<duckdb_libpgquery::PGValue *>(option->arg)->val.str;
+      for (const auto &name : StringUtil::Split(names, ',')) {
+        auto column_ref = ResolveColumn(*table, std::vector{StringUtil::Strip(name, ' ')});
+        include_cols.emplace_back(std::make_unique<BoundColumnRef>(dynamic_cast<const BoundColumnRef &>(*column_ref)));
+      }
+    }
+  }
+
+  // The parser fills in its own default access method when there is no USING clause.
+  IndexType index_type = IndexType::BPlusTreeIndex;
+  if (stmt->accessMethod != nullptr) {
+    auto method = StringUtil::Lower(stmt->accessMethod);
+    if (method == "hash") {
+      index_type = IndexType::HashTableIndex;
+    } else if (method != "btree" && method != DEFAULT_INDEX_TYPE) {
+      throw NotImplementedException(fmt::format("index type {} is not supported", stmt->accessMethod));
+    }
+  }
+
+  return std::make_unique<IndexStatement>(stmt->idxname, std::move(table), std::move(cols), std::move(include_cols),
+                                          index_type);
 }
 
 }  // namespace bustub
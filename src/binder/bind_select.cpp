@@ -875,8 +875,18 @@ auto Binder::BindSort(duckdb_libpgquery::PGList *list) -> std::vector<std::uniqu
       } else {
         throw NotImplementedException("unimplemented order by type");
       }
+      OrderByNullType null_type;
+      if (sort->sortby_nulls == duckdb_libpgquery::PG_SORTBY_NULLS_DEFAULT) {
+        null_type = OrderByNullType::DEFAULT;
+      } else if (sort->sortby_nulls == duckdb_libpgquery::PG_SORTBY_NULLS_FIRST) {
+        null_type = OrderByNullType::NULLS_FIRST;
+      } else if (sort->sortby_nulls == duckdb_libpgquery::PG_SORTBY_NULLS_LAST) {
+        null_type = OrderByNullType::NULLS_LAST;
+      } else {
+        throw NotImplementedException("unimplemented order by null type");
+      }
       auto order_expression = BindExpression(target);
-      order_by.emplace_back(std::make_unique<BoundOrderBy>(type, std::move(order_expression)));
+      order_by.emplace_back(std::make_unique<BoundOrderBy>(type, null_type, std::move(order_expression)));
     } else {
       throw NotImplementedException("unsupported order by node");
     }
@@ -7,14 +7,24 @@
 namespace bustub {
 
 IndexStatement::IndexStatement(std::string index_name, std::unique_ptr<BoundBaseTableRef> table,
-                               std::vector<std::unique_ptr<BoundColumnRef>> cols)
+                               std::vector<std::unique_ptr<BoundColumnRef>> cols,
+                               std::vector<std::unique_ptr<BoundColumnRef>> include_cols, IndexType index_type)
     : BoundStatement(StatementType::INDEX_STATEMENT),
       index_name_(std::move(index_name)),
       table_(std::move(table)),
-      cols_(std::move(cols)) {}
+      cols_(std::move(cols)),
+      include_cols_(std::move(include_cols)),
+      index_type_(index_type) {}
 
 auto IndexStatement::ToString() const -> std::string {
-  return fmt::format("BoundIndex {{ index_name={}, table={}, cols={} }}", index_name_, *table_, cols_);
+  if (index_type_ == IndexType::HashTableIndex) {
+    return fmt::format("BoundIndex {{ index_name={}, table={}, cols={}, type=hash }}", index_name_, *table_, cols_);
+  }
+  if (include_cols_.empty()) {
+    return fmt::format("BoundIndex {{ index_name={}, table={}, cols={} }}", index_name_, *table_, cols_);
+  }
+  return fmt::format("BoundIndex {{ index_name={}, table={}, cols={}, include_cols={} }}", index_name_, *table_, cols_,
+                     include_cols_);
 }
 
 }  // namespace bustub
@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arc_replacer.cpp
+//
+// Identification: src/buffer/arc_replacer.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/arc_replacer.h"
+
+#include <algorithm>
+
+namespace bustub {
+
+ARCReplacer::ARCReplacer(size_t num_frames)
+    : queue_(num_frames, Queue::None),
+      positions_(num_frames),
+      page_ids_(num_frames, INVALID_PAGE_ID),
+      evictable_(num_frames, false),
+      capacity_(num_frames) {}
+
+auto ARCReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock<std::mutex> lock(latch_);
+  bool prefer_t1 = !t1_.empty() && (t1_.size() > target_t1_ || t2_.empty());
+  frame_id_t victim = LeastRecentEvictable(prefer_t1 ? t1_ : t2_);
+  if (victim == INVALID_FRAME_ID) {
+    victim = LeastRecentEvictable(prefer_t1 ? t2_ : t1_);
+  }
+  if (victim == INVALID_FRAME_ID) {
+    return false;
+  }
+  if (page_ids_[victim] != INVALID_PAGE_ID) {
+    (queue_[victim] == Queue::T1 ? b1_ : b2_).PushFront(page_ids_[victim]);
+  }
+  Untrack(victim);
+  TrimGhosts();
+  *frame_id = victim;
+  return true;
+}
+
+void ARCReplacer::RecordAccess(frame_id_t frame_id, page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  BUSTUB_ASSERT(static_cast<size_t>(frame_id) < queue_.size(), "invalid frame id");
+  if (queue_[frame_id] != Queue::None) {
+    // a hit in T1 or T2 makes the page frequent
+    t2_.splice(t2_.begin(), queue_[frame_id] == Queue::T1 ? t1_ : t2_, positions_[frame_id]);
+    queue_[frame_id] = Queue::T2;
+    return;
+  }
+  page_ids_[frame_id] = page_id;
+  if (page_id != INVALID_PAGE_ID && b1_.Contains(page_id)) {
+    target_t1_ = std::min(capacity_, target_t1_ + std::max<size_t>(b2_.Size() / b1_.Size(), 1));
+    b1_.Erase(page_id);
+    queue_[frame_id] = Queue::T2;
+    positions_[frame_id] = t2_.insert(t2_.begin(), frame_id);
+  } else if (page_id != INVALID_PAGE_ID && b2_.Contains(page_id)) {
+    size_t delta = std::max<size_t>(b1_.Size() / b2_.Size(), 1);
+    target_t1_ = target_t1_ > delta ? target_t1_ - delta : 0;
+    b2_.Erase(page_id);
+    queue_[frame_id] = Queue::T2;
+    positions_[frame_id] = t2_.insert(t2_.begin(), frame_id);
+  } else {
+    queue_[frame_id] = Queue::T1;
+    positions_[frame_id] = t1_.insert(t1_.begin(), frame_id);
+  }
+  TrimGhosts();
+}
+
+void ARCReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  BUSTUB_ASSERT(static_cast<size_t>(frame_id) < queue_.size(), "invalid frame id");
+  if (queue_[frame_id] == Queue::None || evictable_[frame_id] == set_evictable) {
+    return;
+  }
+  evictable_[frame_id] = set_evictable;
+  if (set_evictable) {
+    curr_size_++;
+  } else {
+    curr_size_--;
+  }
+}
+
+void ARCReplacer::Remove(frame_id_t frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= queue_.size() || queue_[frame_id] == Queue::None) {
+    return;
+  }
+  BUSTUB_ENSURE(evictable_[frame_id], "cannot remove a non-evictable frame");
+  Untrack(frame_id);
+}
+
+auto ARCReplacer::Size() -> size_t {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return curr_size_;
+}
+
+auto ARCReplacer::GetTargetT1Size() -> size_t {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return target_t1_;
+}
+
+auto ARCReplacer::LeastRecentEvictable(const std::list<frame_id_t> &list) const -> frame_id_t {
+  for (auto it = list.rbegin(); it != list.rend(); ++it) {
+    if (evictable_[*it]) {
+      return *it;
+    }
+  }
+  return INVALID_FRAME_ID;
+}
+
+void ARCReplacer::TrimGhosts() {
+  while (b1_.Size() > 0 && t1_.size() + b1_.Size() > capacity_) {
+    b1_.PopBack();
+  }
+  while (b1_.Size() + b2_.Size() > 0 && t1_.size() + t2_.size() + b1_.Size() + b2_.Size() > 2 * capacity_) {
+    (b2_.Size() > 0 ? b2_ : b1_).PopBack();
+  }
+}
+
+void ARCReplacer::Untrack(frame_id_t frame_id) {
+  (queue_[frame_id] == Queue::T1 ? t1_ : t2_).erase(positions_[frame_id]);
+  queue_[frame_id] = Queue::None;
+  page_ids_[frame_id] = INVALID_PAGE_ID;
+  if (evictable_[frame_id]) {
+    evictable_[frame_id] = false;
+    curr_size_--;
+  }
+}
+
+}  // namespace bustub
@@ -12,48 +12,545 @@
 
 #include "buffer/buffer_pool_manager_instance.h"
 
+#include <algorithm>
+
 #include "common/exception.h"
 #include "common/macros.h"
 
 namespace bustub {
 
 BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager, size_t replacer_k,
-                                                     LogManager *log_manager)
-    : pool_size_(pool_size), disk_manager_(disk_manager), log_manager_(log_manager) {
-  // we allocate a consecutive memory space for the buffer pool
+                                                     LogManager *log_manager, ReplacerPolicy replacer_policy)
+    : BufferPoolManagerInstance(pool_size, 1, 0, disk_manager, replacer_k, log_manager, replacer_policy) {}
+
+BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, uint32_t num_instances, uint32_t instance_index,
+                                                     DiskManager *disk_manager, size_t replacer_k,
+                                                     LogManager *log_manager, ReplacerPolicy replacer_policy)
+    : pool_size_(pool_size),
+      num_instances_(num_instances),
+      instance_index_(instance_index),
+      next_page_id_(instance_index),
+      disk_manager_(disk_manager),
+      disk_scheduler_(std::make_unique<DiskScheduler>(disk_manager)),
+      log_manager_(log_manager),
+      replacer_(MakeReplacer(replacer_policy, pool_size, replacer_k)) {
+  BUSTUB_ASSERT(num_instances > 0, "If BPI is not part of a pool, then the pool size should just be 1");
+  BUSTUB_ASSERT(
+      instance_index < num_instances,
+      "BPI index cannot be greater than the number of BPIs in the pool. In non-parallel case, index should just be 1.");
+  // we allocate a consecutive memory space for the buffer pool, each frame's buffer is BUSTUB_PAGE_ALIGNMENT aligned
+  // so that it can be handed to an O_DIRECT disk manager without copying
   pages_ = new Page[pool_size_];
-  page_table_ = new ExtendibleHashTable<page_id_t, frame_id_t>(bucket_size_);
-  replacer_ = new LRUKReplacer(pool_size, replacer_k);
+  page_table_ = new LockFreePageTable(pool_size_);
+  resident_page_ = std::make_unique<std::atomic<page_id_t>[]>(pool_size_);
+  pending_accesses_ = std::make_unique<std::atomic<uint32_t>[]>(pool_size_);
+  pending_reads_.resize(pool_size_);
+  io_pending_.resize(pool_size_, false);
+  prefetched_.resize(pool_size_, false);
+  prefetch_held_.resize(pool_size_, false);
+  ring_frame_.resize(pool_size_, false);
+  cleaned_.resize(pool_size_, false);
 
   // Initially, every page is in the free list.
   for (size_t i = 0; i < pool_size_; ++i) {
     free_list_.emplace_back(static_cast<int>(i));
+    resident_page_[i] = INVALID_PAGE_ID;
+    pending_accesses_[i] = 0;
   }
-
-  // TODO(students): remove this line after you have implemented the buffer pool manager
-  throw NotImplementedException(
-      "BufferPoolManager is not implemented yet. If you have finished implementing BPM, please remove the throw "
-      "exception line in `buffer_pool_manager_instance.cpp`.");
 }
 
 BufferPoolManagerInstance::~BufferPoolManagerInstance() {
+  StopPageCleaner();
+  for (auto &read : pending_reads_) {
+    if (read.valid()) {
+      read.get();
+    }
+  }
   delete[] pages_;
   delete page_table_;
-  delete replacer_;
 }
 
-auto BufferPoolManagerInstance::NewPgImp(page_id_t *page_id) -> Page * { return nullptr; }
+auto BufferPoolManagerInstance::NewPgImp(page_id_t *page_id) -> Page * {
+  std::unique_lock<std::mutex> lock(latch_);
+  frame_id_t frame_id;
+  if (!AcquireFrame(&lock, &frame_id)) {
+    return nullptr;
+  }
+  *page_id = AllocatePage();
+  if (auto *trace = page_trace_.load(); trace != nullptr) {
+    trace->Record(*page_id);
+  }
+
+  Page *page = &pages_[frame_id];
+  page->page_id_ = *page_id;
+  page_table_->Insert(*page_id, frame_id);
+  PinFrame(frame_id);
+  resident_page_[frame_id] = *page_id;
+  return page;
+}
+
+auto BufferPoolManagerInstance::FetchPgImp(page_id_t page_id) -> Page * {
+  if (page_id == INVALID_PAGE_ID) {
+    return nullptr;
+  }
+  ValidatePageId(page_id);
+  if (auto *trace = page_trace_.load(); trace != nullptr) {
+    trace->Record(page_id);
+  }
+  frame_id_t frame_id;
+  if (TryPinResident(page_id, &frame_id)) {
+    return &pages_[frame_id];
+  }
+
+  std::unique_lock<std::mutex> lock(latch_);
+  while (!FindFrame(&lock, page_id, &frame_id)) {
+    if (!AcquireFrame(&lock, &frame_id)) {
+      return nullptr;
+    }
+    frame_id_t read_frame_id;
+    if (page_table_->Find(page_id, read_frame_id)) {
+      // another fetch read the page while the victim was written back
+      free_list_.push_back(frame_id);
+      continue;
+    }
+
+    // the page is pinned and mapped before the read, fetches of it wait for the read instead of reading it again
+    Page *page = &pages_[frame_id];
+    page->page_id_ = page_id;
+    page_table_->Insert(page_id, frame_id);
+    PinFrame(frame_id);
+    WaitForIo(&lock, frame_id, disk_scheduler_->ScheduleRead(page_id, page->GetData()));
+    resident_page_[frame_id] = page_id;
+    return page;
+  }
+  // a page fetched outside of the ring is no longer private to it
+  ring_frame_[frame_id] = false;
+  PinFrame(frame_id);
+  WaitForRead(&lock, frame_id);
+  resident_page_[frame_id] = page_id;
+  return &pages_[frame_id];
+}
+
+auto BufferPoolManagerInstance::FetchPgRingImp(page_id_t page_id, BufferRing *ring) -> Page * {
+  if (page_id == INVALID_PAGE_ID) {
+    return nullptr;
+  }
+  ValidatePageId(page_id);
+  std::unique_lock<std::mutex> lock(latch_);
+  if (auto *trace = page_trace_.load(); trace != nullptr) {
+    trace->Record(page_id);
+  }
+  frame_id_t frame_id;
+  while (!FindFrame(&lock, page_id, &frame_id)) {
+    if (!AcquireRingFrame(&lock, ring, &frame_id)) {
+      return nullptr;
+    }
+    frame_id_t read_frame_id;
+    if (page_table_->Find(page_id, read_frame_id)) {
+      free_list_.push_back(frame_id);
+      continue;
+    }
+
+    Page *page = &pages_[frame_id];
+    page->page_id_ = page_id;
+    page_table_->Insert(page_id, frame_id);
+    PinFrame(frame_id);
+    ring_frame_[frame_id] = true;
+    ring->page_ids_.push_back(page_id);
+    WaitForIo(&lock, frame_id, disk_scheduler_->ScheduleRead(page_id, page->GetData()));
+    return page;
+  }
+  PinFrame(frame_id, false);
+  WaitForRead(&lock, frame_id);
+  return &pages_[frame_id];
+}
+
+auto BufferPoolManagerInstance::NewPgRingImp(page_id_t *page_id, BufferRing *ring) -> Page * {
+  std::unique_lock<std::mutex> lock(latch_);
+  frame_id_t frame_id;
+  if (!AcquireRingFrame(&lock, ring, &frame_id)) {
+    return nullptr;
+  }
+  *page_id = AllocatePage();
+  if (auto *trace = page_trace_.load(); trace != nullptr) {
+    trace->Record(*page_id);
+  }
+
+  Page *page = &pages_[frame_id];
+  page->page_id_ = *page_id;
+  page_table_->Insert(*page_id, frame_id);
+  PinFrame(frame_id);
+  ring_frame_[frame_id] = true;
+  ring->page_ids_.push_back(*page_id);
+  return page;
+}
+
+auto BufferPoolManagerInstance::UnpinPgImp(page_id_t page_id, bool is_dirty) -> bool {
+  std::scoped_lock<std::mutex> lock(latch_);
+  frame_id_t frame_id;
+  if (!page_table_->Find(page_id, frame_id)) {
+    return false;
+  }
+  Page *page = &pages_[frame_id];
+  if (page->pin_count_ <= 0) {
+    return false;
+  }
+  if (is_dirty) {
+    page->is_dirty_ = true;
+    cleaned_[frame_id] = false;
+  }
+  RecordPendingAccesses(frame_id);
+  if (--page->pin_count_ == 0) {
+    replacer_->SetEvictable(frame_id, true);
+  }
+  return true;
+}
+
+auto BufferPoolManagerInstance::FlushPgImp(page_id_t page_id) -> bool {
+  if (page_id == INVALID_PAGE_ID) {
+    return false;
+  }
+  std::unique_lock<std::mutex> lock(latch_);
+  frame_id_t frame_id;
+  if (!FindFrame(&lock, page_id, &frame_id)) {
+    return false;
+  }
+  if (pending_reads_[frame_id].valid()) {
+    // a prefetched page that was not fetched yet is the same as on disk
+    return true;
+  }
+  Page *page = &pages_[frame_id];
+  disk_scheduler_->ScheduleWrite(page_id, page->GetData()).get();
+  page->is_dirty_ = false;
+  return true;
+}
+
+void BufferPoolManagerInstance::FlushAllPgsImp() {
+  std::unique_lock<std::mutex> lock(latch_);
+  // the latch is then held until all the writes complete, so no frame is reused while its page is being written
+  io_done_.wait(lock, [this] { return num_io_pending_ == 0; });
+  std::vector<std::future<bool>> writes;
+  for (size_t i = 0; i < pool_size_; i++) {
+    Page *page = &pages_[i];
+    if (page->page_id_ != INVALID_PAGE_ID && !pending_reads_[i].valid()) {
+      writes.emplace_back(disk_scheduler_->ScheduleWrite(page->page_id_, page->GetData()));
+      page->is_dirty_ = false;
+    }
+  }
+  for (auto &write : writes) {
+    write.get();
+  }
+  disk_manager_->SyncDb();
+}
+
+auto BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) -> bool {
+  std::unique_lock<std::mutex> lock(latch_);
+  frame_id_t frame_id;
+  if (!FindFrame(&lock, page_id, &frame_id)) {
+    return true;
+  }
+  Page *page = &pages_[frame_id];
+  if (!ClaimFrame(frame_id)) {
+    return false;
+  }
+  if (prefetch_held_[frame_id]) {
+    prefetch_held_[frame_id] = false;
+    num_prefetch_held_--;
+    replacer_->SetEvictable(frame_id, true);
+  }
+  replacer_->Remove(frame_id);
+  WaitForRead(&lock, frame_id);
+  page_table_->Remove(page_id);
+  free_list_.push_back(frame_id);
+  prefetched_[frame_id] = false;
+  ring_frame_[frame_id] = false;
+  cleaned_[frame_id] = false;
+
+  page->ResetMemory();
+  page->page_id_ = INVALID_PAGE_ID;
+  page->is_dirty_ = false;
+  DeallocatePage(page_id);
+  return true;
+}
+
+auto BufferPoolManagerInstance::AllocatePage() -> page_id_t {
+  const page_id_t next_page_id = next_page_id_.fetch_add(num_instances_);
+  ValidatePageId(next_page_id);
+  return next_page_id;
+}
+
+void BufferPoolManagerInstance::ValidatePageId(const page_id_t page_id) const {
+  assert(static_cast<uint32_t>(page_id) % num_instances_ == instance_index_);  // allocated pages mod back to this BPI
+}
+
+auto BufferPoolManagerInstance::FindFrame(std::unique_lock<std::mutex> *lock, page_id_t page_id, frame_id_t *frame_id)
+    -> bool {
+  while (page_table_->Find(page_id, *frame_id)) {
+    if (!io_pending_[*frame_id]) {
+      return true;
+    }
+    // the frame may hold another page once its I/O completes, so look the page up again
+    const frame_id_t pending_frame_id = *frame_id;
+    io_done_.wait(*lock, [this, pending_frame_id] { return !io_pending_[pending_frame_id]; });
+  }
+  return false;
+}
+
+auto BufferPoolManagerInstance::AcquireFrame(std::unique_lock<std::mutex> *lock, frame_id_t *frame_id) -> bool {
+  if (!free_list_.empty()) {
+    *frame_id = free_list_.front();
+    free_list_.pop_front();
+    return true;
+  }
+  while (true) {
+    if (!replacer_->Evict(frame_id)) {
+      // prefetched pages that were not fetched yet are only given up when nothing else can be evicted
+      if (num_prefetch_held_ == 0) {
+        return false;
+      }
+      ReleasePrefetchedFrames();
+      continue;
+    }
+    if (ClaimFrame(*frame_id)) {
+      break;
+    }
+    // the victim was pinned by a lock-free fetch since it was last unpinned, its unpin makes it evictable again
+    RecordPendingAccesses(*frame_id);
+    replacer_->RecordAccess(*frame_id, pages_[*frame_id].page_id_);
+    replacer_->SetEvictable(*frame_id, false);
+  }
+  EvictFrame(lock, *frame_id);
+  return true;
+}
+
+void BufferPoolManagerInstance::EvictFrame(std::unique_lock<std::mutex> *lock, frame_id_t frame_id) {
+  prefetched_[frame_id] = false;
+  ring_frame_[frame_id] = false;
+  Page *page = &pages_[frame_id];
+  if (pending_reads_[frame_id].valid()) {
+    // a prefetched page that was never fetched is clean
+    WaitForRead(lock, frame_id);
+  } else if (page->is_dirty_) {
+    num_dirty_evictions_++;
+    WaitForIo(lock, frame_id, disk_scheduler_->ScheduleWrite(page->page_id_, page->GetData()));
+  } else if (cleaned_[frame_id]) {
+    num_dirty_evictions_avoided_++;
+  }
+  cleaned_[frame_id] = false;
+  page_table_->Remove(page->page_id_);
+  page->ResetMemory();
+  page->page_id_ = INVALID_PAGE_ID;
+  page->is_dirty_ = false;
+}
+
+auto BufferPoolManagerInstance::AcquireRingFrame(std::unique_lock<std::mutex> *lock, BufferRing *ring,
+                                                 frame_id_t *frame_id) -> bool {
+  // the ring only holds on to as many of this instance's pages as it has frames
+  auto owned = [this](page_id_t page_id) { return static_cast<uint32_t>(page_id) % num_instances_ == instance_index_; };
+  if (static_cast<size_t>(std::count_if(ring->page_ids_.begin(), ring->page_ids_.end(), owned)) >= ring->size_) {
+    auto oldest = std::find_if(ring->page_ids_.begin(), ring->page_ids_.end(), owned);
+    page_id_t page_id = *oldest;
+    ring->page_ids_.erase(oldest);
+    // the frame can only be recycled if its page is not in use by anyone else, otherwise it is left to the replacer
+    frame_id_t ring_frame_id;
+    if (page_table_->Find(page_id, ring_frame_id) && ring_frame_[ring_frame_id] && ClaimFrame(ring_frame_id)) {
+      replacer_->Remove(ring_frame_id);
+      EvictFrame(lock, ring_frame_id);
+      *frame_id = ring_frame_id;
+      return true;
+    }
+  }
+  return AcquireFrame(lock, frame_id);
+}
+
+auto BufferPoolManagerInstance::TryPinResident(page_id_t page_id, frame_id_t *frame_id) -> bool {
+  frame_id_t resident_frame_id;
+  if (!page_table_->Find(page_id, resident_frame_id) || resident_page_[resident_frame_id] != page_id) {
+    return false;
+  }
+  Page *page = &pages_[resident_frame_id];
+  page->pin_count_++;
+  // a concurrent ClaimFrame() either sees this pin and backs off, or has cleared resident_page_ before reading the pin
+  // count, in which case the frame is about to be reused and the pin is taken back
+  if (resident_page_[resident_frame_id] != page_id) {
+    page->pin_count_--;
+    return false;
+  }
+  pending_accesses_[resident_frame_id]++;
+  num_lock_free_hits_++;
+  *frame_id = resident_frame_id;
+  return true;
+}
+
+auto BufferPoolManagerInstance::ClaimFrame(frame_id_t frame_id) -> bool {
+  page_id_t resident = resident_page_[frame_id].exchange(INVALID_PAGE_ID);
+  if (pages_[frame_id].pin_count_ == 0) {
+    pending_accesses_[frame_id] = 0;
+    return true;
+  }
+  resident_page_[frame_id] = resident;
+  return false;
+}
+
+void BufferPoolManagerInstance::RecordPendingAccesses(frame_id_t frame_id) {
+  for (uint32_t accesses = pending_accesses_[frame_id].exchange(0); accesses > 0; accesses--) {
+    replacer_->RecordAccess(frame_id, pages_[frame_id].page_id_);
+  }
+}
+
+void BufferPoolManagerInstance::PinFrame(frame_id_t frame_id, bool record_access) {
+  pages_[frame_id].pin_count_++;
+  if (prefetched_[frame_id]) {
+    prefetched_[frame_id] = false;
+    num_prefetch_hits_++;
+    if (prefetch_held_[frame_id]) {
+      prefetch_held_[frame_id] = false;
+      num_prefetch_held_--;
+    }
+  } else if (record_access) {
+    replacer_->RecordAccess(frame_id, pages_[frame_id].page_id_);
+  }
+  replacer_->SetEvictable(frame_id, false);
+}
 
-auto BufferPoolManagerInstance::FetchPgImp(page_id_t page_id) -> Page * { return nullptr; }
+void BufferPoolManagerInstance::WaitForIo(std::unique_lock<std::mutex> *lock, frame_id_t frame_id,
+                                          std::future<bool> io) {
+  io_pending_[frame_id] = true;
+  num_io_pending_++;
+  lock->unlock();
+  io.get();
+  lock->lock();
+  io_pending_[frame_id] = false;
+  num_io_pending_--;
+  io_done_.notify_all();
+}
 
-auto BufferPoolManagerInstance::UnpinPgImp(page_id_t page_id, bool is_dirty) -> bool { return false; }
+void BufferPoolManagerInstance::WaitForRead(std::unique_lock<std::mutex> *lock, frame_id_t frame_id) {
+  if (pending_reads_[frame_id].valid()) {
+    WaitForIo(lock, frame_id, std::move(pending_reads_[frame_id]));
+  }
+}
 
-auto BufferPoolManagerInstance::FlushPgImp(page_id_t page_id) -> bool { return false; }
+void BufferPoolManagerInstance::PrefetchPages(page_id_t start_page_id, size_t count) {
+  std::unique_lock<std::mutex> lock(latch_);
+  for (page_id_t page_id = std::max(start_page_id, 0); page_id < start_page_id + static_cast<page_id_t>(count);
+       page_id++) {
+    if (static_cast<uint32_t>(page_id) % num_instances_ != instance_index_) {
+      continue;
+    }
+    if (page_id >= next_page_id_ || num_prefetch_held_ >= pool_size_ / 2) {
+      break;
+    }
+    frame_id_t frame_id;
+    if (page_table_->Find(page_id, frame_id)) {
+      continue;
+    }
+    if (!AcquireFrame(&lock, &frame_id)) {
+      break;
+    }
+    frame_id_t read_frame_id;
+    if (page_table_->Find(page_id, read_frame_id)) {
+      free_list_.push_back(frame_id);
+      continue;
+    }
 
-void BufferPoolManagerInstance::FlushAllPgsImp() {}
+    Page *page = &pages_[frame_id];
+    page->page_id_ = page_id;
+    pending_reads_[frame_id] = disk_scheduler_->ScheduleRead(page_id, page->GetData());
+    page_table_->Insert(page_id, frame_id);
+    replacer_->RecordAccess(frame_id, pages_[frame_id].page_id_);
+    replacer_->SetEvictable(frame_id, false);
+    prefetched_[frame_id] = true;
+    prefetch_held_[frame_id] = true;
+    num_prefetch_held_++;
+    num_pages_prefetched_++;
+  }
+}
+
+void BufferPoolManagerInstance::SetPageAccessTrace(PageAccessTrace *trace) { page_trace_ = trace; }
 
-auto BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) -> bool { return false; }
+void BufferPoolManagerInstance::ReleasePrefetchedFrames() {
+  for (size_t i = 0; i < pool_size_; i++) {
+    if (prefetch_held_[i]) {
+      prefetch_held_[i] = false;
+      replacer_->SetEvictable(static_cast<frame_id_t>(i), true);
+    }
+  }
+  num_prefetch_held_ = 0;
+}
 
-auto BufferPoolManagerInstance::AllocatePage() -> page_id_t { return next_page_id_++; }
+void BufferPoolManagerInstance::StartPageCleaner(std::chrono::milliseconds interval, size_t max_pages_per_round) {
+  if (page_cleaner_thread_ != nullptr) {
+    return;
+  }
+  enable_page_cleaner_ = true;
+  page_cleaner_thread_ = new std::thread([this, interval, max_pages_per_round] {
+    while (enable_page_cleaner_) {
+      std::this_thread::sleep_for(interval);
+      CleanDirtyPages(max_pages_per_round);
+    }
+  });
+}
+
+void BufferPoolManagerInstance::StopPageCleaner() {
+  if (page_cleaner_thread_ == nullptr) {
+    return;
+  }
+  enable_page_cleaner_ = false;
+  page_cleaner_thread_->join();
+  delete page_cleaner_thread_;
+  page_cleaner_thread_ = nullptr;
+}
+
+auto BufferPoolManagerInstance::CleanDirtyPages(size_t max_pages) -> size_t {
+  // pin the candidates under the latch, then write them back one by one without holding it
+  std::vector<frame_id_t> candidates;
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    for (size_t i = 0; i < pool_size_ && candidates.size() < max_pages; i++) {
+      auto frame_id = static_cast<frame_id_t>(cleaner_hand_);
+      cleaner_hand_ = (cleaner_hand_ + 1) % pool_size_;
+      Page *page = &pages_[frame_id];
+      if (page->page_id_ == INVALID_PAGE_ID || !page->is_dirty_ || page->pin_count_ > 0 || io_pending_[frame_id]) {
+        continue;
+      }
+      page->pin_count_++;
+      replacer_->SetEvictable(frame_id, false);
+      candidates.push_back(frame_id);
+    }
+  }
+
+  size_t cleaned = 0;
+  for (auto frame_id : candidates) {
+    if (CleanFrame(frame_id)) {
+      cleaned++;
+    }
+  }
+  num_pages_cleaned_ += cleaned;
+  return cleaned;
+}
+
+auto BufferPoolManagerInstance::CleanFrame(frame_id_t frame_id) -> bool {
+  Page *page = &pages_[frame_id];
+  // the read latch keeps the content (and the page LSN) stable while it is being written
+  page->RLatch();
+  bool wal_ok = !enable_logging || log_manager_ == nullptr || page->GetLSN() <= log_manager_->GetPersistentLSN();
+  if (wal_ok) {
+    disk_scheduler_->ScheduleWrite(page->page_id_, page->GetData()).get();
+  }
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    if (wal_ok) {
+      // any modification after the write needs the write latch and is marked dirty again when unpinned
+      page->is_dirty_ = false;
+      cleaned_[frame_id] = true;
+    }
+    if (--page->pin_count_ == 0) {
+      replacer_->SetEvictable(frame_id, true);
+    }
+  }
+  page->RUnlatch();
+  return wal_ok;
+}
 
 }  // namespace bustub
@@ -0,0 +1,246 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// clock_pro_replacer.cpp
+//
+// Identification: src/buffer/clock_pro_replacer.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/clock_pro_replacer.h"
+
+#include <algorithm>
+
+namespace bustub {
+
+ClockProReplacer::ClockProReplacer(size_t num_frames)
+    : hand_hot_(clock_.end()),
+      hand_cold_(clock_.end()),
+      hand_test_(clock_.end()),
+      frame_entries_(num_frames),
+      tracked_(num_frames, false),
+      evictable_(num_frames, false),
+      capacity_(num_frames),
+      min_cold_target_(1),
+      max_cold_target_(std::max<size_t>(num_frames, 2) - 1) {
+  cold_target_ = std::max(num_frames / 2, min_cold_target_);
+}
+
+auto ClockProReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (curr_size_ == 0) {
+    return false;
+  }
+  while (true) {
+    if (num_evictable_cold_ == 0) {
+      // every evictable page is hot, demote until one of them becomes a candidate
+      RunHandHot();
+      continue;
+    }
+    auto it = hand_cold_;
+    ClockEntry &entry = *it;
+    if (entry.hot_ || entry.frame_id_ == INVALID_FRAME_ID || !evictable_[entry.frame_id_]) {
+      hand_cold_ = Next(hand_cold_);
+      continue;
+    }
+    if (entry.ref_) {
+      entry.ref_ = false;
+      hand_cold_ = Next(hand_cold_);
+      if (entry.test_) {
+        cold_target_ = std::min(cold_target_ + 1, max_cold_target_);
+        Promote(it);
+      } else {
+        entry.test_ = true;
+      }
+      continue;
+    }
+
+    frame_id_t victim = entry.frame_id_;
+    tracked_[victim] = false;
+    evictable_[victim] = false;
+    num_evictable_cold_--;
+    curr_size_--;
+    if (entry.test_ && entry.page_id_ != INVALID_PAGE_ID) {
+      // the page stays on the clock, non-resident, until its test period ends
+      entry.frame_id_ = INVALID_FRAME_ID;
+      non_resident_[entry.page_id_] = it;
+      hand_cold_ = Next(hand_cold_);
+      while (non_resident_.size() > capacity_) {
+        RunHandTest();
+      }
+    } else {
+      Erase(it);
+    }
+    *frame_id = victim;
+    return true;
+  }
+}
+
+void ClockProReplacer::RecordAccess(frame_id_t frame_id, page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  BUSTUB_ASSERT(static_cast<size_t>(frame_id) < tracked_.size(), "invalid frame id");
+  if (tracked_[frame_id]) {
+    frame_entries_[frame_id]->ref_ = true;
+    return;
+  }
+  tracked_[frame_id] = true;
+  auto nr = page_id == INVALID_PAGE_ID ? non_resident_.end() : non_resident_.find(page_id);
+  if (nr == non_resident_.end()) {
+    frame_entries_[frame_id] = Insert(ClockEntry{page_id, frame_id, false, false, true});
+    return;
+  }
+  // reloaded within its test period: the page's reuse distance is short enough to make it hot
+  Erase(nr->second);
+  non_resident_.erase(nr);
+  cold_target_ = std::min(cold_target_ + 1, max_cold_target_);
+  auto it = Insert(ClockEntry{page_id, frame_id, false, false, false});
+  frame_entries_[frame_id] = it;
+  Promote(it);
+}
+
+void ClockProReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  BUSTUB_ASSERT(static_cast<size_t>(frame_id) < tracked_.size(), "invalid frame id");
+  if (!tracked_[frame_id] || evictable_[frame_id] == set_evictable) {
+    return;
+  }
+  evictable_[frame_id] = set_evictable;
+  bool cold = !frame_entries_[frame_id]->hot_;
+  if (set_evictable) {
+    curr_size_++;
+    num_evictable_cold_ += cold ? 1 : 0;
+  } else {
+    curr_size_--;
+    num_evictable_cold_ -= cold ? 1 : 0;
+  }
+}
+
+void ClockProReplacer::Remove(frame_id_t frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= tracked_.size() || !tracked_[frame_id]) {
+    return;
+  }
+  BUSTUB_ENSURE(evictable_[frame_id], "cannot remove a non-evictable frame");
+  auto it = frame_entries_[frame_id];
+  if (it->hot_) {
+    num_hot_--;
+  } else {
+    num_evictable_cold_--;
+  }
+  tracked_[frame_id] = false;
+  evictable_[frame_id] = false;
+  curr_size_--;
+  Erase(it);
+}
+
+auto ClockProReplacer::Size() -> size_t {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return curr_size_;
+}
+
+auto ClockProReplacer::GetNumHotPages() -> size_t {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return num_hot_;
+}
+
+auto ClockProReplacer::GetNumNonResidentPages() -> size_t {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return non_resident_.size();
+}
+
+auto ClockProReplacer::Next(ClockIterator it) -> ClockIterator {
+  ++it;
+  return it == clock_.end() ? clock_.begin() : it;
+}
+
+auto ClockProReplacer::Insert(const ClockEntry &entry) -> ClockIterator {
+  if (clock_.empty()) {
+    clock_.push_back(entry);
+    hand_hot_ = hand_cold_ = hand_test_ = clock_.begin();
+    return clock_.begin();
+  }
+  return clock_.insert(hand_hot_, entry);
+}
+
+void ClockProReplacer::Erase(ClockIterator it) {
+  if (clock_.size() == 1) {
+    clock_.clear();
+    hand_hot_ = hand_cold_ = hand_test_ = clock_.end();
+    return;
+  }
+  for (auto *hand : {&hand_hot_, &hand_cold_, &hand_test_}) {
+    if (*hand == it) {
+      *hand = Next(it);
+    }
+  }
+  clock_.erase(it);
+}
+
+auto ClockProReplacer::EndTestPeriod(ClockIterator it) -> bool {
+  it->test_ = false;
+  if (cold_target_ > min_cold_target_) {
+    cold_target_--;
+  }
+  if (it->frame_id_ != INVALID_FRAME_ID) {
+    return false;
+  }
+  non_resident_.erase(it->page_id_);
+  Erase(it);
+  return true;
+}
+
+void ClockProReplacer::RunHandHot() {
+  if (num_hot_ == 0) {
+    return;
+  }
+  while (true) {
+    auto it = hand_hot_;
+    ClockEntry &entry = *it;
+    if (entry.hot_) {
+      hand_hot_ = Next(hand_hot_);
+      if (entry.ref_) {
+        entry.ref_ = false;
+        continue;
+      }
+      entry.hot_ = false;
+      num_hot_--;
+      if (evictable_[entry.frame_id_]) {
+        num_evictable_cold_++;
+      }
+      return;
+    }
+    if (entry.test_) {
+      if (EndTestPeriod(it)) {
+        continue;
+      }
+    }
+    hand_hot_ = Next(hand_hot_);
+  }
+}
+
+void ClockProReplacer::RunHandTest() {
+  while (!non_resident_.empty()) {
+    auto it = hand_test_;
+    if (!it->hot_ && it->test_ && EndTestPeriod(it)) {
+      return;
+    }
+    hand_test_ = Next(hand_test_);
+  }
+}
+
+void ClockProReplacer::Promote(ClockIterator it) {
+  it->hot_ = true;
+  it->test_ = false;
+  num_hot_++;
+  if (evictable_[it->frame_id_]) {
+    num_evictable_cold_--;
+  }
+  while (num_hot_ > capacity_ - std::min(cold_target_, capacity_)) {
+    RunHandHot();
+  }
+}
+
+}  // namespace bustub
@@ -12,18 +12,93 @@
 
 #include "buffer/clock_replacer.h"
 
+#include "common/macros.h"
+
 namespace bustub {
 
-ClockReplacer::ClockReplacer(size_t num_pages) {}
+ClockReplacer::ClockReplacer(size_t num_pages)
+    : tracked_(num_pages, false), evictable_(num_pages, false), ref_(num_pages, false) {}
 
 ClockReplacer::~ClockReplacer() = default;
 
-auto ClockReplacer::Victim(frame_id_t *frame_id) -> bool { return false; }
+auto ClockReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (curr_size_ == 0) {
+    return false;
+  }
+  // every evictable frame is visited at most twice: once to clear its reference bit, once to evict it
+  while (true) {
+    auto fid = static_cast<frame_id_t>(hand_);
+    hand_ = (hand_ + 1) % tracked_.size();
+    if (!evictable_[fid]) {
+      continue;
+    }
+    if (ref_[fid]) {
+      ref_[fid] = false;
+      continue;
+    }
+    Untrack(fid);
+    *frame_id = fid;
+    return true;
+  }
+}
+
+void ClockReplacer::RecordAccess(frame_id_t frame_id, __attribute__((unused)) page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  BUSTUB_ASSERT(static_cast<size_t>(frame_id) < tracked_.size(), "invalid frame id");
+  tracked_[frame_id] = true;
+  ref_[frame_id] = true;
+}
+
+void ClockReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  BUSTUB_ASSERT(static_cast<size_t>(frame_id) < tracked_.size(), "invalid frame id");
+  if (!tracked_[frame_id] || evictable_[frame_id] == set_evictable) {
+    return;
+  }
+  evictable_[frame_id] = set_evictable;
+  if (set_evictable) {
+    curr_size_++;
+  } else {
+    curr_size_--;
+  }
+}
+
+void ClockReplacer::Remove(frame_id_t frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= tracked_.size() || !tracked_[frame_id]) {
+    return;
+  }
+  BUSTUB_ENSURE(evictable_[frame_id], "cannot remove a non-evictable frame");
+  Untrack(frame_id);
+}
+
+auto ClockReplacer::Size() -> size_t {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return curr_size_;
+}
+
+auto ClockReplacer::Victim(frame_id_t *frame_id) -> bool { return Evict(frame_id); }
 
-void ClockReplacer::Pin(frame_id_t frame_id) {}
+void ClockReplacer::Pin(frame_id_t frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (static_cast<size_t>(frame_id) < tracked_.size() && tracked_[frame_id]) {
+    Untrack(frame_id);
+  }
+}
 
-void ClockReplacer::Unpin(frame_id_t frame_id) {}
+void ClockReplacer::Unpin(frame_id_t frame_id) {
+  RecordAccess(frame_id);
+  SetEvictable(frame_id, true);
+}
 
-auto ClockReplacer::Size() -> size_t { return 0; }
+void ClockReplacer::Untrack(frame_id_t frame_id) {
+  tracked_[frame_id] = false;
+  ref_[frame_id] = false;
+  if (evictable_[frame_id]) {
+    evictable_[frame_id] = false;
+    curr_size_--;
+  }
+}
 
 }  // namespace bustub
@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// lock_free_page_table.cpp
+//
+// Identification: src/buffer/lock_free_page_table.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/lock_free_page_table.h"
+
+#include <vector>
+
+namespace bustub {
+
+LockFreePageTable::LockFreePageTable(size_t max_entries) {
+  // keep the load factor at or below 1/2 so that probe sequences stay short
+  capacity_bits_ = 2;
+  while ((static_cast<size_t>(1) << capacity_bits_) < 2 * max_entries) {
+    capacity_bits_++;
+  }
+  capacity_ = static_cast<size_t>(1) << capacity_bits_;
+  slots_ = std::make_unique<std::atomic<uint64_t>[]>(capacity_);
+  for (size_t i = 0; i < capacity_; i++) {
+    slots_[i].store(EMPTY_SLOT, std::memory_order_relaxed);
+  }
+}
+
+auto LockFreePageTable::Find(page_id_t page_id, frame_id_t &frame_id) const -> bool {
+  size_t index = HomeSlot(page_id);
+  for (size_t probes = 0; probes < capacity_; probes++) {
+    uint64_t slot = slots_[index].load(std::memory_order_acquire);
+    if (slot == EMPTY_SLOT) {
+      return false;
+    }
+    if (slot != TOMBSTONE_SLOT && SlotPageId(slot) == page_id) {
+      frame_id = SlotFrameId(slot);
+      return true;
+    }
+    index = (index + 1) & (capacity_ - 1);
+  }
+  return false;
+}
+
+void LockFreePageTable::Insert(page_id_t page_id, frame_id_t frame_id) {
+  BUSTUB_ASSERT(page_id != INVALID_PAGE_ID, "cannot map an invalid page");
+  size_t index = HomeSlot(page_id);
+  size_t target = capacity_;
+  for (size_t probes = 0; probes < capacity_; probes++) {
+    uint64_t slot = slots_[index].load(std::memory_order_relaxed);
+    if (slot == EMPTY_SLOT) {
+      if (target == capacity_) {
+        target = index;
+      }
+      break;
+    }
+    if (slot == TOMBSTONE_SLOT) {
+      if (target == capacity_) {
+        target = index;
+      }
+    } else if (SlotPageId(slot) == page_id) {
+      slots_[index].store(MakeSlot(page_id, frame_id), std::memory_order_release);
+      return;
+    }
+    index = (index + 1) & (capacity_ - 1);
+  }
+  BUSTUB_ASSERT(target != capacity_, "page table is full");
+  if (slots_[target].load(std::memory_order_relaxed) == TOMBSTONE_SLOT) {
+    num_tombstones_--;
+  }
+  slots_[target].store(MakeSlot(page_id, frame_id), std::memory_order_release);
+  size_++;
+}
+
+auto LockFreePageTable::Remove(page_id_t page_id) -> bool {
+  size_t index = HomeSlot(page_id);
+  for (size_t probes = 0; probes < capacity_; probes++) {
+    uint64_t slot = slots_[index].load(std::memory_order_relaxed);
+    if (slot == EMPTY_SLOT) {
+      return false;
+    }
+    if (slot != TOMBSTONE_SLOT && SlotPageId(slot) == page_id) {
+      slots_[index].store(TOMBSTONE_SLOT, std::memory_order_release);
+      size_--;
+      num_tombstones_++;
+      if (num_tombstones_ > capacity_ / 4) {
+        Rebuild();
+      }
+      return true;
+    }
+    index = (index + 1) & (capacity_ - 1);
+  }
+  return false;
+}
+
+void LockFreePageTable::Rebuild() {
+  // readers that probe while the table is rewritten may miss a page, which they have to tolerate anyway
+  std::vector<uint64_t> live;
+  live.reserve(size_);
+  for (size_t i = 0; i < capacity_; i++) {
+    uint64_t slot = slots_[i].load(std::memory_order_relaxed);
+    if (slot != EMPTY_SLOT && slot != TOMBSTONE_SLOT) {
+      live.push_back(slot);
+    }
+    slots_[i].store(EMPTY_SLOT, std::memory_order_release);
+  }
+  size_ = 0;
+  num_tombstones_ = 0;
+  for (uint64_t slot : live) {
+    Insert(SlotPageId(slot), SlotFrameId(slot));
+  }
+}
+
+}  // namespace bustub
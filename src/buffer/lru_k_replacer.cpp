@@ -12,18 +12,153 @@
 
 #include "buffer/lru_k_replacer.h"
 
+#include <utility>
+
 namespace bustub {
 
-LRUKReplacer::LRUKReplacer(size_t num_frames, size_t k) : replacer_size_(num_frames), k_(k) {}
+LRUKReplacer::LRUKReplacer(size_t num_frames, size_t k)
+    : nodes_(num_frames), timestamps_(num_frames * k), replacer_size_(num_frames), k_(k) {
+  BUSTUB_ASSERT(k > 0, "k must be positive");
+  heap_.reserve(num_frames);
+}
+
+auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (heap_.empty()) {
+    return false;
+  }
+  frame_id_t victim = heap_.front();
+  HeapErase(victim);
+  ResetNode(victim);
+  curr_size_--;
+  *frame_id = victim;
+  return true;
+}
+
+void LRUKReplacer::RecordAccess(frame_id_t frame_id, __attribute__((unused)) page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  BUSTUB_ASSERT(static_cast<size_t>(frame_id) < replacer_size_, "invalid frame id");
+  auto &node = nodes_[frame_id];
+  size_t *history = &timestamps_[frame_id * k_];
+  if (node.history_size_ < k_) {
+    history[(node.history_head_ + node.history_size_) % k_] = current_timestamp_++;
+    node.history_size_++;
+  } else {
+    // The slot of the oldest access is reused for the newest one.
+    history[node.history_head_] = current_timestamp_++;
+    node.history_head_ = (node.history_head_ + 1) % k_;
+  }
+  // A new access only ever moves a frame later in the eviction order.
+  if (node.heap_index_ != INVALID_HEAP_INDEX) {
+    HeapSiftDown(node.heap_index_);
+  }
+}
+
+void LRUKReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  BUSTUB_ASSERT(static_cast<size_t>(frame_id) < replacer_size_, "invalid frame id");
+  auto &node = nodes_[frame_id];
+  if (node.history_size_ == 0 || node.evictable_ == set_evictable) {
+    return;
+  }
+  node.evictable_ = set_evictable;
+  if (set_evictable) {
+    HeapPush(frame_id);
+    curr_size_++;
+  } else {
+    HeapErase(frame_id);
+    curr_size_--;
+  }
+}
+
+void LRUKReplacer::Remove(frame_id_t frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= replacer_size_ || nodes_[frame_id].history_size_ == 0) {
+    return;
+  }
+  BUSTUB_ENSURE(nodes_[frame_id].evictable_, "cannot remove a non-evictable frame");
+  HeapErase(frame_id);
+  ResetNode(frame_id);
+  curr_size_--;
+}
+
+auto LRUKReplacer::Size() -> size_t {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return curr_size_;
+}
+
+auto LRUKReplacer::EvictsBefore(frame_id_t a, frame_id_t b) const -> bool {
+  // Frames with fewer than k accesses (+inf distance) always beat frames with k accesses. Within each class,
+  // the frame with the smallest relevant timestamp has the largest backward k-distance.
+  bool a_inf = nodes_[a].history_size_ < k_;
+  bool b_inf = nodes_[b].history_size_ < k_;
+  if (a_inf != b_inf) {
+    return a_inf;
+  }
+  return KthTimestamp(a) < KthTimestamp(b);
+}
+
+void LRUKReplacer::ResetNode(frame_id_t frame_id) {
+  auto &node = nodes_[frame_id];
+  node.history_head_ = 0;
+  node.history_size_ = 0;
+  node.evictable_ = false;
+}
 
-auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool { return false; }
+void LRUKReplacer::HeapPush(frame_id_t frame_id) {
+  nodes_[frame_id].heap_index_ = heap_.size();
+  heap_.push_back(frame_id);
+  HeapSiftUp(heap_.size() - 1);
+}
 
-void LRUKReplacer::RecordAccess(frame_id_t frame_id) {}
+void LRUKReplacer::HeapErase(frame_id_t frame_id) {
+  size_t index = nodes_[frame_id].heap_index_;
+  size_t last = heap_.size() - 1;
+  if (index != last) {
+    HeapSwap(index, last);
+  }
+  heap_.pop_back();
+  nodes_[frame_id].heap_index_ = INVALID_HEAP_INDEX;
+  if (index < heap_.size()) {
+    HeapSiftUp(index);
+    HeapSiftDown(index);
+  }
+}
 
-void LRUKReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {}
+void LRUKReplacer::HeapSiftUp(size_t index) {
+  while (index > 0) {
+    size_t parent = (index - 1) / 2;
+    if (!EvictsBefore(heap_[index], heap_[parent])) {
+      break;
+    }
+    HeapSwap(index, parent);
+    index = parent;
+  }
+}
 
-void LRUKReplacer::Remove(frame_id_t frame_id) {}
+void LRUKReplacer::HeapSiftDown(size_t index) {
+  while (true) {
+    size_t smallest = index;
+    size_t left = 2 * index + 1;
+    size_t right = left + 1;
+    if (left < heap_.size() && EvictsBefore(heap_[left], heap_[smallest])) {
+      smallest = left;
+    }
+    if (right < heap_.size() && EvictsBefore(heap_[right], heap_[smallest])) {
+      smallest = right;
+    }
+    if (smallest == index) {
+      return;
+    }
+    HeapSwap(index, smallest);
+    index = smallest;
+  }
+}
 
-auto LRUKReplacer::Size() -> size_t { return 0; }
+void LRUKReplacer::HeapSwap(size_t a, size_t b) {
+  std::swap(heap_[a], heap_[b]);
+  nodes_[heap_[a]].heap_index_ = a;
+  nodes_[heap_[b]].heap_index_ = b;
+}
 
 }  // namespace bustub
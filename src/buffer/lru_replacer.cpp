@@ -12,18 +12,94 @@
 
 #include "buffer/lru_replacer.h"
 
+#include "common/macros.h"
+
 namespace bustub {
 
-LRUReplacer::LRUReplacer(size_t num_pages) {}
+LRUReplacer::LRUReplacer(size_t num_pages)
+    : positions_(num_pages), tracked_(num_pages, false), evictable_(num_pages, false) {}
 
 LRUReplacer::~LRUReplacer() = default;
 
-auto LRUReplacer::Victim(frame_id_t *frame_id) -> bool { return false; }
+auto LRUReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock<std::mutex> lock(latch_);
+  for (auto it = lru_list_.rbegin(); it != lru_list_.rend(); ++it) {
+    if (evictable_[*it]) {
+      *frame_id = *it;
+      Untrack(*it);
+      return true;
+    }
+  }
+  return false;
+}
+
+void LRUReplacer::RecordAccess(frame_id_t frame_id, __attribute__((unused)) page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  BUSTUB_ASSERT(static_cast<size_t>(frame_id) < tracked_.size(), "invalid frame id");
+  if (tracked_[frame_id]) {
+    lru_list_.splice(lru_list_.begin(), lru_list_, positions_[frame_id]);
+    return;
+  }
+  positions_[frame_id] = lru_list_.insert(lru_list_.begin(), frame_id);
+  tracked_[frame_id] = true;
+}
+
+void LRUReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  BUSTUB_ASSERT(static_cast<size_t>(frame_id) < tracked_.size(), "invalid frame id");
+  if (!tracked_[frame_id] || evictable_[frame_id] == set_evictable) {
+    return;
+  }
+  evictable_[frame_id] = set_evictable;
+  if (set_evictable) {
+    curr_size_++;
+  } else {
+    curr_size_--;
+  }
+}
+
+void LRUReplacer::Remove(frame_id_t frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= tracked_.size() || !tracked_[frame_id]) {
+    return;
+  }
+  BUSTUB_ENSURE(evictable_[frame_id], "cannot remove a non-evictable frame");
+  Untrack(frame_id);
+}
+
+auto LRUReplacer::Size() -> size_t {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return curr_size_;
+}
+
+auto LRUReplacer::Victim(frame_id_t *frame_id) -> bool { return Evict(frame_id); }
 
-void LRUReplacer::Pin(frame_id_t frame_id) {}
+void LRUReplacer::Pin(frame_id_t frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (static_cast<size_t>(frame_id) < tracked_.size() && tracked_[frame_id]) {
+    Untrack(frame_id);
+  }
+}
 
-void LRUReplacer::Unpin(frame_id_t frame_id) {}
+void LRUReplacer::Unpin(frame_id_t frame_id) {
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    BUSTUB_ASSERT(static_cast<size_t>(frame_id) < tracked_.size(), "invalid frame id");
+    if (!tracked_[frame_id]) {
+      positions_[frame_id] = lru_list_.insert(lru_list_.begin(), frame_id);
+      tracked_[frame_id] = true;
+    }
+  }
+  SetEvictable(frame_id, true);
+}
 
-auto LRUReplacer::Size() -> size_t { return 0; }
+void LRUReplacer::Untrack(frame_id_t frame_id) {
+  lru_list_.erase(positions_[frame_id]);
+  tracked_[frame_id] = false;
+  if (evictable_[frame_id]) {
+    evictable_[frame_id] = false;
+    curr_size_--;
+  }
+}
 
 }  // namespace bustub
@@ -0,0 +1,42 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// page_access_trace.cpp
+//
+// Identification: src/buffer/page_access_trace.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/page_access_trace.h"
+
+#include <fstream>
+
+namespace bustub {
+
+auto PageAccessTrace::Save(const std::string &file_name) -> bool {
+  std::scoped_lock<std::mutex> lock(latch_);
+  std::ofstream out(file_name, std::ios::trunc);
+  for (page_id_t page_id : page_ids_) {
+    out << page_id << '\n';
+  }
+  out.flush();
+  return out.good();
+}
+
+auto PageAccessTrace::Load(const std::string &file_name, std::vector<page_id_t> *page_ids) -> bool {
+  std::ifstream in(file_name);
+  if (!in.is_open()) {
+    return false;
+  }
+  page_ids->clear();
+  page_id_t page_id;
+  while (in >> page_id) {
+    page_ids->push_back(page_id);
+  }
+  return in.eof();
+}
+
+}  // namespace bustub
@@ -0,0 +1,152 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_buffer_pool_manager.cpp
+//
+// Identification: src/buffer/parallel_buffer_pool_manager.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/parallel_buffer_pool_manager.h"
+
+#include "common/macros.h"
+
+namespace bustub {
+
+ParallelBufferPoolManager::ParallelBufferPoolManager(size_t num_instances, size_t pool_size,
+                                                     DiskManager *disk_manager, size_t replacer_k,
+                                                     LogManager *log_manager, ReplacerPolicy replacer_policy) {
+  BUSTUB_ASSERT(num_instances > 0, "a parallel buffer pool needs at least one instance");
+  instances_.reserve(num_instances);
+  for (size_t i = 0; i < num_instances; i++) {
+    instances_.emplace_back(std::make_unique<BufferPoolManagerInstance>(
+        pool_size, static_cast<uint32_t>(num_instances), static_cast<uint32_t>(i), disk_manager, replacer_k,
+        log_manager, replacer_policy));
+  }
+}
+
+ParallelBufferPoolManager::~ParallelBufferPoolManager() = default;
+
+auto ParallelBufferPoolManager::GetPoolSize() -> size_t {
+  size_t pool_size = 0;
+  for (const auto &instance : instances_) {
+    pool_size += instance->GetPoolSize();
+  }
+  return pool_size;
+}
+
+void ParallelBufferPoolManager::PrefetchPages(page_id_t start_page_id, size_t count) {
+  for (auto &instance : instances_) {
+    instance->PrefetchPages(start_page_id, count);
+  }
+}
+
+void ParallelBufferPoolManager::SetPageAccessTrace(PageAccessTrace *trace) {
+  for (auto &instance : instances_) {
+    instance->SetPageAccessTrace(trace);
+  }
+}
+
+void ParallelBufferPoolManager::StartPageCleaner(std::chrono::milliseconds interval, size_t max_pages_per_round) {
+  for (auto &instance : instances_) {
+    instance->StartPageCleaner(interval, max_pages_per_round);
+  }
+}
+
+void ParallelBufferPoolManager::StopPageCleaner() {
+  for (auto &instance : instances_) {
+    instance->StopPageCleaner();
+  }
+}
+
+auto ParallelBufferPoolManager::GetNumPagesCleaned() -> size_t {
+  size_t num_pages_cleaned = 0;
+  for (const auto &instance : instances_) {
+    num_pages_cleaned += instance->GetNumPagesCleaned();
+  }
+  return num_pages_cleaned;
+}
+
+auto ParallelBufferPoolManager::GetNumDirtyEvictionsAvoided() -> size_t {
+  size_t num_avoided = 0;
+  for (const auto &instance : instances_) {
+    num_avoided += instance->GetNumDirtyEvictionsAvoided();
+  }
+  return num_avoided;
+}
+
+auto ParallelBufferPoolManager::GetBufferPoolManager(page_id_t page_id) -> BufferPoolManagerInstance * {
+  return instances_[static_cast<size_t>(page_id) % instances_.size()].get();
+}
+
+auto ParallelBufferPoolManager::FetchPgImp(page_id_t page_id) -> Page * {
+  if (page_id == INVALID_PAGE_ID) {
+    return nullptr;
+  }
+  return GetBufferPoolManager(page_id)->FetchPage(page_id);
+}
+
+auto ParallelBufferPoolManager::FetchPgRingImp(page_id_t page_id, BufferRing *ring) -> Page * {
+  if (page_id == INVALID_PAGE_ID) {
+    return nullptr;
+  }
+  return GetBufferPoolManager(page_id)->FetchPageWithRing(page_id, ring);
+}
+
+auto ParallelBufferPoolManager::UnpinPgImp(page_id_t page_id, bool is_dirty) -> bool {
+  if (page_id == INVALID_PAGE_ID) {
+    return false;
+  }
+  return GetBufferPoolManager(page_id)->UnpinPage(page_id, is_dirty);
+}
+
+auto ParallelBufferPoolManager::FlushPgImp(page_id_t page_id) -> bool {
+  if (page_id == INVALID_PAGE_ID) {
+    return false;
+  }
+  return GetBufferPoolManager(page_id)->FlushPage(page_id);
+}
+
+auto ParallelBufferPoolManager::NewPgImp(page_id_t *page_id) -> Page * {
+  const size_t num_instances = instances_.size();
+  const size_t start = next_instance_.fetch_add(1) % num_instances;
+  for (size_t i = 0; i < num_instances; i++) {
+    Page *page = instances_[(start + i) % num_instances]->NewPage(page_id);
+    if (page != nullptr) {
+      return page;
+    }
+  }
+  *page_id = INVALID_PAGE_ID;
+  return nullptr;
+}
+
+auto ParallelBufferPoolManager::NewPgRingImp(page_id_t *page_id, BufferRing *ring) -> Page * {
+  const size_t num_instances = instances_.size();
+  const size_t start = next_instance_.fetch_add(1) % num_instances;
+  for (size_t i = 0; i < num_instances; i++) {
+    Page *page = instances_[(start + i) % num_instances]->NewPageWithRing(page_id, ring);
+    if (page != nullptr) {
+      return page;
+    }
+  }
+  *page_id = INVALID_PAGE_ID;
+  return nullptr;
+}
+
+auto ParallelBufferPoolManager::DeletePgImp(page_id_t page_id) -> bool {
+  if (page_id == INVALID_PAGE_ID) {
+    return true;
+  }
+  return GetBufferPoolManager(page_id)->DeletePage(page_id);
+}
+
+void ParallelBufferPoolManager::FlushAllPgsImp() {
+  for (const auto &instance : instances_) {
+    instance->FlushAllPages();
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,118 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// two_queue_replacer.cpp
+//
+// Identification: src/buffer/two_queue_replacer.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/two_queue_replacer.h"
+
+#include <algorithm>
+
+namespace bustub {
+
+TwoQueueReplacer::TwoQueueReplacer(size_t num_frames)
+    : queue_(num_frames, Queue::None),
+      positions_(num_frames),
+      page_ids_(num_frames, INVALID_PAGE_ID),
+      evictable_(num_frames, false),
+      kin_(std::max<size_t>(num_frames / 4, 1)),
+      kout_(std::max<size_t>(num_frames / 2, 1)) {}
+
+auto TwoQueueReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock<std::mutex> lock(latch_);
+  bool prefer_a1in = a1in_.size() > kin_ || am_.empty();
+  frame_id_t victim = OldestEvictable(prefer_a1in ? a1in_ : am_);
+  if (victim == INVALID_FRAME_ID) {
+    victim = OldestEvictable(prefer_a1in ? am_ : a1in_);
+  }
+  if (victim == INVALID_FRAME_ID) {
+    return false;
+  }
+  if (queue_[victim] == Queue::A1In && page_ids_[victim] != INVALID_PAGE_ID) {
+    a1out_.PushFront(page_ids_[victim]);
+    if (a1out_.Size() > kout_) {
+      a1out_.PopBack();
+    }
+  }
+  Untrack(victim);
+  *frame_id = victim;
+  return true;
+}
+
+void TwoQueueReplacer::RecordAccess(frame_id_t frame_id, page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  BUSTUB_ASSERT(static_cast<size_t>(frame_id) < queue_.size(), "invalid frame id");
+  switch (queue_[frame_id]) {
+    case Queue::Am:
+      am_.splice(am_.begin(), am_, positions_[frame_id]);
+      return;
+    case Queue::A1In:
+      // correlated reference, the page keeps its place in the FIFO
+      return;
+    case Queue::None:
+      break;
+  }
+  page_ids_[frame_id] = page_id;
+  if (page_id != INVALID_PAGE_ID && a1out_.Erase(page_id)) {
+    queue_[frame_id] = Queue::Am;
+    positions_[frame_id] = am_.insert(am_.begin(), frame_id);
+  } else {
+    queue_[frame_id] = Queue::A1In;
+    positions_[frame_id] = a1in_.insert(a1in_.begin(), frame_id);
+  }
+}
+
+void TwoQueueReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  BUSTUB_ASSERT(static_cast<size_t>(frame_id) < queue_.size(), "invalid frame id");
+  if (queue_[frame_id] == Queue::None || evictable_[frame_id] == set_evictable) {
+    return;
+  }
+  evictable_[frame_id] = set_evictable;
+  if (set_evictable) {
+    curr_size_++;
+  } else {
+    curr_size_--;
+  }
+}
+
+void TwoQueueReplacer::Remove(frame_id_t frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= queue_.size() || queue_[frame_id] == Queue::None) {
+    return;
+  }
+  BUSTUB_ENSURE(evictable_[frame_id], "cannot remove a non-evictable frame");
+  Untrack(frame_id);
+}
+
+auto TwoQueueReplacer::Size() -> size_t {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return curr_size_;
+}
+
+auto TwoQueueReplacer::OldestEvictable(const std::list<frame_id_t> &queue) const -> frame_id_t {
+  for (auto it = queue.rbegin(); it != queue.rend(); ++it) {
+    if (evictable_[*it]) {
+      return *it;
+    }
+  }
+  return INVALID_FRAME_ID;
+}
+
+void TwoQueueReplacer::Untrack(frame_id_t frame_id) {
+  (queue_[frame_id] == Queue::A1In ? a1in_ : am_).erase(positions_[frame_id]);
+  queue_[frame_id] = Queue::None;
+  page_ids_[frame_id] = INVALID_PAGE_ID;
+  if (evictable_[frame_id]) {
+    evictable_[frame_id] = false;
+    curr_size_--;
+  }
+}
+
+}  // namespace bustub
@@ -2,6 +2,7 @@
 #include <shared_mutex>
 #include <string>
 #include <tuple>
+#include <type_traits>
 
 #include "binder/binder.h"
 #include "binder/bound_expression.h"
@@ -12,11 +13,14 @@
 #include "binder/statement/select_statement.h"
 #include "binder/statement/set_show_statement.h"
 #include "buffer/buffer_pool_manager_instance.h"
+#include "buffer/page_access_trace.h"
+#include "buffer/parallel_buffer_pool_manager.h"
 #include "catalog/schema.h"
 #include "catalog/table_generator.h"
 #include "common/bustub_instance.h"
 #include "common/enums/statement_type.h"
 #include "common/exception.h"
+#include "common/macros.h"
 #include "common/util/string_util.h"
 #include "concurrency/lock_manager.h"
 #include "concurrency/transaction.h"
@@ -38,10 +42,15 @@
 namespace bustub {
 
 auto BustubInstance::MakeExecutorContext(Transaction *txn) -> std::unique_ptr<ExecutorContext> {
-  return std::make_unique<ExecutorContext>(txn, catalog_, buffer_pool_manager_, txn_manager_, lock_manager_);
+  auto exec_ctx = std::make_unique<ExecutorContext>(txn, catalog_, buffer_pool_manager_, txn_manager_, lock_manager_);
+  exec_ctx->SetMemoryBudget(GetExecutorMemoryBudget());
+  exec_ctx->SetRadixSort(IsRadixSort());
+  exec_ctx->SetSortParallelism(GetSortParallelism());
+  exec_ctx->SetBufferAccessStrategy(GetBufferAccessStrategy(), GetBufferRingSize());
+  return exec_ctx;
 }
 
-BustubInstance::BustubInstance(const std::string &db_file_name) {
+BustubInstance::BustubInstance(const std::string &db_file_name, const BustubInstanceConfig &config) {
   enable_logging = false;
 
   // Storage related.
@@ -50,14 +59,7 @@ BustubInstance::BustubInstance(const std::string &db_file_name) {
   // Log related.
   log_manager_ = new LogManager(disk_manager_);
 
-  // We need more frames for GenerateTestTable to work. Therefore, we use 128 instead of the default
-  // buffer pool size specified in `config.h`.
-  try {
-    buffer_pool_manager_ = new BufferPoolManagerInstance(128, disk_manager_, LRUK_REPLACER_K, log_manager_);
-  } catch (NotImplementedException &e) {
-    std::cerr << "BufferPoolManager is not implemented, only mock tables are supported." << std::endl;
-    buffer_pool_manager_ = nullptr;
-  }
+  InitBufferPool(config);
 
   // Transaction (txn) related.
   lock_manager_ = new LockManager();
@@ -73,7 +75,7 @@ BustubInstance::BustubInstance(const std::string &db_file_name) {
   execution_engine_ = new ExecutionEngine(buffer_pool_manager_, txn_manager_, catalog_);
 }
 
-BustubInstance::BustubInstance() {
+BustubInstance::BustubInstance(const BustubInstanceConfig &config) {
   enable_logging = false;
 
   // Storage related.
@@ -82,14 +84,7 @@ BustubInstance::BustubInstance() {
   // Log related.
   log_manager_ = new LogManager(disk_manager_);
 
-  // We need more frames for GenerateTestTable to work. Therefore, we use 128 instead of the default
-  // buffer pool size specified in `config.h`.
-  try {
-    buffer_pool_manager_ = new BufferPoolManagerInstance(128, disk_manager_, LRUK_REPLACER_K, log_manager_);
-  } catch (NotImplementedException &e) {
-    std::cerr << "BufferPoolManager is not implemented, only mock tables are supported." << std::endl;
-    buffer_pool_manager_ = nullptr;
-  }
+  InitBufferPool(config);
 
   // Transaction (txn) related.
   lock_manager_ = new LockManager();
@@ -105,6 +100,44 @@ BustubInstance::BustubInstance() {
   execution_engine_ = new ExecutionEngine(buffer_pool_manager_, txn_manager_, catalog_);
 }
 
+void BustubInstance::InitBufferPool(const BustubInstanceConfig &config) {
+  // We need more frames for GenerateTestTable to work. Therefore, the default configuration uses 128 instead of the
+  // default buffer pool size specified in `config.h`.
+  try {
+    if (config.buffer_pool_instances_ > 1) {
+      size_t instance_pool_size = (config.buffer_pool_size_ + config.buffer_pool_instances_ - 1) /
+                                  config.buffer_pool_instances_;
+      buffer_pool_manager_ =
+          new ParallelBufferPoolManager(config.buffer_pool_instances_, instance_pool_size, disk_manager_,
+                                        config.replacer_k_, log_manager_, config.replacer_policy_);
+    } else {
+      buffer_pool_manager_ = new BufferPoolManagerInstance(config.buffer_pool_size_, disk_manager_,
+                                                           config.replacer_k_, log_manager_, config.replacer_policy_);
+    }
+  } catch (NotImplementedException &e) {
+    std::cerr << "BufferPoolManager is not implemented, only mock tables are supported." << std::endl;
+    buffer_pool_manager_ = nullptr;
+  }
+
+  if (buffer_pool_manager_ != nullptr) {
+    // The b+ tree indexes keep their root page ids in the header page, which must be the first page of the database.
+    page_id_t header_page_id;
+    buffer_pool_manager_->NewPage(&header_page_id);
+    BUSTUB_ASSERT(header_page_id == HEADER_PAGE_ID, "the header page must be the first page");
+    buffer_pool_manager_->UnpinPage(header_page_id, true);
+  }
+
+  if (buffer_pool_manager_ != nullptr && config.page_cleaner_interval_.count() > 0) {
+    buffer_pool_manager_->StartPageCleaner(config.page_cleaner_interval_, PAGE_CLEANER_BATCH_SIZE);
+  }
+
+  if (buffer_pool_manager_ != nullptr && !config.page_trace_file_.empty()) {
+    page_trace_ = std::make_unique<PageAccessTrace>();
+    page_trace_file_ = config.page_trace_file_;
+    buffer_pool_manager_->SetPageAccessTrace(page_trace_.get());
+  }
+}
+
 void BustubInstance::CmdDisplayTables(ResultWriter &writer) {
   auto table_names = catalog_->GetTableNames();
   writer.BeginTable(false);
@@ -237,10 +270,41 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
         }
         auto key_schema = Schema::CopySchema(&index_stmt.table_->schema_, col_ids);
 
+        // The included columns are stored in the entries after the key, which must fit in the largest generic key.
+        std::vector<uint32_t> include_ids;
+        size_t entry_size = INTEGER_SIZE;
+        for (const auto &col : index_stmt.include_cols_) {
+          auto idx = index_stmt.table_->schema_.GetColIdx(col->col_name_.back());
+          include_ids.push_back(idx);
+          if (!index_stmt.table_->schema_.GetColumn(idx).IsInlined()) {
+            throw NotImplementedException("only support including fixed-length columns in an index");
+          }
+          entry_size += index_stmt.table_->schema_.GetColumn(idx).GetFixedLength();
+        }
+
         std::unique_lock<std::shared_mutex> l(catalog_lock_);
-        auto info = catalog_->CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
-            txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
-            INTEGER_SIZE, IntegerHashFunctionType{});
+        auto create_index = [&](auto key_size) {
+          constexpr size_t KEY_SIZE = decltype(key_size)::value;
+          return catalog_->CreateIndex<GenericKey<KEY_SIZE>, RID, GenericComparator<KEY_SIZE>>(
+              txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
+              entry_size, HashFunction<GenericKey<KEY_SIZE>>{}, include_ids, index_stmt.index_type_);
+        };
+        IndexInfo *info;
+        if (include_ids.empty()) {
+          info = catalog_->CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
+              txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
+              INTEGER_SIZE, IntegerHashFunctionType{}, {}, index_stmt.index_type_);
+        } else if (entry_size <= 8) {
+          info = create_index(std::integral_constant<size_t, 8>{});
+        } else if (entry_size <= 16) {
+          info = create_index(std::integral_constant<size_t, 16>{});
+        } else if (entry_size <= 32) {
+          info = create_index(std::integral_constant<size_t, 32>{});
+        } else if (entry_size <= 64) {
+          info = create_index(std::integral_constant<size_t, 64>{});
+        } else {
+          throw NotImplementedException("the key and the included columns of an index should fit in 64 bytes");
+        }
         l.unlock();
 
         if (info == nullptr) {
@@ -391,10 +455,19 @@ BustubInstance::~BustubInstance() {
   if (enable_logging) {
     log_manager_->StopFlushThread();
   }
+  if (buffer_pool_manager_ != nullptr) {
+    buffer_pool_manager_->StopPageCleaner();
+  }
   delete execution_engine_;
   delete catalog_;
   delete checkpoint_manager_;
   delete log_manager_;
+  if (page_trace_ != nullptr) {
+    buffer_pool_manager_->SetPageAccessTrace(nullptr);
+    if (!page_trace_->Save(page_trace_file_)) {
+      std::cerr << "failed to save the page access trace to " << page_trace_file_ << std::endl;
+    }
+  }
   delete buffer_pool_manager_;
   delete lock_manager_;
   delete txn_manager_;
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -17,6 +18,7 @@
 
 #include "common/exception.h"
 #include "common/logger.h"
+#include "common/macros.h"
 #include "common/rid.h"
 #include "container/disk/hash/disk_extendible_hash_table.h"
 
@@ -26,7 +28,18 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_TYPE::DiskExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
                                          const KeyComparator &comparator, HashFunction<KeyType> hash_fn)
     : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
-  //  implement me!
+  // The table starts with one bucket, at global depth 0.
+  Page *directory_page = buffer_pool_manager_->NewPage(&directory_page_id_);
+  BUSTUB_ASSERT(directory_page != nullptr, "no frame for the directory page");
+  directory_ = reinterpret_cast<HashTableDirectoryPage *>(directory_page->GetData());
+  directory_->SetPageId(directory_page_id_);
+  page_id_t bucket_page_id;
+  Page *bucket_page = buffer_pool_manager_->NewPage(&bucket_page_id);
+  BUSTUB_ASSERT(bucket_page != nullptr, "no frame for the first bucket page");
+  reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(bucket_page->GetData())->Init();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  directory_->SetBucketPageId(0, bucket_page_id);
+  directory_->SetLocalDepth(0, 0);
 }
 
 /*****************************************************************************
@@ -46,22 +59,135 @@ auto HASH_TABLE_TYPE::Hash(KeyType key) -> uint32_t {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 inline auto HASH_TABLE_TYPE::KeyToDirectoryIndex(KeyType key, HashTableDirectoryPage *dir_page) -> uint32_t {
-  return 0;
+  return Hash(key) & dir_page->GetGlobalDepthMask();
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 inline auto HASH_TABLE_TYPE::KeyToPageId(KeyType key, HashTableDirectoryPage *dir_page) -> page_id_t {
-  return 0;
+  return dir_page->GetBucketPageId(KeyToDirectoryIndex(key, dir_page));
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::FetchDirectoryPage() -> HashTableDirectoryPage * {
-  return nullptr;
+  return reinterpret_cast<HashTableDirectoryPage *>(buffer_pool_manager_->FetchPage(directory_page_id_)->GetData());
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BUCKET_TYPE * {
-  return nullptr;
+  return reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(buffer_pool_manager_->FetchPage(bucket_page_id)->GetData());
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::LatchBucketPage(const KeyType &key, bool exclusive) -> Page * {
+  // The global depth cannot change under the table latch, so neither can the slot of the key.
+  uint32_t bucket_idx = KeyToDirectoryIndex(key, directory_);
+  while (true) {
+    page_id_t bucket_page_id = directory_->GetBucketPageId(bucket_idx);
+    Page *page = buffer_pool_manager_->FetchPage(bucket_page_id);
+    BUSTUB_ASSERT(page != nullptr, "no frame for a bucket page");
+    exclusive ? page->WLatch() : page->RLatch();
+    if (directory_->GetBucketPageId(bucket_idx) == bucket_page_id) {
+      return page;
+    }
+    // the bucket was split or merged away before it was latched
+    exclusive ? page->WUnlatch() : page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::GrowDirectory(uint32_t global_depth) {
+  table_latch_.WLock();
+  if (directory_->GetGlobalDepth() == global_depth && directory_->Size() * 2 <= DIRECTORY_ARRAY_SIZE) {
+    directory_->IncrGlobalDepth();
+  }
+  table_latch_.WUnlock();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+template <typename Visit>
+auto HASH_TABLE_TYPE::VisitChain(HASH_TABLE_BUCKET_TYPE *bucket, bool dirty, Visit &&visit) -> bool {
+  if (visit(bucket)) {
+    return true;
+  }
+  page_id_t overflow_page_id = bucket->GetOverflowPageId();
+  while (overflow_page_id != INVALID_PAGE_ID) {
+    HASH_TABLE_BUCKET_TYPE *overflow = FetchBucketPage(overflow_page_id);
+    bool stop = visit(overflow);
+    page_id_t next_page_id = overflow->GetOverflowPageId();
+    buffer_pool_manager_->UnpinPage(overflow_page_id, dirty);
+    if (stop) {
+      return true;
+    }
+    overflow_page_id = next_page_id;
+  }
+  return false;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::ChainContains(HASH_TABLE_BUCKET_TYPE *bucket, const KeyType &key, const ValueType &value)
+    -> bool {
+  return VisitChain(bucket, false, [&](HASH_TABLE_BUCKET_TYPE *page) {
+    std::vector<ValueType> values;
+    page->GetValue(key, comparator_, &values);
+    return std::find(values.begin(), values.end(), value) != values.end();
+  });
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::AppendToChain(HASH_TABLE_BUCKET_TYPE *bucket, const KeyType &key, const ValueType &value,
+                                    bool grow) -> bool {
+  if (VisitChain(bucket, true, [&](HASH_TABLE_BUCKET_TYPE *page) {
+        return !page->IsFull() && page->Insert(key, value, comparator_);
+      })) {
+    return true;
+  }
+  if (!grow) {
+    return false;
+  }
+  // the new overflow page goes right after the bucket page, where the next insert finds it first
+  page_id_t overflow_page_id;
+  Page *overflow_page = buffer_pool_manager_->NewPage(&overflow_page_id);
+  BUSTUB_ASSERT(overflow_page != nullptr, "no frame for an overflow page");
+  auto *overflow = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(overflow_page->GetData());
+  overflow->Init();
+  overflow->SetOverflowPageId(bucket->GetOverflowPageId());
+  overflow->Insert(key, value, comparator_);
+  bucket->SetOverflowPageId(overflow_page_id);
+  buffer_pool_manager_->UnpinPage(overflow_page_id, true);
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::PruneChain(HASH_TABLE_BUCKET_TYPE *bucket) {
+  // prev is the last page kept in the chain; the caller holds the pin of the bucket page
+  HASH_TABLE_BUCKET_TYPE *prev = bucket;
+  page_id_t prev_page_id = INVALID_PAGE_ID;
+  page_id_t overflow_page_id = bucket->GetOverflowPageId();
+  while (overflow_page_id != INVALID_PAGE_ID) {
+    HASH_TABLE_BUCKET_TYPE *overflow = FetchBucketPage(overflow_page_id);
+    page_id_t next_page_id = overflow->GetOverflowPageId();
+    if (overflow->IsEmpty()) {
+      prev->SetOverflowPageId(next_page_id);
+      buffer_pool_manager_->UnpinPage(overflow_page_id, false);
+      buffer_pool_manager_->DeletePage(overflow_page_id);
+    } else {
+      if (prev_page_id != INVALID_PAGE_ID) {
+        buffer_pool_manager_->UnpinPage(prev_page_id, true);
+      }
+      prev = overflow;
+      prev_page_id = overflow_page_id;
+    }
+    overflow_page_id = next_page_id;
+  }
+  if (prev_page_id != INVALID_PAGE_ID) {
+    buffer_pool_manager_->UnpinPage(prev_page_id, true);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::IsChainEmpty(HASH_TABLE_BUCKET_TYPE *bucket) -> bool {
+  return bucket->IsEmpty() && bucket->GetOverflowPageId() == INVALID_PAGE_ID;
 }
 
 /*****************************************************************************
@@ -69,7 +195,18 @@ auto HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BU
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool {
-  return false;
+  table_latch_.RLock();
+  Page *page = LatchBucketPage(key, false);
+  auto *bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+  bool found = false;
+  VisitChain(bucket, false, [&](HASH_TABLE_BUCKET_TYPE *chain_page) {
+    found = chain_page->GetValue(key, comparator_, result) || found;
+    return false;
+  });
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  table_latch_.RUnlock();
+  return found;
 }
 
 /*****************************************************************************
@@ -77,12 +214,91 @@ auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.RLock();
+  Page *page = LatchBucketPage(key, true);
+  auto *bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+  bool duplicate = ChainContains(bucket, key, value);
+  bool inserted = !duplicate && AppendToChain(bucket, key, value, false);
+  bool is_full = !duplicate && !inserted;
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), inserted);
+  table_latch_.RUnlock();
+  return is_full ? SplitInsert(transaction, key, value) : inserted;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  while (true) {
+    table_latch_.RLock();
+    Page *page = LatchBucketPage(key, true);
+    auto *bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+    uint32_t bucket_idx = KeyToDirectoryIndex(key, directory_);
+    uint32_t local_depth = directory_->GetLocalDepth(bucket_idx);
+    uint32_t global_depth = directory_->GetGlobalDepth();
+    bool duplicate = ChainContains(bucket, key, value);
+    bool inserted = !duplicate && AppendToChain(bucket, key, value, false);
+    if (!duplicate && !inserted) {
+      // The chain is full. Splitting cannot separate pairs that all hash like the key, and nothing can be split once
+      // the directory cannot grow; the chain takes an overflow page then.
+      uint32_t hash = Hash(key);
+      bool splittable = VisitChain(bucket, false, [&](HASH_TABLE_BUCKET_TYPE *chain_page) {
+        for (uint32_t i = 0; i < BUCKET_ARRAY_SIZE; i++) {
+          if (chain_page->IsReadable(i) && Hash(chain_page->KeyAt(i)) != hash) {
+            return true;
+          }
+        }
+        return false;
+      });
+      bool can_grow = local_depth < global_depth || directory_->Size() * 2 <= DIRECTORY_ARRAY_SIZE;
+      inserted = !(splittable && can_grow) && AppendToChain(bucket, key, value, true);
+    }
+    if (duplicate || inserted) {
+      page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), inserted);
+      table_latch_.RUnlock();
+      return inserted;
+    }
+
+    if (local_depth == global_depth) {
+      page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+      table_latch_.RUnlock();
+      GrowDirectory(global_depth);
+      continue;
+    }
+
+    // Move the pairs whose hash has the new local bit set to a new bucket, which stays latched until the directory
+    // points to it.
+    page_id_t image_page_id;
+    Page *image_page = buffer_pool_manager_->NewPage(&image_page_id);
+    BUSTUB_ASSERT(image_page != nullptr, "no frame for a new bucket page");
+    image_page->WLatch();
+    auto *image = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(image_page->GetData());
+    image->Init();
+    uint32_t high_bit = 1U << local_depth;
+    VisitChain(bucket, true, [&](HASH_TABLE_BUCKET_TYPE *chain_page) {
+      for (uint32_t i = 0; i < BUCKET_ARRAY_SIZE; i++) {
+        if (chain_page->IsReadable(i) && (Hash(chain_page->KeyAt(i)) & high_bit) != 0) {
+          AppendToChain(image, chain_page->KeyAt(i), chain_page->ValueAt(i), true);
+          chain_page->RemoveAt(i);
+        }
+      }
+      return false;
+    });
+    PruneChain(bucket);
+    // the slots of the bucket are those that agree with bucket_idx on the low local_depth bits
+    for (uint32_t i = bucket_idx & (high_bit - 1); i < directory_->Size(); i += high_bit) {
+      if ((i & high_bit) != 0) {
+        directory_->SetBucketPageId(i, image_page_id);
+      }
+      directory_->SetLocalDepth(i, local_depth + 1);
+    }
+    image_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(image_page_id, true);
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+    table_latch_.RUnlock();
+  }
 }
 
 /*****************************************************************************
@@ -90,14 +306,94 @@ auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key,
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.RLock();
+  Page *page = LatchBucketPage(key, true);
+  auto *bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+  bool removed = VisitChain(bucket, true, [&](HASH_TABLE_BUCKET_TYPE *chain_page) {
+    return chain_page->Remove(key, value, comparator_);
+  });
+  if (removed && bucket->GetOverflowPageId() != INVALID_PAGE_ID) {
+    PruneChain(bucket);
+  }
+  bool is_empty = removed && IsChainEmpty(bucket);
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), removed);
+  table_latch_.RUnlock();
+  if (is_empty) {
+    Merge(transaction, key, value);
+  }
+  return removed;
 }
 
 /*****************************************************************************
  * MERGE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {}
+void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.RLock();
+  uint32_t bucket_idx = KeyToDirectoryIndex(key, directory_);
+  bool merged = false;
+  bool merge_on = true;
+  while (merge_on) {
+    merge_on = false;
+    page_id_t bucket_page_id = directory_->GetBucketPageId(bucket_idx);
+    uint32_t local_depth = directory_->GetLocalDepth(bucket_idx);
+    uint32_t image_idx = directory_->GetSplitImageIndex(bucket_idx);
+    page_id_t image_page_id = directory_->GetBucketPageId(image_idx);
+    // a split of the bucket may be halfway through its slots, and then there is nothing to merge either
+    if (local_depth == 0 || image_page_id == bucket_page_id) {
+      break;
+    }
+
+    // Latch both buckets in page id order, since a merge of the image may latch them too, and check that the
+    // directory still points to them.
+    Page *page = buffer_pool_manager_->FetchPage(bucket_page_id);
+    Page *image_page = buffer_pool_manager_->FetchPage(image_page_id);
+    BUSTUB_ASSERT(page != nullptr && image_page != nullptr, "no frame for a bucket page");
+    Page *first = bucket_page_id < image_page_id ? page : image_page;
+    Page *second = first == page ? image_page : page;
+    first->WLatch();
+    second->WLatch();
+    bool unchanged = directory_->GetBucketPageId(bucket_idx) == bucket_page_id &&
+                     directory_->GetLocalDepth(bucket_idx) == local_depth &&
+                     directory_->GetBucketPageId(image_idx) == image_page_id;
+    bool merged_bucket = false;
+    if (unchanged && IsChainEmpty(reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData())) &&
+        directory_->GetLocalDepth(image_idx) == local_depth) {
+      // the slots of both buckets are those that agree with bucket_idx on the low local_depth - 1 bits
+      uint32_t step = 1U << (local_depth - 1);
+      for (uint32_t i = bucket_idx & (step - 1); i < directory_->Size(); i += step) {
+        directory_->SetBucketPageId(i, image_page_id);
+        directory_->SetLocalDepth(i, local_depth - 1);
+      }
+      merged_bucket = true;
+      // the image takes the place of the bucket, and may merge on in turn
+      merge_on = IsChainEmpty(reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(image_page->GetData()));
+    }
+    second->WUnlatch();
+    first->WUnlatch();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+    buffer_pool_manager_->UnpinPage(image_page_id, false);
+    merged = merged || merged_bucket;
+    if (!unchanged) {
+      merge_on = true;
+    } else if (merged_bucket) {
+      // A thread that read the old slot may still hold a pin, and then the page is left to it. It finds the slot
+      // changed once it latches the page.
+      buffer_pool_manager_->DeletePage(bucket_page_id);
+    }
+  }
+  bool can_shrink = merged && directory_->CanShrink();
+  table_latch_.RUnlock();
+
+  if (can_shrink) {
+    table_latch_.WLock();
+    while (directory_->CanShrink()) {
+      directory_->DecrGlobalDepth();
+    }
+    table_latch_.WUnlock();
+  }
+}
 
 /*****************************************************************************
  * GETGLOBALDEPTH - DO NOT TOUCH
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -22,25 +23,241 @@
 
 namespace bustub {
 
+namespace {
+
+/** The number of occupied slots, pairs and tombstones, at which a table of size slots starts to grow. */
+inline auto MaxLoad(size_t size) -> size_t { return size - size / 4; }
+
+}  // namespace
+
 template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_TYPE::LinearProbeHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
                                       const KeyComparator &comparator, size_t num_buckets,
                                       HashFunction<KeyType> hash_fn)
-    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {}
+    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
+  size_t num_blocks = std::clamp<size_t>((num_buckets + BLOCK_ARRAY_SIZE - 1) / BLOCK_ARRAY_SIZE, 1, HEADER_ARRAY_SIZE);
+  header_page_id_ = CreateNewBlockPages(num_blocks);
+}
+
+/*****************************************************************************
+ * HELPERS
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::Hash(const KeyType &key) -> uint64_t {
+  return hash_fn_.GetHash(key);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::GetHeaderPage(page_id_t header_page_id) -> std::pair<Page *, HashTableHeaderPage *> {
+  Page *page = buffer_pool_manager_->FetchPage(header_page_id);
+  BUSTUB_ASSERT(page != nullptr, "no frame for the header page");
+  return {page, reinterpret_cast<HashTableHeaderPage *>(page->GetData())};
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+template <typename Visit>
+void HASH_TABLE_TYPE::Probe(HashTableHeaderPage *header_page, const KeyType &key, bool dirty, Visit &&visit) {
+  const size_t size = header_page->GetSize();
+  size_t slot = Hash(key) % size;
+  Page *page = nullptr;
+  bool stopped = false;
+  for (size_t i = 0; i < size && !stopped; i++, slot = slot + 1 == size ? 0 : slot + 1) {
+    if (page == nullptr || slot % BLOCK_ARRAY_SIZE == 0) {
+      if (page != nullptr) {
+        buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+      }
+      page = buffer_pool_manager_->FetchPage(header_page->GetBlockPageId(slot / BLOCK_ARRAY_SIZE));
+      BUSTUB_ASSERT(page != nullptr, "no frame for a block page");
+    }
+    stopped = visit(reinterpret_cast<HASH_TABLE_BLOCK_TYPE *>(page->GetData()), slot % BLOCK_ARRAY_SIZE);
+  }
+  if (page != nullptr) {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), dirty && stopped);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::GetValueFrom(HashTableHeaderPage *header_page, const KeyType &key,
+                                   std::vector<ValueType> *result) -> bool {
+  bool found = false;
+  Probe(header_page, key, false, [&](HASH_TABLE_BLOCK_TYPE *block, slot_offset_t offset) {
+    if (!block->IsOccupied(offset)) {
+      return true;
+    }
+    if (block->IsReadable(offset) && comparator_(key, block->KeyAt(offset)) == 0) {
+      result->push_back(block->ValueAt(offset));
+      found = true;
+    }
+    return false;
+  });
+  return found;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::Contains(HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value) -> bool {
+  bool found = false;
+  Probe(header_page, key, false, [&](HASH_TABLE_BLOCK_TYPE *block, slot_offset_t offset) {
+    if (!block->IsOccupied(offset)) {
+      return true;
+    }
+    found = block->IsReadable(offset) && comparator_(key, block->KeyAt(offset)) == 0 && block->ValueAt(offset) == value;
+    return found;
+  });
+  return found;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::InsertInto(HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value)
+    -> bool {
+  // The pair goes into the first slot that was never occupied, once every pair before it on the probe sequence is
+  // known to differ. Tombstones are left for the next migration to compact. If another insert claims the slot first,
+  // the probe goes on, and the reserved slot guarantees there is one further on. That insert is of another key, since
+  // inserts of the same key hold the same insert latch, so the slot cannot hold the pair.
+  bool inserted = false;
+  Probe(header_page, key, true, [&](HASH_TABLE_BLOCK_TYPE *block, slot_offset_t offset) {
+    if (block->IsReadable(offset)) {
+      return comparator_(key, block->KeyAt(offset)) == 0 && block->ValueAt(offset) == value;
+    }
+    if (block->IsOccupied(offset)) {
+      return false;
+    }
+    inserted = block->Insert(offset, key, value);
+    return inserted;
+  });
+  if (inserted) {
+    header_page->AddNumReadable(1);
+  }
+  return inserted;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::RemoveFrom(HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value)
+    -> bool {
+  bool removed = false;
+  Probe(header_page, key, true, [&](HASH_TABLE_BLOCK_TYPE *block, slot_offset_t offset) {
+    if (!block->IsOccupied(offset)) {
+      return true;
+    }
+    removed = block->IsReadable(offset) && comparator_(key, block->KeyAt(offset)) == 0 &&
+              block->ValueAt(offset) == value && block->Remove(offset);
+    return removed;
+  });
+  if (removed) {
+    header_page->AddNumReadable(-1);
+  }
+  return removed;
+}
 
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool {
-  return false;
+  table_latch_.RLock();
+  auto [page, header_page] = GetHeaderPage(header_page_id_);
+  if (header_page->GetResizePageId() == INVALID_PAGE_ID) {
+    bool found = GetValueFrom(header_page, key, result);
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    table_latch_.RUnlock();
+    return found;
+  }
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  table_latch_.RUnlock();
+
+  // A pair is in the old table until its slot is migrated, and in the new one after.
+  table_latch_.WLock();
+  MigrateSlots(MIGRATE_SLOTS_PER_OP);
+  std::tie(page, header_page) = GetHeaderPage(header_page_id_);
+  bool found = GetValueFrom(header_page, key, result);
+  if (page_id_t resize_page_id = header_page->GetResizePageId(); resize_page_id != INVALID_PAGE_ID) {
+    auto [new_page, new_header_page] = GetHeaderPage(resize_page_id);
+    found = GetValueFrom(new_header_page, key, result) || found;
+    buffer_pool_manager_->UnpinPage(new_page->GetPageId(), false);
+  }
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  table_latch_.WUnlock();
+  return found;
 }
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  // Reserve a slot under the read latch, unless that would take the table past its load, so that concurrent inserts
+  // cannot fill it up.
+  table_latch_.RLock();
+  auto [page, header_page] = GetHeaderPage(header_page_id_);
+  if (header_page->GetResizePageId() == INVALID_PAGE_ID) {
+    if (header_page->AddNumOccupied(1) < MaxLoad(header_page->GetSize())) {
+      bool inserted;
+      {
+        std::scoped_lock insert_latch(insert_latches_[Hash(key) % INSERT_LATCH_STRIPES]);
+        inserted = InsertInto(header_page, key, value);
+      }
+      if (!inserted) {
+        header_page->AddNumOccupied(-1);
+      }
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+      table_latch_.RUnlock();
+      return inserted;
+    }
+    header_page->AddNumOccupied(-1);
+  }
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  table_latch_.RUnlock();
+
+  table_latch_.WLock();
+  bool inserted;
+  while (true) {
+    MigrateSlots(MIGRATE_SLOTS_PER_OP);
+    std::tie(page, header_page) = GetHeaderPage(header_page_id_);
+    page_id_t resize_page_id = header_page->GetResizePageId();
+    if (resize_page_id == INVALID_PAGE_ID) {
+      size_t occupied = header_page->GetNumOccupied();
+      size_t num_blocks = header_page->GetNumReadable() < header_page->GetSize() / 4
+                              ? header_page->NumBlocks()
+                              : std::min(2 * header_page->NumBlocks(), HEADER_ARRAY_SIZE);
+      if (occupied >= MaxLoad(header_page->GetSize()) && BeginResize(header_page, num_blocks)) {
+        buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+        continue;
+      }
+      // A table that cannot grow any more takes pairs until it is full.
+      inserted = occupied < header_page->GetSize();
+      if (inserted) {
+        header_page->AddNumOccupied(1);
+        inserted = InsertInto(header_page, key, value);
+        if (!inserted) {
+          header_page->AddNumOccupied(-1);
+        }
+      }
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), inserted);
+      break;
+    }
+
+    // The new table takes the inserts. Should it fill up before the old one is migrated, the rest of the migration
+    // is done at once.
+    auto [new_page, new_header_page] = GetHeaderPage(resize_page_id);
+    if (new_header_page->GetNumOccupied() >= MaxLoad(new_header_page->GetSize())) {
+      size_t size = header_page->GetSize();
+      buffer_pool_manager_->UnpinPage(new_page->GetPageId(), false);
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+      MigrateSlots(size);
+      continue;
+    }
+    inserted = !Contains(header_page, key, value);
+    if (inserted) {
+      new_header_page->AddNumOccupied(1);
+      inserted = InsertInto(new_header_page, key, value);
+      if (!inserted) {
+        new_header_page->AddNumOccupied(-1);
+      }
+    }
+    buffer_pool_manager_->UnpinPage(new_page->GetPageId(), inserted);
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    break;
+  }
+  table_latch_.WUnlock();
+  return inserted;
 }
 
 /*****************************************************************************
@@ -48,21 +265,154 @@ auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.RLock();
+  auto [page, header_page] = GetHeaderPage(header_page_id_);
+  if (header_page->GetResizePageId() == INVALID_PAGE_ID) {
+    bool removed = RemoveFrom(header_page, key, value);
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), removed);
+    table_latch_.RUnlock();
+    return removed;
+  }
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  table_latch_.RUnlock();
+
+  table_latch_.WLock();
+  MigrateSlots(MIGRATE_SLOTS_PER_OP);
+  std::tie(page, header_page) = GetHeaderPage(header_page_id_);
+  bool removed = RemoveFrom(header_page, key, value);
+  if (page_id_t resize_page_id = header_page->GetResizePageId(); !removed && resize_page_id != INVALID_PAGE_ID) {
+    auto [new_page, new_header_page] = GetHeaderPage(resize_page_id);
+    removed = RemoveFrom(new_header_page, key, value);
+    buffer_pool_manager_->UnpinPage(new_page->GetPageId(), removed);
+  }
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+  table_latch_.WUnlock();
+  return removed;
 }
 
 /*****************************************************************************
  * RESIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Resize(size_t initial_size) {}
+void HASH_TABLE_TYPE::Resize(size_t initial_size) {
+  table_latch_.WLock();
+  // Finish a migration in progress first, since the table only migrates to one new table at a time.
+  auto [page, header_page] = GetHeaderPage(header_page_id_);
+  size_t size = header_page->GetSize();
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  MigrateSlots(size);
+  std::tie(page, header_page) = GetHeaderPage(header_page_id_);
+  size_t num_blocks =
+      std::clamp<size_t>((2 * initial_size + BLOCK_ARRAY_SIZE - 1) / BLOCK_ARRAY_SIZE, 1, HEADER_ARRAY_SIZE);
+  bool resized = BeginResize(header_page, num_blocks);
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), resized);
+  table_latch_.WUnlock();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::CreateNewBlockPages(size_t num_blocks) -> page_id_t {
+  page_id_t header_page_id;
+  Page *page = buffer_pool_manager_->NewPage(&header_page_id);
+  BUSTUB_ASSERT(page != nullptr, "no frame for a new header page");
+  auto *header_page = reinterpret_cast<HashTableHeaderPage *>(page->GetData());
+  header_page->SetPageId(header_page_id);
+  header_page->SetResizePageId(INVALID_PAGE_ID);
+  header_page->SetSize(num_blocks * BLOCK_ARRAY_SIZE);
+  for (size_t i = 0; i < num_blocks; i++) {
+    page_id_t block_page_id;
+    Page *block_page = buffer_pool_manager_->NewPage(&block_page_id);
+    BUSTUB_ASSERT(block_page != nullptr, "no frame for a new block page");
+    header_page->AddBlockPageId(block_page_id);
+    buffer_pool_manager_->UnpinPage(block_page_id, true);
+  }
+  buffer_pool_manager_->UnpinPage(header_page_id, true);
+  return header_page_id;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::DeleteBlockPages(Page *old_header_page) {
+  auto *header_page = reinterpret_cast<HashTableHeaderPage *>(old_header_page->GetData());
+  for (size_t i = 0; i < header_page->NumBlocks(); i++) {
+    buffer_pool_manager_->DeletePage(header_page->GetBlockPageId(i));
+  }
+  page_id_t header_page_id = old_header_page->GetPageId();
+  buffer_pool_manager_->UnpinPage(header_page_id, false);
+  buffer_pool_manager_->DeletePage(header_page_id);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::BeginResize(HashTableHeaderPage *header_page, size_t num_blocks) -> bool {
+  if (header_page->GetNumReadable() >= MaxLoad(num_blocks * BLOCK_ARRAY_SIZE)) {
+    return false;
+  }
+  header_page->SetResizePageId(CreateNewBlockPages(num_blocks));
+  header_page->SetMigrated(0);
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::MigrateSlots(size_t count) {
+  auto [page, header_page] = GetHeaderPage(header_page_id_);
+  page_id_t resize_page_id = header_page->GetResizePageId();
+  if (resize_page_id == INVALID_PAGE_ID) {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    return;
+  }
+  auto [new_page, new_header_page] = GetHeaderPage(resize_page_id);
+
+  // Each pair moves to the new table and leaves a tombstone behind, so that the probe sequences through its slot still
+  // reach the pairs after it. No pair of the old table is in the new one, so none is a duplicate.
+  const size_t size = header_page->GetSize();
+  const size_t begin = header_page->GetMigrated();
+  const size_t end = begin + std::min(count, size - begin);
+  Page *block_page = nullptr;
+  for (size_t slot = begin; slot < end; slot++) {
+    if (block_page == nullptr || slot % BLOCK_ARRAY_SIZE == 0) {
+      if (block_page != nullptr) {
+        buffer_pool_manager_->UnpinPage(block_page->GetPageId(), true);
+      }
+      block_page = buffer_pool_manager_->FetchPage(header_page->GetBlockPageId(slot / BLOCK_ARRAY_SIZE));
+      BUSTUB_ASSERT(block_page != nullptr, "no frame for a block page");
+    }
+    auto *block = reinterpret_cast<HASH_TABLE_BLOCK_TYPE *>(block_page->GetData());
+    slot_offset_t offset = slot % BLOCK_ARRAY_SIZE;
+    if (block->IsReadable(offset)) {
+      new_header_page->AddNumOccupied(1);
+      InsertInto(new_header_page, block->KeyAt(offset), block->ValueAt(offset));
+      block->Remove(offset);
+      header_page->AddNumReadable(-1);
+    }
+  }
+  if (block_page != nullptr) {
+    buffer_pool_manager_->UnpinPage(block_page->GetPageId(), true);
+  }
+  header_page->SetMigrated(end);
+  buffer_pool_manager_->UnpinPage(new_page->GetPageId(), true);
+
+  if (end < size) {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+    return;
+  }
+  header_page_id_ = resize_page_id;
+  DeleteBlockPages(page);
+}
 
 /*****************************************************************************
  * GETSIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetSize() -> size_t {
-  return 0;
+  table_latch_.RLock();
+  auto [page, header_page] = GetHeaderPage(header_page_id_);
+  size_t size = header_page->GetSize();
+  if (page_id_t resize_page_id = header_page->GetResizePageId(); resize_page_id != INVALID_PAGE_ID) {
+    auto [new_page, new_header_page] = GetHeaderPage(resize_page_id);
+    size = new_header_page->GetSize();
+    buffer_pool_manager_->UnpinPage(new_page->GetPageId(), false);
+  }
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  table_latch_.RUnlock();
+  return size;
 }
 
 template class LinearProbeHashTable<int, int, IntComparator>;
@@ -23,7 +23,9 @@ namespace bustub {
 
 template <typename K, typename V>
 ExtendibleHashTable<K, V>::ExtendibleHashTable(size_t bucket_size)
-    : global_depth_(0), bucket_size_(bucket_size), num_buckets_(1) {}
+    : global_depth_(0), bucket_size_(bucket_size), num_buckets_(1) {
+  dir_.push_back(std::make_shared<Bucket>(bucket_size_, 0));
+}
 
 template <typename K, typename V>
 auto ExtendibleHashTable<K, V>::IndexOf(const K &key) -> size_t {
@@ -66,38 +68,93 @@ auto ExtendibleHashTable<K, V>::GetNumBucketsInternal() const -> int {
 
 template <typename K, typename V>
 auto ExtendibleHashTable<K, V>::Find(const K &key, V &value) -> bool {
-  UNREACHABLE("not implemented");
+  std::scoped_lock<std::mutex> lock(latch_);
+  return dir_[IndexOf(key)]->Find(key, value);
 }
 
 template <typename K, typename V>
 auto ExtendibleHashTable<K, V>::Remove(const K &key) -> bool {
-  UNREACHABLE("not implemented");
+  std::scoped_lock<std::mutex> lock(latch_);
+  return dir_[IndexOf(key)]->Remove(key);
 }
 
 template <typename K, typename V>
 void ExtendibleHashTable<K, V>::Insert(const K &key, const V &value) {
-  UNREACHABLE("not implemented");
+  std::scoped_lock<std::mutex> lock(latch_);
+  while (true) {
+    auto bucket = dir_[IndexOf(key)];
+    if (bucket->Insert(key, value)) {
+      return;
+    }
+    // The bucket is full. Grow the directory if needed, then split the bucket and retry.
+    if (bucket->GetDepth() == global_depth_) {
+      size_t old_size = dir_.size();
+      dir_.reserve(old_size * 2);
+      for (size_t i = 0; i < old_size; i++) {
+        dir_.push_back(dir_[i]);
+      }
+      global_depth_++;
+    }
+    RedistributeBucket(bucket);
+  }
+}
+
+template <typename K, typename V>
+auto ExtendibleHashTable<K, V>::RedistributeBucket(std::shared_ptr<Bucket> bucket) -> void {
+  int local_depth = bucket->GetDepth();
+  size_t high_bit = static_cast<size_t>(1) << local_depth;
+  auto zero_bucket = std::make_shared<Bucket>(bucket_size_, local_depth + 1);
+  auto one_bucket = std::make_shared<Bucket>(bucket_size_, local_depth + 1);
+  for (const auto &[k, v] : bucket->GetItems()) {
+    auto target = (std::hash<K>()(k) & high_bit) != 0 ? one_bucket : zero_bucket;
+    target->GetItems().emplace_back(k, v);
+  }
+  for (size_t i = 0; i < dir_.size(); i++) {
+    if (dir_[i] == bucket) {
+      dir_[i] = (i & high_bit) != 0 ? one_bucket : zero_bucket;
+    }
+  }
+  num_buckets_++;
 }
 
-//===--------------------------------------------------------------------===//
-// Bucket
-//===--------------------------------------------------------------------===//
 template <typename K, typename V>
 ExtendibleHashTable<K, V>::Bucket::Bucket(size_t array_size, int depth) : size_(array_size), depth_(depth) {}
 
 template <typename K, typename V>
 auto ExtendibleHashTable<K, V>::Bucket::Find(const K &key, V &value) -> bool {
-  UNREACHABLE("not implemented");
+  for (const auto &[k, v] : list_) {
+    if (k == key) {
+      value = v;
+      return true;
+    }
+  }
+  return false;
 }
 
 template <typename K, typename V>
 auto ExtendibleHashTable<K, V>::Bucket::Remove(const K &key) -> bool {
-  UNREACHABLE("not implemented");
+  for (auto it = list_.begin(); it != list_.end(); ++it) {
+    if (it->first == key) {
+      list_.erase(it);
+      return true;
+    }
+  }
+  return false;
 }
 
 template <typename K, typename V>
 auto ExtendibleHashTable<K, V>::Bucket::Insert(const K &key, const V &value) -> bool {
-  UNREACHABLE("not implemented");
+  for (auto &[k, v] : list_) {
+    if (k == key) {
+      v = value;
+      return true;
+    }
+  }
+  if (IsFull()) {
+    return false;
+  }
+  list_.emplace_back(key, value);
+  return true;
 }
 
 template class ExtendibleHashTable<page_id_t, Page *>;
@@ -0,0 +1,142 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// robin_hood_hash_table.cpp
+//
+// Identification: src/container/hash/robin_hood_hash_table.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <utility>
+#include <vector>
+
+#include "common/util/hash_util.h"
+#include "container/hash/robin_hood_hash_table.h"
+
+namespace bustub {
+
+namespace {
+
+constexpr size_t INITIAL_SLOTS = 64;
+
+}  // namespace
+
+RobinHoodHashTable::RobinHoodHashTable(size_t key_width, size_t payload_width)
+    : key_width_(key_width), payload_width_(payload_width), slots_(INITIAL_SLOTS), mask_(INITIAL_SLOTS - 1) {}
+
+auto RobinHoodHashTable::Hash(const std::vector<Value> &key) const -> uint32_t {
+  hash_t hash = 0;
+  for (const auto &value : key) {
+    if (!value.IsNull()) {
+      hash = HashUtil::CombineHashes(hash, HashUtil::HashValue(&value));
+    }
+  }
+  return static_cast<uint32_t>(HashUtil::MixHash(hash));
+}
+
+auto RobinHoodHashTable::KeyEquals(size_t entry, const std::vector<Value> &key) const -> bool {
+  const Value *entry_key = KeyAt(entry);
+  for (size_t i = 0; i < key_width_; i++) {
+    if (entry_key[i].IsNull() || key[i].IsNull()) {
+      if (entry_key[i].IsNull() != key[i].IsNull()) {
+        return false;
+      }
+    } else if (entry_key[i].CompareEquals(key[i]) != CmpBool::CmpTrue) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto RobinHoodHashTable::FindEntry(const std::vector<Value> &key, uint32_t hash) const -> size_t {
+  for (size_t pos = hash & mask_, dist = 0;; pos = (pos + 1) & mask_, dist++) {
+    const Slot &slot = slots_[pos];
+    // An entry of the key would have taken the slot of any entry closer to its home than it is.
+    if (slot.entry_ == 0 || ((pos - slot.hash_) & mask_) < dist) {
+      return NO_ENTRY;
+    }
+    if (slot.hash_ == hash && KeyEquals(slot.entry_ - 1, key)) {
+      return slot.entry_ - 1;
+    }
+  }
+}
+
+auto RobinHoodHashTable::AppendEntry(const std::vector<Value> &key) -> size_t {
+  size_t entry = next_.size();
+  keys_.insert(keys_.end(), key.begin(), key.end());
+  payloads_.resize(payloads_.size() + payload_width_);
+  next_.push_back(NO_ENTRY);
+  last_.push_back(entry);
+  return entry;
+}
+
+void RobinHoodHashTable::PlaceEntry(uint32_t hash, size_t entry) {
+  if ((used_ + 1) * 8 > slots_.size() * 7) {
+    Grow();
+  }
+  used_++;
+  Slot slot{hash, static_cast<uint32_t>(entry + 1)};
+  for (size_t pos = hash & mask_, dist = 0;; pos = (pos + 1) & mask_, dist++) {
+    Slot &resident = slots_[pos];
+    if (resident.entry_ == 0) {
+      resident = slot;
+      return;
+    }
+    // Take the slot from an entry that is closer to its home, and go on placing that one.
+    size_t resident_dist = (pos - resident.hash_) & mask_;
+    if (resident_dist < dist) {
+      std::swap(resident, slot);
+      dist = resident_dist;
+    }
+  }
+}
+
+void RobinHoodHashTable::Grow() {
+  std::vector<Slot> old_slots(slots_.size() * 2);
+  old_slots.swap(slots_);
+  mask_ = slots_.size() - 1;
+  used_ = 0;
+  for (const auto &slot : old_slots) {
+    if (slot.entry_ != 0) {
+      PlaceEntry(slot.hash_, slot.entry_ - 1);
+    }
+  }
+}
+
+auto RobinHoodHashTable::FindOrInsert(const std::vector<Value> &key) -> std::pair<size_t, bool> {
+  uint32_t hash = Hash(key);
+  if (size_t entry = FindEntry(key, hash); entry != NO_ENTRY) {
+    return {entry, false};
+  }
+  size_t entry = AppendEntry(key);
+  PlaceEntry(hash, entry);
+  return {entry, true};
+}
+
+auto RobinHoodHashTable::Insert(const std::vector<Value> &key) -> size_t {
+  uint32_t hash = Hash(key);
+  size_t first = FindEntry(key, hash);
+  size_t entry = AppendEntry(key);
+  if (first == NO_ENTRY) {
+    PlaceEntry(hash, entry);
+  } else {
+    next_[last_[first]] = entry;
+    last_[first] = entry;
+  }
+  return entry;
+}
+
+auto RobinHoodHashTable::Find(const std::vector<Value> &key) const -> size_t { return FindEntry(key, Hash(key)); }
+
+void RobinHoodHashTable::Clear() {
+  slots_.assign(INITIAL_SLOTS, Slot{0, 0});
+  mask_ = INITIAL_SLOTS - 1;
+  used_ = 0;
+  keys_.clear();
+  payloads_.clear();
+  next_.clear();
+  last_.clear();
+}
+
+}  // namespace bustub
@@ -1,29 +1,151 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// aggregation_executor.cpp
-//
-// Identification: src/execution/aggregation_executor.cpp
-//
-// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-#include <memory>
-#include <vector>
-
-#include "execution/executors/aggregation_executor.h"
-
-namespace bustub {
-
-AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
-                                         std::unique_ptr<AbstractExecutor> &&child)
-    : AbstractExecutor(exec_ctx) {}
-
-void AggregationExecutor::Init() {}
-
-auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
-
-auto AggregationExecutor::GetChildExecutor() const -> const AbstractExecutor * { return child_.get(); }
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_executor.cpp
+//
+// Identification: src/execution/aggregation_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executors/aggregation_executor.h"
+
+namespace bustub {
+
+AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
+                                         std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_(std::move(child)),
+      aht_(plan->GetAggregates(), plan->GetAggregateTypes(), plan->GetGroupBys().size()),
+      aht_iterator_(aht_.End()),
+      partitions_(exec_ctx->GetBufferPoolManager(), 1) {}
+
+void AggregationExecutor::Init() {
+  child_->Init();
+  aht_.Clear();
+  partitions_.Clear();
+
+  size_t budget = exec_ctx_->GetMemoryBudget() * BUSTUB_PAGE_SIZE;
+  size_t size = 0;
+  std::vector<SpillPartitions::Partition> parts;
+  Tuple child_tuple;
+  RID child_rid;
+  AggregateKey key;
+  AggregateValue val;
+  while (child_->Next(&child_tuple, &child_rid)) {
+    MakeAggregateKey(&child_tuple, &key);
+    MakeAggregateValue(&child_tuple, &val);
+    if (aht_.InsertCombine(key, val)) {
+      size += GroupSize(key);
+    }
+    if (size > budget && partitions_.CanSpill()) {
+      SpillTable(&parts, 0);
+      size = 0;
+    }
+  }
+  if (!parts.empty()) {
+    SpillTable(&parts, 0);
+    AddPending(&parts);
+  }
+  aht_iterator_ = aht_.Begin();
+  // Without groups, an aggregation over no tuples still produces one row of initial aggregates.
+  empty_result_pending_ = aht_.Size() == 0 && plan_->GetGroupBys().empty();
+}
+
+auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  std::vector<Value> values;
+  if (empty_result_pending_) {
+    empty_result_pending_ = false;
+    values = aht_.GenerateInitialAggregateValue().aggregates_;
+  } else {
+    while (aht_iterator_ == aht_.End()) {
+      if (!LoadNextPartition()) {
+        return false;
+      }
+    }
+    values = std::move(aht_iterator_.Key().group_bys_);
+    auto val = aht_iterator_.Val();
+    values.insert(values.end(), val.aggregates_.begin(), val.aggregates_.end());
+    ++aht_iterator_;
+  }
+  *tuple = Tuple(values, &GetOutputSchema());
+  return true;
+}
+
+auto AggregationExecutor::LoadNextPartition() -> bool {
+  size_t budget = exec_ctx_->GetMemoryBudget() * BUSTUB_PAGE_SIZE;
+  size_t num_group_bys = plan_->GetGroupBys().size();
+  const Schema &schema = GetOutputSchema();
+  SpillPartitions::Partition part;
+  while (partitions_.PopPending(&part)) {
+    aht_.Clear();
+    size_t size = 0;
+    std::vector<SpillPartitions::Partition> parts;
+    AggregateKey key;
+    AggregateValue partial;
+    TmpTupleFile::Reader reader(part.files_[0].get());
+    Tuple tuple;
+    while (reader.Next(&tuple)) {
+      key.group_bys_.clear();
+      partial.aggregates_.clear();
+      for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+        (i < num_group_bys ? key.group_bys_ : partial.aggregates_).emplace_back(tuple.GetValue(&schema, i));
+      }
+      if (aht_.InsertMerge(key, partial)) {
+        size += GroupSize(key);
+      }
+      if (size > budget && part.depth_ < SpillPartitions::MAX_DEPTH) {
+        SpillTable(&parts, part.depth_ + 1);
+        size = 0;
+      }
+    }
+    if (!parts.empty()) {
+      SpillTable(&parts, part.depth_ + 1);
+      AddPending(&parts);
+      continue;
+    }
+    aht_iterator_ = aht_.Begin();
+    return true;
+  }
+  aht_.Clear();
+  aht_iterator_ = aht_.End();
+  return false;
+}
+
+auto AggregationExecutor::GroupSize(const AggregateKey &key) const -> size_t {
+  size_t size = sizeof(uint32_t) + plan_->GetAggregates().size() * sizeof(int64_t);
+  for (const auto &value : key.group_bys_) {
+    size += value.GetTypeId() == TypeId::VARCHAR ? sizeof(uint32_t) + value.GetLength()
+                                                  : Type::GetTypeSize(value.GetTypeId());
+  }
+  return size;
+}
+
+void AggregationExecutor::SpillTable(std::vector<SpillPartitions::Partition> *parts, size_t depth) {
+  if (parts->empty()) {
+    *parts = partitions_.MakePartitions(depth);
+  }
+  for (auto it = aht_.Begin(); it != aht_.End(); ++it) {
+    auto key = it.Key();
+    std::vector<Value> values = key.group_bys_;
+    auto val = it.Val();
+    values.insert(values.end(), val.aggregates_.begin(), val.aggregates_.end());
+    (*parts)[partitions_.PartitionOf(std::hash<AggregateKey>{}(key), depth)].files_[0]->Append(
+        Tuple(values, &GetOutputSchema()));
+  }
+  aht_.Clear();
+}
+
+void AggregationExecutor::AddPending(std::vector<SpillPartitions::Partition> *parts) {
+  partitions_.AddPending(parts, [](const SpillPartitions::Partition &part) { return part.files_[0]->Size() > 0; });
+}
+
+auto AggregationExecutor::GetChildExecutor() const -> const AbstractExecutor * { return child_.get(); }
+
+}  // namespace bustub
@@ -12,23 +12,200 @@
 
 #include "execution/executors/hash_join_executor.h"
 
-// Note for 2022 Fall: You don't need to implement HashJoinExecutor to pass all tests. You ONLY need to implement it
-// if you want to get faster in leaderboard tests.
+#include "common/util/hash_util.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 
 HashJoinExecutor::HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlanNode *plan,
                                    std::unique_ptr<AbstractExecutor> &&left_child,
                                    std::unique_ptr<AbstractExecutor> &&right_child)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_child_(std::move(left_child)),
+      right_child_(std::move(right_child)),
+      ht_(1, plan->GetRightPlan()->OutputSchema().GetColumnCount()),
+      partitions_(exec_ctx->GetBufferPoolManager(), 2) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2022 Fall: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void HashJoinExecutor::Init() { throw NotImplementedException("HashJoinExecutor is not implemented"); }
+void HashJoinExecutor::Init() {
+  left_child_->Init();
+  right_child_->Init();
+  ht_.Clear();
+  entry_ = RobinHoodHashTable::NO_ENTRY;
+  left_reader_.reset();
+  current_ = SpillPartitions::Partition{};
+  partitions_.Clear();
+  spilled_ = false;
 
-auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+  size_t budget = exec_ctx_->GetMemoryBudget() * BUSTUB_PAGE_SIZE;
+  size_t size = 0;
+  std::vector<SpillPartitions::Partition> parts;
+  const Schema &right_schema = right_child_->GetOutputSchema();
+  Tuple right_tuple;
+  RID right_rid;
+  while (right_child_->Next(&right_tuple, &right_rid)) {
+    if (spilled_) {
+      PartitionTuple(&parts, right_tuple, false, 0);
+      continue;
+    }
+    key_.assign(1, plan_->RightJoinKeyExpression().Evaluate(&right_tuple, right_schema));
+    if (key_[0].IsNull()) {
+      continue;
+    }
+    size_t entry = ht_.Insert(key_);
+    Value *payload = ht_.PayloadAt(entry);
+    for (uint32_t i = 0; i < right_schema.GetColumnCount(); i++) {
+      payload[i] = right_tuple.GetValue(&right_schema, i);
+    }
+    // The tuples take about as much memory as in the pages they would spill to.
+    size += sizeof(uint32_t) + right_tuple.GetLength();
+    if (size > budget && partitions_.CanSpill()) {
+      spilled_ = true;
+      parts = partitions_.MakePartitions(0);
+      SpillTable(&parts, 0);
+    }
+  }
+  if (!spilled_) {
+    return;
+  }
+
+  Tuple left_tuple;
+  RID left_rid;
+  while (left_child_->Next(&left_tuple, &left_rid)) {
+    PartitionTuple(&parts, left_tuple, true, 0);
+  }
+  AddPending(&parts);
+}
+
+auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (true) {
+    if (entry_ != RobinHoodHashTable::NO_ENTRY) {
+      *tuple = JoinTuple(entry_);
+      entry_ = ht_.NextDuplicate(entry_);
+      return true;
+    }
+
+    if (!NextLeftTuple()) {
+      return false;
+    }
+    key_.assign(1, plan_->LeftJoinKeyExpression().Evaluate(&left_tuple_, left_child_->GetOutputSchema()));
+    entry_ = key_[0].IsNull() ? RobinHoodHashTable::NO_ENTRY : ht_.Find(key_);
+    if (entry_ == RobinHoodHashTable::NO_ENTRY && plan_->GetJoinType() == JoinType::LEFT) {
+      *tuple = JoinTuple(RobinHoodHashTable::NO_ENTRY);
+      return true;
+    }
+  }
+}
+
+auto HashJoinExecutor::NextLeftTuple() -> bool {
+  if (!spilled_) {
+    RID left_rid;
+    return left_child_->Next(&left_tuple_, &left_rid);
+  }
+  while (left_reader_ == nullptr || !left_reader_->Next(&left_tuple_)) {
+    if (!LoadNextPartition()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto HashJoinExecutor::LoadNextPartition() -> bool {
+  // The reader goes first, since the pages of the partitions cannot be deleted while it pins one.
+  left_reader_.reset();
+  current_ = SpillPartitions::Partition{};
+  const Schema &right_schema = right_child_->GetOutputSchema();
+  while (partitions_.PopPending(&current_)) {
+    if (current_.files_[RIGHT_FILE]->PageCount() > exec_ctx_->GetMemoryBudget() &&
+        current_.depth_ < SpillPartitions::MAX_DEPTH) {
+      Repartition(&current_);
+      current_ = SpillPartitions::Partition{};
+      continue;
+    }
+
+    ht_.Clear();
+    TmpTupleFile::Reader reader(current_.files_[RIGHT_FILE].get());
+    Tuple right_tuple;
+    while (reader.Next(&right_tuple)) {
+      key_.assign(1, plan_->RightJoinKeyExpression().Evaluate(&right_tuple, right_schema));
+      Value *payload = ht_.PayloadAt(ht_.Insert(key_));
+      for (uint32_t i = 0; i < right_schema.GetColumnCount(); i++) {
+        payload[i] = right_tuple.GetValue(&right_schema, i);
+      }
+    }
+    left_reader_ = std::make_unique<TmpTupleFile::Reader>(current_.files_[LEFT_FILE].get());
+    return true;
+  }
+  return false;
+}
+
+void HashJoinExecutor::PartitionTuple(std::vector<SpillPartitions::Partition> *parts, const Tuple &tuple, bool left,
+                                      size_t depth) {
+  Value key = left ? plan_->LeftJoinKeyExpression().Evaluate(&tuple, left_child_->GetOutputSchema())
+                   : plan_->RightJoinKeyExpression().Evaluate(&tuple, right_child_->GetOutputSchema());
+  if (key.IsNull()) {
+    // A left tuple with a NULL key still makes a tuple of a LEFT join, from whichever partition it is in.
+    if (left && plan_->GetJoinType() == JoinType::LEFT) {
+      (*parts)[0].files_[LEFT_FILE]->Append(tuple);
+    }
+    return;
+  }
+  auto &part = (*parts)[partitions_.PartitionOf(HashUtil::HashValue(&key), depth)];
+  part.files_[left ? LEFT_FILE : RIGHT_FILE]->Append(tuple);
+}
+
+void HashJoinExecutor::SpillTable(std::vector<SpillPartitions::Partition> *parts, size_t depth) {
+  const Schema &right_schema = right_child_->GetOutputSchema();
+  size_t width = right_schema.GetColumnCount();
+  for (size_t entry = 0; entry < ht_.Size(); entry++) {
+    const Value *payload = ht_.PayloadAt(entry);
+    Tuple right_tuple{std::vector<Value>(payload, payload + width), &right_schema};
+    (*parts)[partitions_.PartitionOf(HashUtil::HashValue(&ht_.KeyAt(entry)[0]), depth)].files_[RIGHT_FILE]->Append(
+        right_tuple);
+  }
+  ht_.Clear();
+}
+
+void HashJoinExecutor::Repartition(SpillPartitions::Partition *part) {
+  auto parts = partitions_.MakePartitions(part->depth_ + 1);
+  Tuple tuple;
+  TmpTupleFile::Reader right_reader(part->files_[RIGHT_FILE].get());
+  while (right_reader.Next(&tuple)) {
+    PartitionTuple(&parts, tuple, false, part->depth_ + 1);
+  }
+  TmpTupleFile::Reader left_reader(part->files_[LEFT_FILE].get());
+  while (left_reader.Next(&tuple)) {
+    PartitionTuple(&parts, tuple, true, part->depth_ + 1);
+  }
+  AddPending(&parts);
+}
+
+void HashJoinExecutor::AddPending(std::vector<SpillPartitions::Partition> *parts) {
+  partitions_.AddPending(parts, [this](const SpillPartitions::Partition &part) {
+    return part.files_[LEFT_FILE]->Size() > 0 &&
+           (part.files_[RIGHT_FILE]->Size() > 0 || plan_->GetJoinType() == JoinType::LEFT);
+  });
+}
+
+auto HashJoinExecutor::JoinTuple(size_t entry) -> Tuple {
+  const Schema &left_schema = left_child_->GetOutputSchema();
+  const Schema &right_schema = right_child_->GetOutputSchema();
+  std::vector<Value> values;
+  values.reserve(GetOutputSchema().GetColumnCount());
+  for (uint32_t i = 0; i < left_schema.GetColumnCount(); i++) {
+    values.push_back(left_tuple_.GetValue(&left_schema, i));
+  }
+  const Value *right_values = entry != RobinHoodHashTable::NO_ENTRY ? ht_.PayloadAt(entry) : nullptr;
+  for (uint32_t i = 0; i < right_schema.GetColumnCount(); i++) {
+    values.push_back(right_values != nullptr ? right_values[i]
+                                             : ValueFactory::GetNullValueByType(right_schema.GetColumn(i).GetType()));
+  }
+  return Tuple{values, &GetOutputSchema()};
+}
 
 }  // namespace bustub
@@ -11,12 +11,101 @@
 //===----------------------------------------------------------------------===//
 #include "execution/executors/index_scan_executor.h"
 
+#include <algorithm>
+
+#include "type/limits.h"
+#include "type/value_factory.h"
+
 namespace bustub {
 IndexScanExecutor::IndexScanExecutor(ExecutorContext *exec_ctx, const IndexScanPlanNode *plan)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+void IndexScanExecutor::Init() {
+  auto *catalog = exec_ctx_->GetCatalog();
+  index_info_ = catalog->GetIndex(plan_->GetIndexOid());
+  table_info_ = catalog->GetTable(index_info_->table_name_);
+  iter_ = nullptr;
+  rids_.clear();
+  cursor_ = 0;
+
+  if (plan_->KeyPredicate() != nullptr) {
+    // a NULL key equals no key
+    Value key = plan_->KeyPredicate()->Evaluate(nullptr, GetOutputSchema());
+    if (!key.IsNull()) {
+      Tuple key_tuple{std::vector<Value>{key}, &index_info_->key_schema_};
+      index_info_->index_->ScanKey(key_tuple, &rids_, exec_ctx_->GetTransaction());
+    }
+    return;
+  }
+  if (index_info_->key_schema_.GetColumnCount() != 1 ||
+      index_info_->key_schema_.GetColumn(0).GetType() != TypeId::INTEGER) {
+    throw NotImplementedException("index range scan only supports indexes on one integer column");
+  }
+  const auto &low = plan_->GetLow();
+  const auto &high = plan_->GetHigh();
+  auto direction = plan_->IsReverse() ? ScanDirection::BACKWARD : ScanDirection::FORWARD;
+  if (low.key_ == nullptr && high.key_ == nullptr) {
+    iter_ = index_info_->index_->ScanRange(nullptr, nullptr, direction);
+    return;
+  }
 
-void IndexScanExecutor::Init() { throw NotImplementedException("IndexScanExecutor is not implemented"); }
+  // Turn the ends of the range into the half-open range of integer keys [low_key, high_key), which starts past the
+  // NULL key, the lowest of all. A NULL end compares true with no key.
+  int64_t low_key = BUSTUB_INT32_MIN;
+  int64_t high_key = static_cast<int64_t>(BUSTUB_INT32_MAX) + 1;
+  if (low.key_ != nullptr) {
+    Value value = low.key_->Evaluate(nullptr, GetOutputSchema());
+    if (value.IsNull()) {
+      return;
+    }
+    low_key = std::max<int64_t>(low_key, static_cast<int64_t>(value.GetAs<int32_t>()) + (low.inclusive_ ? 0 : 1));
+  }
+  if (high.key_ != nullptr) {
+    Value value = high.key_->Evaluate(nullptr, GetOutputSchema());
+    if (value.IsNull()) {
+      return;
+    }
+    high_key = static_cast<int64_t>(value.GetAs<int32_t>()) + (high.inclusive_ ? 1 : 0);
+  }
+  if (low_key >= high_key) {
+    return;
+  }
+  auto to_key = [this](int64_t key) {
+    return Tuple{std::vector<Value>{ValueFactory::GetIntegerValue(static_cast<int32_t>(key))},
+                 &index_info_->key_schema_};
+  };
+  Tuple low_key_tuple = to_key(low_key);
+  Tuple high_key_tuple;
+  bool high_open = high_key > BUSTUB_INT32_MAX;
+  if (!high_open) {
+    high_key_tuple = to_key(high_key);
+  }
+  iter_ = index_info_->index_->ScanRange(&low_key_tuple, high_open ? nullptr : &high_key_tuple, direction);
+}
 
-auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (true) {
+    if (iter_ != nullptr) {
+      if (iter_->IsEnd()) {
+        return false;
+      }
+      *rid = iter_->GetRID();
+      if (plan_->IsIndexOnly()) {
+        *tuple = iter_->GetEntry();
+        iter_->Next();
+        return true;
+      }
+      iter_->Next();
+    } else {
+      if (cursor_ == rids_.size()) {
+        return false;
+      }
+      *rid = rids_[cursor_++];
+    }
+    if (table_info_->table_->GetTuple(*rid, tuple, exec_ctx_->GetTransaction())) {
+      return true;
+    }
+  }
+}
 
 }  // namespace bustub
@@ -1,27 +1,61 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// insert_executor.cpp
-//
-// Identification: src/execution/insert_executor.cpp
-//
-// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-
-#include <memory>
-
-#include "execution/executors/insert_executor.h"
-
-namespace bustub {
-
-InsertExecutor::InsertExecutor(ExecutorContext *exec_ctx, const InsertPlanNode *plan,
-                               std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
-
-void InsertExecutor::Init() { throw NotImplementedException("InsertExecutor is not implemented"); }
-
-auto InsertExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool { return false; }
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// insert_executor.cpp
+//
+// Identification: src/execution/insert_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "execution/executors/insert_executor.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+InsertExecutor::InsertExecutor(ExecutorContext *exec_ctx, const InsertPlanNode *plan,
+                               std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void InsertExecutor::Init() {
+  child_executor_->Init();
+  ring_ = exec_ctx_->MakeBufferRing();
+  done_ = false;
+}
+
+auto InsertExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
+  if (done_) {
+    return false;
+  }
+  auto *catalog = exec_ctx_->GetCatalog();
+  auto *txn = exec_ctx_->GetTransaction();
+  auto *table_info = catalog->GetTable(plan_->TableOid());
+  auto indexes = catalog->GetTableIndexes(table_info->name_);
+
+  int32_t num_inserted = 0;
+  Tuple child_tuple;
+  RID child_rid;
+  while (child_executor_->Next(&child_tuple, &child_rid)) {
+    RID inserted_rid;
+    if (!table_info->table_->InsertTuple(child_tuple, &inserted_rid, txn, ring_.get())) {
+      continue;
+    }
+    for (auto *index_info : indexes) {
+      auto key = child_tuple.KeyFromTuple(table_info->schema_, *index_info->index_->GetEntrySchema(),
+                                          index_info->index_->GetEntryAttrs());
+      index_info->index_->InsertEntry(key, inserted_rid, txn);
+    }
+    num_inserted++;
+  }
+
+  *tuple = Tuple{std::vector<Value>{ValueFactory::GetIntegerValue(num_inserted)}, &GetOutputSchema()};
+  done_ = true;
+  return true;
+}
+
+}  // namespace bustub
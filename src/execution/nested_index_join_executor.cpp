@@ -11,20 +11,71 @@
 //===----------------------------------------------------------------------===//
 
 #include "execution/executors/nested_index_join_executor.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 
 NestIndexJoinExecutor::NestIndexJoinExecutor(ExecutorContext *exec_ctx, const NestedIndexJoinPlanNode *plan,
                                              std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2022 Fall: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void NestIndexJoinExecutor::Init() { throw NotImplementedException("NestIndexJoinExecutor is not implemented"); }
+void NestIndexJoinExecutor::Init() {
+  child_executor_->Init();
+  auto *catalog = exec_ctx_->GetCatalog();
+  index_info_ = catalog->GetIndex(plan_->GetIndexOid());
+  inner_table_info_ = catalog->GetTable(plan_->GetInnerTableOid());
+  inner_rids_.clear();
+  cursor_ = 0;
+}
+
+auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  auto *txn = exec_ctx_->GetTransaction();
+  while (true) {
+    while (cursor_ < inner_rids_.size()) {
+      Tuple inner_tuple;
+      if (inner_table_info_->table_->GetTuple(inner_rids_[cursor_++], &inner_tuple, txn)) {
+        *tuple = JoinTuple(&inner_tuple);
+        return true;
+      }
+    }
+
+    RID outer_rid;
+    if (!child_executor_->Next(&outer_tuple_, &outer_rid)) {
+      return false;
+    }
+    inner_rids_.clear();
+    cursor_ = 0;
+    // the index may map the key to many inner tuples; a NULL key matches none
+    Value key = plan_->KeyPredicate()->Evaluate(&outer_tuple_, child_executor_->GetOutputSchema());
+    if (!key.IsNull()) {
+      Tuple key_tuple{std::vector<Value>{key}, &index_info_->key_schema_};
+      index_info_->index_->ScanKey(key_tuple, &inner_rids_, txn);
+    }
+    if (inner_rids_.empty() && plan_->GetJoinType() == JoinType::LEFT) {
+      *tuple = JoinTuple(nullptr);
+      return true;
+    }
+  }
+}
 
-auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto NestIndexJoinExecutor::JoinTuple(const Tuple *inner) const -> Tuple {
+  const Schema &outer_schema = child_executor_->GetOutputSchema();
+  const Schema &inner_schema = plan_->InnerTableSchema();
+  std::vector<Value> values;
+  values.reserve(GetOutputSchema().GetColumnCount());
+  for (uint32_t i = 0; i < outer_schema.GetColumnCount(); i++) {
+    values.push_back(outer_tuple_.GetValue(&outer_schema, i));
+  }
+  for (uint32_t i = 0; i < inner_schema.GetColumnCount(); i++) {
+    values.push_back(inner != nullptr ? inner->GetValue(&inner_schema, i)
+                                      : ValueFactory::GetNullValueByType(inner_schema.GetColumn(i).GetType()));
+  }
+  return Tuple{values, &GetOutputSchema()};
+}
 
 }  // namespace bustub
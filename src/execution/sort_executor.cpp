@@ -1,13 +1,285 @@
 #include "execution/executors/sort_executor.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <thread>
+
 namespace bustub {
 
+namespace {
+
+/** Run task(0) to task(num_tasks - 1) on num_workers threads, the calling thread being one of them. */
+template <class Task>
+void RunWorkers(size_t num_tasks, size_t num_workers, const Task &task) {
+  std::atomic<size_t> next_task{0};
+  auto work = [&]() {
+    for (size_t i = next_task++; i < num_tasks; i = next_task++) {
+      task(i);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < num_workers; i++) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+}  // namespace
+
 SortExecutor::SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void SortExecutor::Init() {
+  child_executor_->Init();
+  // The readers go before the runs, since the pages of the runs cannot be deleted while they pin one.
+  tree_.reset();
+  cursors_.clear();
+  runs_.clear();
+  tuples_.clear();
+  entries_.clear();
+  cursor_ = 0;
+
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  size_t budget = exec_ctx_->GetMemoryBudget() * BUSTUB_PAGE_SIZE;
+  size_t size = 0;
+  SortKeyNormalizer normalizer(plan_->GetOrderBy(), child_executor_->GetOutputSchema());
+  Tuple tuple;
+  RID rid;
+  while (child_executor_->Next(&tuple, &rid)) {
+    Entry entry{std::string(), tuples_.size()};
+    normalizer.Normalize(tuple, &entry.key_);
+    // The tuples take about as much memory as in the runs they would spill to.
+    size += 3 * sizeof(uint32_t) + entry.key_.size() + tuple.GetLength();
+    entries_.push_back(std::move(entry));
+    tuples_.push_back(tuple);
+    if (size > budget && bpm != nullptr) {
+      WriteRun();
+      size = 0;
+    }
+  }
+  if (runs_.empty()) {
+    SortEntries();
+    return;
+  }
+  if (!entries_.empty()) {
+    WriteRun();
+  }
+
+  // Every run being merged takes a frame to be read with, and so does the run it is merged into.
+  size_t fan_in = std::clamp<size_t>(std::min(exec_ctx_->GetMemoryBudget(), bpm->GetPoolSize() / 2), 2,
+                                     MAX_MERGE_FAN_IN);
+  while (runs_.size() > fan_in) {
+    std::vector<std::unique_ptr<TmpTupleFile>> merged;
+    for (size_t begin = 0; begin < runs_.size(); begin += fan_in) {
+      size_t end = std::min(begin + fan_in, runs_.size());
+      if (end - begin == 1) {
+        merged.push_back(std::move(runs_[begin]));
+        continue;
+      }
+      std::vector<RunCursor> cursors;
+      std::optional<LoserTree<RunLess>> tree;
+      OpenRuns(begin, end, &cursors, &tree);
+      auto run = std::make_unique<TmpTupleFile>(bpm);
+      for (size_t winner = tree->Winner(); cursors[winner].valid_; winner = tree->Winner()) {
+        AppendRecord(run.get(), cursors[winner].key_, cursors[winner].tuple_);
+        Advance(&cursors[winner]);
+        tree->Replay();
+      }
+      run->FinishAppending();
+      merged.push_back(std::move(run));
+    }
+    runs_ = std::move(merged);
+  }
+  OpenRuns(0, runs_.size(), &cursors_, &tree_);
+}
+
+auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (tree_.has_value()) {
+    size_t winner = tree_->Winner();
+    if (!cursors_[winner].valid_) {
+      return false;
+    }
+    *tuple = cursors_[winner].tuple_;
+    *rid = tuple->GetRid();
+    Advance(&cursors_[winner]);
+    tree_->Replay();
+    return true;
+  }
+  if (cursor_ == entries_.size()) {
+    return false;
+  }
+  *tuple = tuples_[entries_[cursor_++].index_];
+  *rid = tuple->GetRid();
+  return true;
+}
+
+void SortExecutor::SortEntries() {
+  size_t threads = std::min(exec_ctx_->GetSortParallelism(), entries_.size() / MIN_PARALLEL_SORT_CHUNK);
+  if (threads > 1) {
+    ParallelSort(threads);
+    return;
+  }
+  std::vector<Entry> scratch(exec_ctx_->IsRadixSort() ? entries_.size() : 0);
+  SortRange(0, entries_.size(), &scratch);
+}
+
+void SortExecutor::SortRange(size_t begin, size_t end, std::vector<Entry> *scratch) {
+  if (exec_ctx_->IsRadixSort()) {
+    RadixSort(begin, end, 0, scratch);
+    return;
+  }
+  std::sort(entries_.begin() + begin, entries_.begin() + end,
+            [](const Entry &a, const Entry &b) { return a.key_ < b.key_; });
+}
+
+void SortExecutor::ParallelSort(size_t threads) {
+  auto key_less = [](const Entry &a, const Entry &b) { return a.key_ < b.key_; };
+  size_t size = entries_.size();
+  std::vector<Entry> scratch(size);
+
+  // The boundaries of the sorted runs: the chunks of the workers, and then the runs merged from them.
+  std::vector<size_t> bounds;
+  for (size_t i = 0; i <= threads; i++) {
+    bounds.push_back(size * i / threads);
+  }
+  RunWorkers(threads, threads, [&](size_t i) { SortRange(bounds[i], bounds[i + 1], &scratch); });
+
+  while (bounds.size() > 2) {
+    // Merge every pair of runs into scratch, in segments of about size / threads entries of the output. A segment
+    // starts where the merge path of its pair crosses the diagonal of its first output entry.
+    struct Segment {
+      size_t begin_, middle_, end_, diagonal_begin_, diagonal_end_;
+    };
+    std::vector<Segment> segments;
+    std::vector<size_t> merged_bounds;
+    for (size_t run = 0; run + 1 < bounds.size(); run += 2) {
+      size_t begin = bounds[run];
+      size_t middle = bounds[run + 1];
+      size_t end = run + 2 < bounds.size() ? bounds[run + 2] : middle;
+      size_t num_segments = std::max<size_t>(1, (end - begin) * threads / size);
+      for (size_t i = 0; i < num_segments; i++) {
+        segments.push_back(
+            {begin, middle, end, (end - begin) * i / num_segments, (end - begin) * (i + 1) / num_segments});
+      }
+      merged_bounds.push_back(begin);
+    }
+    merged_bounds.push_back(size);
+
+    auto merge_path = [&](const Segment &segment, size_t diagonal) {
+      // The number of entries of the first run among the first diagonal entries of the merge, which takes the entry
+      // of the first run on a tie.
+      size_t lo = diagonal > segment.end_ - segment.middle_ ? diagonal - (segment.end_ - segment.middle_) : 0;
+      size_t hi = std::min(diagonal, segment.middle_ - segment.begin_);
+      while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (key_less(entries_[segment.middle_ + diagonal - mid - 1], entries_[segment.begin_ + mid])) {
+          hi = mid;
+        } else {
+          lo = mid + 1;
+        }
+      }
+      return lo;
+    };
+    RunWorkers(segments.size(), threads, [&](size_t i) {
+      const auto &segment = segments[i];
+      size_t first_begin = merge_path(segment, segment.diagonal_begin_);
+      size_t first_end = merge_path(segment, segment.diagonal_end_);
+      auto first = entries_.begin() + segment.begin_;
+      auto second = entries_.begin() + segment.middle_;
+      std::merge(std::make_move_iterator(first + first_begin), std::make_move_iterator(first + first_end),
+                 std::make_move_iterator(second + (segment.diagonal_begin_ - first_begin)),
+                 std::make_move_iterator(second + (segment.diagonal_end_ - first_end)),
+                 scratch.begin() + segment.begin_ + segment.diagonal_begin_, key_less);
+    });
+    entries_.swap(scratch);
+    bounds = std::move(merged_bounds);
+  }
+}
+
+void SortExecutor::RadixSort(size_t begin, size_t end, size_t depth, std::vector<Entry> *scratch) {
+  if (end - begin < MIN_RADIX_SORT_SIZE) {
+    std::sort(entries_.begin() + begin, entries_.begin() + end, [depth](const Entry &a, const Entry &b) {
+      return a.key_.compare(depth, std::string::npos, b.key_, depth, std::string::npos) < 0;
+    });
+    return;
+  }
+  // Bucket 0 holds the keys that end at depth, which are equal, and bucket 1 + b those whose byte at depth is b.
+  std::array<size_t, 258> bucket_begin{};
+  for (size_t i = begin; i < end; i++) {
+    const auto &key = entries_[i].key_;
+    bucket_begin[(depth == key.size() ? 0 : 1 + static_cast<uint8_t>(key[depth])) + 1]++;
+  }
+  bucket_begin[0] = begin;
+  for (size_t b = 1; b < bucket_begin.size(); b++) {
+    bucket_begin[b] += bucket_begin[b - 1];
+  }
+  auto next = bucket_begin;
+  for (size_t i = begin; i < end; i++) {
+    const auto &key = entries_[i].key_;
+    (*scratch)[next[depth == key.size() ? 0 : 1 + static_cast<uint8_t>(key[depth])]++] = std::move(entries_[i]);
+  }
+  std::move(scratch->begin() + begin, scratch->begin() + end, entries_.begin() + begin);
+  for (size_t b = 1; b + 1 < bucket_begin.size(); b++) {
+    if (bucket_begin[b + 1] - bucket_begin[b] > 1) {
+      RadixSort(bucket_begin[b], bucket_begin[b + 1], depth + 1, scratch);
+    }
+  }
+}
+
+void SortExecutor::WriteRun() {
+  SortEntries();
+  auto run = std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager());
+  for (const auto &entry : entries_) {
+    AppendRecord(run.get(), entry.key_, tuples_[entry.index_]);
+  }
+  run->FinishAppending();
+  runs_.push_back(std::move(run));
+  tuples_.clear();
+  entries_.clear();
+}
+
+void SortExecutor::OpenRuns(size_t begin, size_t end, std::vector<RunCursor> *cursors,
+                            std::optional<LoserTree<RunLess>> *tree) const {
+  cursors->resize(end - begin);
+  for (size_t i = begin; i < end; i++) {
+    auto &cursor = (*cursors)[i - begin];
+    cursor.reader_ = std::make_unique<TmpTupleFile::Reader>(runs_[i].get());
+    Advance(&cursor);
+  }
+  tree->emplace(cursors->size(), RunLess{cursors});
+}
 
-void SortExecutor::Init() { throw NotImplementedException("SortExecutor is not implemented"); }
+void SortExecutor::Advance(RunCursor *cursor) {
+  Tuple record;
+  cursor->valid_ = cursor->reader_->Next(&record);
+  if (!cursor->valid_) {
+    return;
+  }
+  uint32_t key_size;
+  memcpy(&key_size, record.GetData(), sizeof(uint32_t));
+  cursor->key_.assign(record.GetData() + sizeof(uint32_t), key_size);
+  cursor->tuple_.DeserializeFrom(record.GetData() + sizeof(uint32_t) + key_size);
+}
 
-auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+void SortExecutor::AppendRecord(TmpTupleFile *run, const std::string &key, const Tuple &tuple) {
+  auto key_size = static_cast<uint32_t>(key.size());
+  uint32_t record_size = 2 * sizeof(uint32_t) + key_size + tuple.GetLength();
+  record_.resize(sizeof(uint32_t) + record_size);
+  char *data = record_.data();
+  memcpy(data, &record_size, sizeof(uint32_t));
+  memcpy(data + sizeof(uint32_t), &key_size, sizeof(uint32_t));
+  memcpy(data + 2 * sizeof(uint32_t), key.data(), key_size);
+  tuple.SerializeTo(data + 2 * sizeof(uint32_t) + key_size);
+  Tuple record;
+  record.DeserializeFrom(data);
+  run->Append(record);
+}
 
 }  // namespace bustub
@@ -0,0 +1,92 @@
+#include "execution/sort_key_normalizer.h"
+
+#include <cstring>
+
+#include "type/type.h"
+
+namespace bustub {
+
+namespace {
+
+constexpr char NULL_FIRST = 0x00;
+constexpr char NOT_NULL = 0x01;
+constexpr char NULL_LAST = 0x02;
+
+/** Append an unsigned integer of the given width in bytes, most significant byte first. */
+void AppendBigEndian(uint64_t bits, size_t width, std::string *key) {
+  for (size_t i = width; i > 0; i--) {
+    key->push_back(static_cast<char>(bits >> (8 * (i - 1))));
+  }
+}
+
+/** Append a signed integer of the given width, with its sign bit flipped so that negative numbers come first. */
+void AppendSigned(int64_t value, size_t width, std::string *key) {
+  uint64_t sign_bit = uint64_t{1} << (8 * width - 1);
+  AppendBigEndian(static_cast<uint64_t>(value) ^ sign_bit, width, key);
+}
+
+}  // namespace
+
+void SortKeyNormalizer::Normalize(const Tuple &tuple, std::string *key) const {
+  for (const auto &[order_by_type, null_type, expr] : order_bys_) {
+    bool descending = order_by_type == OrderByType::DESC;
+    bool nulls_first = null_type == OrderByNullType::DEFAULT ? !descending : null_type == OrderByNullType::NULLS_FIRST;
+    NormalizeValue(expr->Evaluate(&tuple, schema_), descending, nulls_first, key);
+  }
+}
+
+void SortKeyNormalizer::NormalizeValue(const Value &value, bool descending, bool nulls_first, std::string *key) {
+  if (value.IsNull()) {
+    key->push_back(nulls_first ? NULL_FIRST : NULL_LAST);
+    return;
+  }
+  key->push_back(NOT_NULL);
+  size_t begin = key->size();
+  switch (value.GetTypeId()) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      AppendSigned(value.GetAs<int8_t>(), sizeof(int8_t), key);
+      break;
+    case TypeId::SMALLINT:
+      AppendSigned(value.GetAs<int16_t>(), sizeof(int16_t), key);
+      break;
+    case TypeId::INTEGER:
+      AppendSigned(value.GetAs<int32_t>(), sizeof(int32_t), key);
+      break;
+    case TypeId::BIGINT:
+      AppendSigned(value.GetAs<int64_t>(), sizeof(int64_t), key);
+      break;
+    case TypeId::TIMESTAMP:
+      AppendBigEndian(value.GetAs<uint64_t>(), sizeof(uint64_t), key);
+      break;
+    case TypeId::DECIMAL: {
+      double decimal = value.GetAs<double>();
+      uint64_t bits;
+      memcpy(&bits, &decimal, sizeof(bits));
+      bits = (bits >> 63) != 0 ? ~bits : bits | (uint64_t{1} << 63);
+      AppendBigEndian(bits, sizeof(bits), key);
+      break;
+    }
+    case TypeId::VARCHAR: {
+      const char *data = value.GetData();
+      uint32_t length = value.GetLength() - 1;
+      for (uint32_t i = 0; i < length; i++) {
+        key->push_back(data[i]);
+        if (data[i] == '\0') {
+          key->push_back(static_cast<char>(0xFF));
+        }
+      }
+      key->append(2, '\0');
+      break;
+    }
+    default:
+      throw NotImplementedException(fmt::format("cannot sort on type {}", Type::TypeIdToString(value.GetTypeId())));
+  }
+  if (descending) {
+    for (size_t i = begin; i < key->size(); i++) {
+      (*key)[i] = static_cast<char>(~(*key)[i]);
+    }
+  }
+}
+
+}  // namespace bustub
@@ -1,13 +1,47 @@
 #include "execution/executors/topn_executor.h"
 
+#include <algorithm>
+
 namespace bustub {
 
 TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void TopNExecutor::Init() {
+  child_executor_->Init();
+  entries_.clear();
+  cursor_ = 0;
 
-void TopNExecutor::Init() { throw NotImplementedException("TopNExecutor is not implemented"); }
+  auto key_less = [](const Entry &a, const Entry &b) { return a.key_ < b.key_; };
+  SortKeyNormalizer normalizer(plan_->GetOrderBy(), child_executor_->GetOutputSchema());
+  std::string key;
+  Tuple tuple;
+  RID rid;
+  while (plan_->GetN() > 0 && child_executor_->Next(&tuple, &rid)) {
+    key.clear();
+    normalizer.Normalize(tuple, &key);
+    if (entries_.size() == plan_->GetN()) {
+      // The heap is full; the tuple replaces the last of the first N if it goes before it.
+      if (key >= entries_.front().key_) {
+        continue;
+      }
+      std::pop_heap(entries_.begin(), entries_.end(), key_less);
+      entries_.pop_back();
+    }
+    entries_.push_back({key, tuple});
+    std::push_heap(entries_.begin(), entries_.end(), key_less);
+  }
+  std::sort_heap(entries_.begin(), entries_.end(), key_less);
+}
 
-auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (cursor_ == entries_.size()) {
+    return false;
+  }
+  *tuple = entries_[cursor_++].tuple_;
+  *rid = tuple->GetRid();
+  return true;
+}
 
 }  // namespace bustub
@@ -28,22 +28,36 @@ enum class OrderByType : uint8_t {
   DESC = 3,    /**< Descending order by type. */
 };
 
+/**
+ * Where the NULLs of an order-by go. By default they go last in ascending order and first in descending order.
+ */
+enum class OrderByNullType : uint8_t {
+  DEFAULT = 0,     /**< Default NULL order. */
+  NULLS_FIRST = 1, /**< NULLS FIRST. */
+  NULLS_LAST = 2,  /**< NULLS LAST. */
+};
+
 /**
  * BoundOrderBy is an item in the ORDER BY clause.
  */
 class BoundOrderBy {
  public:
-  explicit BoundOrderBy(OrderByType type, std::unique_ptr<BoundExpression> expr)
-      : type_(type), expr_(std::move(expr)) {}
+  explicit BoundOrderBy(OrderByType type, OrderByNullType null_type, std::unique_ptr<BoundExpression> expr)
+      : type_(type), null_type_(null_type), expr_(std::move(expr)) {}
 
   /** The order by type. */
   OrderByType type_;
 
+  /** Where the NULLs go. */
+  OrderByNullType null_type_;
+
   /** The order by expression */
   std::unique_ptr<BoundExpression> expr_;
 
   /** Render this statement as a string. */
-  auto ToString() const -> std::string { return fmt::format("BoundOrderBy {{ type={}, expr={} }}", type_, expr_); }
+  auto ToString() const -> std::string {
+    return fmt::format("BoundOrderBy {{ type={}, null_type={}, expr={} }}", type_, null_type_, expr_);
+  }
 };
 
 }  // namespace bustub
@@ -91,3 +105,26 @@ struct fmt::formatter<bustub::OrderByType> : formatter<string_view> {
     return formatter<string_view>::format(name, ctx);
   }
 };
+
+template <>
+struct fmt::formatter<bustub::OrderByNullType> : formatter<string_view> {
+  template <typename FormatContext>
+  auto format(bustub::OrderByNullType c, FormatContext &ctx) const {
+    string_view name;
+    switch (c) {
+      case bustub::OrderByNullType::DEFAULT:
+        name = "Default";
+        break;
+      case bustub::OrderByNullType::NULLS_FIRST:
+        name = "NullsFirst";
+        break;
+      case bustub::OrderByNullType::NULLS_LAST:
+        name = "NullsLast";
+        break;
+      default:
+        name = "Unknown";
+        break;
+    }
+    return formatter<string_view>::format(name, ctx);
+  }
+};
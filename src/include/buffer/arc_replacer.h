@@ -0,0 +1,97 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arc_replacer.h
+//
+// Identification: src/include/buffer/arc_replacer.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "buffer/ghost_list.h"
+#include "buffer/replacer.h"
+#include "common/config.h"
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * ARCReplacer implements the Adaptive Replacement Cache policy (Megiddo and Modha, FAST '03).
+ *
+ * Resident pages are split between T1, pages accessed once since they were loaded, and T2, pages accessed at least
+ * twice; both are LRU lists. Evicted pages are remembered in the ghost lists B1 and B2. Loading a page remembered in
+ * B1 means T1 was too small and grows its target size p, loading a page remembered in B2 shrinks it; eviction takes
+ * the least recently used page of T1 while T1 is larger than p, and of T2 otherwise. A list whose candidates are all
+ * pinned yields to the other one.
+ */
+class ARCReplacer : public Replacer {
+ public:
+  /**
+   * Create a new ARCReplacer.
+   * @param num_frames the maximum number of frames the replacer will be required to store
+   */
+  explicit ARCReplacer(size_t num_frames);
+
+  DISALLOW_COPY_AND_MOVE(ARCReplacer);
+
+  ~ARCReplacer() override = default;
+
+  auto Evict(frame_id_t *frame_id) -> bool override;
+
+  void RecordAccess(frame_id_t frame_id, page_id_t page_id) override;
+
+  using Replacer::RecordAccess;
+
+  void SetEvictable(frame_id_t frame_id, bool set_evictable) override;
+
+  void Remove(frame_id_t frame_id) override;
+
+  auto Size() -> size_t override;
+
+  /** @return the current target size of T1 */
+  auto GetTargetT1Size() -> size_t;
+
+ private:
+  /** Resident list of a tracked frame. */
+  enum class Queue { None, T1, T2 };
+
+  /** @return the least recently used evictable frame of a resident list, or INVALID_FRAME_ID */
+  auto LeastRecentEvictable(const std::list<frame_id_t> &list) const -> frame_id_t;
+
+  /** Keep |T1| + |B1| <= c and |T1| + |T2| + |B1| + |B2| <= 2c. */
+  void TrimGhosts();
+
+  /** Drop a tracked frame. */
+  void Untrack(frame_id_t frame_id);
+
+  static constexpr frame_id_t INVALID_FRAME_ID = -1;
+
+  /** Resident pages seen once, most recently used first. */
+  std::list<frame_id_t> t1_;
+  /** Resident pages seen at least twice, most recently used first. */
+  std::list<frame_id_t> t2_;
+  /** Ghost lists of pages evicted from T1 and T2. */
+  GhostList b1_;
+  GhostList b2_;
+  /** Per-frame state, indexed by frame id. */
+  std::vector<Queue> queue_;
+  std::vector<std::list<frame_id_t>::iterator> positions_;
+  std::vector<page_id_t> page_ids_;
+  std::vector<bool> evictable_;
+  /** Number of frames, c in the paper. */
+  size_t capacity_;
+  /** Target size of T1, p in the paper. */
+  size_t target_t1_{0};
+  size_t curr_size_{0};
+  std::mutex latch_;
+};
+
+}  // namespace bustub
@@ -12,11 +12,14 @@
 
 #pragma once
 
+#include <chrono>  // NOLINT
 #include <list>
 #include <mutex>  // NOLINT
 #include <unordered_map>
 
+#include "buffer/buffer_ring.h"
 #include "buffer/lru_replacer.h"
+#include "buffer/page_access_trace.h"
 #include "recovery/log_manager.h"
 #include "storage/disk/disk_manager.h"
 #include "storage/page/page.h"
@@ -84,9 +87,58 @@ class BufferPoolManager {
     GradingCallback(callback, CallbackType::AFTER, INVALID_PAGE_ID);
   }
 
+  /**
+   * Fetch a page on behalf of a large sequential operation. The page is read into a frame of the ring if it is not
+   * buffered, and is not promoted in the replacer. Same as FetchPage() if ring is nullptr.
+   * @param page_id id of page to be fetched
+   * @param ring the buffer ring of the operation, or nullptr
+   * @return the requested page
+   */
+  auto FetchPageWithRing(page_id_t page_id, BufferRing *ring) -> Page * {
+    return ring == nullptr ? FetchPgImp(page_id) : FetchPgRingImp(page_id, ring);
+  }
+
+  /**
+   * Create a new page on behalf of a large sequential operation, in a frame of the ring. Same as NewPage() if ring is
+   * nullptr.
+   * @param[out] page_id id of created page
+   * @param ring the buffer ring of the operation, or nullptr
+   * @return nullptr if no new pages could be created, otherwise pointer to new page
+   */
+  auto NewPageWithRing(page_id_t *page_id, BufferRing *ring) -> Page * {
+    return ring == nullptr ? NewPgImp(page_id) : NewPgRingImp(page_id, ring);
+  }
+
   /** @return size of the buffer pool */
   virtual auto GetPoolSize() -> size_t = 0;
 
+  /**
+   * Hint that the pages [start_page_id, start_page_id + count) are about to be fetched, so that they can be read into
+   * the buffer pool in the background. This is only a hint: a buffer pool may skip some or all of the pages, e.g. when
+   * all frames are pinned. The prefetched pages are not pinned.
+   * @param start_page_id id of the first page to read ahead
+   * @param count number of consecutive page ids to read ahead
+   */
+  virtual void PrefetchPages(__attribute__((unused)) page_id_t start_page_id, __attribute__((unused)) size_t count) {}
+
+  /**
+   * Start or stop recording the pages fetched from and created in this buffer pool.
+   * @param trace the trace to append to, or nullptr to stop recording. It must outlive the recording.
+   */
+  virtual void SetPageAccessTrace(__attribute__((unused)) PageAccessTrace *trace) {}
+
+  /**
+   * Start writing dirty pages back in the background, so that evictions find them clean. Buffer pools without a page
+   * cleaner ignore it.
+   * @param interval how often the cleaner looks for dirty pages
+   * @param max_pages_per_round the maximum number of pages written back in each round
+   */
+  virtual void StartPageCleaner(__attribute__((unused)) std::chrono::milliseconds interval,
+                                __attribute__((unused)) size_t max_pages_per_round) {}
+
+  /** Stop the background page cleaner, if it is running. */
+  virtual void StopPageCleaner() {}
+
  protected:
   /**
    * Grading function. Do not modify!
@@ -141,5 +193,25 @@ class BufferPoolManager {
    * Flushes all the pages in the buffer pool to disk.
    */
   virtual void FlushAllPgsImp() = 0;
+
+  /**
+   * Fetch the requested page through a buffer ring. Buffer pools without ring support fetch it like any other page.
+   * @param page_id id of page to be fetched
+   * @param ring the buffer ring of the operation
+   * @return the requested page
+   */
+  virtual auto FetchPgRingImp(page_id_t page_id, __attribute__((unused)) BufferRing *ring) -> Page * {
+    return FetchPgImp(page_id);
+  }
+
+  /**
+   * Creates a new page through a buffer ring. Buffer pools without ring support create it like any other page.
+   * @param[out] page_id id of created page
+   * @param ring the buffer ring of the operation
+   * @return nullptr if no new pages could be created, otherwise pointer to new page
+   */
+  virtual auto NewPgRingImp(page_id_t *page_id, __attribute__((unused)) BufferRing *ring) -> Page * {
+    return NewPgImp(page_id);
+  }
 };
 }  // namespace bustub
@@ -12,16 +12,24 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <future>  // NOLINT
 #include <list>
+#include <memory>
 #include <mutex>  // NOLINT
+#include <thread>  // NOLINT
 #include <unordered_map>
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
-#include "buffer/lru_k_replacer.h"
+#include "buffer/lock_free_page_table.h"
+#include "buffer/page_access_trace.h"
+#include "buffer/replacer.h"
 #include "common/config.h"
-#include "container/hash/extendible_hash_table.h"
 #include "recovery/log_manager.h"
 #include "storage/disk/disk_manager.h"
+#include "storage/disk/disk_scheduler.h"
 #include "storage/page/page.h"
 
 namespace bustub {
@@ -37,9 +45,24 @@ class BufferPoolManagerInstance : public BufferPoolManager {
    * @param disk_manager the disk manager
    * @param replacer_k the lookback constant k for the LRU-K replacer
    * @param log_manager the log manager (for testing only: nullptr = disable logging). Please ignore this for P1.
+   * @param replacer_policy the replacement policy of the buffer pool
    */
   BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager, size_t replacer_k = LRUK_REPLACER_K,
-                            LogManager *log_manager = nullptr);
+                            LogManager *log_manager = nullptr, ReplacerPolicy replacer_policy = ReplacerPolicy::LRUK);
+
+  /**
+   * @brief Creates a new BufferPoolManagerInstance that is one shard of a ParallelBufferPoolManager.
+   * @param pool_size the size of the buffer pool
+   * @param num_instances total number of BPIs in the parallel BPM
+   * @param instance_index index of this BPI in the parallel BPM
+   * @param disk_manager the disk manager
+   * @param replacer_k the lookback constant k for the LRU-K replacer
+   * @param log_manager the log manager (for testing only: nullptr = disable logging). Please ignore this for P1.
+   * @param replacer_policy the replacement policy of the buffer pool
+   */
+  BufferPoolManagerInstance(size_t pool_size, uint32_t num_instances, uint32_t instance_index,
+                            DiskManager *disk_manager, size_t replacer_k = LRUK_REPLACER_K,
+                            LogManager *log_manager = nullptr, ReplacerPolicy replacer_policy = ReplacerPolicy::LRUK);
 
   /**
    * @brief Destroy an existing BufferPoolManagerInstance.
@@ -52,10 +75,73 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   /** @brief Return the pointer to all the pages in the buffer pool. */
   auto GetPages() -> Page * { return pages_; }
 
- protected:
   /**
-   * TODO(P1): Add implementation
+   * @brief Read the pages in [start_page_id, start_page_id + count) owned by this instance into the buffer pool
+   * without waiting for the reads. Pages that are already buffered or were never allocated are skipped, and read-ahead
+   * stops when no frame is free or evictable.
+   *
+   * A prefetched page is unpinned, but it is held unevictable until it is fetched: under LRU-K its single access would
+   * otherwise make it the first victim. Held pages are released only when no other frame can be evicted, and at most
+   * half of the buffer pool is held at a time. The read-ahead records the access that brings the page in, so the first
+   * FetchPage of a prefetched page does not record a second one in the replacer. Any use of the frame waits for the
+   * pending read first.
+   *
+   * @param start_page_id id of the first page to read ahead
+   * @param count number of consecutive page ids to read ahead
+   */
+  void PrefetchPages(page_id_t start_page_id, size_t count) override;
+
+  /**
+   * @brief Start or stop recording the pages fetched from and created in this buffer pool.
+   * @param trace the trace to append to, or nullptr to stop recording
+   */
+  void SetPageAccessTrace(PageAccessTrace *trace) override;
+
+  /** @brief Return the number of pages read into the buffer pool by PrefetchPages(). */
+  auto GetNumPagesPrefetched() const -> size_t { return num_pages_prefetched_; }
+
+  /** @brief Return the number of FetchPage calls served by a prefetched page. */
+  auto GetNumPrefetchHits() const -> size_t { return num_prefetch_hits_; }
+
+  /** @brief Return the number of FetchPage calls served without taking the latch. */
+  auto GetNumLockFreeHits() const -> size_t { return num_lock_free_hits_; }
+
+  /**
+   * @brief Start the background page cleaner. Every interval, the cleaner runs CleanDirtyPages() so that dirty pages
+   * are already written back by the time the replacer picks them as victims, and NewPage/FetchPage do not have to wait
+   * for the write. Does nothing if the cleaner is already running.
+   * @param interval how often the cleaner looks for dirty pages
+   * @param max_pages_per_round the maximum number of pages written back in each round
+   */
+  void StartPageCleaner(std::chrono::milliseconds interval, size_t max_pages_per_round) override;
+
+  /** @brief Stop the background page cleaner and wait for its current round to finish. */
+  void StopPageCleaner() override;
+
+  /**
+   * @brief Run one round of the page cleaner: write back up to max_pages dirty, unpinned pages, continuing the scan
+   * of the frames where the previous round stopped.
    *
+   * With logging enabled, a page is only written once the log records up to its LSN are persistent (write-ahead
+   * logging), other pages are skipped until a later round. The cleaner pins a page while writing it so it cannot be
+   * evicted, but does not record an access in the replacer.
+   *
+   * @param max_pages the maximum number of pages to write back
+   * @return the number of pages written back
+   */
+  auto CleanDirtyPages(size_t max_pages) -> size_t;
+
+  /** @brief Return the number of pages written back by the page cleaner. */
+  auto GetNumPagesCleaned() const -> size_t { return num_pages_cleaned_; }
+
+  /** @brief Return the number of evictions of pages that would have been dirty if the page cleaner had not run. */
+  auto GetNumDirtyEvictionsAvoided() const -> size_t { return num_dirty_evictions_avoided_; }
+
+  /** @brief Return the number of evictions that had to write back a dirty page in the foreground. */
+  auto GetNumDirtyEvictions() const -> size_t { return num_dirty_evictions_; }
+
+ protected:
+  /**
    * @brief Create a new page in the buffer pool. Set page_id to the new page's id, or nullptr if all frames
    * are currently in use and not evictable (in another word, pinned).
    *
@@ -73,14 +159,12 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   auto NewPgImp(page_id_t *page_id) -> Page * override;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Fetch the requested page from the buffer pool. Return nullptr if page_id needs to be fetched from the disk
    * but all frames are currently in use and not evictable (in another word, pinned).
    *
    * First search for page_id in the buffer pool. If not found, pick a replacement frame from either the free list or
-   * the replacer (always find from the free list first), read the page from disk by calling disk_manager_->ReadPage(),
-   * and replace the old page in the frame. Similar to NewPgImp(), if the old page is dirty, you need to write it back
+   * the replacer (always find from the free list first), read the page from disk by scheduling a read request
+   * with disk_scheduler_->Schedule(), and replace the old page in the frame. Similar to NewPgImp(), if the old page is dirty, you need to write it back
    * to disk and update the metadata of the new page
    *
    * In addition, remember to disable eviction and record the access history of the frame like you did for NewPgImp().
@@ -91,8 +175,24 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   auto FetchPgImp(page_id_t page_id) -> Page * override;
 
   /**
-   * TODO(P1): Add implementation
+   * @brief Fetch the requested page through a buffer ring. A buffered page is pinned without recording an access in
+   * the replacer. Otherwise the page is read into a frame from AcquireRingFrame() and becomes part of the ring.
    *
+   * @param page_id id of page to be fetched
+   * @param ring the buffer ring of the calling operation
+   * @return nullptr if page_id cannot be fetched, otherwise pointer to the requested page
+   */
+  auto FetchPgRingImp(page_id_t page_id, BufferRing *ring) -> Page * override;
+
+  /**
+   * @brief Create a new page in a frame from AcquireRingFrame(), the page becomes part of the ring.
+   * @param[out] page_id id of created page
+   * @param ring the buffer ring of the calling operation
+   * @return nullptr if no new pages could be created, otherwise pointer to new page
+   */
+  auto NewPgRingImp(page_id_t *page_id, BufferRing *ring) -> Page * override;
+
+  /**
    * @brief Unpin the target page from the buffer pool. If page_id is not in the buffer pool or its pin count is already
    * 0, return false.
    *
@@ -106,11 +206,9 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   auto UnpinPgImp(page_id_t page_id, bool is_dirty) -> bool override;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Flush the target page to disk.
    *
-   * Use the DiskManager::WritePage() method to flush a page to disk, REGARDLESS of the dirty flag.
+   * Schedule a write request through the DiskScheduler to flush a page to disk, REGARDLESS of the dirty flag.
    * Unset the dirty flag of the page after flushing.
    *
    * @param page_id id of page to be flushed, cannot be INVALID_PAGE_ID
@@ -119,15 +217,12 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   auto FlushPgImp(page_id_t page_id) -> bool override;
 
   /**
-   * TODO(P1): Add implementation
-   *
-   * @brief Flush all the pages in the buffer pool to disk.
+   * @brief Flush all the pages in the buffer pool to disk. All the writes are scheduled before waiting for any of them,
+   * so the disk scheduler can issue them as one batch. The database file is synced once all the writes complete.
    */
   void FlushAllPgsImp() override;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Delete a page from the buffer pool. If page_id is not in the buffer pool, do nothing and return true. If the
    * page is pinned and cannot be deleted, return false immediately.
    *
@@ -142,25 +237,76 @@ class BufferPoolManagerInstance : public BufferPoolManager {
 
   /** Number of pages in the buffer pool. */
   const size_t pool_size_;
+  /** How many instances are in the parallel BPM (if present, otherwise just 1 BPI) */
+  const uint32_t num_instances_ = 1;
+  /** Index of this BPI in the parallel BPM (if present, otherwise just 0) */
+  const uint32_t instance_index_ = 0;
   /** The next page id to be allocated  */
-  std::atomic<page_id_t> next_page_id_ = 0;
-  /** Bucket size for the extendible hash table */
-  const size_t bucket_size_ = 4;
+  std::atomic<page_id_t> next_page_id_;
 
   /** Array of buffer pool pages. */
   Page *pages_;
   /** Pointer to the disk manager. */
-  DiskManager *disk_manager_ __attribute__((__unused__));
-  /** Pointer to the log manager. Please ignore this for P1. */
-  LogManager *log_manager_ __attribute__((__unused__));
-  /** Page table for keeping track of buffer pool pages. */
-  ExtendibleHashTable<page_id_t, frame_id_t> *page_table_;
+  DiskManager *disk_manager_;
+  /** Schedules the reads and writes of this instance on the disk manager. */
+  std::unique_ptr<DiskScheduler> disk_scheduler_;
+  /** Pointer to the log manager, used by the page cleaner to respect write-ahead logging. */
+  LogManager *log_manager_;
+  /** Page table for keeping track of buffer pool pages. Lookups do not need the latch, updates do. */
+  LockFreePageTable *page_table_;
   /** Replacer to find unpinned pages for replacement. */
-  LRUKReplacer *replacer_;
+  std::unique_ptr<Replacer> replacer_;
+  /** Trace the fetched and created pages are recorded in, nullptr when not recording. */
+  std::atomic<PageAccessTrace *> page_trace_{nullptr};
   /** List of free frames that don't have any pages on them. */
   std::list<frame_id_t> free_list_;
-  /** This latch protects shared data structures. We recommend updating this comment to describe what it protects. */
+  /**
+   * This latch protects updates of the page table, the replacer, the free list and the metadata of every frame. The
+   * lock-free FetchPage path only touches the page table, resident_page_, pending_accesses_ and the pin counts.
+   */
   std::mutex latch_;
+  /**
+   * For every frame, the page FetchPage may pin without the latch, or INVALID_PAGE_ID if fetches of the frame must
+   * take the latch (it is free, being evicted, or holds a prefetched or buffer ring page).
+   */
+  std::unique_ptr<std::atomic<page_id_t>[]> resident_page_;
+  /** For every frame, accesses made without the latch that are not recorded in the replacer yet. */
+  std::unique_ptr<std::atomic<uint32_t>[]> pending_accesses_;
+  std::atomic<size_t> num_lock_free_hits_{0};
+
+  /**
+   * For every frame, true while a read into or a write back of the frame is in flight. The latch is released during
+   * the I/O; the frame keeps its page table entry, and threads looking up its page wait on io_done_ instead.
+   */
+  std::vector<bool> io_pending_;
+  /** Number of frames in io_pending_. */
+  size_t num_io_pending_{0};
+  /** Signalled, together with latch_, whenever the I/O of a frame completes. */
+  std::condition_variable io_done_;
+
+  /** For every frame, true if its page was written back by the page cleaner since it was last modified. */
+  std::vector<bool> cleaned_;
+  /** For every frame, the read scheduled by PrefetchPages() that has not been waited for yet, if any. */
+  std::vector<std::future<bool>> pending_reads_;
+  /** For every frame, true if its page was prefetched and has not been fetched since. */
+  std::vector<bool> prefetched_;
+  /** For every frame, true if it holds a prefetched page that is kept unevictable until it is fetched. */
+  std::vector<bool> prefetch_held_;
+  /** Number of frames in prefetch_held_. */
+  size_t num_prefetch_held_{0};
+  /** For every frame, true if its page was read through a buffer ring and was not fetched outside of it since. */
+  std::vector<bool> ring_frame_;
+  std::atomic<size_t> num_pages_prefetched_{0};
+  std::atomic<size_t> num_prefetch_hits_{0};
+  /** The frame where the next page cleaner round starts scanning. */
+  size_t cleaner_hand_{0};
+  /** True while the page cleaner thread should keep running. */
+  std::atomic<bool> enable_page_cleaner_{false};
+  /** The background page cleaner, nullptr when it is not running. */
+  std::thread *page_cleaner_thread_{nullptr};
+  std::atomic<size_t> num_pages_cleaned_{0};
+  std::atomic<size_t> num_dirty_evictions_avoided_{0};
+  std::atomic<size_t> num_dirty_evictions_{0};
 
   /**
    * @brief Allocate a page on disk. Caller should acquire the latch before calling this function.
@@ -176,6 +322,115 @@ class BufferPoolManagerInstance : public BufferPoolManager {
     // This is a no-nop right now without a more complex data structure to track deallocated pages
   }
 
-  // TODO(student): You may add additional private members and helper functions
+  /**
+   * @brief Validate that the page_id being used is accessible to this BPI. This can be used in all of the functions
+   * to validate input data and ensure that a parallel BPM is routing requests to the correct BPI.
+   * @param page_id the page id to validate
+   */
+  void ValidatePageId(page_id_t page_id) const;
+
+  /**
+   * @brief Pin a resident page without taking the latch. Wait-free: a page table lookup, then the pin is published
+   * and validated against resident_page_, which an eviction clears before it checks the pin count (see ClaimFrame).
+   * The access is recorded in the replacer by the next unpin of the frame.
+   * @param page_id the page to pin
+   * @param[out] frame_id id of the frame of the page
+   * @return true if the page was pinned, false if the fetch has to take the latch
+   */
+  auto TryPinResident(page_id_t page_id, frame_id_t *frame_id) -> bool;
+
+  /**
+   * @brief Take a frame away from lock-free fetches before evicting or deleting its page. Caller should acquire the
+   * latch before calling this function.
+   * @param frame_id id of the frame
+   * @return true if nobody has the page pinned and the frame can be reused, false if it is pinned after all
+   */
+  auto ClaimFrame(frame_id_t frame_id) -> bool;
+
+  /**
+   * @brief Record the accesses made by lock-free fetches of a frame in the replacer. Caller should acquire the latch
+   * before calling this function.
+   * @param frame_id id of the frame
+   */
+  void RecordPendingAccesses(frame_id_t frame_id);
+
+  /**
+   * @brief Look up the frame of a page, waiting until I/O in flight on that frame has completed. Caller should hold
+   * the latch through lock, which is released while waiting.
+   * @param lock the caller's lock of the latch
+   * @param page_id the page to look up
+   * @param[out] frame_id id of the frame of the page
+   * @return true if the page is buffered, false otherwise
+   */
+  auto FindFrame(std::unique_lock<std::mutex> *lock, page_id_t page_id, frame_id_t *frame_id) -> bool;
+
+  /**
+   * @brief Find a frame to hold a new page, first from the free list and then from the replacer. If the victim frame
+   * holds a dirty page, it is written back to disk. Caller should hold the latch through lock; it is released during
+   * the write back, so a page looked up before may have been read into another frame by the time this returns.
+   * @param lock the caller's lock of the latch
+   * @param[out] frame_id id of the frame that is now unused
+   * @return false if all frames are pinned, true otherwise
+   */
+  auto AcquireFrame(std::unique_lock<std::mutex> *lock, frame_id_t *frame_id) -> bool;
+
+  /**
+   * @brief Write back and unmap the page held by a frame that was taken out of the replacer, leaving the frame
+   * empty. Caller should hold the latch through lock, which is released during the write back.
+   * @param lock the caller's lock of the latch
+   * @param frame_id id of the victim frame
+   */
+  void EvictFrame(std::unique_lock<std::mutex> *lock, frame_id_t frame_id);
+
+  /**
+   * @brief Find a frame for a page read through a buffer ring. Once the ring holds as many pages of this instance as it
+   * has frames, the frame of its oldest page is recycled, unless that page was pinned or fetched outside of the ring in
+   * the meantime; a frame is taken with AcquireFrame() otherwise. Caller should hold the latch through lock, which may
+   * be released as in AcquireFrame().
+   * @param lock the caller's lock of the latch
+   * @param ring the buffer ring
+   * @param[out] frame_id id of the frame that is now unused
+   * @return false if no frame could be found, true otherwise
+   */
+  auto AcquireRingFrame(std::unique_lock<std::mutex> *lock, BufferRing *ring, frame_id_t *frame_id) -> bool;
+
+  /**
+   * @brief Pin the page held by the given frame and record the access in the replacer, unless the access was already
+   * recorded when the page was prefetched. Caller should acquire the latch before calling this function.
+   * @param frame_id id of the frame to pin
+   * @param record_access false to pin the page without recording an access, e.g. for an access through a buffer ring
+   */
+  void PinFrame(frame_id_t frame_id, bool record_access = true);
+
+  /**
+   * @brief Wait for I/O on a frame without holding the latch. The frame is marked in io_pending_ meanwhile. Caller
+   * should hold the latch through lock, and the frame must be pinned or taken out of the replacer so it cannot be
+   * evicted while the latch is released.
+   * @param lock the caller's lock of the latch
+   * @param frame_id id of the frame
+   * @param io the read or write of the frame
+   */
+  void WaitForIo(std::unique_lock<std::mutex> *lock, frame_id_t frame_id, std::future<bool> io);
+
+  /**
+   * @brief Wait until the prefetch read into the given frame, if any, has completed, see WaitForIo().
+   * @param lock the caller's lock of the latch
+   * @param frame_id id of the frame
+   */
+  void WaitForRead(std::unique_lock<std::mutex> *lock, frame_id_t frame_id);
+
+  /**
+   * @brief Make every held prefetched frame evictable again. Caller should acquire the latch before calling this
+   * function.
+   */
+  void ReleasePrefetchedFrames();
+
+  /**
+   * @brief Write back the page held by a frame that the page cleaner has pinned, unless write-ahead logging forbids it.
+   * Caller must not hold the latch.
+   * @param frame_id id of the pinned frame
+   * @return true if the page was written back
+   */
+  auto CleanFrame(frame_id_t frame_id) -> bool;
 };
 }  // namespace bustub
@@ -0,0 +1,65 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// buffer_ring.h
+//
+// Identification: src/include/buffer/buffer_ring.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <deque>
+
+#include "common/config.h"
+
+namespace bustub {
+
+/** How an executor accesses the pages of a large sequential operation. */
+enum class BufferAccessStrategy {
+  /** Pages go through the buffer pool like any other access. */
+  Default,
+  /** Pages go through a private BufferRing of BUFFER_RING_SIZE frames. */
+  Ring,
+};
+
+/**
+ * BufferRing is a small private set of buffer pool frames that a large sequential operation (a full table scan, a bulk
+ * insert, an index build) recycles, so that a single pass over a large table does not push the working set of every
+ * other query out of the buffer pool.
+ *
+ * A page that misses the buffer pool when fetched through a ring is read into a frame of the ring: once the ring is
+ * full, the frame of its oldest page is reused if nobody else pinned or fetched that page in the meantime, and the
+ * frame is taken from the buffer pool otherwise. Pages reached through a ring are recorded once in the replacer and are
+ * never promoted by later accesses through the ring, so they stay the first eviction candidates.
+ *
+ * A ring belongs to one executor and must not be shared between threads.
+ */
+class BufferRing {
+  friend class BufferPoolManagerInstance;
+
+ public:
+  /**
+   * @brief Create a new, empty buffer ring.
+   * @param size the number of frames the ring recycles
+   */
+  explicit BufferRing(size_t size = BUFFER_RING_SIZE) : size_(std::max<size_t>(size, 1)) {}
+
+  /** @return the number of frames the ring recycles */
+  auto GetSize() const -> size_t { return size_; }
+
+  /** @return the number of pages currently in the ring */
+  auto GetNumPages() const -> size_t { return page_ids_.size(); }
+
+ private:
+  /** The number of frames the ring recycles. */
+  const size_t size_;
+  /** The pages read through this ring, oldest first. */
+  std::deque<page_id_t> page_ids_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,128 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// clock_pro_replacer.h
+//
+// Identification: src/include/buffer/clock_pro_replacer.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <mutex>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "buffer/replacer.h"
+#include "common/config.h"
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * ClockProReplacer implements the CLOCK-Pro replacement policy (Jiang, Chen and Zhang, USENIX ATC '05).
+ *
+ * Pages are hot or cold and sit on a single clock together with non-resident cold pages, whose ids are kept for a
+ * test period after their eviction. Three hands sweep the clock:
+ *
+ * - HAND_cold evicts unreferenced resident cold pages. A referenced cold page still in its test period is promoted to
+ *   hot, other referenced cold pages start a new test period.
+ * - HAND_hot demotes the first unreferenced hot page to cold when there are too many hot pages, and ends the test
+ *   periods it passes.
+ * - HAND_test ends test periods, dropping non-resident pages, when more pages than frames are non-resident.
+ *
+ * A cold page that is reloaded or referenced within its test period grows the target number of cold pages, a test
+ * period that ends without a reference shrinks it.
+ */
+class ClockProReplacer : public Replacer {
+ public:
+  /**
+   * Create a new ClockProReplacer.
+   * @param num_frames the maximum number of frames the replacer will be required to store
+   */
+  explicit ClockProReplacer(size_t num_frames);
+
+  DISALLOW_COPY_AND_MOVE(ClockProReplacer);
+
+  ~ClockProReplacer() override = default;
+
+  auto Evict(frame_id_t *frame_id) -> bool override;
+
+  void RecordAccess(frame_id_t frame_id, page_id_t page_id) override;
+
+  using Replacer::RecordAccess;
+
+  void SetEvictable(frame_id_t frame_id, bool set_evictable) override;
+
+  void Remove(frame_id_t frame_id) override;
+
+  auto Size() -> size_t override;
+
+  /** @return the number of resident hot pages */
+  auto GetNumHotPages() -> size_t;
+
+  /** @return the number of non-resident pages in their test period */
+  auto GetNumNonResidentPages() -> size_t;
+
+ private:
+  static constexpr frame_id_t INVALID_FRAME_ID = -1;
+
+  /** A page on the clock. */
+  struct ClockEntry {
+    page_id_t page_id_;
+    /** Frame of a resident page, INVALID_FRAME_ID for a non-resident one. */
+    frame_id_t frame_id_;
+    bool hot_{false};
+    bool ref_{false};
+    bool test_{false};
+  };
+  using ClockIterator = std::list<ClockEntry>::iterator;
+
+  /** @return the entry after it on the clock */
+  auto Next(ClockIterator it) -> ClockIterator;
+
+  /** Insert an entry at the head of the clock, behind HAND_hot. */
+  auto Insert(const ClockEntry &entry) -> ClockIterator;
+
+  /** Erase an entry, moving the hands that point at it forward. */
+  void Erase(ClockIterator it);
+
+  /** End the test period of a cold page, dropping it if it is not resident. @return true if it was dropped */
+  auto EndTestPeriod(ClockIterator it) -> bool;
+
+  /** Move HAND_hot until it has demoted a hot page. */
+  void RunHandHot();
+
+  /** Move HAND_test until it has dropped a non-resident page. */
+  void RunHandTest();
+
+  /** Turn a resident cold page into a hot one, demoting hot pages beyond the hot target. */
+  void Promote(ClockIterator it);
+
+  std::list<ClockEntry> clock_;
+  ClockIterator hand_hot_;
+  ClockIterator hand_cold_;
+  ClockIterator hand_test_;
+  /** Clock entry of every resident frame. */
+  std::vector<ClockIterator> frame_entries_;
+  std::vector<bool> tracked_;
+  std::vector<bool> evictable_;
+  /** Clock entries of non-resident pages in their test period. */
+  std::unordered_map<page_id_t, ClockIterator> non_resident_;
+  /** Number of frames. */
+  size_t capacity_;
+  /** Target number of resident cold pages, m_c in the paper; at most capacity_ - m_c pages are hot. */
+  size_t cold_target_;
+  size_t min_cold_target_;
+  size_t max_cold_target_;
+  size_t num_hot_{0};
+  size_t num_evictable_cold_{0};
+  size_t curr_size_{0};
+  std::mutex latch_;
+};
+
+}  // namespace bustub
@@ -12,7 +12,6 @@
 
 #pragma once
 
-#include <list>
 #include <mutex>  // NOLINT
 #include <vector>
 
@@ -37,16 +36,38 @@ class ClockReplacer : public Replacer {
    */
   ~ClockReplacer() override;
 
-  auto Victim(frame_id_t *frame_id) -> bool override;
+  auto Evict(frame_id_t *frame_id) -> bool override;
 
-  void Pin(frame_id_t frame_id) override;
+  void RecordAccess(frame_id_t frame_id, page_id_t page_id) override;
 
-  void Unpin(frame_id_t frame_id) override;
+  using Replacer::RecordAccess;
+
+  void SetEvictable(frame_id_t frame_id, bool set_evictable) override;
+
+  void Remove(frame_id_t frame_id) override;
 
   auto Size() -> size_t override;
 
+  /** Classic pin/unpin interface: evict the victim frame. */
+  auto Victim(frame_id_t *frame_id) -> bool;
+
+  /** Classic pin/unpin interface: stop tracking a frame, it cannot be victimized until it is unpinned again. */
+  void Pin(frame_id_t frame_id);
+
+  /** Classic pin/unpin interface: make a frame a victimization candidate with its reference bit set. */
+  void Unpin(frame_id_t frame_id);
+
  private:
-  // TODO(student): implement me!
+  /** Drop a tracked frame. */
+  void Untrack(frame_id_t frame_id);
+
+  /** Per-frame state, the clock hand sweeps frames in frame id order. */
+  std::vector<bool> tracked_;
+  std::vector<bool> evictable_;
+  std::vector<bool> ref_;
+  size_t hand_{0};
+  size_t curr_size_{0};
+  std::mutex latch_;
 };
 
 }  // namespace bustub
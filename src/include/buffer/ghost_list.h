@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// ghost_list.h
+//
+// Identification: src/include/buffer/ghost_list.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <unordered_map>
+
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * GhostList remembers the ids of recently evicted pages, most recent first, so that a replacer can tell a page that
+ * comes back soon after its eviction from a page it has never seen.
+ */
+class GhostList {
+ public:
+  /** @return the number of remembered pages */
+  auto Size() const -> size_t { return pages_.size(); }
+
+  /** @return true if the page is remembered */
+  auto Contains(page_id_t page_id) const -> bool { return index_.count(page_id) > 0; }
+
+  /** Remember a page as the most recently evicted one. */
+  void PushFront(page_id_t page_id) {
+    pages_.push_front(page_id);
+    index_[page_id] = pages_.begin();
+  }
+
+  /** Forget a page. @return true if it was remembered */
+  auto Erase(page_id_t page_id) -> bool {
+    auto it = index_.find(page_id);
+    if (it == index_.end()) {
+      return false;
+    }
+    pages_.erase(it->second);
+    index_.erase(it);
+    return true;
+  }
+
+  /** Forget the least recently evicted page. */
+  void PopBack() {
+    index_.erase(pages_.back());
+    pages_.pop_back();
+  }
+
+ private:
+  std::list<page_id_t> pages_;
+  std::unordered_map<page_id_t, std::list<page_id_t>::iterator> index_;
+};
+
+}  // namespace bustub
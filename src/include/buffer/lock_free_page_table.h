@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// lock_free_page_table.h
+//
+// Identification: src/include/buffer/lock_free_page_table.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * LockFreePageTable maps the ids of the pages resident in a buffer pool to their frames.
+ *
+ * It is a fixed-capacity open-addressing table with linear probing whose slots are single 64-bit atomics holding a
+ * (page id, frame id) pair. Find never blocks and finishes within a bounded number of probes, so it can run
+ * concurrently with anything. Insert and Remove must be serialized by the caller (the buffer pool latch).
+ *
+ * A concurrent Find may miss a page that is being inserted, or find a mapping that is being removed; the caller has to
+ * validate a hit against the frame and retry a miss under its latch. A hit always returns a pair that was inserted
+ * together.
+ */
+class LockFreePageTable {
+ public:
+  /**
+   * Create a new page table.
+   * @param max_entries the maximum number of pages in the table at any time, i.e. the buffer pool size
+   */
+  explicit LockFreePageTable(size_t max_entries);
+
+  DISALLOW_COPY_AND_MOVE(LockFreePageTable);
+
+  /**
+   * Look up the frame of a page. Wait-free.
+   * @param page_id the page to look up
+   * @param[out] frame_id the frame of the page, if found
+   * @return true if the page was found
+   */
+  auto Find(page_id_t page_id, frame_id_t &frame_id) const -> bool;
+
+  /**
+   * Map a page to a frame, replacing its previous mapping if any. Not thread safe with other writers.
+   * @param page_id the page, must be valid
+   * @param frame_id the frame holding the page
+   */
+  void Insert(page_id_t page_id, frame_id_t frame_id);
+
+  /**
+   * Remove the mapping of a page. Not thread safe with other writers.
+   * @param page_id the page to remove
+   * @return true if the page was in the table
+   */
+  auto Remove(page_id_t page_id) -> bool;
+
+  /** @return the number of pages in the table */
+  auto Size() const -> size_t { return size_; }
+
+  /** @return the number of slots of the table */
+  auto GetCapacity() const -> size_t { return capacity_; }
+
+ private:
+  static constexpr uint64_t EMPTY_SLOT = ~static_cast<uint64_t>(0);
+  /** A removed entry: probing continues past it, Insert may reuse it. */
+  static constexpr uint64_t TOMBSTONE_SLOT = EMPTY_SLOT - (static_cast<uint64_t>(1) << 32);
+
+  static auto MakeSlot(page_id_t page_id, frame_id_t frame_id) -> uint64_t {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(page_id)) << 32) | static_cast<uint32_t>(frame_id);
+  }
+  static auto SlotPageId(uint64_t slot) -> page_id_t { return static_cast<page_id_t>(slot >> 32); }
+  static auto SlotFrameId(uint64_t slot) -> frame_id_t { return static_cast<frame_id_t>(slot & 0xFFFFFFFF); }
+
+  /** @return the first slot probed for a page */
+  auto HomeSlot(page_id_t page_id) const -> size_t {
+    // Fibonacci hashing spreads the consecutive page ids a buffer pool usually holds
+    return static_cast<size_t>((static_cast<uint64_t>(static_cast<uint32_t>(page_id)) * 0x9E3779B97F4A7C15ULL) >>
+                               (64 - capacity_bits_));
+  }
+
+  /** Rewrite all live entries to get rid of the tombstones. */
+  void Rebuild();
+
+  size_t capacity_bits_;
+  size_t capacity_;
+  std::unique_ptr<std::atomic<uint64_t>[]> slots_;
+  std::atomic<size_t> size_{0};
+  size_t num_tombstones_{0};
+};
+
+}  // namespace bustub
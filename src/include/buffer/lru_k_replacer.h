@@ -13,11 +13,10 @@
 #pragma once
 
 #include <limits>
-#include <list>
 #include <mutex>  // NOLINT
-#include <unordered_map>
 #include <vector>
 
+#include "buffer/replacer.h"
 #include "common/config.h"
 #include "common/macros.h"
 
@@ -33,13 +32,14 @@ namespace bustub {
  * A frame with less than k historical references is given
  * +inf as its backward k-distance. When multiple frames have +inf backward k-distance,
  * classical LRU algorithm is used to choose victim.
+ *
+ * Every frame owns a preallocated node holding its last k access timestamps in a fixed slice of a
+ * shared ring buffer, and evictable frames are kept in an indexed binary min-heap ordered by eviction
+ * priority. RecordAccess, SetEvictable, Remove and Evict are all O(log n) and never allocate.
  */
-class LRUKReplacer {
+class LRUKReplacer : public Replacer {
  public:
   /**
-   *
-   * TODO(P1): Add implementation
-   *
    * @brief a new LRUKReplacer.
    * @param num_frames the maximum number of frames the LRUReplacer will be required to store
    */
@@ -48,15 +48,11 @@ class LRUKReplacer {
   DISALLOW_COPY_AND_MOVE(LRUKReplacer);
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Destroys the LRUReplacer.
    */
-  ~LRUKReplacer() = default;
+  ~LRUKReplacer() override = default;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Find the frame with largest backward k-distance and evict that frame. Only frames
    * that are marked as 'evictable' are candidates for eviction.
    *
@@ -70,11 +66,9 @@ class LRUKReplacer {
    * @param[out] frame_id id of frame that is evicted.
    * @return true if a frame is evicted successfully, false if no frames can be evicted.
    */
-  auto Evict(frame_id_t *frame_id) -> bool;
+  auto Evict(frame_id_t *frame_id) -> bool override;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Record the event that the given frame id is accessed at current timestamp.
    * Create a new entry for access history if frame id has not been seen before.
    *
@@ -82,12 +76,13 @@ class LRUKReplacer {
    * also use BUSTUB_ASSERT to abort the process if frame id is invalid.
    *
    * @param frame_id id of frame that received a new access.
+   * @param page_id unused, LRU-K only looks at frames
    */
-  void RecordAccess(frame_id_t frame_id);
+  void RecordAccess(frame_id_t frame_id, page_id_t page_id) override;
+
+  using Replacer::RecordAccess;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Toggle whether a frame is evictable or non-evictable. This function also
    * controls replacer's size. Note that size is equal to number of evictable entries.
    *
@@ -102,11 +97,9 @@ class LRUKReplacer {
    * @param frame_id id of frame whose 'evictable' status will be modified
    * @param set_evictable whether the given frame is evictable or not
    */
-  void SetEvictable(frame_id_t frame_id, bool set_evictable);
+  void SetEvictable(frame_id_t frame_id, bool set_evictable) override;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Remove an evictable frame from replacer, along with its access history.
    * This function should also decrement replacer's size if removal is successful.
    *
@@ -121,24 +114,57 @@ class LRUKReplacer {
    *
    * @param frame_id id of frame to be removed
    */
-  void Remove(frame_id_t frame_id);
+  void Remove(frame_id_t frame_id) override;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Return replacer's size, which tracks the number of evictable frames.
    *
    * @return size_t
    */
-  auto Size() -> size_t;
+  auto Size() -> size_t override;
 
  private:
-  // TODO(student): implement me! You can replace these member variables as you like.
-  // Remove maybe_unused if you start using them.
-  [[maybe_unused]] size_t current_timestamp_{0};
-  [[maybe_unused]] size_t curr_size_{0};
-  [[maybe_unused]] size_t replacer_size_;
-  [[maybe_unused]] size_t k_;
+  /** Position of a frame that is not in the eviction heap. */
+  static constexpr size_t INVALID_HEAP_INDEX = std::numeric_limits<size_t>::max();
+
+  /** Intrusive per-frame replacer state, preallocated for every frame. */
+  struct LRUKNode {
+    /** Slot of the oldest retained timestamp in this frame's slice of timestamps_. */
+    size_t history_head_{0};
+    /** Number of retained timestamps, at most k. Zero means the frame is not tracked. */
+    size_t history_size_{0};
+    /** Position of the frame in heap_, or INVALID_HEAP_INDEX if it is not evictable. */
+    size_t heap_index_{INVALID_HEAP_INDEX};
+    bool evictable_{false};
+  };
+
+  /** @return the backward k-distance timestamp of the frame: its k-th most recent access, or its first access. */
+  auto KthTimestamp(frame_id_t frame_id) const -> size_t {
+    return timestamps_[frame_id * k_ + nodes_[frame_id].history_head_];
+  }
+
+  /** @return true if frame a should be evicted before frame b */
+  auto EvictsBefore(frame_id_t a, frame_id_t b) const -> bool;
+
+  /** Drop the access history of a frame. */
+  void ResetNode(frame_id_t frame_id);
+
+  void HeapPush(frame_id_t frame_id);
+  void HeapErase(frame_id_t frame_id);
+  void HeapSiftUp(size_t index);
+  void HeapSiftDown(size_t index);
+  void HeapSwap(size_t a, size_t b);
+
+  /** Node pool, indexed by frame id. */
+  std::vector<LRUKNode> nodes_;
+  /** Ring buffers of the last k access timestamps of every frame; frame f owns [f * k, (f + 1) * k). */
+  std::vector<size_t> timestamps_;
+  /** Min-heap of evictable frames; the root is the next victim. */
+  std::vector<frame_id_t> heap_;
+  size_t current_timestamp_{0};
+  size_t curr_size_{0};
+  size_t replacer_size_;
+  size_t k_;
   std::mutex latch_;
 };
 
@@ -37,16 +37,42 @@ class LRUReplacer : public Replacer {
    */
   ~LRUReplacer() override;
 
-  auto Victim(frame_id_t *frame_id) -> bool override;
+  auto Evict(frame_id_t *frame_id) -> bool override;
 
-  void Pin(frame_id_t frame_id) override;
+  void RecordAccess(frame_id_t frame_id, page_id_t page_id) override;
 
-  void Unpin(frame_id_t frame_id) override;
+  using Replacer::RecordAccess;
+
+  void SetEvictable(frame_id_t frame_id, bool set_evictable) override;
+
+  void Remove(frame_id_t frame_id) override;
 
   auto Size() -> size_t override;
 
+  /** Classic pin/unpin interface: evict the victim frame. */
+  auto Victim(frame_id_t *frame_id) -> bool;
+
+  /** Classic pin/unpin interface: stop tracking a frame, it cannot be victimized until it is unpinned again. */
+  void Pin(frame_id_t frame_id);
+
+  /**
+   * Classic pin/unpin interface: make a frame a victimization candidate, as the most recently used one if it is not
+   * tracked yet.
+   */
+  void Unpin(frame_id_t frame_id);
+
  private:
-  // TODO(student): implement me!
+  /** Drop a tracked frame. */
+  void Untrack(frame_id_t frame_id);
+
+  /** Tracked frames, most recently used first. */
+  std::list<frame_id_t> lru_list_;
+  /** Position of every tracked frame in lru_list_. */
+  std::vector<std::list<frame_id_t>::iterator> positions_;
+  std::vector<bool> tracked_;
+  std::vector<bool> evictable_;
+  size_t curr_size_{0};
+  std::mutex latch_;
 };
 
 }  // namespace bustub
@@ -0,0 +1,70 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// page_access_trace.h
+//
+// Identification: src/include/buffer/page_access_trace.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * PageAccessTrace records the sequence of pages fetched from or created in a buffer pool, so that replacement policies
+ * can be compared offline by replaying it (see tools/trace_replay). Only demand accesses are recorded: read-ahead and
+ * the page cleaner do not show up in a trace.
+ *
+ * A trace is saved as text, one page id per line.
+ */
+class PageAccessTrace {
+ public:
+  /** Append an access to the trace. Thread safe. */
+  void Record(page_id_t page_id) {
+    std::scoped_lock<std::mutex> lock(latch_);
+    page_ids_.push_back(page_id);
+  }
+
+  /** @return a copy of the recorded accesses, oldest first */
+  auto GetPageIds() -> std::vector<page_id_t> {
+    std::scoped_lock<std::mutex> lock(latch_);
+    return page_ids_;
+  }
+
+  /** @return the number of recorded accesses */
+  auto Size() -> size_t {
+    std::scoped_lock<std::mutex> lock(latch_);
+    return page_ids_.size();
+  }
+
+  /**
+   * Write the trace to a file.
+   * @param file_name the file to write, it is overwritten
+   * @return true if the whole trace was written
+   */
+  auto Save(const std::string &file_name) -> bool;
+
+  /**
+   * Read a trace saved with Save().
+   * @param file_name the file to read
+   * @param[out] page_ids the accesses in the trace, oldest first
+   * @return true if the file could be read
+   */
+  static auto Load(const std::string &file_name, std::vector<page_id_t> *page_ids) -> bool;
+
+ private:
+  std::vector<page_id_t> page_ids_;
+  std::mutex latch_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,162 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_buffer_pool_manager.h
+//
+// Identification: src/include/buffer/parallel_buffer_pool_manager.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "buffer/buffer_pool_manager_instance.h"
+#include "recovery/log_manager.h"
+#include "storage/disk/disk_manager.h"
+#include "storage/page/page.h"
+
+namespace bustub {
+
+/**
+ * ParallelBufferPoolManager splits the buffer pool into several BufferPoolManagerInstances. Every instance has its
+ * own latch, page table, replacer and free list, so operations on pages owned by different instances do not contend.
+ *
+ * A page is owned by instance (page_id mod num_instances). Each instance only hands out page ids that map back to
+ * itself, so routing a page id is a single modulo. New pages are allocated round-robin across the instances.
+ */
+class ParallelBufferPoolManager : public BufferPoolManager {
+ public:
+  /**
+   * @brief Creates a new ParallelBufferPoolManager.
+   * @param num_instances the number of individual BufferPoolManagerInstances to store
+   * @param pool_size the pool size of each BufferPoolManagerInstance
+   * @param disk_manager the disk manager
+   * @param replacer_k the lookback constant k for the LRU-K replacer of each instance
+   * @param log_manager the log manager (for testing only: nullptr = disable logging)
+   * @param replacer_policy the replacement policy of each instance
+   */
+  ParallelBufferPoolManager(size_t num_instances, size_t pool_size, DiskManager *disk_manager,
+                            size_t replacer_k = LRUK_REPLACER_K, LogManager *log_manager = nullptr,
+                            ReplacerPolicy replacer_policy = ReplacerPolicy::LRUK);
+
+  /**
+   * @brief Destroys an existing ParallelBufferPoolManager.
+   */
+  ~ParallelBufferPoolManager() override;
+
+  /** @brief Return the total size (number of frames) of all BufferPoolManagerInstances. */
+  auto GetPoolSize() -> size_t override;
+
+  /** @brief Return the number of BufferPoolManagerInstances. */
+  auto GetNumInstances() -> size_t { return instances_.size(); }
+
+  /**
+   * @brief Read ahead the pages [start_page_id, start_page_id + count), every instance reads the pages it owns.
+   * @param start_page_id id of the first page to read ahead
+   * @param count number of consecutive page ids to read ahead
+   */
+  void PrefetchPages(page_id_t start_page_id, size_t count) override;
+
+  /**
+   * @brief Record the accesses of every BufferPoolManagerInstance in the same trace.
+   * @param trace the trace to append to, or nullptr to stop recording
+   */
+  void SetPageAccessTrace(PageAccessTrace *trace) override;
+
+  /**
+   * @brief Start the background page cleaner of every BufferPoolManagerInstance.
+   * @param interval how often each cleaner looks for dirty pages
+   * @param max_pages_per_round the maximum number of pages each instance writes back in one round
+   */
+  void StartPageCleaner(std::chrono::milliseconds interval, size_t max_pages_per_round) override;
+
+  /** @brief Stop the background page cleaner of every BufferPoolManagerInstance. */
+  void StopPageCleaner() override;
+
+  /** @brief Return the number of pages written back by the page cleaners of all instances. */
+  auto GetNumPagesCleaned() -> size_t;
+
+  /** @brief Return the number of dirty evictions avoided by the page cleaners of all instances. */
+  auto GetNumDirtyEvictionsAvoided() -> size_t;
+
+ protected:
+  /**
+   * @param page_id id of page
+   * @return pointer to the BufferPoolManagerInstance responsible for handling given page id
+   */
+  auto GetBufferPoolManager(page_id_t page_id) -> BufferPoolManagerInstance *;
+
+  /**
+   * @brief Fetch the requested page from the responsible BufferPoolManagerInstance.
+   * @param page_id id of page to be fetched
+   * @return the requested page
+   */
+  auto FetchPgImp(page_id_t page_id) -> Page * override;
+
+  /**
+   * @brief Fetch the requested page through a buffer ring from the responsible BufferPoolManagerInstance. The ring
+   * keeps track of the pages of every instance separately.
+   * @param page_id id of page to be fetched
+   * @param ring the buffer ring of the calling operation
+   * @return the requested page
+   */
+  auto FetchPgRingImp(page_id_t page_id, BufferRing *ring) -> Page * override;
+
+  /**
+   * @brief Unpin the target page from the responsible BufferPoolManagerInstance.
+   * @param page_id id of page to be unpinned
+   * @param is_dirty true if the page should be marked as dirty, false otherwise
+   * @return false if the page pin count is <= 0 before this call, true otherwise
+   */
+  auto UnpinPgImp(page_id_t page_id, bool is_dirty) -> bool override;
+
+  /**
+   * @brief Flush the target page to disk through the responsible BufferPoolManagerInstance.
+   * @param page_id id of page to be flushed, cannot be INVALID_PAGE_ID
+   * @return false if the page could not be found in the page table, true otherwise
+   */
+  auto FlushPgImp(page_id_t page_id) -> bool override;
+
+  /**
+   * @brief Create a new page. Instances are tried in round-robin order, starting from the instance after the one
+   * that served the previous call, until one of them has a free or evictable frame.
+   * @param[out] page_id id of created page
+   * @return nullptr if no new pages could be created, otherwise pointer to new page
+   */
+  auto NewPgImp(page_id_t *page_id) -> Page * override;
+
+  /**
+   * @brief Create a new page through a buffer ring, trying the instances in the same order as NewPgImp().
+   * @param[out] page_id id of created page
+   * @param ring the buffer ring of the calling operation
+   * @return nullptr if no new pages could be created, otherwise pointer to new page
+   */
+  auto NewPgRingImp(page_id_t *page_id, BufferRing *ring) -> Page * override;
+
+  /**
+   * @brief Delete a page through the responsible BufferPoolManagerInstance.
+   * @param page_id id of page to be deleted
+   * @return false if the page exists but could not be deleted, true if the page didn't exist or deletion succeeded
+   */
+  auto DeletePgImp(page_id_t page_id) -> bool override;
+
+  /**
+   * @brief Flush all the pages of every BufferPoolManagerInstance to disk.
+   */
+  void FlushAllPgsImp() override;
+
+ private:
+  /** The shards of this buffer pool, instance i owns the page ids equal to i mod num_instances. */
+  std::vector<std::unique_ptr<BufferPoolManagerInstance>> instances_;
+  /** The instance NewPgImp starts probing from. */
+  std::atomic<size_t> next_instance_{0};
+};
+
+}  // namespace bustub
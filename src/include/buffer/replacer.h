@@ -12,12 +12,36 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <string>
+
 #include "common/config.h"
 
 namespace bustub {
 
+/** The replacement policies a buffer pool can be configured with. */
+enum class ReplacerPolicy {
+  /** LRUKReplacer, the default. */
+  LRUK,
+  /** LRUReplacer. */
+  LRU,
+  /** ClockReplacer. */
+  Clock,
+  /** TwoQueueReplacer (2Q). */
+  TwoQueue,
+  /** ARCReplacer (Adaptive Replacement Cache). */
+  ARC,
+  /** ClockProReplacer (CLOCK-Pro). */
+  ClockPro,
+};
+
 /**
  * Replacer is an abstract class that tracks page usage.
+ *
+ * The buffer pool reports every access to a frame with RecordAccess and marks a frame evictable while nobody pins it.
+ * Policies that remember recently evicted pages (2Q, ARC, CLOCK-Pro) identify them by the page id passed to
+ * RecordAccess, since a frame id is reused as soon as its page is evicted.
  */
 class Replacer {
  public:
@@ -25,26 +49,53 @@ class Replacer {
   virtual ~Replacer() = default;
 
   /**
-   * Remove the victim frame as defined by the replacement policy.
-   * @param[out] frame_id id of frame that was removed, nullptr if no victim was found
+   * Remove the victim frame as defined by the replacement policy. Only frames that are marked as 'evictable' are
+   * candidates for eviction.
+   * @param[out] frame_id id of frame that was removed
    * @return true if a victim frame was found, false otherwise
    */
-  virtual auto Victim(frame_id_t *frame_id) -> bool = 0;
+  virtual auto Evict(frame_id_t *frame_id) -> bool = 0;
+
+  /**
+   * Record that the given frame, which holds the given page, was accessed. A frame that is not tracked yet has just
+   * been loaded with the page.
+   * @param frame_id the id of the frame that was accessed
+   * @param page_id the id of the page in the frame, or INVALID_PAGE_ID if it is not known
+   */
+  virtual void RecordAccess(frame_id_t frame_id, page_id_t page_id) = 0;
+
+  /** Record an access to a frame whose page is not known. */
+  void RecordAccess(frame_id_t frame_id) { RecordAccess(frame_id, INVALID_PAGE_ID); }
 
   /**
-   * Pins a frame, indicating that it should not be victimized until it is unpinned.
-   * @param frame_id the id of the frame to pin
+   * Mark a tracked frame as evictable or non-evictable. Untracked frames are left alone.
+   * @param frame_id the id of the frame
+   * @param set_evictable whether the frame can be victimized
    */
-  virtual void Pin(frame_id_t frame_id) = 0;
+  virtual void SetEvictable(frame_id_t frame_id, bool set_evictable) = 0;
 
   /**
-   * Unpins a frame, indicating that it can now be victimized.
-   * @param frame_id the id of the frame to unpin
+   * Stop tracking an evictable frame because its page was deleted. Unlike eviction, the page is not remembered.
+   * @param frame_id the id of the frame to remove
    */
-  virtual void Unpin(frame_id_t frame_id) = 0;
+  virtual void Remove(frame_id_t frame_id) = 0;
 
   /** @return the number of elements in the replacer that can be victimized */
   virtual auto Size() -> size_t = 0;
 };
 
+/**
+ * Create a replacer.
+ * @param policy the replacement policy
+ * @param num_frames the number of frames the replacer tracks
+ * @param k the lookback window of the LRU-K policy, ignored by the others
+ */
+auto MakeReplacer(ReplacerPolicy policy, size_t num_frames, size_t k) -> std::unique_ptr<Replacer>;
+
+/** @return the configuration name of a replacement policy: "lru-k", "lru", "clock", "2q", "arc" or "clock-pro" */
+auto ReplacerPolicyToString(ReplacerPolicy policy) -> std::string;
+
+/** @return the replacement policy with the given configuration name, or std::nullopt if there is none */
+auto ReplacerPolicyFromString(const std::string &name) -> std::optional<ReplacerPolicy>;
+
 }  // namespace bustub
@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// two_queue_replacer.h
+//
+// Identification: src/include/buffer/two_queue_replacer.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "buffer/ghost_list.h"
+#include "buffer/replacer.h"
+#include "common/config.h"
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * TwoQueueReplacer implements the full version of the 2Q replacement policy (Johnson and Shasha, VLDB '94).
+ *
+ * A newly loaded page enters the A1in FIFO queue, where further accesses are treated as correlated and ignored. When
+ * A1in holds more than a quarter of the frames its oldest page is evicted and remembered in the A1out ghost queue,
+ * which keeps the ids of up to half as many pages as there are frames. A page that is loaded again while it is in
+ * A1out has proven to be re-referenced and enters the Am LRU queue; otherwise the least recently used page of Am is
+ * evicted. A queue whose candidates are all pinned yields to the other one.
+ */
+class TwoQueueReplacer : public Replacer {
+ public:
+  /**
+   * Create a new TwoQueueReplacer.
+   * @param num_frames the maximum number of frames the replacer will be required to store
+   */
+  explicit TwoQueueReplacer(size_t num_frames);
+
+  DISALLOW_COPY_AND_MOVE(TwoQueueReplacer);
+
+  ~TwoQueueReplacer() override = default;
+
+  auto Evict(frame_id_t *frame_id) -> bool override;
+
+  void RecordAccess(frame_id_t frame_id, page_id_t page_id) override;
+
+  using Replacer::RecordAccess;
+
+  void SetEvictable(frame_id_t frame_id, bool set_evictable) override;
+
+  void Remove(frame_id_t frame_id) override;
+
+  auto Size() -> size_t override;
+
+ private:
+  /** Resident queue of a tracked frame. */
+  enum class Queue { None, A1In, Am };
+
+  /** @return the oldest evictable frame of a resident queue, or INVALID_FRAME_ID */
+  auto OldestEvictable(const std::list<frame_id_t> &queue) const -> frame_id_t;
+
+  /** Drop a tracked frame. */
+  void Untrack(frame_id_t frame_id);
+
+  static constexpr frame_id_t INVALID_FRAME_ID = -1;
+
+  /** Resident FIFO queue of pages seen once, newest first. */
+  std::list<frame_id_t> a1in_;
+  /** Resident LRU queue of re-referenced pages, most recently used first. */
+  std::list<frame_id_t> am_;
+  /** Ghost queue of pages evicted from A1in. */
+  GhostList a1out_;
+  /** Per-frame state, indexed by frame id. */
+  std::vector<Queue> queue_;
+  std::vector<std::list<frame_id_t>::iterator> positions_;
+  std::vector<page_id_t> page_ids_;
+  std::vector<bool> evictable_;
+  /** Maximum size of A1in before its pages are preferred for eviction. */
+  size_t kin_;
+  /** Maximum number of pages remembered in A1out. */
+  size_t kout_;
+  size_t curr_size_{0};
+  std::mutex latch_;
+};
+
+}  // namespace bustub
@@ -20,6 +20,7 @@
 
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/schema.h"
+#include "common/exception.h"
 #include "container/hash/hash_function.h"
 #include "storage/index/b_plus_tree_index.h"
 #include "storage/index/extendible_hash_table_index.h"
@@ -35,6 +36,9 @@ using table_oid_t = uint32_t;
 using column_oid_t = uint32_t;
 using index_oid_t = uint32_t;
 
+/** The kinds of index the catalog can build. A hash index only answers lookups of a single key. */
+enum class IndexType { BPlusTreeIndex, HashTableIndex };
+
 /**
  * The TableInfo class maintains metadata about a table.
  */
@@ -70,15 +74,17 @@ struct IndexInfo {
    * @param index_oid The unique OID for the index
    * @param table_name The name of the table on which the index is created
    * @param key_size The size of the index key, in bytes
+   * @param index_type The kind of the index
    */
   IndexInfo(Schema key_schema, std::string name, std::unique_ptr<Index> &&index, index_oid_t index_oid,
-            std::string table_name, size_t key_size)
+            std::string table_name, size_t key_size, IndexType index_type = IndexType::BPlusTreeIndex)
       : key_schema_{std::move(key_schema)},
         name_{std::move(name)},
         index_{std::move(index)},
         index_oid_{index_oid},
         table_name_{std::move(table_name)},
-        key_size_{key_size} {}
+        key_size_{key_size},
+        index_type_{index_type} {}
   /** The schema for the index key */
   Schema key_schema_;
   /** The name of the index */
@@ -91,6 +97,8 @@ struct IndexInfo {
   std::string table_name_;
   /** The size of the index key, in bytes */
   const size_t key_size_;
+  /** The kind of the index */
+  const IndexType index_type_;
 };
 
 /**
@@ -194,14 +202,18 @@ class Catalog {
    * @param schema The schema of the table
    * @param key_schema The schema of the key
    * @param key_attrs Key attributes
-   * @param keysize Size of the key
+   * @param keysize Size of an index entry, the key and the included columns
    * @param hash_function The hash function for the index
+   * @param include_attrs The columns stored in every entry along with the key, so that a scan of the index can answer
+   * a query on them without fetching the tuples; only b+ tree indexes can include columns
+   * @param index_type The kind of index to build
    * @return A (non-owning) pointer to the metadata of the new table
    */
   template <class KeyType, class ValueType, class KeyComparator>
   auto CreateIndex(Transaction *txn, const std::string &index_name, const std::string &table_name, const Schema &schema,
                    const Schema &key_schema, const std::vector<uint32_t> &key_attrs, std::size_t keysize,
-                   HashFunction<KeyType> hash_function) -> IndexInfo * {
+                   HashFunction<KeyType> hash_function, const std::vector<uint32_t> &include_attrs = {},
+                   IndexType index_type = IndexType::BPlusTreeIndex) -> IndexInfo * {
     // Reject the creation request for nonexistent table
     if (table_names_.find(table_name) == table_names_.end()) {
       return NULL_INDEX_INFO;
@@ -218,29 +230,44 @@ class Catalog {
     }
 
     // Construct index metdata
-    auto meta = std::make_unique<IndexMetadata>(index_name, table_name, &schema, key_attrs);
-
-    // Construct the index, take ownership of metadata
-    // TODO(Kyle): We should update the API for CreateIndex
-    // to allow specification of the index type itself, not
-    // just the key, value, and comparator types
-
-    // TODO(chi): support both hash index and btree index
-    auto index = std::make_unique<BPlusTreeIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_);
+    auto meta = std::make_unique<IndexMetadata>(index_name, table_name, &schema, key_attrs, include_attrs);
 
-    // Populate the index with all tuples in table heap
+    // Construct the index, take ownership of metadata, and populate it with all tuples in table heap. The scan goes
+    // through a buffer ring so that building the index does not flush the buffer pool.
     auto *table_meta = GetTable(table_name);
     auto *heap = table_meta->table_.get();
-    for (auto tuple = heap->Begin(txn); tuple != heap->End(); ++tuple) {
-      index->InsertEntry(tuple->KeyFromTuple(schema, key_schema, key_attrs), tuple->GetRid(), txn);
+    BufferRing ring;
+    std::unique_ptr<Index> index;
+    if (index_type == IndexType::HashTableIndex) {
+      if (!include_attrs.empty()) {
+        throw NotImplementedException("hash indexes cannot include columns");
+      }
+      index = std::make_unique<ExtendibleHashTableIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_,
+                                                                                            hash_function);
+      for (auto tuple = heap->Begin(txn, &ring); tuple != heap->End(); ++tuple) {
+        index->InsertEntry(tuple->KeyFromTuple(schema, key_schema, key_attrs), tuple->GetRid(), txn);
+      }
+    } else {
+      // The keys are collected and sorted, and the tree is bulk loaded bottom-up instead of descending from the root
+      // once per tuple.
+      auto tree = std::make_unique<BPlusTreeIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_);
+      const Schema &entry_schema = *tree->GetEntrySchema();
+      std::vector<std::pair<KeyType, ValueType>> entries;
+      for (auto tuple = heap->Begin(txn, &ring); tuple != heap->End(); ++tuple) {
+        KeyType key;
+        key.SetFromKey(tuple->KeyFromTuple(schema, entry_schema, tree->GetEntryAttrs()));
+        entries.emplace_back(key, tuple->GetRid());
+      }
+      tree->BulkLoad(&entries, txn);
+      index = std::move(tree);
     }
 
     // Get the next OID for the new index
     const auto index_oid = next_index_oid_.fetch_add(1);
 
     // Construct index information; IndexInfo takes ownership of the Index itself
-    auto index_info =
-        std::make_unique<IndexInfo>(key_schema, index_name, std::move(index), index_oid, table_name, keysize);
+    auto index_info = std::make_unique<IndexInfo>(key_schema, index_name, std::move(index), index_oid, table_name,
+                                                  keysize, index_type);
     auto *tmp = index_info.get();
 
     // Update internal tracking
@@ -298,7 +325,7 @@ class Catalog {
    * @param index_oid The OID of the index for which to query
    * @return A (non-owning) pointer to the metadata for the index
    */
-  auto GetIndex(index_oid_t index_oid) -> IndexInfo * {
+  auto GetIndex(index_oid_t index_oid) const -> IndexInfo * {
     auto index = indexes_.find(index_oid);
     if (index == indexes_.end()) {
       return NULL_INDEX_INFO;
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <chrono>  // NOLINT
 #include <iostream>
 #include <memory>
 #include <optional>
@@ -22,8 +23,11 @@
 #include <utility>
 #include <vector>
 
+#include "buffer/buffer_ring.h"
+#include "buffer/replacer.h"
 #include "catalog/catalog.h"
 #include "common/config.h"
+#include "common/exception.h"
 #include "common/util/string_util.h"
 #include "libfort/lib/fort.hpp"
 #include "type/value.h"
@@ -38,6 +42,7 @@ class LockManager;
 class TransactionManager;
 class LogManager;
 class CheckpointManager;
+class PageAccessTrace;
 class Catalog;
 class ExecutionEngine;
 
@@ -203,6 +208,22 @@ class FortTableWriter : public ResultWriter {
   std::vector<std::string> tables_;
 };
 
+/** Configuration of a BustubInstance. */
+struct BustubInstanceConfig {
+  /** Number of frames of the buffer pool. GenerateTestTable needs more than the default of `config.h`. */
+  size_t buffer_pool_size_{128};
+  /** Number of buffer pool instances the frames are split over. Above one, a ParallelBufferPoolManager shards pages. */
+  size_t buffer_pool_instances_{1};
+  /** Replacement policy of the buffer pool. */
+  ReplacerPolicy replacer_policy_{ReplacerPolicy::LRUK};
+  /** Lookback constant k of the LRU-K replacer. */
+  size_t replacer_k_{LRUK_REPLACER_K};
+  /** If not zero, the page cleaner of the buffer pool looks for dirty pages to write back this often. */
+  std::chrono::milliseconds page_cleaner_interval_{0};
+  /** If not empty, the pages accessed in the buffer pool are recorded and saved to this file on shutdown. */
+  std::string page_trace_file_;
+};
+
 class BustubInstance {
  private:
   /**
@@ -211,9 +232,9 @@ class BustubInstance {
   auto MakeExecutorContext(Transaction *txn) -> std::unique_ptr<ExecutorContext>;
 
  public:
-  explicit BustubInstance(const std::string &db_file_name);
+  explicit BustubInstance(const std::string &db_file_name, const BustubInstanceConfig &config = {});
 
-  BustubInstance();
+  explicit BustubInstance(const BustubInstanceConfig &config = {});
 
   ~BustubInstance();
 
@@ -266,12 +287,75 @@ class BustubInstance {
     return variable == "1" || variable == "true" || variable == "yes";
   }
 
+  /** @return the pages of tuples each executor of a query may hold in memory, `set executor_memory_budget=<pages>` */
+  auto GetExecutorMemoryBudget() -> size_t {
+    auto variable = GetSessionVariable("executor_memory_budget");
+    if (variable.empty()) {
+      return EXEC_MEMORY_BUDGET;
+    }
+    if (variable.find_first_not_of("0123456789") != std::string::npos || std::stoull(variable) == 0) {
+      throw Exception(ExceptionType::INVALID, "executor_memory_budget must be a positive number of pages");
+    }
+    return std::stoull(variable);
+  }
+
+  /** @return whether sorts radix sort their normalized keys in memory, `set enable_radix_sort=true` */
+  auto IsRadixSort() -> bool {
+    auto variable = StringUtil::Lower(GetSessionVariable("enable_radix_sort"));
+    return variable == "1" || variable == "true" || variable == "yes";
+  }
+
+  /** @return the number of threads each sort of a query may sort with, `set sort_parallelism=<threads>` */
+  auto GetSortParallelism() -> size_t {
+    auto variable = GetSessionVariable("sort_parallelism");
+    if (variable.empty()) {
+      return 1;
+    }
+    if (variable.find_first_not_of("0123456789") != std::string::npos || std::stoull(variable) == 0) {
+      throw Exception(ExceptionType::INVALID, "sort_parallelism must be a positive number of threads");
+    }
+    return std::stoull(variable);
+  }
+
+  /**
+   * @return how executors access the pages of large sequential operations, `set buffer_access_strategy=ring` or
+   * `set buffer_access_strategy=normal`
+   */
+  auto GetBufferAccessStrategy() -> BufferAccessStrategy {
+    auto variable = StringUtil::Lower(GetSessionVariable("buffer_access_strategy"));
+    if (variable.empty() || variable == "normal") {
+      return BufferAccessStrategy::Default;
+    }
+    if (variable == "ring") {
+      return BufferAccessStrategy::Ring;
+    }
+    throw Exception(ExceptionType::INVALID, "buffer_access_strategy must be normal or ring");
+  }
+
+  /** @return the number of frames of each buffer ring, `set buffer_ring_size=<frames>` */
+  auto GetBufferRingSize() -> size_t {
+    auto variable = GetSessionVariable("buffer_ring_size");
+    if (variable.empty()) {
+      return BUFFER_RING_SIZE;
+    }
+    if (variable.find_first_not_of("0123456789") != std::string::npos || std::stoull(variable) == 0) {
+      throw Exception(ExceptionType::INVALID, "buffer_ring_size must be a positive number of frames");
+    }
+    return std::stoull(variable);
+  }
+
  private:
   void CmdDisplayTables(ResultWriter &writer);
   void CmdDisplayIndices(ResultWriter &writer);
   void CmdDisplayHelp(ResultWriter &writer);
   void WriteOneCell(const std::string &cell, ResultWriter &writer);
+
+  /** Create the buffer pool and, if the configuration asks for it, start recording its page access trace. */
+  void InitBufferPool(const BustubInstanceConfig &config);
+
   std::unordered_map<std::string, std::string> session_variables_;
+  std::unique_ptr<PageAccessTrace> page_trace_;
+  std::string page_trace_file_;
 };
 
 }  // namespace bustub
@@ -27,15 +27,26 @@ extern std::atomic<bool> enable_logging;
 /** If ENABLE_LOGGING is true, the log should be flushed to disk every LOG_TIMEOUT. */
 extern std::chrono::duration<int64_t> log_timeout;
 
+/** The default interval at which the page cleaner of a buffer pool looks for dirty pages. */
+extern std::chrono::milliseconds page_cleaner_interval;
+
 static constexpr int INVALID_PAGE_ID = -1;                                           // invalid page id
 static constexpr int INVALID_TXN_ID = -1;                                            // invalid transaction id
 static constexpr int INVALID_LSN = -1;                                               // invalid log sequence number
 static constexpr int HEADER_PAGE_ID = 0;                                             // the header page id
 static constexpr int BUSTUB_PAGE_SIZE = 4096;                                        // size of a data page in byte
+static constexpr int BUSTUB_PAGE_ALIGNMENT = 4096;                                   // alignment of page buffers
 static constexpr int BUFFER_POOL_SIZE = 10;                                          // size of buffer pool
 static constexpr int LOG_BUFFER_SIZE = ((BUFFER_POOL_SIZE + 1) * BUSTUB_PAGE_SIZE);  // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                               // size of extendible hash bucket
 static constexpr int LRUK_REPLACER_K = 10;  // lookback window for lru-k replacer
+static constexpr int PAGE_CLEANER_BATCH_SIZE = 16;  // max pages written by one page cleaner round
+static constexpr int READ_AHEAD_MIN_PAGES = 4;      // initial read-ahead window of a sequential scan
+static constexpr int READ_AHEAD_MAX_PAGES = 64;     // largest read-ahead window of a sequential scan
+static constexpr int BUFFER_RING_SIZE = 16;         // frames recycled by a scan-resistant buffer ring
+static constexpr double INDEX_FILL_FACTOR = 0.9;    // fraction of each page filled by a b+ tree bulk load
+static constexpr int POSTING_LIST_INLINE_SIZE = 2;  // values of a b+ tree key kept in its leaf entry
+static constexpr int EXEC_MEMORY_BUDGET = 4096;     // pages of tuples an executor holds before spilling
 
 using frame_id_t = int32_t;    // frame id type
 using page_id_t = int32_t;     // page id type
@@ -30,6 +30,18 @@ namespace bustub {
  * Implementation of extendible hash table that is backed by a buffer pool
  * manager. Non-unique keys are supported. Supports insert and delete. The
  * table grows/shrinks dynamically as buckets become full/empty.
+ *
+ * Every operation holds the table latch shared, and latches only the bucket page of its key, which it finds in the
+ * directory without latching it: a bucket only moves out of a directory slot while the bucket is write latched, so a
+ * thread that latches the bucket of a slot and finds the slot unchanged has the right bucket. A split or merge write
+ * latches the buckets involved and rewrites their slots in place. Doubling or halving the directory is the only
+ * operation that takes the table latch exclusively.
+ *
+ * The table keeps the directory page pinned, so that no operation goes through the buffer pool to read it.
+ *
+ * A full bucket whose pairs all hash alike, such as the values of a single key that outgrow one page, cannot be split
+ * apart; neither can any full bucket once the directory is as large as it can be. Such a bucket links overflow pages
+ * instead. The latch of the bucket page covers the overflow pages of its chain, which nothing reaches but through it.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class DiskExtendibleHashTable {
@@ -122,7 +134,7 @@ class DiskExtendibleHashTable {
   auto KeyToPageId(KeyType key, HashTableDirectoryPage *dir_page) -> page_id_t;
 
   /**
-   * Fetches the directory page from the buffer pool manager.
+   * Fetches the directory page from the buffer pool manager, with a pin of its own.
    *
    * @return a pointer to the directory page
    */
@@ -137,12 +149,68 @@ class DiskExtendibleHashTable {
   auto FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BUCKET_TYPE *;
 
   /**
-   * Performs insertion with an optional bucket splitting.
+   * Fetches and latches the bucket page of a key. The caller must hold the table latch.
+   *
+   * @param key the key for lookup
+   * @param exclusive whether to write latch the page instead of read latching it
+   * @return the pinned and latched bucket page
+   */
+  auto LatchBucketPage(const KeyType &key, bool exclusive) -> Page *;
+
+  /**
+   * Doubles the directory, unless another thread already grew it past global_depth or it is as large as it can be.
+   *
+   * @param global_depth the global depth at which the caller found a full bucket that could not split
+   */
+  void GrowDirectory(uint32_t global_depth);
+
+  /**
+   * Calls visit on a bucket page and then on each overflow page of its chain, until visit returns true. The caller
+   * must hold the latch of the bucket page.
+   *
+   * @param bucket the bucket page, pinned by the caller
+   * @param dirty whether visit may modify the overflow pages
+   * @param visit called with each page of the chain
+   * @return true if visit returned true for some page
+   */
+  template <typename Visit>
+  auto VisitChain(HASH_TABLE_BUCKET_TYPE *bucket, bool dirty, Visit &&visit) -> bool;
+
+  /**
+   * @return whether a page of the chain of the bucket holds the pair
+   */
+  auto ChainContains(HASH_TABLE_BUCKET_TYPE *bucket, const KeyType &key, const ValueType &value) -> bool;
+
+  /**
+   * Inserts a pair that is not in the chain of a bucket into the first page of the chain with room.
+   *
+   * @param bucket the bucket page, write latched by the caller
+   * @param grow whether to link a new overflow page if no page of the chain has room
+   * @return false if the chain is full and grow is false
+   */
+  auto AppendToChain(HASH_TABLE_BUCKET_TYPE *bucket, const KeyType &key, const ValueType &value, bool grow) -> bool;
+
+  /**
+   * Unlinks and deletes the empty overflow pages of the chain of a bucket.
+   *
+   * @param bucket the bucket page, write latched by the caller
+   */
+  void PruneChain(HASH_TABLE_BUCKET_TYPE *bucket);
+
+  /**
+   * @return whether the bucket page holds no pair and has no overflow pages
+   */
+  auto IsChainEmpty(HASH_TABLE_BUCKET_TYPE *bucket) -> bool;
+
+  /**
+   * Performs insertion with an optional bucket splitting. Splits the bucket of the key, doubling the directory first
+   * if the bucket's local depth is the global depth, until the bucket has room for the key. A bucket that cannot be
+   * split apart links an overflow page for the key instead.
    *
    * @param transaction a pointer to the current transaction
    * @param key the key to insert
    * @param value the value to insert
-   * @return whether or not the insertion was successful
+   * @return whether or not the insertion was successful; false for a duplicate pair
    */
   auto SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool;
 
@@ -163,10 +231,11 @@ class DiskExtendibleHashTable {
 
   // member variables
   page_id_t directory_page_id_;
+  HashTableDirectoryPage *directory_;
   BufferPoolManager *buffer_pool_manager_;
   KeyComparator comparator_;
 
-  // Readers includes inserts and removes, writers are splits and merges
+  // Readers include inserts, removes, splits and merges; writers double or halve the directory
   ReaderWriterLatch table_latch_;
   HashFunction<KeyType> hash_fn_;
 };
@@ -12,8 +12,10 @@
 
 #pragma once
 
+#include <mutex>  // NOLINT
 #include <queue>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
@@ -30,6 +32,19 @@ namespace bustub {
  * Implementation of linear probing hash table that is backed by a buffer pool
  * manager. Non-unique keys are supported. Supports insert and delete. The
  * table dynamically grows once full.
+ *
+ * The slots of the table are spread over block pages, which the header page lists. Once three quarters of the slots
+ * are occupied, by pairs or by tombstones, the table starts to migrate to a new table with twice the block pages, or
+ * with as many if most of them are tombstones. Inserts, removes and lookups each migrate a few slots of the old table
+ * in order, leaving tombstones behind so that the probe sequences through them stay intact, and the new table takes
+ * all inserts; there is never a rehash of the whole table at once. Tombstones are not migrated, so the new table
+ * starts without any.
+ *
+ * Without a migration in progress, inserts, removes and lookups run concurrently under the read latch of the table:
+ * they claim and clear slots with atomic operations on the block pages, and an insert reserves its slot in the count
+ * of occupied slots before it looks for one. Inserts of keys that hash alike also take the same one of a few insert
+ * latches, so that a slot another insert has claimed but not yet filled never holds the pair being inserted. While the
+ * table migrates, they take the write latch.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class LinearProbeHashTable {
@@ -73,24 +88,56 @@ class LinearProbeHashTable {
   auto GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool;
 
   /**
-   * Resizes the table to at least twice the initial size provided.
+   * Resizes the table to at least twice the initial size provided. The table migrates to the new size incrementally,
+   * like when it grows by itself, and keeps its size if the pairs would not fit.
    * @param initial_size the initial size of the hash table
    */
   void Resize(size_t initial_size);
 
   /**
    * Gets the size of the hash table
-   * @return current size of the hash table
+   * @return current size of the hash table, in slots, which is that of the new table while the table grows
    */
   auto GetSize() -> size_t;
 
  private:
-  auto GetHeaderPage() -> HashTableHeaderPage *;
-  auto GetBlockPage(page_id_t block_page_id) -> HASH_TABLE_BLOCK_TYPE *;
-  void ResizeInsert(HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value);
-  void DeleteBlockPages(HashTableHeaderPage *old_header_page);
-  void CreateNewBlockPages(HashTableHeaderPage *header_page, size_t num_blocks);
-  auto GetValueLatchFree(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool;
+  /** The number of slots of the old table that every operation migrates while the table grows. */
+  static constexpr size_t MIGRATE_SLOTS_PER_OP = 16;
+  /** The number of insert latches that inserts under the read latch of the table take by the hash of their key. */
+  static constexpr size_t INSERT_LATCH_STRIPES = 64;
+
+  auto Hash(const KeyType &key) -> uint64_t;
+  auto GetHeaderPage(page_id_t header_page_id) -> std::pair<Page *, HashTableHeaderPage *>;
+
+  /**
+   * Call visit(block, offset) on the slots of the probe sequence of key, from its home slot, until it returns true or
+   * every slot of the table has been visited. The block page of the slot visit stops at is unpinned dirty if dirty is
+   * set.
+   */
+  template <typename Visit>
+  void Probe(HashTableHeaderPage *header_page, const KeyType &key, bool dirty, Visit &&visit);
+
+  auto GetValueFrom(HashTableHeaderPage *header_page, const KeyType &key, std::vector<ValueType> *result) -> bool;
+  auto Contains(HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value) -> bool;
+  /** Insert into a table with a slot reserved for the pair. @return false if the pair is already there */
+  auto InsertInto(HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value) -> bool;
+  auto RemoveFrom(HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value) -> bool;
+
+  /** @return the page ID of the header page of a new, empty table of num_blocks block pages */
+  auto CreateNewBlockPages(size_t num_blocks) -> page_id_t;
+  void DeleteBlockPages(Page *old_header_page);
+
+  /**
+   * Start to migrate the table to a new one of num_blocks block pages. Requires the write latch.
+   * @return false if the pairs of the table would not fit in the new one
+   */
+  auto BeginResize(HashTableHeaderPage *header_page, size_t num_blocks) -> bool;
+
+  /**
+   * Migrate up to count slots of the old table to the new one, if the table is growing, and switch to the new table
+   * once all are. Requires the write latch.
+   */
+  void MigrateSlots(size_t count);
 
   // member variable
   page_id_t header_page_id_;
@@ -99,6 +146,8 @@ class LinearProbeHashTable {
 
   // Readers includes inserts and removes, writer is only resize
   ReaderWriterLatch table_latch_;
+  // Serialize the inserts of a key under the read latch, so that no two of them insert the same pair
+  std::mutex insert_latches_[INSERT_LATCH_STRIPES];
 
   // Hash function
   HashFunction<KeyType> hash_fn_;
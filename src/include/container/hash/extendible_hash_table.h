@@ -36,9 +36,6 @@ template <typename K, typename V>
 class ExtendibleHashTable : public HashTable<K, V> {
  public:
   /**
-   *
-   * TODO(P1): Add implementation
-   *
    * @brief Create a new ExtendibleHashTable.
    * @param bucket_size: fixed size for each bucket
    */
@@ -64,9 +61,6 @@ class ExtendibleHashTable : public HashTable<K, V> {
   auto GetNumBuckets() const -> int;
 
   /**
-   *
-   * TODO(P1): Add implementation
-   *
    * @brief Find the value associated with the given key.
    *
    * Use IndexOf(key) to find the directory index the key hashes to.
@@ -78,9 +72,6 @@ class ExtendibleHashTable : public HashTable<K, V> {
   auto Find(const K &key, V &value) -> bool override;
 
   /**
-   *
-   * TODO(P1): Add implementation
-   *
    * @brief Insert the given key-value pair into the hash table.
    * If a key already exists, the value should be updated.
    * If the bucket is full and can't be inserted, do the following steps before retrying:
@@ -95,9 +86,6 @@ class ExtendibleHashTable : public HashTable<K, V> {
   void Insert(const K &key, const V &value) override;
 
   /**
-   *
-   * TODO(P1): Add implementation
-   *
    * @brief Given the key, remove the corresponding key-value pair in the hash table.
    * Shrink & Combination is not required for this project
    * @param key The key to be deleted.
@@ -124,9 +112,6 @@ class ExtendibleHashTable : public HashTable<K, V> {
     inline auto GetItems() -> std::list<std::pair<K, V>> & { return list_; }
 
     /**
-     *
-     * TODO(P1): Add implementation
-     *
      * @brief Find the value associated with the given key in the bucket.
      * @param key The key to be searched.
      * @param[out] value The value associated with the key.
@@ -135,9 +120,6 @@ class ExtendibleHashTable : public HashTable<K, V> {
     auto Find(const K &key, V &value) -> bool;
 
     /**
-     *
-     * TODO(P1): Add implementation
-     *
      * @brief Given the key, remove the corresponding key-value pair in the bucket.
      * @param key The key to be deleted.
      * @return True if the key exists, false otherwise.
@@ -145,9 +127,6 @@ class ExtendibleHashTable : public HashTable<K, V> {
     auto Remove(const K &key) -> bool;
 
     /**
-     *
-     * TODO(P1): Add implementation
-     *
      * @brief Insert the given key-value pair into the bucket.
      *      1. If a key already exists, the value should be updated.
      *      2. If the bucket is full, do nothing and return false.
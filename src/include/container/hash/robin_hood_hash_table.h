@@ -0,0 +1,125 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// robin_hood_hash_table.h
+//
+// Identification: src/include/container/hash/robin_hood_hash_table.h
+//
+//===----------------------------------------------------------------------===//
+/**
+ * robin_hood_hash_table.h
+ *
+ * In-memory open-addressing hash table for the hash joins and aggregations of the executors
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * RobinHoodHashTable maps keys of a fixed number of values to entries that hold a fixed number of payload values,
+ * such as the running aggregates of a group, or the columns of a tuple to join with.
+ *
+ * The keys and the payloads of all entries live in two flat arrays of values, in the order the entries were inserted,
+ * and entries are named by their position in them. The slots of the table only hold the hash of the key of an entry
+ * along with the position of the entry, eight bytes in all, so probes walk a compact array and compare keys only when
+ * the hashes match. The hashes are also what the table rehashes with when it grows, without touching the keys.
+ *
+ * Collisions are resolved by linear probing with Robin Hood insertion: an entry takes over the slot of one that is
+ * closer to its home slot, so the distances from home stay short and even, and a probe can stop as soon as it reaches
+ * an entry closer to home than itself would be. The table keeps at most 7/8 of its slots in use.
+ *
+ * A key can have several entries, for the build side of a hash join. Only the first entry of a key has a slot; the
+ * others are chained to it, in the order they were inserted.
+ *
+ * NULL keys are equal to each other, so that they make one group; hash joins must skip them themselves.
+ */
+class RobinHoodHashTable {
+ public:
+  /** The position of no entry. */
+  static constexpr size_t NO_ENTRY = std::numeric_limits<size_t>::max();
+
+  /**
+   * Create a new, empty table.
+   * @param key_width the number of values of every key
+   * @param payload_width the number of payload values of every entry
+   */
+  RobinHoodHashTable(size_t key_width, size_t payload_width);
+
+  /**
+   * Find the entry of a key, or insert one with unset payload values, for the caller to set, if there is none.
+   * @return the position of the entry, and whether it was inserted
+   */
+  auto FindOrInsert(const std::vector<Value> &key) -> std::pair<size_t, bool>;
+
+  /**
+   * Insert an entry for a key, after all the entries of an equal key.
+   * @return the position of the entry, whose payload values are unset
+   */
+  auto Insert(const std::vector<Value> &key) -> size_t;
+
+  /** @return the position of the first entry of a key, or NO_ENTRY */
+  auto Find(const std::vector<Value> &key) const -> size_t;
+
+  /** @return the position of the entry after entry with the same key, or NO_ENTRY */
+  auto NextDuplicate(size_t entry) const -> size_t { return next_[entry]; }
+
+  /** @return the key values of an entry; the pointer is good until the next insert */
+  auto KeyAt(size_t entry) const -> const Value * { return keys_.data() + entry * key_width_; }
+
+  /** @return the payload values of an entry; the pointer is good until the next insert */
+  auto PayloadAt(size_t entry) -> Value * { return payloads_.data() + entry * payload_width_; }
+
+  /** @return the number of entries, which are at positions 0 to Size() - 1 */
+  auto Size() const -> size_t { return next_.size(); }
+
+  /** Remove every entry. */
+  void Clear();
+
+ private:
+  struct Slot {
+    /** The hash of the key of the entry. */
+    uint32_t hash_;
+    /** The position of the entry plus one, or 0 if the slot is empty. */
+    uint32_t entry_;
+  };
+
+  auto Hash(const std::vector<Value> &key) const -> uint32_t;
+  auto KeyEquals(size_t entry, const std::vector<Value> &key) const -> bool;
+
+  /** @return the first entry of the key with the hash, or NO_ENTRY */
+  auto FindEntry(const std::vector<Value> &key, uint32_t hash) const -> size_t;
+
+  /** Append an entry for a key with unset payload values. */
+  auto AppendEntry(const std::vector<Value> &key) -> size_t;
+
+  /** Put the first entry of a key with the hash into the slots, growing them first if they are too full. */
+  void PlaceEntry(uint32_t hash, size_t entry);
+
+  void Grow();
+
+  const size_t key_width_;
+  const size_t payload_width_;
+  /** The slots, whose number is a power of two. */
+  std::vector<Slot> slots_;
+  size_t mask_{0};
+  /** The number of slots in use. */
+  size_t used_{0};
+
+  /** The keys and the payloads of the entries, key_width_ and payload_width_ values apiece. */
+  std::vector<Value> keys_;
+  std::vector<Value> payloads_;
+  /** The next entry of the same key, and for the first entry of a key, the last one. */
+  std::vector<size_t> next_;
+  std::vector<size_t> last_;
+};
+
+}  // namespace bustub
@@ -12,10 +12,12 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "buffer/buffer_ring.h"
 #include "catalog/catalog.h"
 #include "concurrency/transaction.h"
 #include "storage/page/tmp_tuple_page.h"
@@ -60,6 +62,54 @@ class ExecutorContext {
   /** @return the transaction manager */
   auto GetTransactionManager() -> TransactionManager * { return txn_mgr_; }
 
+  /**
+   * Select how the executors of this context access the pages of large sequential operations (sequential scans, bulk
+   * inserts).
+   * @param strategy BufferAccessStrategy::Ring to give each such executor a private BufferRing
+   * @param ring_size the number of frames in each ring
+   */
+  void SetBufferAccessStrategy(BufferAccessStrategy strategy, size_t ring_size = BUFFER_RING_SIZE) {
+    buffer_access_strategy_ = strategy;
+    buffer_ring_size_ = ring_size;
+  }
+
+  /** @return the buffer access strategy of large sequential operations */
+  auto GetBufferAccessStrategy() const -> BufferAccessStrategy { return buffer_access_strategy_; }
+
+  /**
+   * Called by an executor that is about to run a large sequential operation.
+   * @return a new buffer ring for the executor, or nullptr if the operation goes through the buffer pool like any
+   * other access
+   */
+  auto MakeBufferRing() const -> std::unique_ptr<BufferRing> {
+    if (buffer_access_strategy_ != BufferAccessStrategy::Ring) {
+      return nullptr;
+    }
+    return std::make_unique<BufferRing>(buffer_ring_size_);
+  }
+
+  /**
+   * Set how much memory each executor of this context may use for the tuples it holds, such as the build side of a
+   * hash join, before it spills them to temporary pages.
+   * @param pages the budget in pages
+   */
+  void SetMemoryBudget(size_t pages) { memory_budget_ = pages; }
+
+  /** @return the memory budget of each executor in pages */
+  auto GetMemoryBudget() const -> size_t { return memory_budget_; }
+
+  /** Set whether sorts sort their normalized keys in memory with a radix sort, instead of comparing them. */
+  void SetRadixSort(bool radix_sort) { radix_sort_ = radix_sort; }
+
+  /** @return whether sorts sort their normalized keys in memory with a radix sort */
+  auto IsRadixSort() const -> bool { return radix_sort_; }
+
+  /** Set the number of threads sorts may sort with. */
+  void SetSortParallelism(size_t threads) { sort_parallelism_ = threads; }
+
+  /** @return the number of threads sorts may sort with */
+  auto GetSortParallelism() const -> size_t { return sort_parallelism_; }
+
  private:
   /** The transaction context associated with this executor context */
   Transaction *transaction_;
@@ -71,6 +121,16 @@ class ExecutorContext {
   TransactionManager *txn_mgr_;
   /** The lock manager associated with this executor context */
   LockManager *lock_mgr_;
+  /** How executors access the pages of large sequential operations */
+  BufferAccessStrategy buffer_access_strategy_{BufferAccessStrategy::Default};
+  /** The number of frames of the buffer rings handed out to executors */
+  size_t buffer_ring_size_{BUFFER_RING_SIZE};
+  /** The pages of tuples each executor may hold in memory */
+  size_t memory_budget_{EXEC_MEMORY_BUDGET};
+  /** Whether sorts radix sort their normalized keys */
+  bool radix_sort_{false};
+  /** The number of threads of each sort */
+  size_t sort_parallelism_{1};
 };
 
 }  // namespace bustub
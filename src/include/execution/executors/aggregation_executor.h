@@ -13,23 +13,26 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "common/util/hash_util.h"
 #include "container/hash/hash_function.h"
+#include "container/hash/robin_hood_hash_table.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/aggregation_plan.h"
+#include "storage/table/spill_partitions.h"
 #include "storage/table/tuple.h"
 #include "type/value_factory.h"
 
 namespace bustub {
 
 /**
- * A simplified hash table that has all the necessary functionality for aggregations.
+ * A simplified hash table that has all the necessary functionality for aggregations. The groups and their running
+ * aggregates are kept in a RobinHoodHashTable, which stores them in flat arrays of values, so that adding a tuple to
+ * its group allocates nothing.
  */
 class SimpleAggregationHashTable {
  public:
@@ -37,10 +40,14 @@ class SimpleAggregationHashTable {
    * Construct a new SimpleAggregationHashTable instance.
    * @param agg_exprs the aggregation expressions
    * @param agg_types the types of aggregations
+   * @param num_group_bys the number of group-by values of every key
    */
   SimpleAggregationHashTable(const std::vector<AbstractExpressionRef> &agg_exprs,
-                             const std::vector<AggregationType> &agg_types)
-      : agg_exprs_{agg_exprs}, agg_types_{agg_types} {}
+                             const std::vector<AggregationType> &agg_types, size_t num_group_bys)
+      : ht_{num_group_bys, agg_types.size()},
+        num_group_bys_{num_group_bys},
+        agg_exprs_{agg_exprs},
+        agg_types_{agg_types} {}
 
   /** @return The initial aggregrate value for this aggregation executor */
   auto GenerateInitialAggregateValue() -> AggregateValue {
@@ -64,20 +71,64 @@ class SimpleAggregationHashTable {
   }
 
   /**
-   * TODO(Student)
-   *
    * Combines the input into the aggregation result.
-   * @param[out] result The output aggregate value
+   * @param[out] result The running aggregates, one for each aggregation
    * @param input The input value
    */
-  void CombineAggregateValues(AggregateValue *result, const AggregateValue &input) {
+  void CombineAggregateValues(Value *result, const AggregateValue &input) {
     for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
+      const Value &value = input.aggregates_[i];
+      switch (agg_types_[i]) {
+        case AggregationType::CountStarAggregate:
+          result[i] = result[i].Add(ValueFactory::GetIntegerValue(1));
+          break;
+        case AggregationType::CountAggregate:
+          if (!value.IsNull()) {
+            result[i] = result[i].IsNull() ? ValueFactory::GetIntegerValue(1)
+                                           : result[i].Add(ValueFactory::GetIntegerValue(1));
+          }
+          break;
+        case AggregationType::SumAggregate:
+          if (!value.IsNull()) {
+            result[i] = result[i].IsNull() ? value : result[i].Add(value);
+          }
+          break;
+        case AggregationType::MinAggregate:
+          if (!value.IsNull()) {
+            result[i] = result[i].IsNull() ? value : result[i].Min(value);
+          }
+          break;
+        case AggregationType::MaxAggregate:
+          if (!value.IsNull()) {
+            result[i] = result[i].IsNull() ? value : result[i].Max(value);
+          }
+          break;
+      }
+    }
+  }
+
+  /**
+   * Combines the running aggregates of part of the input into the aggregation result.
+   * @param[out] result The running aggregates, one for each aggregation
+   * @param partial The running aggregates of the part of the input
+   */
+  void MergeAggregateValues(Value *result, const AggregateValue &partial) {
+    for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
+      const Value &value = partial.aggregates_[i];
+      if (value.IsNull()) {
+        continue;
+      }
       switch (agg_types_[i]) {
         case AggregationType::CountStarAggregate:
         case AggregationType::CountAggregate:
         case AggregationType::SumAggregate:
+          result[i] = result[i].IsNull() ? value : result[i].Add(value);
+          break;
         case AggregationType::MinAggregate:
+          result[i] = result[i].IsNull() ? value : result[i].Min(value);
+          break;
         case AggregationType::MaxAggregate:
+          result[i] = result[i].IsNull() ? value : result[i].Max(value);
           break;
       }
     }
@@ -87,57 +138,95 @@ class SimpleAggregationHashTable {
    * Inserts a value into the hash table and then combines it with the current aggregation.
    * @param agg_key the key to be inserted
    * @param agg_val the value to be inserted
+   * @return `true` if the key is that of a new group
    */
-  void InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) {
-    if (ht_.count(agg_key) == 0) {
-      ht_.insert({agg_key, GenerateInitialAggregateValue()});
-    }
-    CombineAggregateValues(&ht_[agg_key], agg_val);
+  auto InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) -> bool {
+    auto [aggregates, inserted] = FindOrInsertGroup(agg_key);
+    CombineAggregateValues(aggregates, agg_val);
+    return inserted;
+  }
+
+  /**
+   * Inserts the running aggregates of a group over part of the input, and merges them with the current aggregation.
+   * @param agg_key the key of the group
+   * @param partial the running aggregates of the group over the part of the input
+   * @return `true` if the key is that of a new group
+   */
+  auto InsertMerge(const AggregateKey &agg_key, const AggregateValue &partial) -> bool {
+    auto [aggregates, inserted] = FindOrInsertGroup(agg_key);
+    MergeAggregateValues(aggregates, partial);
+    return inserted;
   }
 
   /**
    * Clear the hash table
    */
-  void Clear() { ht_.clear(); }
+  void Clear() { ht_.Clear(); }
+
+  /** @return The number of groups in the hash table */
+  auto Size() const -> size_t { return ht_.Size(); }
 
-  /** An iterator over the aggregation hash table */
+  /** An iterator over the aggregation hash table, in the order the groups were inserted */
   class Iterator {
    public:
     /** Creates an iterator for the aggregate map. */
-    explicit Iterator(std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter) : iter_{iter} {}
+    Iterator(RobinHoodHashTable *ht, size_t entry, size_t num_group_bys, size_t num_aggregates)
+        : ht_{ht}, entry_{entry}, num_group_bys_{num_group_bys}, num_aggregates_{num_aggregates} {}
 
     /** @return The key of the iterator */
-    auto Key() -> const AggregateKey & { return iter_->first; }
+    auto Key() -> AggregateKey {
+      const Value *group_bys = ht_->KeyAt(entry_);
+      return {std::vector<Value>(group_bys, group_bys + num_group_bys_)};
+    }
 
     /** @return The value of the iterator */
-    auto Val() -> const AggregateValue & { return iter_->second; }
+    auto Val() -> AggregateValue {
+      const Value *aggregates = ht_->PayloadAt(entry_);
+      return {std::vector<Value>(aggregates, aggregates + num_aggregates_)};
+    }
 
     /** @return The iterator before it is incremented */
     auto operator++() -> Iterator & {
-      ++iter_;
+      ++entry_;
       return *this;
     }
 
     /** @return `true` if both iterators are identical */
-    auto operator==(const Iterator &other) -> bool { return this->iter_ == other.iter_; }
+    auto operator==(const Iterator &other) -> bool { return this->entry_ == other.entry_; }
 
     /** @return `true` if both iterators are different */
-    auto operator!=(const Iterator &other) -> bool { return this->iter_ != other.iter_; }
+    auto operator!=(const Iterator &other) -> bool { return this->entry_ != other.entry_; }
 
    private:
     /** Aggregates map */
-    std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter_;
+    RobinHoodHashTable *ht_;
+    /** The position of the group in the map */
+    size_t entry_;
+    size_t num_group_bys_;
+    size_t num_aggregates_;
   };
 
   /** @return Iterator to the start of the hash table */
-  auto Begin() -> Iterator { return Iterator{ht_.cbegin()}; }
+  auto Begin() -> Iterator { return Iterator{&ht_, 0, num_group_bys_, agg_types_.size()}; }
 
   /** @return Iterator to the end of the hash table */
-  auto End() -> Iterator { return Iterator{ht_.cend()}; }
+  auto End() -> Iterator { return Iterator{&ht_, ht_.Size(), num_group_bys_, agg_types_.size()}; }
 
  private:
-  /** The hash table is just a map from aggregate keys to aggregate values */
-  std::unordered_map<AggregateKey, AggregateValue> ht_{};
+  /** @return the running aggregates of the group of a key, initial if the group is new, and whether it is */
+  auto FindOrInsertGroup(const AggregateKey &agg_key) -> std::pair<Value *, bool> {
+    auto [entry, inserted] = ht_.FindOrInsert(agg_key.group_bys_);
+    Value *aggregates = ht_.PayloadAt(entry);
+    if (inserted) {
+      auto initial = GenerateInitialAggregateValue();
+      std::move(initial.aggregates_.begin(), initial.aggregates_.end(), aggregates);
+    }
+    return {aggregates, inserted};
+  }
+
+  /** The hash table maps the group-by values of a group to its running aggregates */
+  RobinHoodHashTable ht_;
+  size_t num_group_bys_;
   /** The aggregate expressions that we have */
   const std::vector<AbstractExpressionRef> &agg_exprs_;
   /** The types of aggregations that we have */
@@ -147,6 +236,11 @@ class SimpleAggregationHashTable {
 /**
  * AggregationExecutor executes an aggregation operation (e.g. COUNT, SUM, MIN, MAX)
  * over the tuples produced by a child executor.
+ *
+ * If the groups outgrow the memory budget of the executor context, the running aggregates of the groups so far are
+ * hashed by their keys into SpillPartitions, as tuples of the output schema, and the table starts over. Once the child
+ * runs out, the partial aggregates of each partition are merged into the groups of the partition one partition at a
+ * time. A partition whose groups still outgrow the budget is partitioned again.
  */
 class AggregationExecutor : public AbstractExecutor {
  public:
@@ -177,22 +271,32 @@ class AggregationExecutor : public AbstractExecutor {
   auto GetChildExecutor() const -> const AbstractExecutor *;
 
  private:
-  /** @return The tuple as an AggregateKey */
-  auto MakeAggregateKey(const Tuple *tuple) -> AggregateKey {
-    std::vector<Value> keys;
+  /** @return the bytes a group of a key takes, about as much as in the pages it would spill to */
+  auto GroupSize(const AggregateKey &key) const -> size_t;
+
+  /** Write the groups of the table into partitions at depth, made first if parts is empty, and clear the table. */
+  void SpillTable(std::vector<SpillPartitions::Partition> *parts, size_t depth);
+
+  /** Finish writing the partitions, and add those that have groups to the pending ones. */
+  void AddPending(std::vector<SpillPartitions::Partition> *parts);
+
+  /** Aggregate the groups of the next pending partition that fits in memory into the table. @return false if none */
+  auto LoadNextPartition() -> bool;
+
+  /** Evaluate the group-bys of the tuple into key, whose vector is reused from tuple to tuple */
+  void MakeAggregateKey(const Tuple *tuple, AggregateKey *key) {
+    key->group_bys_.clear();
     for (const auto &expr : plan_->GetGroupBys()) {
-      keys.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
+      key->group_bys_.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
     }
-    return {keys};
   }
 
-  /** @return The tuple as an AggregateValue */
-  auto MakeAggregateValue(const Tuple *tuple) -> AggregateValue {
-    std::vector<Value> vals;
+  /** Evaluate the aggregate inputs of the tuple into val, whose vector is reused from tuple to tuple */
+  void MakeAggregateValue(const Tuple *tuple, AggregateValue *val) {
+    val->aggregates_.clear();
     for (const auto &expr : plan_->GetAggregates()) {
-      vals.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
+      val->aggregates_.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
     }
-    return {vals};
   }
 
  private:
@@ -201,8 +305,12 @@ class AggregationExecutor : public AbstractExecutor {
   /** The child executor that produces tuples over which the aggregation is computed */
   std::unique_ptr<AbstractExecutor> child_;
   /** Simple aggregation hash table */
-  // TODO(Student): Uncomment SimpleAggregationHashTable aht_;
+  SimpleAggregationHashTable aht_;
   /** Simple aggregation hash table iterator */
-  // TODO(Student): Uncomment SimpleAggregationHashTable::Iterator aht_iterator_;
+  SimpleAggregationHashTable::Iterator aht_iterator_;
+  /** Whether the single row of an aggregation without groups over no tuples is still to be produced */
+  bool empty_result_pending_{false};
+  /** The partitions of partial aggregates left to aggregate */
+  SpillPartitions partitions_;
 };
 }  // namespace bustub
@@ -14,16 +14,25 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "container/hash/robin_hood_hash_table.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/hash_join_plan.h"
+#include "storage/table/spill_partitions.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * HashJoinExecutor executes a nested-loop JOIN on two tables.
+ * HashJoinExecutor executes a hash JOIN on two tables. It builds a RobinHoodHashTable of the tuples of the right child
+ * by their join keys, and probes it with the key of each tuple of the left child, so that a LEFT join can produce the
+ * left tuples that match none. NULL keys match nothing.
+ *
+ * If the right tuples outgrow the memory budget of the executor context, the join turns into a grace hash join: both
+ * children are hashed into SpillPartitions, and the pairs of left and right files with the same hashes are joined one
+ * at a time. A partition whose right tuples are still larger than the budget is partitioned again.
  */
 class HashJoinExecutor : public AbstractExecutor {
  public:
@@ -52,8 +61,50 @@ class HashJoinExecutor : public AbstractExecutor {
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
  private:
-  /** The NestedLoopJoin plan node to be executed. */
+  /** The files of the left and the right tuples of a partition */
+  static constexpr size_t LEFT_FILE = 0;
+  static constexpr size_t RIGHT_FILE = 1;
+
+  /** Append a tuple of the left or the right child to its partition at depth, unless it can match nothing. */
+  void PartitionTuple(std::vector<SpillPartitions::Partition> *parts, const Tuple &tuple, bool left, size_t depth);
+
+  /** Write the right tuples of the table into their partitions at depth, and clear it. */
+  void SpillTable(std::vector<SpillPartitions::Partition> *parts, size_t depth);
+
+  /** Hash the tuples of a partition into partitions one level deeper, and add them to the pending ones. */
+  void Repartition(SpillPartitions::Partition *part);
+
+  /** Finish writing the partitions, and add those that can produce tuples to the pending ones. */
+  void AddPending(std::vector<SpillPartitions::Partition> *parts);
+
+  /** Build the table from the right tuples of the next pending partition that fits in memory. @return false if none */
+  auto LoadNextPartition() -> bool;
+
+  /** Read the next left tuple to probe with into left_tuple_, from the left child or the current partition. */
+  auto NextLeftTuple() -> bool;
+
+  /** @return the left tuple joined with the right tuple stored in entry, or with NULLs if entry is NO_ENTRY */
+  auto JoinTuple(size_t entry) -> Tuple;
+
+  /** The HashJoin plan node to be executed. */
   const HashJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_child_;
+  std::unique_ptr<AbstractExecutor> right_child_;
+  /** The tuples of the right child by their join keys, with their values as the payload */
+  RobinHoodHashTable ht_;
+  /** The current left tuple, and the next entry of the table it joins with */
+  Tuple left_tuple_;
+  size_t entry_{RobinHoodHashTable::NO_ENTRY};
+  /** A reused buffer for the join key of a tuple */
+  std::vector<Value> key_;
+
+  /** Whether the right tuples outgrew the memory budget, so that the join goes by partitions */
+  bool spilled_{false};
+  /** The partitions left to join */
+  SpillPartitions partitions_;
+  /** The partition being joined, and the reader of its left tuples */
+  SpillPartitions::Partition current_;
+  std::unique_ptr<TmpTupleFile::Reader> left_reader_;
 };
 
 }  // namespace bustub
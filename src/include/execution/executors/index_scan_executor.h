@@ -12,18 +12,22 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "common/rid.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/index_scan_plan.h"
+#include "storage/index/index.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * IndexScanExecutor executes an index scan over a table.
+ * IndexScanExecutor executes an index scan over a table: the tuples whose key is in a range, the whole table by
+ * default, in ascending or descending key order, or the tuples of a single key, which may be many since b+ tree
+ * indexes allow duplicate keys. An index-only scan returns the entries of the index instead of the tuples.
  */
 
 class IndexScanExecutor : public AbstractExecutor {
@@ -44,5 +48,13 @@ class IndexScanExecutor : public AbstractExecutor {
  private:
   /** The index scan plan node to be executed. */
   const IndexScanPlanNode *plan_;
+  /** The index to scan, and the table it is built on. */
+  IndexInfo *index_info_{nullptr};
+  TableInfo *table_info_{nullptr};
+  /** The position of a range scan in the index, nullptr for a key lookup. */
+  std::unique_ptr<IndexCursor> iter_;
+  /** The RIDs of the looked up key, and the next one to return. */
+  std::vector<RID> rids_;
+  size_t cursor_{0};
 };
 }  // namespace bustub
@@ -57,6 +57,12 @@ class InsertExecutor : public AbstractExecutor {
  private:
   /** The insert plan node to be executed*/
   const InsertPlanNode *plan_;
+  /** The child executor from which inserted tuples are pulled */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The buffer ring of the insert, nullptr if it goes through the buffer pool like any other access */
+  std::unique_ptr<BufferRing> ring_;
+  /** True once the number of inserted rows has been produced */
+  bool done_{false};
 };
 
 }  // namespace bustub
@@ -28,7 +28,8 @@
 namespace bustub {
 
 /**
- * IndexJoinExecutor executes index join operations.
+ * IndexJoinExecutor executes index join operations: every outer tuple looks up its join key in the index of the inner
+ * table, and is joined with all the inner tuples the key maps to.
  */
 class NestIndexJoinExecutor : public AbstractExecutor {
  public:
@@ -48,7 +49,20 @@ class NestIndexJoinExecutor : public AbstractExecutor {
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
  private:
+  /** Build the output tuple from the current outer tuple and an inner tuple, or NULLs if inner is nullptr. */
+  auto JoinTuple(const Tuple *inner) const -> Tuple;
+
   /** The nested index join plan node. */
   const NestedIndexJoinPlanNode *plan_;
+  /** The outer table. */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The index on the inner table and the inner table. */
+  IndexInfo *index_info_{nullptr};
+  TableInfo *inner_table_info_{nullptr};
+  /** The current outer tuple. */
+  Tuple outer_tuple_;
+  /** The RIDs of the inner tuples that match the current outer tuple, and the next one to join. */
+  std::vector<RID> inner_rids_;
+  size_t cursor_{0};
 };
 }  // namespace bustub
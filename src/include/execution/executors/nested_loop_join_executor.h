@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
@@ -53,8 +54,20 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
  private:
+  /** @return the left tuple joined with right, or with NULLs if right is nullptr */
+  auto JoinTuple(const Tuple *right) const -> Tuple;
+
   /** The NestedLoopJoin plan node to be executed. */
   const NestedLoopJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+  /** The tuples of the right child, read once in Init rather than again for every left tuple */
+  std::vector<Tuple> right_tuples_;
+  /** The current left tuple, the next right tuple to join it with, and whether any right tuple matched it yet */
+  Tuple left_tuple_;
+  bool has_left_tuple_{false};
+  size_t right_cursor_{0};
+  bool left_matched_{false};
 };
 
 }  // namespace bustub
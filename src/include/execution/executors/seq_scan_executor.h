@@ -12,11 +12,13 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "storage/table/table_iterator.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -50,5 +52,11 @@ class SeqScanExecutor : public AbstractExecutor {
  private:
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
+  /** The table being scanned */
+  TableInfo *table_info_{nullptr};
+  /** The buffer ring of the scan, nullptr if the scan goes through the buffer pool like any other access */
+  std::unique_ptr<BufferRing> ring_;
+  /** The position of the scan in the table */
+  std::unique_ptr<TableIterator> iter_;
 };
 }  // namespace bustub
@@ -13,18 +13,34 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/loser_tree.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/sort_plan.h"
+#include "execution/sort_key_normalizer.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * The SortExecutor executor executes a sort.
+ * The SortExecutor executor executes a sort, on the normalized keys of the tuples (see SortKeyNormalizer).
+ *
+ * The tuples of the child are sorted in memory as long as they fit in the memory budget of the executor context. Past
+ * that, it runs an external merge sort: every time the tuples in memory fill the budget, they are sorted and written
+ * out as a run of TmpTupleFile pages, along with their keys. The runs are then merged with a LoserTree, at most
+ * MAX_MERGE_FAN_IN at a time, and fewer if the budget or the buffer pool has fewer frames to read them with, until the
+ * runs left are merged as Next is called.
+ *
+ * The tuples in memory are sorted by comparing their keys with memcmp, or with a radix sort on the bytes of the keys
+ * if the executor context asks for it. With a sort parallelism above one, they are split into as many chunks, sorted by
+ * as many worker threads, and merged pairwise; every merge is split between the workers along its merge path, so that
+ * each writes an equal share of the output.
  */
 class SortExecutor : public AbstractExecutor {
  public:
@@ -49,8 +65,82 @@ class SortExecutor : public AbstractExecutor {
   /** @return The output schema for the sort */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
+  /** The most runs merged at a time */
+  static constexpr size_t MAX_MERGE_FAN_IN = 64;
+
+  /** The fewest entries the radix sort distributes into buckets; it compares fewer. */
+  static constexpr size_t MIN_RADIX_SORT_SIZE = 64;
+
+  /** The fewest entries sorted by each worker of a parallel sort */
+  static constexpr size_t MIN_PARALLEL_SORT_CHUNK = 4096;
+
  private:
+  /** A tuple in memory, by its normalized key and its index in tuples_ */
+  struct Entry {
+    std::string key_;
+    size_t index_;
+  };
+
+  /** A run being merged, with its current tuple and key, if it has not run out */
+  struct RunCursor {
+    std::unique_ptr<TmpTupleFile::Reader> reader_;
+    std::string key_;
+    Tuple tuple_;
+    bool valid_{false};
+  };
+
+  /** Orders the runs being merged by their current keys, those that ran out last. */
+  struct RunLess {
+    const std::vector<RunCursor> *cursors_;
+    auto operator()(size_t a, size_t b) const -> bool {
+      const auto &x = (*cursors_)[a];
+      const auto &y = (*cursors_)[b];
+      return x.valid_ && (!y.valid_ || x.key_ < y.key_);
+    }
+  };
+
+  /** Sort the entries of the tuples in memory by their keys. */
+  void SortEntries();
+
+  /** Sort the entries [begin, end) of entries_, which is as long as scratch, on one thread. */
+  void SortRange(size_t begin, size_t end, std::vector<Entry> *scratch);
+
+  /** Sort the entries of the tuples in memory with a number of worker threads. */
+  void ParallelSort(size_t threads);
+
+  /**
+   * Sort the entries [begin, end) of entries_, whose keys agree on their first depth bytes, with an MSD radix sort,
+   * through scratch, which is as long as entries_.
+   */
+  void RadixSort(size_t begin, size_t end, size_t depth, std::vector<Entry> *scratch);
+
+  /** Sort the tuples in memory, and write them out as a new run. */
+  void WriteRun();
+
+  /** Start merging the runs [begin, end) of runs_ into cursors and a loser tree. */
+  void OpenRuns(size_t begin, size_t end, std::vector<RunCursor> *cursors,
+                std::optional<LoserTree<RunLess>> *tree) const;
+
+  /** Move a cursor to the next tuple of its run. */
+  static void Advance(RunCursor *cursor);
+
+  /** Append a tuple with its key to a run, as a record of | key size | key | tuple size | tuple |. */
+  void AppendRecord(TmpTupleFile *run, const std::string &key, const Tuple &tuple);
+
   /** The sort plan node to be executed */
   const SortPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** The tuples in memory, and their entries in sort order */
+  std::vector<Tuple> tuples_;
+  std::vector<Entry> entries_;
+  size_t cursor_{0};
+
+  /** The runs written out, which the last of them are merged from as Next is called */
+  std::vector<std::unique_ptr<TmpTupleFile>> runs_;
+  std::vector<RunCursor> cursors_;
+  std::optional<LoserTree<RunLess>> tree_;
+  /** A reused buffer for the records of the runs */
+  std::string record_;
 };
 }  // namespace bustub
@@ -13,18 +13,21 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/topn_plan.h"
+#include "execution/sort_key_normalizer.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * The TopNExecutor executor executes a topn.
+ * The TopNExecutor executor executes a topn. It keeps the first N tuples of the child so far in a max-heap on their
+ * normalized keys (see SortKeyNormalizer), so that a tuple that goes after all of them costs one comparison of bytes.
  */
 class TopNExecutor : public AbstractExecutor {
  public:
@@ -50,7 +53,18 @@ class TopNExecutor : public AbstractExecutor {
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
  private:
+  /** A tuple kept, with its normalized key */
+  struct Entry {
+    std::string key_;
+    Tuple tuple_;
+  };
+
   /** The topn plan node to be executed */
   const TopNPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** The heap of the first N tuples while the child is read, and then the tuples in order */
+  std::vector<Entry> entries_;
+  size_t cursor_{0};
 };
 }  // namespace bustub
@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// loser_tree.h
+//
+// Identification: src/include/execution/loser_tree.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+namespace bustub {
+
+/**
+ * LoserTree picks the smallest of the current items of k sorted sources, for a k-way merge, with about log2(k)
+ * comparisons per item: every inner node of the tree remembers the source that lost the match played there, so that
+ * when the winner moves on to its next item only the matches on its path to the root are replayed.
+ *
+ * The sources are numbered 0 to k - 1, and Less(i, j) tells whether the current item of source i goes before that of
+ * source j. A source that ran out must go after every other one, so that the winner is a source that ran out only once
+ * all of them did.
+ */
+template <class Less>
+class LoserTree {
+ public:
+  LoserTree(size_t num_sources, Less less) : num_sources_(num_sources), less_(std::move(less)) {
+    tree_.resize(num_sources_ + 1);
+    if (num_sources_ > 0) {
+      tree_[0] = Build(1);
+    }
+  }
+
+  /** @return the source whose current item is the smallest */
+  auto Winner() const -> size_t { return tree_[0]; }
+
+  /** Find the new winner once the current winner has moved on to its next item, or ran out. */
+  void Replay() {
+    size_t winner = tree_[0];
+    for (size_t node = (winner + num_sources_) / 2; node > 0; node /= 2) {
+      if (less_(tree_[node], winner)) {
+        std::swap(tree_[node], winner);
+      }
+    }
+    tree_[0] = winner;
+  }
+
+ private:
+  /** Play the matches of the subtree under node. The leaves num_sources_ to 2 * num_sources_ - 1 are the sources. */
+  auto Build(size_t node) -> size_t {
+    if (node >= num_sources_) {
+      return node - num_sources_;
+    }
+    size_t left = Build(2 * node);
+    size_t right = Build(2 * node + 1);
+    if (less_(right, left)) {
+      tree_[node] = left;
+      return right;
+    }
+    tree_[node] = right;
+    return left;
+  }
+
+  size_t num_sources_;
+  Less less_;
+  /** The winner at 0, and the loser of the match at every inner node 1 to num_sources_ - 1 */
+  std::vector<size_t> tree_;
+};
+
+}  // namespace bustub
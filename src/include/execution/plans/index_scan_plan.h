@@ -20,8 +20,23 @@
 #include "execution/plans/abstract_plan.h"
 
 namespace bustub {
+
+/** One end of the key range of an index scan. */
+struct IndexScanBound {
+  /** The key at this end, which does not depend on any tuple, or nullptr if the range is open at this end. */
+  AbstractExpressionRef key_;
+  /** Whether the range includes key_. */
+  bool inclusive_{false};
+};
+
 /**
- * IndexScanPlanNode identifies a table that should be scanned with an optional predicate.
+ * IndexScanPlanNode identifies a table that should be scanned with an optional predicate. Without a key predicate the
+ * scan returns the tuples whose key is in the range of the scan, the whole table by default, in index key order,
+ * ascending or descending; with one it only returns the tuples whose key equals the key the predicate evaluates to.
+ * A range scan never returns tuples whose key is NULL, unless both ends of the range are open.
+ *
+ * An index-only range scan returns the entries of the index, the key columns followed by the included columns, without
+ * fetching the tuples from the table; its output schema is then the schema of an index entry.
  */
 class IndexScanPlanNode : public AbstractPlanNode {
  public:
@@ -33,21 +48,82 @@ class IndexScanPlanNode : public AbstractPlanNode {
   IndexScanPlanNode(SchemaRef output, index_oid_t index_oid)
       : AbstractPlanNode(std::move(output), {}), index_oid_(index_oid) {}
 
+  /**
+   * Creates a new index scan plan node that looks up a single key.
+   * @param output the output format of this scan plan node
+   * @param index_oid the identifier of the index to look up
+   * @param key_predicate the expression the key is evaluated from, which does not depend on any tuple
+   */
+  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid, AbstractExpressionRef key_predicate)
+      : AbstractPlanNode(std::move(output), {}), index_oid_(index_oid), key_predicate_(std::move(key_predicate)) {}
+
+  /**
+   * Creates a new index scan plan node over a range of keys.
+   * @param output the output format of this scan plan node
+   * @param index_oid the identifier of the index to scan
+   * @param low the low end of the range
+   * @param high the high end of the range
+   * @param reverse whether the tuples are returned in descending key order
+   * @param index_only whether the index entries are returned instead of the tuples they point to
+   */
+  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid, IndexScanBound low, IndexScanBound high, bool reverse,
+                    bool index_only = false)
+      : AbstractPlanNode(std::move(output), {}),
+        index_oid_(index_oid),
+        low_(std::move(low)),
+        high_(std::move(high)),
+        reverse_(reverse),
+        index_only_(index_only) {}
+
   auto GetType() const -> PlanType override { return PlanType::IndexScan; }
 
   /** @return the identifier of the table that should be scanned */
   auto GetIndexOid() const -> index_oid_t { return index_oid_; }
 
+  /** @return the expression the looked up key is evaluated from, or nullptr if the whole index is scanned */
+  auto KeyPredicate() const -> const AbstractExpressionRef & { return key_predicate_; }
+
+  /** @return the low end of the range of keys that is scanned */
+  auto GetLow() const -> const IndexScanBound & { return low_; }
+
+  /** @return the high end of the range of keys that is scanned */
+  auto GetHigh() const -> const IndexScanBound & { return high_; }
+
+  /** @return true if the tuples are returned in descending key order */
+  auto IsReverse() const -> bool { return reverse_; }
+
+  /** @return true if the index entries are returned without fetching the tuples */
+  auto IsIndexOnly() const -> bool { return index_only_; }
+
   BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(IndexScanPlanNode);
 
   /** The table whose tuples should be scanned. */
   index_oid_t index_oid_;
 
-  // Add anything you want here for index lookup
+  /** The key to look up, nullptr for a range scan. */
+  AbstractExpressionRef key_predicate_;
+
+  /** The range of keys to scan, if there is no key to look up. */
+  IndexScanBound low_;
+  IndexScanBound high_;
+  bool reverse_{false};
+
+  /** Whether the scan returns the index entries, so that the table is never read. */
+  bool index_only_{false};
 
  protected:
   auto PlanNodeToString() const -> std::string override {
-    return fmt::format("IndexScan {{ index_oid={} }}", index_oid_);
+    if (key_predicate_ != nullptr) {
+      return fmt::format("IndexScan {{ index_oid={}, key_predicate={} }}", index_oid_, key_predicate_);
+    }
+    std::string index_only = index_only_ ? ", index_only=true" : "";
+    if (low_.key_ == nullptr && high_.key_ == nullptr && !reverse_) {
+      return fmt::format("IndexScan {{ index_oid={}{} }}", index_oid_, index_only);
+    }
+    return fmt::format("IndexScan {{ index_oid={}, range={}{}, {}{}, reverse={}{} }}", index_oid_,
+                       low_.inclusive_ ? "[" : "(", low_.key_ != nullptr ? low_.key_->ToString() : "-inf",
+                       high_.key_ != nullptr ? high_.key_->ToString() : "+inf", high_.inclusive_ ? "]" : ")",
+                       reverse_, index_only);
   }
 };
 
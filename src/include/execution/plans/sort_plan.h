@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -24,6 +25,9 @@
 
 namespace bustub {
 
+/** An ORDER BY item of a plan: the direction, where the NULLs go, and the expression to order by. */
+using OrderBy = std::tuple<OrderByType, OrderByNullType, AbstractExpressionRef>;
+
 /**
  * The SortPlanNode represents a sort operation. It will sort the input with
  * the given predicate.
@@ -37,7 +41,7 @@ class SortPlanNode : public AbstractPlanNode {
    * @param order_bys The sort expressions and their order by types.
    */
   SortPlanNode(SchemaRef output, AbstractPlanNodeRef child,
-               std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys)
+               std::vector<OrderBy> order_bys)
       : AbstractPlanNode(std::move(output), {std::move(child)}), order_bys_(std::move(order_bys)) {}
 
   /** @return The type of the plan node */
@@ -50,11 +54,11 @@ class SortPlanNode : public AbstractPlanNode {
   }
 
   /** @return Get sort by expressions */
-  auto GetOrderBy() const -> const std::vector<std::pair<OrderByType, AbstractExpressionRef>> & { return order_bys_; }
+  auto GetOrderBy() const -> const std::vector<OrderBy> & { return order_bys_; }
 
   BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(SortPlanNode);
 
-  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys_;
+  std::vector<OrderBy> order_bys_;
 
  protected:
   auto PlanNodeToString() const -> std::string override;
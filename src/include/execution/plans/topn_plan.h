@@ -21,6 +21,7 @@
 #include "catalog/catalog.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/plans/sort_plan.h"
 
 namespace bustub {
 
@@ -38,7 +39,7 @@ class TopNPlanNode : public AbstractPlanNode {
    * @param n Retain n elements.
    */
   TopNPlanNode(SchemaRef output, AbstractPlanNodeRef child,
-               std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys, std::size_t n)
+               std::vector<OrderBy> order_bys, std::size_t n)
       : AbstractPlanNode(std::move(output), {std::move(child)}), order_bys_(std::move(order_bys)), n_{n} {}
 
   /** @return The type of the plan node */
@@ -48,7 +49,7 @@ class TopNPlanNode : public AbstractPlanNode {
   auto GetN() const -> size_t { return n_; }
 
   /** @return Get order by expressions */
-  auto GetOrderBy() const -> const std::vector<std::pair<OrderByType, AbstractExpressionRef>> & { return order_bys_; }
+  auto GetOrderBy() const -> const std::vector<OrderBy> & { return order_bys_; }
 
   /** @return The child plan node */
   auto GetChildPlan() const -> AbstractPlanNodeRef {
@@ -58,7 +59,7 @@ class TopNPlanNode : public AbstractPlanNode {
 
   BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(TopNPlanNode);
 
-  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys_;
+  std::vector<OrderBy> order_bys_;
   std::size_t n_;
 
  protected:
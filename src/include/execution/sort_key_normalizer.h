@@ -0,0 +1,56 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key_normalizer.h
+//
+// Identification: src/include/execution/sort_key_normalizer.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "catalog/schema.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/sort_plan.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * SortKeyNormalizer encodes the ORDER BY values of a tuple into a byte string, its normalized key, such that the keys
+ * of two tuples compare with memcmp, shorter first on a tie, in the order of the tuples. Sorts compare the keys
+ * instead of Values, whose comparisons dispatch on the type of every column of every comparison.
+ *
+ * Every column begins with a byte that sorts its NULLs before or after all values, as the order-by asks. By default
+ * NULL is the smallest value, first when ascending and last when descending, as in a b+ tree index. Integers follow big-endian with their sign bit flipped, decimals
+ * with the sign bit flipped if positive and every bit flipped if negative, and varchars as their bytes, 0x00 escaped
+ * as 0x00 0xFF, up to a terminating 0x00 0x00, so that no key of a column is a prefix of another. A descending column
+ * has every byte of the encoding of its value flipped.
+ */
+class SortKeyNormalizer {
+ public:
+  /**
+   * @param order_bys the ORDER BY expressions and their directions
+   * @param schema the schema of the tuples the expressions are evaluated on
+   */
+  SortKeyNormalizer(const std::vector<OrderBy> &order_bys, const Schema &schema)
+      : order_bys_(order_bys), schema_(schema) {}
+
+  /** Append the normalized key of a tuple to key. */
+  void Normalize(const Tuple &tuple, std::string *key) const;
+
+  /** Append the encoding of a value, in ascending or descending order, with NULLs first or last, to key. */
+  static void NormalizeValue(const Value &value, bool descending, bool nulls_first, std::string *key);
+
+ private:
+  const std::vector<OrderBy> &order_bys_;
+  const Schema &schema_;
+};
+
+}  // namespace bustub
@@ -45,8 +45,8 @@ class Optimizer {
 
   /**
    * @brief optimize nested loop join into hash join.
-   * In the starter code, we will check NLJs with exactly one equal condition. You can further support optimizing joins
-   * with multiple eq conditions.
+   * One equality of a left column with a right column is the key of the hash join. The rest of the predicate of an
+   * inner join goes into filters: below the join for the conditions on a single side, above it for the others.
    */
   auto OptimizeNLJAsHashJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
@@ -81,12 +81,30 @@ class Optimizer {
   auto IsPredicateTrue(const AbstractExpression &expr) -> bool;
 
   /**
-   * @brief optimize order by as index scan if there's an index on a table
+   * @brief optimize a filter on a seq scan as an index scan if there's an index on a column it compares with
+   * constants: `column = constant` as a lookup of the key, `column < constant` and the like as a scan of a key range.
+   * The rest of the predicate stays in a filter on the index scan.
+   */
+  auto OptimizeFilterAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief optimize order by as index scan if there's an index on the order by column, scanning it backward for a
+   * descending order. The scan may be under filters and projections of columns, and an index scan of the column
+   * keeps its range.
    */
   auto OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
-  /** @brief check if the index can be matched */
-  auto MatchIndex(const std::string &table_name, uint32_t index_key_idx)
+  /**
+   * @brief optimize a projection of a sequential or index scan, possibly through a filter, as an index-only scan if an
+   * index stores every column they refer to among its key and included columns, so that the table is never read.
+   */
+  auto OptimizeIndexOnlyScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief check if the index can be matched. A lookup of a single key prefers a hash index on the column to a b+ tree
+   * index, but ranges and orders need a b+ tree index.
+   */
+  auto MatchIndex(const std::string &table_name, uint32_t index_key_idx, bool ordered = false)
       -> std::optional<std::tuple<index_oid_t, std::string>>;
 
   /**
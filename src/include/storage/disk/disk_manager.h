@@ -15,7 +15,6 @@
 #include <atomic>
 #include <fstream>
 #include <future>  // NOLINT
-#include <mutex>   // NOLINT
 #include <string>
 
 #include "common/config.h"
@@ -32,12 +31,12 @@ class DiskManager {
    * Creates a new disk manager that writes to the specified database file.
    * @param db_file the file name of the database file to write to
    */
-  explicit DiskManager(const std::string &db_file);
+  explicit DiskManager(const std::string &db_file, bool direct_io = false);
 
   /** FOR TEST / LEADERBOARD ONLY, used by DiskManagerMemory */
   DiskManager() = default;
 
-  virtual ~DiskManager() = default;
+  virtual ~DiskManager();
 
   /**
    * Shut down the disk manager and close all the file resources.
@@ -58,6 +57,12 @@ class DiskManager {
    */
   virtual void ReadPage(page_id_t page_id, char *page_data);
 
+  /**
+   * Make all pages written so far durable. Page writes are not synced individually; callers that need
+   * durability (checkpoints, FlushAllPages, shutdown) call this at the points where it matters.
+   */
+  virtual void SyncDb();
+
   /**
    * Flush the entire log buffer into disk.
    * @param log_data raw log data
@@ -83,6 +88,12 @@ class DiskManager {
   /** @return the number of disk writes */
   auto GetNumWrites() const -> int;
 
+  /** @return the number of fdatasync calls made on the database file */
+  auto GetNumSyncs() const -> int;
+
+  /** @return true if the database file was opened with O_DIRECT */
+  auto IsDirectIO() const -> bool { return direct_io_; }
+
   /**
    * Sets the future which is used to check for non-blocking flushes.
    * @param f the non-blocking flush check
@@ -94,18 +105,23 @@ class DiskManager {
 
  protected:
   auto GetFileSize(const std::string &file_name) -> int;
+  static auto IsAligned(const char *data) -> bool;
+  static auto BounceBuffer() -> char *;
   // stream to write log file
   std::fstream log_io_;
   std::string log_name_;
-  // stream to write db file
-  std::fstream db_io_;
+  // file descriptor of the db file, accessed with positional pread/pwrite so no latch is needed
+  int db_fd_{-1};
   std::string file_name_;
+  // whether db_fd_ bypasses the kernel page cache; page buffers must then be BUSTUB_PAGE_ALIGNMENT aligned
+  bool direct_io_{false};
+  // size of the db file in bytes, tracked in memory instead of stat-ing the file on every read
+  std::atomic<size_t> db_file_size_{0};
   int num_flushes_{0};
-  int num_writes_{0};
+  std::atomic<int> num_writes_{0};
+  std::atomic<int> num_syncs_{0};
   bool flush_log_{false};
   std::future<void> *flush_log_f_{nullptr};
-  // With multiple buffer pool instances, need to protect file access
-  std::mutex db_io_latch_;
 };
 
 }  // namespace bustub
@@ -0,0 +1,168 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// disk_scheduler.h
+//
+// Identification: src/include/storage/disk/disk_scheduler.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <future>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+#include "storage/disk/disk_manager.h"
+
+namespace bustub {
+
+/**
+ * @brief Represents a Write or Read request for the DiskManager to execute.
+ */
+struct DiskRequest {
+  /** Flag indicating whether the request is a write or a read. */
+  bool is_write_;
+
+  /**
+   *  Pointer to the start of the memory location where a page is either:
+   *   1. being read into from disk (on a read).
+   *   2. being written out to disk (on a write).
+   */
+  char *data_;
+
+  /** ID of the page being read from / written to disk. */
+  page_id_t page_id_;
+
+  /** Callback used to signal to the request issuer when the request has been completed. */
+  std::promise<bool> callback_;
+};
+
+/**
+ * @brief DiskSchedulerBackend performs the actual I/O of the requests handed out by the DiskScheduler workers.
+ * Backends may issue a whole batch at once (e.g. through an asynchronous I/O interface), but must fulfil the
+ * callback of every request in the batch before returning.
+ */
+class DiskSchedulerBackend {
+ public:
+  virtual ~DiskSchedulerBackend() = default;
+
+  /**
+   * @brief Execute a batch of requests. The batch is sorted by page id; requests on the same page keep the order in
+   * which they were scheduled.
+   * @param batch the requests to execute
+   */
+  virtual void Execute(std::vector<DiskRequest> *batch) = 0;
+};
+
+/**
+ * @brief Backend that issues every request as a blocking DiskManager::ReadPage / WritePage call from the worker
+ * thread that owns the batch. With several workers this behaves as a thread pool of synchronous I/O calls.
+ */
+class DiskManagerBackend : public DiskSchedulerBackend {
+ public:
+  explicit DiskManagerBackend(DiskManager *disk_manager) : disk_manager_(disk_manager) {}
+
+  void Execute(std::vector<DiskRequest> *batch) override;
+
+ private:
+  DiskManager *disk_manager_;
+};
+
+/**
+ * @brief The DiskScheduler schedules disk read and write operations.
+ *
+ * A request is scheduled by calling DiskScheduler::Schedule() with an appropriate DiskRequest object. Requests are
+ * spread over a fixed number of worker threads by page id, so all requests on the same page are executed by the same
+ * worker in the order they were scheduled. Each worker drains everything that is pending in its queue as one batch,
+ * orders the batch by page id (i.e. by file offset) and hands it to the backend.
+ *
+ * The caller waits for completion through the future of the request's callback.
+ */
+class DiskScheduler {
+ public:
+  /**
+   * @brief Creates a DiskScheduler that issues requests through the DiskManager.
+   * @param disk_manager the disk manager
+   * @param num_workers number of worker threads
+   */
+  explicit DiskScheduler(DiskManager *disk_manager, size_t num_workers = 1);
+
+  /**
+   * @brief Creates a DiskScheduler with a custom backend.
+   * @param backend the backend that executes the requests
+   * @param num_workers number of worker threads
+   */
+  explicit DiskScheduler(std::unique_ptr<DiskSchedulerBackend> backend, size_t num_workers = 1);
+
+  /**
+   * @brief Drains the outstanding requests and joins the worker threads.
+   */
+  ~DiskScheduler();
+
+  DISALLOW_COPY_AND_MOVE(DiskScheduler);
+
+  /**
+   * @brief Schedules a request for the DiskManager to execute.
+   * @param r The request to be scheduled.
+   */
+  void Schedule(DiskRequest r);
+
+  /**
+   * @brief Schedules a read of a page and returns the future that is fulfilled once the read is done.
+   * @param page_id id of the page to read
+   * @param[out] data buffer of BUSTUB_PAGE_SIZE bytes the page is read into
+   */
+  auto ScheduleRead(page_id_t page_id, char *data) -> std::future<bool>;
+
+  /**
+   * @brief Schedules a write of a page and returns the future that is fulfilled once the write is done. The buffer
+   * must stay untouched until then.
+   * @param page_id id of the page to write
+   * @param data buffer of BUSTUB_PAGE_SIZE bytes to write
+   */
+  auto ScheduleWrite(page_id_t page_id, const char *data) -> std::future<bool>;
+
+  /**
+   * @brief Create a Promise object. If you want to implement your own version of promise, you can change this function
+   * so that our test cases can use your promise implementation.
+   *
+   * @return std::promise<bool>
+   */
+  using DiskSchedulerPromise = std::promise<bool>;
+  auto CreatePromise() -> DiskSchedulerPromise { return {}; };
+
+  /** @return the number of worker threads */
+  auto GetNumWorkers() const -> size_t { return workers_.size(); }
+
+ private:
+  /** Pending requests of a single worker. */
+  struct RequestQueue {
+    std::mutex latch_;
+    std::condition_variable cv_;
+    std::deque<DiskRequest> requests_;
+    bool stop_{false};
+  };
+
+  /**
+   * @brief Worker loop: waits for requests, executes them in batches sorted by page id, and exits once the scheduler
+   * is shutting down and the queue is empty.
+   * @param queue the queue this worker serves
+   */
+  void RunWorker(RequestQueue *queue);
+
+  std::unique_ptr<DiskSchedulerBackend> backend_;
+  std::vector<std::unique_ptr<RequestQueue>> queues_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace bustub
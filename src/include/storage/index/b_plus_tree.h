@@ -10,33 +10,63 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <functional>
 #include <queue>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "common/rwlatch.h"
 #include "concurrency/transaction.h"
 #include "storage/index/index_iterator.h"
-#include "storage/page/b_plus_tree_internal_page.h"
-#include "storage/page/b_plus_tree_leaf_page.h"
+#include "storage/index/key_codec.h"
+#include "storage/page/b_plus_tree_posting_page.h"
 
 namespace bustub {
 
-#define BPLUSTREE_TYPE BPlusTree<KeyType, ValueType, KeyComparator>
+#define BPLUSTREE_TEMPLATE_ARGUMENTS \
+  template <typename KeyType, typename ValueType, typename KeyComparator, typename KeyCodec, bool Unique>
+#define BPLUSTREE_TYPE BPlusTree<KeyType, ValueType, KeyComparator, KeyCodec, Unique>
 
 /**
  * Main class providing the API for the Interactive B+ Tree.
  *
  * Implementation of simple b+ tree data structure where internal pages direct
  * the search and leaf pages contain actual data.
- * (1) We only support unique key
+ * (1) Keys are unique, unless Unique is false (see below)
  * (2) support insert & remove
  * (3) The structure should shrink and grow dynamically
  * (4) Implement index iterator for range scan
+ *
+ * Concurrency: lookups, iterators and writers descend with optimistic latch coupling. Internal pages are read without
+ * latches and validated against their page version (see Page::GetVersion()) before the child they point to is
+ * trusted, so readers never write to the shared cache lines of the upper levels. Only the leaf is latched, shared by
+ * readers and exclusive by writers. A conflicting write restarts the descent. A writer whose leaf would split or
+ * underflow retries pessimistically, write latching the path from the root and releasing the ancestors of every safe
+ * page (latch crabbing). A writer that changes the sibling links of the leaves latches the leaves left to right.
+ *
+ * Page format: the KeyCodec policy decides how keys are stored (see key_codec.h). The default VerbatimKeyCodec stores
+ * them as they are, in fixed-size slots. CompressedKeyCodec stores them as memcmp-comparable byte strings in pages
+ * that keep the prefix shared by their keys once and separate the leaves with the shortest possible keys, so more
+ * keys fit in a page. Since the capacity of a compressed page depends on its keys, pages decide themselves whether
+ * they have room for a key or can absorb a sibling; their max size only bounds the min size.
+ *
+ * Duplicate keys: a tree whose Unique argument is false maps every key to any number of values. Each key still has a
+ * single leaf entry, whose value is the posting list of the key (see PostingList): a few values inline, the rest in
+ * overflow pages. Adding a value to or removing a value from a key that stays in the tree only changes the posting
+ * list, never the structure of the tree.
  */
-INDEX_TEMPLATE_ARGUMENTS
+template <typename KeyType, typename ValueType, typename KeyComparator,
+          typename KeyCodec = VerbatimKeyCodec<KeyType, KeyComparator>, bool Unique = true>
 class BPlusTree {
-  using InternalPage = BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator>;
-  using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
+  using StoredKey = typename KeyCodec::StoredKey;
+  using StoredComparator = typename KeyCodec::StoredComparator;
+  using InternalPage = typename KeyCodec::InternalPage;
+  /** The value of a leaf entry: the value of its key, or the posting list of its key if keys are not unique. */
+  using LeafValue = std::conditional_t<Unique, ValueType, PostingList<ValueType>>;
+  using LeafPage = typename KeyCodec::template LeafPage<LeafValue>;
 
  public:
   explicit BPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
@@ -45,13 +75,20 @@ class BPlusTree {
   // Returns true if this B+ tree has no keys and values.
   auto IsEmpty() const -> bool;
 
-  // Insert a key-value pair into this B+ tree.
+  // Insert a key-value pair into this B+ tree. A tree with duplicate keys expects the pair not to be in it yet.
   auto Insert(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr) -> bool;
 
-  // Remove a key and its value from this B+ tree.
+  // Remove a key and all of its values from this B+ tree.
   void Remove(const KeyType &key, Transaction *transaction = nullptr);
 
-  // return the value associated with a given key
+  // Remove a key-value pair from this B+ tree, and the key with its last value.
+  void Remove(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
+
+  // Build this empty B+ tree bottom-up from key & value pairs sorted by key, filling pages up to fill_factor.
+  auto BulkLoad(const std::function<bool(MappingType *)> &next, double fill_factor = INDEX_FILL_FACTOR,
+                Transaction *transaction = nullptr) -> bool;
+
+  // return the values associated with a given key
   auto GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *transaction = nullptr) -> bool;
 
   // return the page id of the root node
@@ -60,6 +97,10 @@ class BPlusTree {
   // index iterator
   auto Begin() -> INDEXITERATOR_TYPE;
   auto Begin(const KeyType &key) -> INDEXITERATOR_TYPE;
+  auto RBegin() -> INDEXITERATOR_TYPE;
+  // iterate over the keys in [*low, *high) in the given direction, where a nullptr bound leaves its end open
+  auto Range(const KeyType *low, const KeyType *high, ScanDirection direction = ScanDirection::FORWARD,
+             bool prefetch = false) -> INDEXITERATOR_TYPE;
   auto End() -> INDEXITERATOR_TYPE;
 
   // print the B+ tree
@@ -75,6 +116,47 @@ class BPlusTree {
   void RemoveFromFile(const std::string &file_name, Transaction *transaction = nullptr);
 
  private:
+  // iterators find leaves and read them with the descents and the codec of the tree
+  friend INDEXITERATOR_TYPE;
+
+  /** The kind of structural change a pessimistic write may need. */
+  enum class Operation { Insert, Remove };
+
+  /**
+   * The latches held by a pessimistic write: the write latched pages from the topmost page that may change down to
+   * the current page, whether the root latch is held, and the pages to delete once everything is released.
+   */
+  struct WriteContext {
+    bool root_latched_{false};
+    std::deque<Page *> pages_;
+    std::vector<page_id_t> deleted_pages_;
+  };
+
+  // descents
+  auto FindLeafOptimistic(const StoredKey *key, bool exclusive, bool before = false) -> Page *;
+  auto TryFindLeafOptimistic(const StoredKey *key, bool exclusive, bool before, Page **leaf_page) -> bool;
+  auto FindLeafPessimistic(const StoredKey &key, Operation op, WriteContext *context) -> Page *;
+  auto IsSafe(const BPlusTreePage *node, const StoredKey &key, Operation op) const -> bool;
+  void ReleaseAncestors(WriteContext *context);
+  void ReleaseAll(WriteContext *context);
+
+  // insertion
+  auto AddToExistingKey(LeafPage *leaf, const StoredKey &key, const ValueType &value) -> bool;
+  static auto ToLeafValue(const ValueType &value) -> LeafValue;
+  void StartNewTree(const StoredKey &key, const LeafValue &value);
+  void InsertIntoParent(int index, const StoredKey &key, BPlusTreePage *new_node, WriteContext *context);
+  void SetPrevPageIdOf(page_id_t page_id, page_id_t prev_page_id);
+
+  // removal
+  void RemovePair(const StoredKey &key, const ValueType *value);
+  auto RemoveFromExistingKey(LeafPage *leaf, const StoredKey &key, const ValueType *value, bool *dirty) -> bool;
+  void RemoveEntry(LeafPage *leaf, const StoredKey &key);
+  void CoalesceOrRedistribute(int index, WriteContext *context);
+  void AdjustRoot(BPlusTreePage *old_root, WriteContext *context);
+
+  auto FetchPageOrThrow(page_id_t page_id) -> Page *;
+  auto NewPageOrThrow(page_id_t *page_id) -> Page *;
+
   void UpdateRootPageId(int insert_record = 0);
 
   /* Debug Routines for FREE!! */
@@ -84,9 +166,14 @@ class BPlusTree {
 
   // member variable
   std::string index_name_;
-  page_id_t root_page_id_;
+  /** Read without latches by the optimistic descents, changed only under root_latch_. */
+  std::atomic<page_id_t> root_page_id_;
+  /** Held by the pessimistic writes that may change the root. */
+  ReaderWriterLatch root_latch_;
   BufferPoolManager *buffer_pool_manager_;
-  KeyComparator comparator_;
+  KeyCodec codec_;
+  /** Orders the stored keys. */
+  StoredComparator comparator_;
   int leaf_max_size_;
   int internal_max_size_;
 };
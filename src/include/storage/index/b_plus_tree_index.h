@@ -24,9 +24,21 @@ namespace bustub {
 
 #define BPLUSTREE_INDEX_TYPE BPlusTreeIndex<KeyType, ValueType, KeyComparator>
 
+/**
+ * An index backed by a b+ tree with duplicate keys, so that it can be built on any columns: every key maps to the
+ * RIDs of all the tuples that have it.
+ *
+ * The included columns of an entry are stored in the tree key after the key columns, and the tree orders the entries
+ * by all of their columns. The entries of a key are then next to each other, starting with the one whose included
+ * columns are all NULL, the lowest value, so a key is looked up as the range of the entries that start with it.
+ */
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeIndex : public Index {
+  using Container = BPlusTree<KeyType, ValueType, KeyComparator, VerbatimKeyCodec<KeyType, KeyComparator>, false>;
+
  public:
+  using Iterator = IndexIterator<KeyType, ValueType, KeyComparator, VerbatimKeyCodec<KeyType, KeyComparator>, false>;
+
   BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager);
 
   void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) override;
@@ -35,17 +47,32 @@ class BPlusTreeIndex : public Index {
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
-  auto GetBeginIterator() -> INDEXITERATOR_TYPE;
+  /** The cursor prefetches the leaves ahead of it. */
+  auto ScanRange(const Tuple *low, const Tuple *high, ScanDirection direction) -> std::unique_ptr<IndexCursor> override;
+
+  /**
+   * Build the empty index from the given entries, which is much faster than inserting them one by one. The entries
+   * are sorted by key here, and all of them are kept, as with InsertEntry.
+   * @param entries the key & RID pairs to load, reordered by this call
+   * @param transaction the transaction building the index
+   */
+  void BulkLoad(std::vector<MappingType> *entries, Transaction *transaction);
 
-  auto GetBeginIterator(const KeyType &key) -> INDEXITERATOR_TYPE;
+  auto GetBeginIterator() -> Iterator;
 
-  auto GetEndIterator() -> INDEXITERATOR_TYPE;
+  auto GetBeginIterator(const KeyType &key) -> Iterator;
+
+  auto GetEndIterator() -> Iterator;
 
  protected:
-  // comparator for key
+  /** @return the tree key of the lowest entry of key, a tuple in the key schema: the one with no included values */
+  auto LowestEntryOf(const Tuple &key) -> KeyType;
+
+  // comparator for the entries of the tree, and for their key columns only
   KeyComparator comparator_;
+  KeyComparator key_comparator_;
   // container
-  BPlusTree<KeyType, ValueType, KeyComparator> container_;
+  Container container_;
 };
 
 /** We only support index table with one integer key for now in BusTub. Hardcode everything here. */
@@ -55,8 +82,7 @@ using IntegerKeyType = GenericKey<INTEGER_SIZE>;
 using IntegerValueType = RID;
 using IntegerComparatorType = GenericComparator<INTEGER_SIZE>;
 using BPlusTreeIndexForOneIntegerColumn = BPlusTreeIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>;
-using BPlusTreeIndexIteratorForOneIntegerColumn =
-    IndexIterator<IntegerKeyType, IntegerValueType, IntegerComparatorType>;
+using BPlusTreeIndexIteratorForOneIntegerColumn = BPlusTreeIndexForOneIntegerColumn::Iterator;
 using IntegerHashFunctionType = HashFunction<IntegerKeyType>;
 
 }  // namespace bustub
@@ -83,6 +83,13 @@ class GenericComparator {
       Value lhs_value = (lhs.ToValue(key_schema_, i));
       Value rhs_value = (rhs.ToValue(key_schema_, i));
 
+      // NULL sorts before any other value, as the integer key search kernels order the NULL sentinel
+      if (lhs_value.IsNull() || rhs_value.IsNull()) {
+        if (lhs_value.IsNull() != rhs_value.IsNull()) {
+          return lhs_value.IsNull() ? -1 : 1;
+        }
+        continue;
+      }
       if (lhs_value.CompareLessThan(rhs_value) == CmpBool::CmpTrue) {
         return -1;
       }
@@ -94,13 +101,30 @@ class GenericComparator {
     return 0;
   }
 
-  GenericComparator(const GenericComparator &other) : key_schema_{other.key_schema_} {}
+  GenericComparator(const GenericComparator &other)
+      : key_schema_{other.key_schema_}, integer_key_size_{other.integer_key_size_} {}
 
   // constructor
-  explicit GenericComparator(Schema *key_schema) : key_schema_(key_schema) {}
+  explicit GenericComparator(Schema *key_schema) : key_schema_(key_schema) {
+    if (key_schema_ != nullptr && key_schema_->GetColumnCount() == 1) {
+      TypeId type = key_schema_->GetColumn(0).GetType();
+      if (type == TypeId::INTEGER || type == TypeId::BIGINT) {
+        integer_key_size_ = static_cast<uint32_t>(Type::GetTypeSize(type));
+      }
+    }
+  }
+
+  auto GetKeySchema() const -> Schema * { return key_schema_; }
+
+  /**
+   * @return the size of the key, 4 or 8, if it is a single INTEGER or BIGINT column stored in the first bytes of the
+   * key, which the key search kernels then compare as integers; 0 otherwise
+   */
+  auto GetIntegerKeySize() const -> uint32_t { return integer_key_size_; }
 
  private:
   Schema *key_schema_;
+  uint32_t integer_key_size_{0};
 };
 
 }  // namespace bustub
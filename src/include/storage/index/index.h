@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "common/exception.h"
 #include "storage/table/tuple.h"
 #include "type/value.h"
 
@@ -43,11 +44,19 @@ class IndexMetadata {
    * @param table_name The name of the table on which the index is created
    * @param tuple_schema The schema of the indexed key
    * @param key_attrs The mapping from indexed columns to base table columns
+   * @param include_attrs The base table columns stored along with the key in every entry, which the index does not
+   * search by
    */
   IndexMetadata(std::string index_name, std::string table_name, const Schema *tuple_schema,
-                std::vector<uint32_t> key_attrs)
-      : name_(std::move(index_name)), table_name_(std::move(table_name)), key_attrs_(std::move(key_attrs)) {
+                std::vector<uint32_t> key_attrs, std::vector<uint32_t> include_attrs = {})
+      : name_(std::move(index_name)),
+        table_name_(std::move(table_name)),
+        key_attrs_(std::move(key_attrs)),
+        include_attrs_(std::move(include_attrs)) {
     key_schema_ = std::make_shared<Schema>(Schema::CopySchema(tuple_schema, key_attrs_));
+    entry_attrs_ = key_attrs_;
+    entry_attrs_.insert(entry_attrs_.end(), include_attrs_.begin(), include_attrs_.end());
+    entry_schema_ = std::make_shared<Schema>(Schema::CopySchema(tuple_schema, entry_attrs_));
   }
 
   ~IndexMetadata() = default;
@@ -72,6 +81,15 @@ class IndexMetadata {
   /** @return The mapping relation between indexed columns and base table columns */
   inline auto GetKeyAttrs() const -> const std::vector<uint32_t> & { return key_attrs_; }
 
+  /** @return The base table columns included in every entry after the key */
+  inline auto GetIncludeAttrs() const -> const std::vector<uint32_t> & { return include_attrs_; }
+
+  /** @return The base table columns of an entry: the key columns followed by the included columns */
+  inline auto GetEntryAttrs() const -> const std::vector<uint32_t> & { return entry_attrs_; }
+
+  /** @return A schema object pointer that represents an entry, the key followed by the included columns */
+  inline auto GetEntrySchema() const -> Schema * { return entry_schema_.get(); }
+
   /** @return A string representation for debugging */
   auto ToString() const -> std::string {
     std::stringstream os;
@@ -92,8 +110,36 @@ class IndexMetadata {
   std::string table_name_;
   /** The mapping relation between key schema and tuple schema */
   const std::vector<uint32_t> key_attrs_;
+  /** The included columns, and the columns of an entry */
+  const std::vector<uint32_t> include_attrs_;
+  std::vector<uint32_t> entry_attrs_;
   /** The schema of the indexed key */
   std::shared_ptr<Schema> key_schema_;
+  /** The schema of an entry */
+  std::shared_ptr<Schema> entry_schema_;
+};
+
+/** The order in which an ordered scan of an index visits the keys. */
+enum class ScanDirection { FORWARD, BACKWARD };
+
+/**
+ * IndexCursor walks the entries of an ordered scan of an index, one RID at a time.
+ */
+class IndexCursor {
+ public:
+  virtual ~IndexCursor() = default;
+
+  /** @return true if the cursor is past the last entry of the scan */
+  virtual auto IsEnd() -> bool = 0;
+
+  /** @return the entry at the cursor, in the entry schema of the index: the key followed by the included columns */
+  virtual auto GetEntry() -> Tuple = 0;
+
+  /** @return the RID at the cursor */
+  virtual auto GetRID() -> RID = 0;
+
+  /** Move to the next RID of the entry, or the next entry. */
+  virtual void Next() = 0;
 };
 
 /////////////////////////////////////////////////////////////////////
@@ -139,6 +185,15 @@ class Index {
   /** @return The index key attributes */
   auto GetKeyAttrs() const -> const std::vector<uint32_t> & { return metadata_->GetKeyAttrs(); }
 
+  /** @return The attributes included in every entry after the key */
+  auto GetIncludeAttrs() const -> const std::vector<uint32_t> & { return metadata_->GetIncludeAttrs(); }
+
+  /** @return The attributes of an entry, which InsertEntry and DeleteEntry take */
+  auto GetEntryAttrs() const -> const std::vector<uint32_t> & { return metadata_->GetEntryAttrs(); }
+
+  /** @return The schema of an entry, which InsertEntry and DeleteEntry take */
+  auto GetEntrySchema() const -> Schema * { return metadata_->GetEntrySchema(); }
+
   /** @return A string representation for debugging */
   auto ToString() const -> std::string {
     std::stringstream os;
@@ -153,7 +208,7 @@ class Index {
 
   /**
    * Insert an entry into the index.
-   * @param key The index key
+   * @param key The index entry, the key followed by the included columns (see GetEntrySchema())
    * @param rid The RID associated with the key
    * @param transaction The transaction context
    */
@@ -161,7 +216,7 @@ class Index {
 
   /**
    * Delete an index entry by key.
-   * @param key The index key
+   * @param key The index entry, the key followed by the included columns (see GetEntrySchema())
    * @param rid The RID associated with the key (unused)
    * @param transaction The transaction context
    */
@@ -175,6 +230,18 @@ class Index {
    */
   virtual void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) = 0;
 
+  /**
+   * Scan the entries whose key is in [low, high), in key order.
+   * @param low The low end of the range in the key schema, or nullptr if the range is open at that end
+   * @param high The high end of the range in the key schema, or nullptr if the range is open at that end
+   * @param direction The order of the scan
+   * @return A cursor over the entries of the range
+   */
+  virtual auto ScanRange(const Tuple *low, const Tuple *high, ScanDirection direction)
+      -> std::unique_ptr<IndexCursor> {
+    throw NotImplementedException("the index does not support ordered scans");
+  }
+
  private:
   /** The Index structure owns its metadata */
   std::unique_ptr<IndexMetadata> metadata_;
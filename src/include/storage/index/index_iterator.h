@@ -13,31 +13,152 @@
  * For range scan of b+ tree
  */
 #pragma once
-#include "storage/page/b_plus_tree_leaf_page.h"
+#include <type_traits>
+#include <vector>
+
+#include "storage/index/index.h"
+#include "storage/index/key_codec.h"
+#include "storage/page/b_plus_tree_posting_page.h"
 
 namespace bustub {
 
-#define INDEXITERATOR_TYPE IndexIterator<KeyType, ValueType, KeyComparator>
+#define INDEXITERATOR_TEMPLATE_ARGUMENTS \
+  template <typename KeyType, typename ValueType, typename KeyComparator, typename KeyCodec, bool Unique>
+#define INDEXITERATOR_TYPE IndexIterator<KeyType, ValueType, KeyComparator, KeyCodec, Unique>
+
+template <typename KeyType, typename ValueType, typename KeyComparator, typename KeyCodec, bool Unique>
+class BPlusTree;
 
-INDEX_TEMPLATE_ARGUMENTS
+/**
+ * IndexIterator walks the leaf pages of a b+ tree in key order, forward or backward. It keeps the current leaf pinned
+ * but not latched between calls, and read latches it only while copying the current pair out, so an open iterator
+ * never blocks writers. If a writer changed the leaf in between, the iterator finds its place again from the root by
+ * the last key it visited. Iterators are move-only, since each one owns the pin on its leaf. The keys are decoded with
+ * the key codec of the tree as they are read.
+ *
+ * A forward iterator follows the next page links and latches one leaf at a time. A backward iterator follows the prev
+ * page links against the order in which writers latch siblings, so it only tries to latch the previous leaf while it
+ * holds the current one; if a writer holds the previous leaf, it lets go and finds the previous leaf from the root.
+ *
+ * An iterator over a range [low, high) stops at the first key past the far end of the range. It also pins the leaf
+ * that holds the last keys of the range, which it looks up when it is created: if that leaf is unchanged once the
+ * iterator gets there, no key of the range can be past it, so the iterator ends without fetching the next leaf. It may
+ * also hint the buffer pool to prefetch the next leaf of the scan whenever it moves to a new leaf.
+ *
+ * In a tree with duplicate keys, the iterator yields one pair for every value of a key, in no particular order. It
+ * copies all the values of a key out of its posting list at once, when it reaches the key.
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator,
+          typename KeyCodec = VerbatimKeyCodec<KeyType, KeyComparator>, bool Unique = true>
 class IndexIterator {
+  using Tree = BPlusTree<KeyType, ValueType, KeyComparator, KeyCodec, Unique>;
+  using StoredKey = typename KeyCodec::StoredKey;
+  using LeafValue = std::conditional_t<Unique, ValueType, PostingList<ValueType>>;
+  using LeafPage = typename KeyCodec::template LeafPage<LeafValue>;
+
  public:
-  // you may define your own constructor based on your member variables
+  /** Create an iterator that is at the end. */
   IndexIterator();
+
+  /**
+   * Create an iterator that starts at the given position of a leaf page.
+   * @param tree the b+ tree, which must outlive the iterator
+   * @param page the pinned and unlatched leaf page; the iterator takes over the pin
+   * @param index the position in the leaf page, which may be past its last pair, or before its first one if the
+   * iterator moves backward
+   * @param page_version the version of the leaf page the position was found in
+   * @param direction the order in which the iterator visits the keys
+   * @param low, high the range [low, high) of the iterator, where nullptr leaves an end open. The iterator starts at
+   * the near end of the range, which the caller has already positioned it at.
+   * @param stop_page the pinned and unlatched leaf page that holds the keys at the far end of the range, as of
+   * stop_version, or nullptr; the iterator takes over the pin
+   * @param prefetch whether to prefetch the next leaf of the scan
+   */
+  IndexIterator(Tree *tree, Page *page, int index, uint64_t page_version,
+                ScanDirection direction = ScanDirection::FORWARD, const StoredKey *low = nullptr,
+                const StoredKey *high = nullptr, Page *stop_page = nullptr, uint64_t stop_version = 0,
+                bool prefetch = false);
+
   ~IndexIterator();  // NOLINT
 
+  IndexIterator(const IndexIterator &) = delete;
+  auto operator=(const IndexIterator &) -> IndexIterator & = delete;
+  IndexIterator(IndexIterator &&other) noexcept;
+  auto operator=(IndexIterator &&other) noexcept -> IndexIterator &;
+
   auto IsEnd() -> bool;
 
   auto operator*() -> const MappingType &;
 
   auto operator++() -> IndexIterator &;
 
-  auto operator==(const IndexIterator &itr) const -> bool { throw std::runtime_error("unimplemented"); }
+  auto operator==(const IndexIterator &itr) const -> bool {
+    return page_ == itr.page_ && index_ == itr.index_ && value_index_ == itr.value_index_;
+  }
 
-  auto operator!=(const IndexIterator &itr) const -> bool { throw std::runtime_error("unimplemented"); }
+  auto operator!=(const IndexIterator &itr) const -> bool { return !(*this == itr); }
 
  private:
-  // add your own private member variables here
+  /**
+   * Move along the leaf chain until index_ points at a pair of the range, and copy that pair into item_, or move to
+   * the end.
+   */
+  void Settle();
+
+  /**
+   * Leave the latched current leaf for the next one.
+   * @return false if there is none, with the current leaf latched or page_ set to nullptr
+   */
+  auto MoveToNextLeaf(LeafPage *leaf) -> bool;
+
+  /**
+   * Leave the latched current leaf for the previous one.
+   * @return false if there is none, with the current leaf latched or page_ set to nullptr
+   */
+  auto MoveToPrevLeaf(LeafPage *leaf) -> bool;
+
+  /**
+   * Leave the latched current leaf, which a writer may have changed, for the leaf that holds the next key after the
+   * last one visited, in the direction of the scan, found from the root.
+   * @return false if the tree is empty, with page_ set to nullptr
+   */
+  auto Relocate() -> bool;
+
+  /** Hint the buffer pool to read the leaf after the latched leaf, in the direction of the scan. */
+  void PrefetchSibling(LeafPage *leaf);
+
+  /** Unpin the pages of the iterator, which moves it to the end. */
+  void Release();
+
+  Tree *tree_{nullptr};
+  /** The pinned current leaf page, or nullptr at the end. */
+  Page *page_{nullptr};
+  int index_{0};
+  /** The version of the current leaf page when index_ was last found in it. */
+  uint64_t page_version_{0};
+  /** The position in the values of the current key, which is always 0 if keys are unique. */
+  int value_index_{0};
+  /** The values of the current key, if keys are not unique. */
+  std::vector<ValueType> values_;
+  /** The current pair. */
+  MappingType item_;
+
+  ScanDirection direction_{ScanDirection::FORWARD};
+  /** The far end of the range, if any. */
+  bool has_bound_{false};
+  StoredKey bound_;
+  /**
+   * The last key the iterator visited, or the near end of its range before it visits any: the iterator goes on from
+   * the keys after it, or from the first key of the range if resume_past_ is false. An iterator that finds its place
+   * from the root looks for this key.
+   */
+  bool has_resume_key_{false};
+  StoredKey resume_key_;
+  bool resume_past_{false};
+  /** The pinned leaf page that holds the far end of the range, and its version when the range was looked up. */
+  Page *stop_page_{nullptr};
+  uint64_t stop_version_{0};
+  bool prefetch_{false};
 };
 
 }  // namespace bustub
@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// key_codec.h
+//
+// Identification: src/include/storage/index/key_codec.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+
+#include "catalog/schema.h"
+#include "storage/index/generic_key.h"
+#include "storage/page/b_plus_tree_compressed_internal_page.h"
+#include "storage/page/b_plus_tree_compressed_leaf_page.h"
+#include "storage/page/b_plus_tree_internal_page.h"
+#include "storage/page/b_plus_tree_leaf_page.h"
+
+namespace bustub {
+
+/**
+ * A key codec is the policy that decides how a BPlusTree stores its keys. It names the key type and the comparator
+ * the pages are built on, the leaf and internal page formats, and converts the keys of the tree's interface to and
+ * from the stored keys:
+ *
+ *  - StoredKey, StoredComparator: the key type of the pages and the comparator they are ordered by
+ *  - LeafPage<ValueType>, InternalPage: the page formats
+ *  - Encode(key), Decode(stored_key): the conversions between the two key types
+ *  - Separator(left, right): the key a split stores in the parent between a left page whose last key is left and a
+ *    right page whose first key is right
+ */
+
+/**
+ * The default codec: keys are stored as they are, in fixed-size slots, and searched with the comparator of the tree.
+ */
+template <typename KeyType, typename KeyComparator>
+class VerbatimKeyCodec {
+ public:
+  using StoredKey = KeyType;
+  using StoredComparator = KeyComparator;
+  template <typename ValueType>
+  using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
+  using InternalPage = BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator>;
+
+  explicit VerbatimKeyCodec(const KeyComparator &comparator) : comparator_(comparator) {}
+
+  auto GetStoredComparator() const -> const KeyComparator & { return comparator_; }
+  auto Encode(const KeyType &key) const -> const KeyType & { return key; }
+  auto Decode(const KeyType &stored_key) const -> const KeyType & { return stored_key; }
+  auto Separator(const KeyType &left __attribute__((unused)), const KeyType &right) const -> KeyType { return right; }
+
+ private:
+  KeyComparator comparator_;
+};
+
+/**
+ * A key encoded so that the order of its bytes, compared with memcmp, is the order of the key.
+ */
+template <size_t KeySize>
+class EncodedKey {
+ public:
+  // NOTE: for debug purpose only
+  friend auto operator<<(std::ostream &os, const EncodedKey &key) -> std::ostream & {
+    std::ios_base::fmtflags flags = os.flags();
+    os << std::hex << std::setfill('0');
+    for (size_t i = 0; i < KeySize; i++) {
+      os << std::setw(2) << static_cast<int>(static_cast<uint8_t>(key.data_[i]));
+    }
+    os.flags(flags);
+    return os;
+  }
+
+  char data_[KeySize];
+};
+
+/**
+ * Function object that compares two encoded keys byte by byte.
+ */
+template <size_t KeySize>
+class EncodedComparator {
+ public:
+  inline auto operator()(const EncodedKey<KeySize> &lhs, const EncodedKey<KeySize> &rhs) const -> int {
+    return memcmp(lhs.data_, rhs.data_, KeySize);
+  }
+};
+
+/**
+ * The codec of the compressed page format. Keys are encoded into byte strings that compare with memcmp, so the pages
+ * can keep the prefix shared by all keys of a page once (prefix truncation), drop the trailing zero bytes of each key,
+ * and store only the shortest key that separates two pages in their parent (suffix truncation). See
+ * BPlusTreeCompressedPage for the page format.
+ *
+ * Only GenericKey is supported, for keys whose columns all have a fixed length.
+ */
+template <typename KeyType, typename KeyComparator>
+class CompressedKeyCodec;
+
+template <size_t KeySize>
+class CompressedKeyCodec<GenericKey<KeySize>, GenericComparator<KeySize>> {
+ public:
+  using StoredKey = EncodedKey<KeySize>;
+  using StoredComparator = EncodedComparator<KeySize>;
+  template <typename ValueType>
+  using LeafPage = BPlusTreeCompressedLeafPage<StoredKey, ValueType, StoredComparator>;
+  using InternalPage = BPlusTreeCompressedInternalPage<StoredKey, page_id_t, StoredComparator>;
+
+  /** @throw NotImplementedException if a key column has a variable length */
+  explicit CompressedKeyCodec(const GenericComparator<KeySize> &comparator);
+
+  auto GetStoredComparator() const -> StoredComparator { return StoredComparator(); }
+
+  /**
+   * Every column is stored big-endian at its offset in the key, integers with their sign bit flipped and decimals with
+   * their sign bit flipped if positive and all their bits flipped if negative. NULL values, which the key comparator
+   * does not order, sort as the smallest values of their type.
+   */
+  auto Encode(const GenericKey<KeySize> &key) const -> StoredKey;
+  auto Decode(const StoredKey &stored_key) const -> GenericKey<KeySize>;
+
+  /** @return the shortest byte string greater than left and at most right, padded with zero bytes */
+  auto Separator(const StoredKey &left, const StoredKey &right) const -> StoredKey;
+
+ private:
+  Schema *key_schema_;
+};
+
+}  // namespace bustub
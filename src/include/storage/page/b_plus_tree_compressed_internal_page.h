@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_compressed_internal_page.h
+//
+// Identification: src/include/storage/page/b_plus_tree_compressed_internal_page.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "storage/page/b_plus_tree_compressed_page.h"
+
+namespace bustub {
+
+#define B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE BPlusTreeCompressedInternalPage<KeyType, ValueType, KeyComparator>
+
+/**
+ * The internal page of the compressed page format, with the interface of BPlusTreeInternalPage. Keys are compared
+ * byte by byte, so the comparator arguments are not used. See BPlusTreeCompressedPage for the format.
+ *
+ * The first key is invalid: it is left out of the prefix and dropped whenever the page is rewritten.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTreeCompressedInternalPage : public BPlusTreeCompressedPage<KeyType, ValueType, KeyComparator> {
+  using CompressedPage = BPlusTreeCompressedPage<KeyType, ValueType, KeyComparator>;
+
+ public:
+  // must call initialize method after "create" a new node
+  void Init(page_id_t page_id, page_id_t parent_id = INVALID_PAGE_ID, int max_size = CompressedPage::MIN_CAPACITY);
+
+  auto KeyAt(int index) const -> KeyType;
+  void SetKeyAt(int index, const KeyType &key);
+  auto CanSetKeyAt(int index, const KeyType &key) const -> bool;
+  auto ValueAt(int index) const -> ValueType;
+  void SetValueAt(int index, const ValueType &value);
+  auto ValueIndex(const ValueType &value) const -> int;
+
+  // lookup
+  auto Lookup(const KeyType &key, const KeyComparator &comparator) const -> ValueType;
+  // the child that covers the keys just below key
+  auto LookupBefore(const KeyType &key, const KeyComparator &comparator) const -> ValueType;
+
+  // insertion
+  auto HasRoomFor(const KeyType &key) const -> bool;
+  auto HasRoomForAnyKey() const -> bool;
+  void PopulateNewRoot(const ValueType &old_value, const KeyType &new_key, const ValueType &new_value);
+  void InsertAt(int index, const KeyType &new_key, const ValueType &new_value);
+  auto ReachedFillFactor(double fill_factor) const -> bool;
+
+  // deletion
+  void Remove(int index);
+
+  // split, merge and redistribute; the children that change pages get their parent page id updated
+  auto SplitInsert(int index, const KeyType &new_key, const ValueType &new_value,
+                   BPlusTreeCompressedInternalPage *recipient, BufferPoolManager *buffer_pool_manager) -> KeyType;
+  auto CanAbsorb(const BPlusTreeCompressedInternalPage *right, const KeyType &middle_key) const -> bool;
+  void MoveAllTo(BPlusTreeCompressedInternalPage *recipient, const KeyType &middle_key,
+                 BufferPoolManager *buffer_pool_manager);
+  void MoveFirstToEndOf(BPlusTreeCompressedInternalPage *recipient, const KeyType &middle_key,
+                        BufferPoolManager *buffer_pool_manager);
+  void MoveLastToFrontOf(BPlusTreeCompressedInternalPage *recipient, const KeyType &middle_key,
+                         BufferPoolManager *buffer_pool_manager);
+
+ private:
+  void AdoptChild(const ValueType &child, BufferPoolManager *buffer_pool_manager);
+};
+
+}  // namespace bustub
@@ -0,0 +1,64 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_compressed_leaf_page.h
+//
+// Identification: src/include/storage/page/b_plus_tree_compressed_leaf_page.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "storage/page/b_plus_tree_compressed_page.h"
+
+namespace bustub {
+
+#define B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE BPlusTreeCompressedLeafPage<KeyType, ValueType, KeyComparator>
+
+/**
+ * The leaf page of the compressed page format, with the interface of BPlusTreeLeafPage. Keys are compared byte by
+ * byte, so the comparator arguments are not used. See BPlusTreeCompressedPage for the format.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTreeCompressedLeafPage : public BPlusTreeCompressedPage<KeyType, ValueType, KeyComparator> {
+  using CompressedPage = BPlusTreeCompressedPage<KeyType, ValueType, KeyComparator>;
+
+ public:
+  // After creating a new leaf page from buffer pool, must call initialize
+  // method to set default values
+  void Init(page_id_t page_id, page_id_t parent_id = INVALID_PAGE_ID, int max_size = CompressedPage::MIN_CAPACITY);
+  // helper methods
+  auto GetNextPageId() const -> page_id_t;
+  void SetNextPageId(page_id_t next_page_id);
+  auto GetPrevPageId() const -> page_id_t;
+  void SetPrevPageId(page_id_t prev_page_id);
+  auto KeyAt(int index) const -> KeyType;
+  auto ValueAt(int index) const -> ValueType;
+  void SetValueAt(int index, const ValueType &value);
+  auto KeyIndex(const KeyType &key, const KeyComparator &comparator) const -> int;
+
+  // lookup
+  auto Lookup(const KeyType &key, ValueType *value, const KeyComparator &comparator) const -> bool;
+
+  // insertion; returns the size after the insertion, which is unchanged if the key already exists
+  auto HasRoomFor(const KeyType &key) const -> bool;
+  auto Insert(const KeyType &key, const ValueType &value, const KeyComparator &comparator) -> int;
+  void Append(const KeyType &key, const ValueType &value);
+  auto ReachedFillFactor(double fill_factor) const -> bool;
+
+  // deletion; returns the size after the deletion, which is unchanged if the key does not exist
+  auto RemoveAndDeleteRecord(const KeyType &key, const KeyComparator &comparator) -> int;
+
+  // split, merge and redistribute
+  void SplitInsert(const KeyType &key, const ValueType &value, BPlusTreeCompressedLeafPage *recipient,
+                   const KeyComparator &comparator);
+  auto CanAbsorb(const BPlusTreeCompressedLeafPage *right) const -> bool;
+  void MoveAllTo(BPlusTreeCompressedLeafPage *recipient);
+  void MoveFirstToEndOf(BPlusTreeCompressedLeafPage *recipient);
+  void MoveLastToFrontOf(BPlusTreeCompressedLeafPage *recipient);
+};
+
+}  // namespace bustub
@@ -0,0 +1,130 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_compressed_page.h
+//
+// Identification: src/include/storage/page/b_plus_tree_compressed_page.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "storage/page/b_plus_tree_page.h"
+
+namespace bustub {
+
+#define B_PLUS_TREE_COMPRESSED_PAGE_TYPE BPlusTreeCompressedPage<KeyType, ValueType, KeyComparator>
+#define COMPRESSED_PAGE_HEADER_SIZE 38
+
+/**
+ * The layout shared by the compressed leaf and internal pages (see CompressedKeyCodec). Keys are byte strings ordered
+ * by memcmp. The prefix shared by the keys of a page is stored once, after the header, and every entry stores the rest
+ * of its key without its trailing zero bytes, so entries have a variable size. A directory of 2-byte slots grows from
+ * the start of the data area and points at the entries, which grow from its end.
+ *
+ * Compressed page format (entries are stored in the order they were written, slots in key order):
+ *  -----------------------------------------------------------------------------------------------
+ * | HEADER | PREFIX | SLOT(1) | SLOT(2) | ... | SLOT(n) | free space | ENTRY(n) | ... | ENTRY(1) |
+ *  -----------------------------------------------------------------------------------------------
+ *  Entry format: | SuffixSize (1) | Suffix (SuffixSize) | Value |
+ *
+ *  Header format (size in byte, 38 bytes in total, then the prefix, which has room for a whole key):
+ *  --------------------------------------------------------------------------------------------------------------
+ * | B+ tree page header (24) | NextPageId (4) | PrevPageId (4) | PrefixSize (2) | HeapOffset (2) | EntryBytes (2) |
+ *  --------------------------------------------------------------------------------------------------------------
+ *
+ * A removed entry leaves a hole that is reclaimed when an insertion needs the space. An insertion whose key does not
+ * share the prefix rewrites the page with a shorter prefix. The capacity of a page is in bytes: its max size is the
+ * number of entries that fit in the page whatever the keys, which the tree uses for the min size of a page.
+ *
+ * Internal pages do not store their first key, which is invalid, and leave it out of the prefix.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTreeCompressedPage : public BPlusTreePage {
+ public:
+  static constexpr int KEY_SIZE = static_cast<int>(sizeof(KeyType));
+  /** The size of the area that holds the slots and the entries. */
+  static constexpr int DATA_SIZE = BUSTUB_PAGE_SIZE - COMPRESSED_PAGE_HEADER_SIZE - KEY_SIZE;
+  static constexpr int SLOT_SIZE = static_cast<int>(sizeof(uint16_t));
+  /** The size of an entry and its slot, with an empty suffix. */
+  static constexpr int MIN_ENTRY_SIZE = SLOT_SIZE + 1 + static_cast<int>(sizeof(ValueType));
+  /** The size of an entry and its slot, with a whole key as suffix. */
+  static constexpr int MAX_ENTRY_SIZE = MIN_ENTRY_SIZE + KEY_SIZE;
+  /** The most entries a page can hold. */
+  static constexpr int MAX_ENTRIES = DATA_SIZE / MIN_ENTRY_SIZE;
+  /** The number of entries a page can hold whatever the keys. */
+  static constexpr int MIN_CAPACITY = DATA_SIZE / MAX_ENTRY_SIZE;
+
+  /** @return the number of bytes of the data area taken by the slots and the entries */
+  auto UsedBytes() const -> int;
+
+ protected:
+  void InitCompressed(IndexPageType page_type, page_id_t page_id, page_id_t parent_id, int max_size);
+
+  // The first key that is stored and part of the prefix: 0 for leaf pages, 1 for internal pages.
+  auto FirstKey() const -> int { return IsLeafPage() ? 0 : 1; }
+
+  auto PrefixSize() const -> int;
+  auto StoredKeyAt(int index) const -> KeyType;
+  auto StoredValueAt(int index) const -> ValueType;
+  void SetStoredValueAt(int index, const ValueType &value);
+
+  // the index of the first valid key that is not less than key (upper is false), or greater than key (upper is true)
+  auto Search(const KeyType &key, bool upper) const -> int;
+  auto KeyEqualsAt(int index, const KeyType &key) const -> bool;
+
+  // the number of bytes UsedBytes() would return once key is inserted
+  auto BytesAfterInsert(const KeyType &key) const -> int;
+  // the caller makes sure that the entry fits, see BytesAfterInsert()
+  void InsertEntry(int index, const KeyType &key, const ValueType &value);
+  void RemoveEntry(int index);
+
+  void GetEntries(std::vector<MappingType> *entries) const;
+  // replace the content of the page with entries, which must fit
+  void Rebuild(typename std::vector<MappingType>::const_iterator begin,
+               typename std::vector<MappingType>::const_iterator end);
+  // the number of bytes a page holding entries uses; first_key is the FirstKey() of that page
+  static auto RequiredBytes(typename std::vector<MappingType>::const_iterator begin,
+                            typename std::vector<MappingType>::const_iterator end, int first_key) -> int;
+  // where to split entries that do not fit in one page so that both halves fit and hold at least min_size entries
+  static auto SplitPoint(const std::vector<MappingType> &entries, int first_key, int min_size) -> int;
+
+  // the sibling links of a leaf page, unused by internal pages
+  page_id_t next_page_id_;
+  page_id_t prev_page_id_;
+
+ private:
+  static auto CommonPrefixSize(const char *lhs, const char *rhs, int size) -> int;
+  static auto SignificantSize(const char *data, int size) -> int;
+
+  // Accessors of the slots and entries. They clamp what they read to the page, since optimistic readers may see a
+  // page that is being changed.
+  auto SlotAt(int index) const -> int;
+  void SetSlotAt(int index, int offset);
+  auto SuffixSizeAt(int index) const -> int;
+  auto SuffixAt(int index) const -> const char *;
+  auto EntrySizeAt(int index) const -> int;
+  // compare the suffix of the index-th key with the bytes of key past the prefix, whose significant size is key_size
+  auto CompareSuffixAt(int index, const KeyType &key, int key_size) const -> int;
+  // the size of the entry of key, without its slot; an entry that is not stored has an empty suffix
+  auto EntrySizeOf(const KeyType &key, bool stored) const -> int;
+  // write an entry that fits the prefix into the free space, which must be large enough
+  void WriteEntry(int index, const KeyType &key, const ValueType &value, bool stored);
+
+  uint16_t prefix_size_;
+  /** The offset of the lowest entry in data_. */
+  uint16_t heap_offset_;
+  /** The bytes taken by the live entries, without their slots. */
+  uint16_t entry_bytes_;
+  char prefix_[KEY_SIZE];
+  // Flexible array member for page data.
+  char data_[1];
+};
+
+}  // namespace bustub
@@ -35,14 +35,48 @@ namespace bustub {
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeInternalPage : public BPlusTreePage {
  public:
+  /** The most pairs a page can hold. */
+  static constexpr int MAX_ENTRIES = static_cast<int>(INTERNAL_PAGE_SIZE);
+
   // must call initialize method after "create" a new node
   void Init(page_id_t page_id, page_id_t parent_id = INVALID_PAGE_ID, int max_size = INTERNAL_PAGE_SIZE);
 
   auto KeyAt(int index) const -> KeyType;
   void SetKeyAt(int index, const KeyType &key);
+  auto CanSetKeyAt(int index, const KeyType &key) const -> bool;
   auto ValueAt(int index) const -> ValueType;
+  void SetValueAt(int index, const ValueType &value);
+  auto ValueIndex(const ValueType &value) const -> int;
+
+  // lookup
+  auto Lookup(const KeyType &key, const KeyComparator &comparator) const -> ValueType;
+  // the child that covers the keys just below key
+  auto LookupBefore(const KeyType &key, const KeyComparator &comparator) const -> ValueType;
+
+  // insertion
+  auto HasRoomFor(const KeyType &key) const -> bool;
+  auto HasRoomForAnyKey() const -> bool;
+  void PopulateNewRoot(const ValueType &old_value, const KeyType &new_key, const ValueType &new_value);
+  void InsertAt(int index, const KeyType &new_key, const ValueType &new_value);
+  auto ReachedFillFactor(double fill_factor) const -> bool;
+
+  // deletion
+  void Remove(int index);
+
+  // split, merge and redistribute; the children that change pages get their parent page id updated
+  auto SplitInsert(int index, const KeyType &new_key, const ValueType &new_value, BPlusTreeInternalPage *recipient,
+                   BufferPoolManager *buffer_pool_manager) -> KeyType;
+  auto CanAbsorb(const BPlusTreeInternalPage *right, const KeyType &middle_key) const -> bool;
+  void MoveTailTo(BPlusTreeInternalPage *recipient, int from_index, BufferPoolManager *buffer_pool_manager);
+  void MoveAllTo(BPlusTreeInternalPage *recipient, const KeyType &middle_key, BufferPoolManager *buffer_pool_manager);
+  void MoveFirstToEndOf(BPlusTreeInternalPage *recipient, const KeyType &middle_key,
+                        BufferPoolManager *buffer_pool_manager);
+  void MoveLastToFrontOf(BPlusTreeInternalPage *recipient, const KeyType &middle_key,
+                         BufferPoolManager *buffer_pool_manager);
 
  private:
+  void AdoptChild(const ValueType &child, BufferPoolManager *buffer_pool_manager);
+
   // Flexible array member for page data.
   MappingType array_[1];
 };
@@ -0,0 +1,140 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_key_search.h
+//
+// Identification: src/include/storage/page/b_plus_tree_key_search.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "storage/index/generic_key.h"
+
+namespace bustub {
+
+/**
+ * Search kernels for sorted integer keys spread over an array of entries: the key of entry i is the first bytes of
+ * keys + i * stride. They run a branchless binary search down to a window of a few entries, then count the keys of the
+ * window that are below the bound with AVX2 if the CPU has it, or with scalar code otherwise.
+ * @return the number of keys that are less than key, or less than or equal to key if upper is true
+ */
+auto IntegerKeySearch(const char *keys, size_t stride, int size, int32_t key, bool upper) -> int;
+auto IntegerKeySearch(const char *keys, size_t stride, int size, int64_t key, bool upper) -> int;
+
+/**
+ * Binary search within the sorted entries of a b+ tree page that compares keys with the comparator, one key at a time.
+ * Entry is a key & value pair whose first member is the key.
+ */
+template <typename KeyType, typename KeyComparator>
+class ComparatorKeySearch {
+ public:
+  /** @return the index of the first entry whose key is >= key, or size if there is none */
+  template <typename Entry>
+  static auto LowerBound(const Entry *entries, int size, const KeyType &key, const KeyComparator &comparator) -> int {
+    int low = 0;
+    int high = size;
+    while (low < high) {
+      int mid = low + (high - low) / 2;
+      if (comparator(entries[mid].first, key) < 0) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+
+  /** @return the index of the first entry whose key is > key, or size if there is none */
+  template <typename Entry>
+  static auto UpperBound(const Entry *entries, int size, const KeyType &key, const KeyComparator &comparator) -> int {
+    int low = 0;
+    int high = size;
+    while (low < high) {
+      int mid = low + (high - low) / 2;
+      if (comparator(entries[mid].first, key) <= 0) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+
+  static auto Equals(const KeyType &lhs, const KeyType &rhs, const KeyComparator &comparator) -> bool {
+    return comparator(lhs, rhs) == 0;
+  }
+};
+
+/**
+ * Search within the sorted entries of a b+ tree page. The primary template is the comparator search; specializations
+ * on the comparator replace it with faster kernels for the keys they know how to compare.
+ */
+template <typename KeyType, typename KeyComparator>
+class KeySearch : public ComparatorKeySearch<KeyType, KeyComparator> {};
+
+/**
+ * GenericComparator compares keys column by column through Values. A key that is a single INTEGER or BIGINT column
+ * (see GenericComparator::GetIntegerKeySize()) is compared as a plain integer instead, by the integer search kernels.
+ * A NULL key is the smallest integer of its type, which orders it before every other key, as the comparator does.
+ */
+template <size_t KeySize>
+class KeySearch<GenericKey<KeySize>, GenericComparator<KeySize>> {
+  using KeyType = GenericKey<KeySize>;
+  using KeyComparator = GenericComparator<KeySize>;
+  using ComparatorSearch = ComparatorKeySearch<KeyType, KeyComparator>;
+
+ public:
+  template <typename Entry>
+  static auto LowerBound(const Entry *entries, int size, const KeyType &key, const KeyComparator &comparator) -> int {
+    return Search(entries, size, key, comparator, false);
+  }
+
+  template <typename Entry>
+  static auto UpperBound(const Entry *entries, int size, const KeyType &key, const KeyComparator &comparator) -> int {
+    return Search(entries, size, key, comparator, true);
+  }
+
+  static auto Equals(const KeyType &lhs, const KeyType &rhs, const KeyComparator &comparator) -> bool {
+    uint32_t integer_key_size = comparator.GetIntegerKeySize();
+    if (integer_key_size != 0) {
+      return memcmp(lhs.data_, rhs.data_, integer_key_size) == 0;
+    }
+    return comparator(lhs, rhs) == 0;
+  }
+
+ private:
+  template <typename Entry>
+  static auto Search(const Entry *entries, int size, const KeyType &key, const KeyComparator &comparator, bool upper)
+      -> int {
+    uint32_t integer_key_size = comparator.GetIntegerKeySize();
+    if (integer_key_size == 4) {
+      return IntegerKeySearch(reinterpret_cast<const char *>(&entries[0].first), sizeof(Entry), size,
+                              Load<int32_t>(key), upper);
+    }
+    if constexpr (KeySize >= sizeof(int64_t)) {
+      if (integer_key_size == 8) {
+        return IntegerKeySearch(reinterpret_cast<const char *>(&entries[0].first), sizeof(Entry), size,
+                                Load<int64_t>(key), upper);
+      }
+    }
+    return upper ? ComparatorSearch::UpperBound(entries, size, key, comparator)
+                 : ComparatorSearch::LowerBound(entries, size, key, comparator);
+  }
+
+  template <typename Int>
+  static auto Load(const KeyType &key) -> Int {
+    Int value;
+    memcpy(&value, key.data_, sizeof(Int));
+    return value;
+  }
+};
+
+}  // namespace bustub
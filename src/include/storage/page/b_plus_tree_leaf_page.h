@@ -18,26 +18,29 @@
 namespace bustub {
 
 #define B_PLUS_TREE_LEAF_PAGE_TYPE BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>
-#define LEAF_PAGE_HEADER_SIZE 28
+#define LEAF_PAGE_HEADER_SIZE 32
 #define LEAF_PAGE_SIZE ((BUSTUB_PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / sizeof(MappingType))
 
 /**
  * Store indexed key and record id(record id = page id combined with slot id,
  * see include/common/rid.h for detailed implementation) together within leaf
- * page. Only support unique key.
+ * page. Only support unique key: a tree with duplicate keys stores the posting
+ * list of each key as its value (see PostingList).
  *
  * Leaf page format (keys are stored in order):
  *  ----------------------------------------------------------------------
  * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
  *  ----------------------------------------------------------------------
  *
- *  Header format (size in byte, 28 bytes in total):
+ *  Header format (size in byte, 32 bytes in total):
  *  ---------------------------------------------------------------------
  * | PageType (4) | LSN (4) | CurrentSize (4) | MaxSize (4) |
  *  ---------------------------------------------------------------------
- *  -----------------------------------------------
- * | ParentPageId (4) | PageId (4) | NextPageId (4)
- *  -----------------------------------------------
+ *  ----------------------------------------------------------------
+ * | ParentPageId (4) | PageId (4) | NextPageId (4) | PrevPageId (4)
+ *  ----------------------------------------------------------------
+ *
+ * The leaves of a tree are linked both ways, so that they can be scanned in either direction.
  */
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeLeafPage : public BPlusTreePage {
@@ -48,10 +51,39 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   // helper methods
   auto GetNextPageId() const -> page_id_t;
   void SetNextPageId(page_id_t next_page_id);
+  auto GetPrevPageId() const -> page_id_t;
+  void SetPrevPageId(page_id_t prev_page_id);
   auto KeyAt(int index) const -> KeyType;
+  auto ValueAt(int index) const -> ValueType;
+  void SetValueAt(int index, const ValueType &value);
+  auto GetItem(int index) -> const MappingType &;
+  auto KeyIndex(const KeyType &key, const KeyComparator &comparator) const -> int;
+
+  // lookup
+  auto Lookup(const KeyType &key, ValueType *value, const KeyComparator &comparator) const -> bool;
+
+  // insertion; returns the size after the insertion, which is unchanged if the key already exists
+  auto HasRoomFor(const KeyType &key) const -> bool;
+  auto Insert(const KeyType &key, const ValueType &value, const KeyComparator &comparator) -> int;
+  // append a pair whose key is greater than every key of the page, as a bulk load does
+  void Append(const KeyType &key, const ValueType &value);
+  auto ReachedFillFactor(double fill_factor) const -> bool;
+
+  // deletion; returns the size after the deletion, which is unchanged if the key does not exist
+  auto RemoveAndDeleteRecord(const KeyType &key, const KeyComparator &comparator) -> int;
+
+  // split, merge and redistribute
+  void SplitInsert(const KeyType &key, const ValueType &value, BPlusTreeLeafPage *recipient,
+                   const KeyComparator &comparator);
+  auto CanAbsorb(const BPlusTreeLeafPage *right) const -> bool;
+  void MoveTailTo(BPlusTreeLeafPage *recipient, int from_index);
+  void MoveAllTo(BPlusTreeLeafPage *recipient);
+  void MoveFirstToEndOf(BPlusTreeLeafPage *recipient);
+  void MoveLastToFrontOf(BPlusTreeLeafPage *recipient);
 
  private:
   page_id_t next_page_id_;
+  page_id_t prev_page_id_;
   // Flexible array member for page data.
   MappingType array_[1];
 };
@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_posting_page.h
+//
+// Identification: src/include/storage/page/b_plus_tree_posting_page.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+
+namespace bustub {
+
+#define POSTING_PAGE_HEADER_SIZE 8
+
+/**
+ * A page of the overflow chain of a posting list (see PostingList). Only the first page of a chain may be partly
+ * filled, so that values are added to and taken from that page alone.
+ *
+ * Posting page format:
+ *  --------------------------------------------------------------
+ * | NextPageId (4) | Size (4) | VALUE(1) | VALUE(2) | ... | VALUE(n) |
+ *  --------------------------------------------------------------
+ */
+template <typename ValueType>
+class BPlusTreePostingPage {
+ public:
+  static constexpr int CAPACITY = (BUSTUB_PAGE_SIZE - POSTING_PAGE_HEADER_SIZE) / sizeof(ValueType);
+
+  void Init(page_id_t next_page_id);
+  auto GetNextPageId() const -> page_id_t { return next_page_id_; }
+  auto GetSize() const -> int { return size_; }
+
+  /** @return true if value is the only value of the list */
+  auto HoldsOnly(const ValueType &value) const -> bool { return size_ == 1 && values_[0] == value; }
+  auto IsFull() const -> bool { return size_ == CAPACITY; }
+  auto ValueAt(int index) const -> const ValueType & { return values_[index]; }
+  void SetValueAt(int index, const ValueType &value) { values_[index] = value; }
+  void Append(const ValueType &value) { values_[size_++] = value; }
+  void RemoveLast() { size_--; }
+
+ private:
+  page_id_t next_page_id_;
+  int size_;
+  // Flexible array member for page data.
+  ValueType values_[1];
+};
+
+/**
+ * The values of a key in a b+ tree that allows duplicate keys, stored as the value of the key's leaf entry. The
+ * first POSTING_LIST_INLINE_SIZE values live in the entry itself, so the many keys that have only a few values take
+ * no more than a fixed-size slot of their leaf. Once a list grows past that, the rest of its values overflow into a
+ * chain of posting pages that belongs to the entry and moves with it.
+ *
+ * The values of a list are not ordered: a removed value is replaced with the last one. The overflow pages are only
+ * reached through the entry, so the latch of the leaf page that holds the entry protects them too.
+ */
+template <typename ValueType>
+class PostingList {
+ public:
+  using PostingPage = BPlusTreePostingPage<ValueType>;
+
+  /** @return a list that holds value only */
+  static auto Of(const ValueType &value) -> PostingList;
+
+  auto GetSize() const -> int { return size_; }
+
+  /** @return true if value is the only value of the list */
+  auto HoldsOnly(const ValueType &value) const -> bool { return size_ == 1 && values_[0] == value; }
+
+  /** Add value, which the caller makes sure is not in the list yet, allocating an overflow page if needed. */
+  void Add(const ValueType &value, BufferPoolManager *buffer_pool_manager);
+
+  /**
+   * Remove value from the list, which must not become empty: the caller removes the whole entry instead.
+   * @return false if value is not in the list
+   */
+  auto Remove(const ValueType &value, BufferPoolManager *buffer_pool_manager) -> bool;
+
+  /** Append every value of the list to result. */
+  void GetValues(std::vector<ValueType> *result, BufferPoolManager *buffer_pool_manager) const;
+
+  /** Delete the overflow pages of the list, whose entry is being removed. */
+  void Free(BufferPoolManager *buffer_pool_manager);
+
+ private:
+  static auto FetchPage(page_id_t page_id, BufferPoolManager *buffer_pool_manager) -> Page *;
+
+  int size_;
+  /** The first page of the overflow chain, or INVALID_PAGE_ID if every value is inline. */
+  page_id_t overflow_page_id_;
+  ValueType values_[POSTING_LIST_INLINE_SIZE];
+};
+
+}  // namespace bustub
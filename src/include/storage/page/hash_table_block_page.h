@@ -71,11 +71,13 @@ class HashTableBlockPage {
   auto Insert(slot_offset_t bucket_ind, const KeyType &key, const ValueType &value) -> bool;
 
   /**
-   * Removes a key and value at index.
+   * Removes a key and value at index, leaving a tombstone. The remove is thread safe: of concurrent removes of the
+   * same index, only one succeeds.
    *
    * @param bucket_ind ind to remove the value
+   * @return true if the index held a key and value, false if it was not readable
    */
-  void Remove(slot_offset_t bucket_ind);
+  auto Remove(slot_offset_t bucket_ind) -> bool;
 
   /**
    * Returns whether or not an index is occupied (key/value pair or tombstone)
@@ -30,8 +30,14 @@ namespace bustub {
  *  ----------------------------------------------------------------
  *
  *  Here '+' means concatenation.
- *  The above format omits the space required for the occupied_ and
- *  readable_ arrays. More information is in storage/page/hash_table_page_defs.h.
+ *  The above format omits the space required for the overflow page id and
+ *  the occupied_ and readable_ arrays. More information is in
+ *  storage/page/hash_table_page_defs.h.
+ *
+ * A bucket whose pairs cannot be split apart, such as the values of a single
+ * key that outgrow one page, links overflow pages of the same format. The
+ * bucket page in the directory and its overflow pages form the chain of the
+ * bucket.
  *
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
@@ -40,6 +46,23 @@ class HashTableBucketPage {
   // Delete all constructor / destructor to ensure memory safety
   HashTableBucketPage() = delete;
 
+  /**
+   * Sets up a zeroed page as an empty bucket page without overflow pages.
+   */
+  void Init();
+
+  /**
+   * @return the page id of the next page of the chain of this bucket, or INVALID_PAGE_ID if this is the last one
+   */
+  auto GetOverflowPageId() const -> page_id_t;
+
+  /**
+   * Links the next page of the chain of this bucket.
+   *
+   * @param overflow_page_id the page id of the next page, or INVALID_PAGE_ID
+   */
+  void SetOverflowPageId(page_id_t overflow_page_id);
+
   /**
    * Scan the bucket and collect values that have the matching key
    *
@@ -138,6 +161,8 @@ class HashTableBucketPage {
   void PrintBucket();
 
  private:
+  // The next page of the chain of this bucket
+  page_id_t overflow_page_id_;
   //  For more on BUCKET_ARRAY_SIZE see storage/page/hash_table_page_defs.h
   char occupied_[(BUCKET_ARRAY_SIZE - 1) / 8 + 1];
   // 0 if tombstone/brand new (never occupied), 1 otherwise.
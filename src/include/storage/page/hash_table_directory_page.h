@@ -30,6 +30,9 @@ namespace bustub {
  * --------------------------------------------------------------------------------------------
  * | LSN (4) | PageId(4) | GlobalDepth(4) | LocalDepths(512) | BucketPageIds(2048) | Free(1524)
  * --------------------------------------------------------------------------------------------
+ *
+ * The bucket page ids and local depths are read and written atomically, so that a reader may look up a bucket while
+ * another thread splits or merges a different one. Only a change of the global depth needs the directory to itself.
  */
 class HashTableDirectoryPage {
  public:
@@ -74,7 +77,8 @@ class HashTableDirectoryPage {
   void SetBucketPageId(uint32_t bucket_idx, page_id_t bucket_page_id);
 
   /**
-   * Gets the split image of an index
+   * Gets the split image of an index: the index of the bucket that was split from the same bucket, at the local depth
+   * of the bucket at bucket_idx
    *
    * @param bucket_idx the directory index for which to find the split image
    * @return the directory index of the split image
@@ -114,7 +118,8 @@ class HashTableDirectoryPage {
   auto GetGlobalDepth() -> uint32_t;
 
   /**
-   * Increment the global depth of the directory
+   * Increment the global depth of the directory, which doubles it: the new half points to the same buckets as the old
+   * half
    */
   void IncrGlobalDepth();
 
@@ -167,7 +172,7 @@ class HashTableDirectoryPage {
    * is helpful for finding the pair, or "split image", of a bucket.
    *
    * @param bucket_idx bucket index to lookup
-   * @return the high bit corresponding to the bucket's local depth
+   * @return the high bit corresponding to the bucket's local depth, 1 << (local depth - 1), or 0 at local depth 0
    */
   auto GetLocalHighBit(uint32_t bucket_idx) -> uint32_t;
 
@@ -26,10 +26,16 @@ namespace bustub {
  *
  * Header Page for linear probing hash table.
  *
- * Header format (size in byte, 16 bytes in total):
- * -------------------------------------------------------------
- * | LSN (4) | Size (4) | PageId(4) | NextBlockIndex(4)
- * -------------------------------------------------------------
+ * Header format (size in byte, 64 bytes in total):
+ * ---------------------------------------------------------------------------------------------------------
+ * | LSN (4) | Size (8) | PageId(4) | NextBlockIndex(8) | ResizePageId(4) | Migrated(8) | NumReadable(8) |
+ * ---------------------------------------------------------------------------------------------------------
+ * | NumOccupied(8) | BlockPageIds(4) ... |
+ * ---------------------------------------------------------------------------------------------------------
+ *
+ * While the table grows, the header page of the old table points to the header page of the new one, and counts how
+ * many slots of the old table have been migrated to it. The counts of readable and occupied slots are updated
+ * atomically, since inserts and removes that do not resize the table run concurrently.
  */
 class HashTableHeaderPage {
  public:
@@ -89,13 +95,63 @@ class HashTableHeaderPage {
    */
   auto NumBlocks() -> size_t;
 
+  /**
+   * @return the page ID of the header page of the table this one is being migrated to, or INVALID_PAGE_ID
+   */
+  auto GetResizePageId() const -> page_id_t;
+
+  /**
+   * Sets the page ID of the header page of the table this one is being migrated to
+   *
+   * @param page_id the page id of the new header page, or INVALID_PAGE_ID
+   */
+  void SetResizePageId(page_id_t page_id);
+
+  /**
+   * @return the number of slots, from the first one, that have been migrated to the new table
+   */
+  auto GetMigrated() const -> size_t;
+
+  /**
+   * Sets the number of slots that have been migrated to the new table
+   *
+   * @param migrated the number of migrated slots
+   */
+  void SetMigrated(size_t migrated);
+
+  /**
+   * @return the number of slots that hold a key/value pair
+   */
+  auto GetNumReadable() const -> size_t;
+
+  /**
+   * Atomically adds delta to the number of slots that hold a key/value pair
+   */
+  void AddNumReadable(int64_t delta);
+
+  /**
+   * @return the number of slots that hold a key/value pair or a tombstone
+   */
+  auto GetNumOccupied() const -> size_t;
+
+  /**
+   * Atomically adds delta to the number of slots that hold a key/value pair or a tombstone
+   *
+   * @return the number before the addition
+   */
+  auto AddNumOccupied(int64_t delta) -> size_t;
+
  private:
-  __attribute__((unused)) lsn_t lsn_;
-  __attribute__((unused)) size_t size_;
-  __attribute__((unused)) page_id_t page_id_;
-  __attribute__((unused)) size_t next_ind_;
+  lsn_t lsn_;
+  size_t size_;
+  page_id_t page_id_;
+  size_t next_ind_;
+  page_id_t resize_page_id_;
+  size_t migrated_;
+  size_t num_readable_;
+  size_t num_occupied_;
   // Flexible array member for page data.
-  __attribute__((unused)) page_id_t block_page_ids_[1];
+  page_id_t block_page_ids_[1];
 };
 
 }  // namespace bustub
@@ -12,8 +12,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstring>
 #include <iostream>
+#include <new>
 
 #include "common/config.h"
 #include "common/rwlatch.h"
@@ -30,11 +32,14 @@ class Page {
   friend class BufferPoolManagerInstance;
 
  public:
-  /** Constructor. Zeros out the page data. */
-  Page() { ResetMemory(); }
+  /** Constructor. Allocates a BUSTUB_PAGE_ALIGNMENT aligned buffer so the page can be used for O_DIRECT I/O. */
+  Page() : data_(new(std::align_val_t{BUSTUB_PAGE_ALIGNMENT}) char[BUSTUB_PAGE_SIZE]) { ResetMemory(); }
 
-  /** Default destructor. */
-  ~Page() = default;
+  /** Destructor. Frees the page buffer. */
+  ~Page() { ::operator delete[](data_, std::align_val_t{BUSTUB_PAGE_ALIGNMENT}); }
+
+  Page(const Page &) = delete;
+  auto operator=(const Page &) -> Page & = delete;
 
   /** @return the actual data contained within this page */
   inline auto GetData() -> char * { return data_; }
@@ -48,18 +53,45 @@ class Page {
   /** @return true if the page in memory has been modified from the page on disk, false otherwise */
   inline auto IsDirty() -> bool { return is_dirty_; }
 
-  /** Acquire the page write latch. */
-  inline void WLatch() { rwlatch_.WLock(); }
+  /** Acquire the page write latch. Bumps the page version to an odd value. */
+  inline void WLatch() {
+    rwlatch_.WLock();
+    version_.fetch_add(1);
+  }
 
-  /** Release the page write latch. */
-  inline void WUnlatch() { rwlatch_.WUnlock(); }
+  /** Release the page write latch. Bumps the page version back to an even value. */
+  inline void WUnlatch() {
+    version_.fetch_add(1);
+    rwlatch_.WUnlock();
+  }
 
   /** Acquire the page read latch. */
   inline void RLatch() { rwlatch_.RLock(); }
 
+  /** Acquire the page read latch unless a writer holds it. @return true if the latch was acquired */
+  inline auto TryRLatch() -> bool { return rwlatch_.TryRLock(); }
+
   /** Release the page read latch. */
   inline void RUnlatch() { rwlatch_.RUnlock(); }
 
+  /**
+   * Optimistic readers read the page without latching it: they read the version before and after reading the page,
+   * and the read is consistent only if the version was even and did not change in between. The version is bumped by
+   * every write latch, so it also changes when the page is merely write latched. The caller must keep the page pinned.
+   * @return the version of the page, odd while a writer holds the write latch
+   */
+  inline auto GetVersion() const -> uint64_t { return version_.load(); }
+
+  /**
+   * Check that an optimistic read that started at the given version is still consistent.
+   * @param version the version read before reading the page
+   * @return true if no writer latched the page since version was read
+   */
+  inline auto ValidateVersion(uint64_t version) const -> bool {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return version_.load(std::memory_order_relaxed) == version;
+  }
+
   /** @return the page LSN. */
   inline auto GetLSN() -> lsn_t { return *reinterpret_cast<lsn_t *>(GetData() + OFFSET_LSN); }
 
@@ -78,16 +110,18 @@ class Page {
   /** Zeroes out the data that is held within the page. */
   inline void ResetMemory() { memset(data_, OFFSET_PAGE_START, BUSTUB_PAGE_SIZE); }
 
-  /** The actual data that is stored within a page. */
-  char data_[BUSTUB_PAGE_SIZE]{};
+  /** The actual data that is stored within a page, aligned to BUSTUB_PAGE_ALIGNMENT. */
+  char *data_;
   /** The ID of this page. */
   page_id_t page_id_ = INVALID_PAGE_ID;
-  /** The pin count of this page. */
-  int pin_count_ = 0;
+  /** The pin count of this page. Atomic, as the buffer pool pins resident pages without holding its latch. */
+  std::atomic<int> pin_count_{0};
   /** True if the page is dirty, i.e. it is different from its corresponding page on disk. */
   bool is_dirty_ = false;
   /** Page latch. */
   ReaderWriterLatch rwlatch_;
+  /** Version of the page contents for optimistic readers. Kept across page replacements, so it never goes back. */
+  std::atomic<uint64_t> version_{0};
 };
 
 }  // namespace bustub
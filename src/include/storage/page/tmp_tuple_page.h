@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstring>
+
 #include "storage/page/page.h"
 #include "storage/table/tmp_tuple.h"
 #include "storage/table/tuple.h"
@@ -17,20 +19,55 @@ namespace bustub {
  * | PageId (4) | LSN (4) | FreeSpace (4) | (free space) | TupleSize2 | TupleData2 | TupleSize1 | TupleData1 |
  *
  * We choose this format because DeserializeExpression expects to read Size followed by Data.
+ *
+ * FreeSpace is the offset of the tuple inserted last. The tuples of a page are read starting there, each one followed
+ * by the one inserted before it, up to the end of the page.
  */
 class TmpTuplePage : public Page {
  public:
   void Init(page_id_t page_id, uint32_t page_size) {
     memcpy(GetData(), &page_id, sizeof(page_id_t));
-    memcpy(GetData() + sizeof(page_id_t), &page_size, sizeof(uint32_t));
+    memset(GetData() + OFFSET_LSN, 0, sizeof(lsn_t));
+    SetFreeSpacePointer(page_size);
+  }
+
+  auto GetTablePageId() -> page_id_t { return *reinterpret_cast<page_id_t *>(GetData()); }
+
+  /**
+   * Insert a tuple into the page.
+   * @param tuple the tuple to insert
+   * @param[out] out where the tuple was stored
+   * @return false if the page has no room for the tuple
+   */
+  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool {
+    uint32_t size = sizeof(uint32_t) + tuple.GetLength();
+    uint32_t free_space_pointer = GetFreeSpacePointer();
+    if (free_space_pointer < SIZE_HEADER + size) {
+      return false;
+    }
+    free_space_pointer -= size;
+    tuple.SerializeTo(GetData() + free_space_pointer);
+    SetFreeSpacePointer(free_space_pointer);
+    *out = TmpTuple(GetTablePageId(), free_space_pointer);
+    return true;
   }
 
-  auto GetTablePageId() -> page_id_t { return INVALID_PAGE_ID; }
+  /** Read the tuple stored at tmp_tuple, which must be on this page, into tuple. */
+  void Get(const TmpTuple &tmp_tuple, Tuple *tuple) { tuple->DeserializeFrom(GetData() + tmp_tuple.GetOffset()); }
 
-  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool { return false; }
+  /** @return the offset of the tuple inserted last, or the page size if there are none */
+  auto GetFreeSpacePointer() -> uint32_t { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
 
  private:
   static_assert(sizeof(page_id_t) == 4);
+
+  void SetFreeSpacePointer(uint32_t free_space_pointer) {
+    memcpy(GetData() + OFFSET_FREE_SPACE, &free_space_pointer, sizeof(uint32_t));
+  }
+
+  static constexpr size_t OFFSET_LSN = 4;
+  static constexpr size_t OFFSET_FREE_SPACE = 8;
+  static constexpr size_t SIZE_HEADER = 12;
 };
 
 }  // namespace bustub
@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// spill_partitions.h
+//
+// Identification: src/include/storage/table/spill_partitions.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/util/hash_util.h"
+#include "storage/table/tmp_tuple_file.h"
+
+namespace bustub {
+
+/**
+ * SpillPartitions hashes the tuples that an executor cannot keep in memory into partitions of TmpTupleFiles, and keeps
+ * the partitions left to process. Every partition has a file for each input of the executor, e.g. for the left and
+ * the right tuples of a hash join, and the tuples whose keys hash alike go to the partitions with the same index.
+ *
+ * A partition that is still too large for memory is partitioned again with a hash of its own for every depth, up to
+ * MAX_DEPTH times; past that its keys are too skewed to split, and the executor processes it in memory anyway.
+ */
+class SpillPartitions {
+ public:
+  /** The most partitions the tuples are hashed into at a time */
+  static constexpr size_t MAX_FANOUT = 16;
+  /** The most times the tuples of a partition are partitioned again */
+  static constexpr size_t MAX_DEPTH = 4;
+
+  /** A file for each input of the tuples with the same hashes */
+  struct Partition {
+    std::vector<std::unique_ptr<TmpTupleFile>> files_;
+    /** How many times the tuples were partitioned */
+    size_t depth_{0};
+  };
+
+  /**
+   * @param bpm the buffer pool the files are written to, nullptr if the executor cannot spill
+   * @param num_files the number of files of every partition
+   */
+  SpillPartitions(BufferPoolManager *bpm, size_t num_files);
+
+  /** @return false if there is no buffer pool to spill to */
+  auto CanSpill() const -> bool { return fanout_ > 0; }
+
+  /** @return fanout empty partitions for tuples hashed at depth */
+  auto MakePartitions(size_t depth) const -> std::vector<Partition>;
+
+  /** @return the index of the partition of a key with the given hash at depth */
+  auto PartitionOf(hash_t hash, size_t depth) const -> size_t;
+
+  /** Finish writing the partitions, and add those for which keep returns true to the pending ones. */
+  void AddPending(std::vector<Partition> *parts, const std::function<bool(const Partition &)> &keep);
+
+  /** Take the partition that was added last out of the pending ones. @return false if there are none */
+  auto PopPending(Partition *part) -> bool;
+
+  /** Drop the pending partitions, deleting their files. */
+  void Clear() { pending_.clear(); }
+
+ private:
+  BufferPoolManager *bpm_;
+  size_t num_files_;
+  /** Spilling takes a frame of the buffer pool for every file being written, so only a few are written at a time. */
+  size_t fanout_;
+  /** The partitions left to process */
+  std::vector<Partition> pending_;
+};
+
+}  // namespace bustub
@@ -12,6 +12,10 @@
 
 #pragma once
 
+#include <mutex>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
 #include "buffer/buffer_pool_manager.h"
 #include "recovery/log_manager.h"
 #include "storage/page/table_page.h"
@@ -55,9 +59,10 @@ class TableHeap {
    * @param tuple tuple to insert
    * @param[out] rid the rid of the inserted tuple
    * @param txn the transaction performing the insert
+   * @param ring the buffer ring of a bulk insert, nullptr to go through the buffer pool like any other access
    * @return true iff the insert is successful
    */
-  auto InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> bool;
+  auto InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn, BufferRing *ring = nullptr) -> bool;
 
   /**
    * Mark the tuple as deleted. The actual delete will occur when ApplyDelete is called.
@@ -95,12 +100,20 @@ class TableHeap {
    * @param rid rid of the tuple to read
    * @param tuple output variable for the tuple
    * @param txn transaction performing the read
+   * @param acquire_read_lock whether to latch the page, false if the caller already holds its latch
+   * @param ring the buffer ring of a large scan, nullptr to go through the buffer pool like any other access
    * @return true if the read was successful (i.e. the tuple exists)
    */
-  auto GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, bool acquire_read_lock = true) -> bool;
+  auto GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, bool acquire_read_lock = true,
+                BufferRing *ring = nullptr) -> bool;
 
-  /** @return the begin iterator of this table */
-  auto Begin(Transaction *txn) -> TableIterator;
+  /**
+   * @param txn the transaction performing the scan
+   * @param ring the buffer ring of a large scan, nullptr to go through the buffer pool like any other access. A scan
+   * through a ring does not read ahead, since the pages read ahead would not be confined to the ring.
+   * @return the begin iterator of this table
+   */
+  auto Begin(Transaction *txn, BufferRing *ring = nullptr) -> TableIterator;
 
   /** @return the end iterator of this table */
   auto End() -> TableIterator;
@@ -108,11 +121,36 @@ class TableHeap {
   /** @return the id of the first page of this table */
   inline auto GetFirstPageId() const -> page_id_t { return first_page_id_; }
 
+  /**
+   * Record that page_id follows prev_page_id in the page chain. Only extends the known chain, i.e. does nothing unless
+   * prev_page_id is the last page known so far.
+   * @param prev_page_id the page linking to page_id
+   * @param page_id the next page
+   */
+  void AppendPageId(page_id_t prev_page_id, page_id_t page_id);
+
+  /**
+   * @param page_id a page of this table
+   * @param count the maximum number of pages to return
+   * @return the ids of up to count pages that follow page_id in the page chain, as far as the chain is known
+   */
+  auto GetNextPageIds(page_id_t page_id, size_t count) -> std::vector<page_id_t>;
+
  private:
   BufferPoolManager *buffer_pool_manager_;
   LockManager *lock_manager_;
   LogManager *log_manager_;
   page_id_t first_page_id_{};
+
+  /**
+   * The page chain in memory, so that a scan can read ahead the pages it will visit next. A created table knows its
+   * whole chain, the pages of an opened table become known as they are visited.
+   */
+  std::vector<page_id_t> page_ids_;
+  /** Position of every page of page_ids_. */
+  std::unordered_map<page_id_t, size_t> page_positions_;
+  /** Protects page_ids_ and page_positions_. */
+  std::mutex page_ids_latch_;
 };
 
 }  // namespace bustub
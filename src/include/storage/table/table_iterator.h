@@ -14,6 +14,7 @@
 
 #include <cassert>
 
+#include "buffer/buffer_ring.h"
 #include "common/rid.h"
 #include "concurrency/transaction.h"
 #include "storage/table/tuple.h"
@@ -29,10 +30,16 @@ class TableIterator {
   friend class Cursor;
 
  public:
-  TableIterator(TableHeap *table_heap, RID rid, Transaction *txn);
+  TableIterator(TableHeap *table_heap, RID rid, Transaction *txn, BufferRing *ring = nullptr);
 
   TableIterator(const TableIterator &other)
-      : table_heap_(other.table_heap_), tuple_(new Tuple(*other.tuple_)), txn_(other.txn_) {}
+      : table_heap_(other.table_heap_),
+        tuple_(new Tuple(*other.tuple_)),
+        txn_(other.txn_),
+        ring_(other.ring_),
+        read_ahead_window_(other.read_ahead_window_),
+        read_ahead_end_(other.read_ahead_end_),
+        read_ahead_pending_(other.read_ahead_pending_) {}
 
   ~TableIterator() { delete tuple_; }
 
@@ -54,13 +61,32 @@ class TableIterator {
     table_heap_ = other.table_heap_;
     *tuple_ = *other.tuple_;
     txn_ = other.txn_;
+    ring_ = other.ring_;
+    read_ahead_window_ = other.read_ahead_window_;
+    read_ahead_end_ = other.read_ahead_end_;
+    read_ahead_pending_ = other.read_ahead_pending_;
     return *this;
   }
 
  private:
+  /**
+   * Called when the scan moves on to the next page of the heap. The pages that follow next_page_id in the page chain
+   * of the heap are read ahead, and the read-ahead window doubles every time it is refilled (up to
+   * READ_AHEAD_MAX_PAGES, or a quarter of the buffer pool).
+   */
+  void ReadAhead(page_id_t next_page_id);
+
   TableHeap *table_heap_;
   Tuple *tuple_;
   Transaction *txn_;
+  /** The buffer ring the scan goes through, nullptr if it goes through the buffer pool like any other access. */
+  BufferRing *ring_;
+  /** Number of pages the scan reads ahead of its current page, 0 until sequential access is detected. */
+  size_t read_ahead_window_{0};
+  /** The last page that was read ahead. */
+  page_id_t read_ahead_end_{INVALID_PAGE_ID};
+  /** Number of pages read ahead that the scan has not reached yet. */
+  size_t read_ahead_pending_{0};
 };
 
 }  // namespace bustub
@@ -4,10 +4,13 @@
 
 namespace bustub {
 
-// Document this class! What does it represent?
-
+/**
+ * TmpTuple is the location of a tuple in a TmpTuplePage: the id of the page, and the offset of the tuple in it.
+ * Executors write the tuples they cannot keep in memory to such pages, and read them back later in the same query.
+ */
 class TmpTuple {
  public:
+  TmpTuple() = default;
   TmpTuple(page_id_t page_id, size_t offset) : page_id_(page_id), offset_(offset) {}
 
   inline auto operator==(const TmpTuple &rhs) const -> bool {
@@ -18,8 +21,8 @@ class TmpTuple {
   auto GetOffset() const -> size_t { return offset_; }
 
  private:
-  page_id_t page_id_;
-  size_t offset_;
+  page_id_t page_id_{INVALID_PAGE_ID};
+  size_t offset_{0};
 };
 
 }  // namespace bustub
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.h
+//
+// Identification: src/include/storage/table/tmp_tuple_file.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/macros.h"
+#include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TmpTupleFile is a sequence of tuples that an executor spills out of memory, such as a partition of a hash join, and
+ * reads back later in the same query. The tuples are appended to a list of TmpTuplePages in the buffer pool, which
+ * writes them to disk when it needs their frames, and the pages are deleted along with the file.
+ *
+ * Only the page being appended to stays pinned while the file is written, and only the page being read while it is
+ * read, so that an executor can write to many files at once with a few frames.
+ */
+class TmpTupleFile {
+ public:
+  explicit TmpTupleFile(BufferPoolManager *bpm) : bpm_(bpm) {}
+
+  ~TmpTupleFile();
+
+  DISALLOW_COPY_AND_MOVE(TmpTupleFile);
+
+  /** Append a tuple to the file. Throws OUT_OF_MEMORY if the buffer pool has no frame for a new page. */
+  void Append(const Tuple &tuple);
+
+  /** Unpin the page being appended to, once the file is written. Appending again pins a new page. */
+  void FinishAppending();
+
+  /** @return the number of tuples in the file */
+  auto Size() const -> size_t { return size_; }
+
+  /** @return the number of pages of the file */
+  auto PageCount() const -> size_t { return page_ids_.size(); }
+
+  /** Reader reads the tuples of a file that is no longer appended to, page by page, in the order they were appended. */
+  class Reader {
+   public:
+    explicit Reader(const TmpTupleFile *file) : file_(file) {}
+
+    ~Reader();
+
+    DISALLOW_COPY_AND_MOVE(Reader);
+
+    /** Read the next tuple of the file into tuple. @return false if there are no more */
+    auto Next(Tuple *tuple) -> bool;
+
+   private:
+    const TmpTupleFile *file_;
+    /** The index of the next page of the file to read, and the page being read */
+    size_t next_page_{0};
+    TmpTuplePage *page_{nullptr};
+    /** The offsets of the tuples of the page left to read, the next one last */
+    std::vector<uint32_t> offsets_;
+  };
+
+ private:
+  BufferPoolManager *bpm_;
+  std::vector<page_id_t> page_ids_;
+  /** The last page of the file while it is pinned for appending, or nullptr */
+  TmpTuplePage *append_page_{nullptr};
+  size_t size_{0};
+};
+
+}  // namespace bustub
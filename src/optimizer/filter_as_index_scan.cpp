@@ -0,0 +1,190 @@
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/** A conjunct of the form <column_expr> <comp_type> <constant_expr>. */
+struct ColumnComparison {
+  uint32_t col_idx_;
+  ComparisonType comp_type_;
+  AbstractExpressionRef constant_;
+};
+
+void SplitConjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *conjuncts) {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get());
+      logic_expr != nullptr && logic_expr->logic_type_ == LogicType::And) {
+    SplitConjuncts(logic_expr->children_[0], conjuncts);
+    SplitConjuncts(logic_expr->children_[1], conjuncts);
+    return;
+  }
+  conjuncts->push_back(expr);
+}
+
+/** Match a comparison of a column with a constant, on either side, as one with the column on the left. */
+auto MatchColumnComparison(const AbstractExpressionRef &expr) -> std::optional<ColumnComparison> {
+  const auto *comparison = dynamic_cast<const ComparisonExpression *>(expr.get());
+  if (comparison == nullptr || comparison->comp_type_ == ComparisonType::NotEqual) {
+    return std::nullopt;
+  }
+  for (size_t column_side : {0, 1}) {
+    const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(comparison->children_[column_side].get());
+    const auto &constant_expr = comparison->children_[1 - column_side];
+    if (column_expr == nullptr || dynamic_cast<const ConstantValueExpression *>(constant_expr.get()) == nullptr) {
+      continue;
+    }
+    // The key is built with the type of the column, so the constant must already have it.
+    if (column_expr->GetReturnType() != constant_expr->GetReturnType()) {
+      continue;
+    }
+    ComparisonType comp_type = comparison->comp_type_;
+    if (column_side == 1) {
+      switch (comp_type) {
+        case ComparisonType::LessThan:
+          comp_type = ComparisonType::GreaterThan;
+          break;
+        case ComparisonType::LessThanOrEqual:
+          comp_type = ComparisonType::GreaterThanOrEqual;
+          break;
+        case ComparisonType::GreaterThan:
+          comp_type = ComparisonType::LessThan;
+          break;
+        case ComparisonType::GreaterThanOrEqual:
+          comp_type = ComparisonType::LessThanOrEqual;
+          break;
+        default:
+          break;
+      }
+    }
+    return ColumnComparison{column_expr->GetColIdx(), comp_type, constant_expr};
+  }
+  return std::nullopt;
+}
+
+/**
+ * Narrow one end of a range to key if that is more selective. A NULL key makes the range empty, so it is always kept.
+ */
+void NarrowBound(IndexScanBound *bound, const AbstractExpressionRef &key, bool inclusive, bool is_low) {
+  if (bound->key_ != nullptr) {
+    const Value &old_value = dynamic_cast<const ConstantValueExpression &>(*bound->key_).val_;
+    const Value &new_value = dynamic_cast<const ConstantValueExpression &>(*key).val_;
+    if (old_value.IsNull()) {
+      return;
+    }
+    if (!new_value.IsNull()) {
+      if (new_value.CompareEquals(old_value) == CmpBool::CmpTrue) {
+        bound->inclusive_ = bound->inclusive_ && inclusive;
+        return;
+      }
+      CmpBool narrower = is_low ? new_value.CompareGreaterThan(old_value) : new_value.CompareLessThan(old_value);
+      if (narrower != CmpBool::CmpTrue) {
+        return;
+      }
+    }
+  }
+  bound->key_ = key;
+  bound->inclusive_ = inclusive;
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeFilterAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeFilterAsIndexScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::Filter) {
+    const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*optimized_plan);
+    BUSTUB_ENSURE(filter_plan.children_.size() == 1, "Filter should have exactly 1 child.");
+    if (filter_plan.GetChildPlan()->GetType() != PlanType::SeqScan) {
+      return optimized_plan;
+    }
+    const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*filter_plan.GetChildPlan());
+
+    // Look for conjuncts in form of <column_expr> <comp_type> <constant_expr> on an indexed column, and prefer a
+    // lookup of a single key, which a hash index serves best, to a range, which needs a b+ tree index. Indexes allow
+    // duplicate keys, so any indexed column will do.
+    std::vector<AbstractExpressionRef> conjuncts;
+    SplitConjuncts(filter_plan.GetPredicate(), &conjuncts);
+    std::vector<std::optional<ColumnComparison>> comparisons;
+    std::optional<size_t> chosen;
+    std::optional<index_oid_t> index_oid;
+    for (size_t i = 0; i < conjuncts.size(); i++) {
+      comparisons.push_back(MatchColumnComparison(conjuncts[i]));
+      const auto &comparison = comparisons.back();
+      if (comparison == std::nullopt ||
+          (chosen != std::nullopt && (comparisons[*chosen]->comp_type_ == ComparisonType::Equal ||
+                                      comparison->comp_type_ != ComparisonType::Equal))) {
+        continue;
+      }
+      if (auto index = MatchIndex(seq_scan.table_name_, comparison->col_idx_,
+                                  comparison->comp_type_ != ComparisonType::Equal);
+          index != std::nullopt) {
+        chosen = i;
+        index_oid = std::get<0>(*index);
+      }
+    }
+    if (chosen == std::nullopt) {
+      return optimized_plan;
+    }
+
+    // Everything the index scan does not cover stays in a filter on top of it.
+    std::vector<AbstractExpressionRef> residual;
+    AbstractPlanNodeRef index_scan;
+    const ColumnComparison &key_comparison = *comparisons[*chosen];
+    if (key_comparison.comp_type_ == ComparisonType::Equal) {
+      for (size_t i = 0; i < conjuncts.size(); i++) {
+        if (i != *chosen) {
+          residual.push_back(conjuncts[i]);
+        }
+      }
+      index_scan =
+          std::make_shared<IndexScanPlanNode>(filter_plan.output_schema_, *index_oid, key_comparison.constant_);
+    } else {
+      IndexScanBound low;
+      IndexScanBound high;
+      for (size_t i = 0; i < conjuncts.size(); i++) {
+        const auto &comparison = comparisons[i];
+        if (comparison == std::nullopt || comparison->col_idx_ != key_comparison.col_idx_ ||
+            comparison->comp_type_ == ComparisonType::Equal) {
+          residual.push_back(conjuncts[i]);
+          continue;
+        }
+        ComparisonType comp_type = comparison->comp_type_;
+        bool inclusive =
+            comp_type == ComparisonType::GreaterThanOrEqual || comp_type == ComparisonType::LessThanOrEqual;
+        bool is_low = comp_type == ComparisonType::GreaterThan || comp_type == ComparisonType::GreaterThanOrEqual;
+        NarrowBound(is_low ? &low : &high, comparison->constant_, inclusive, is_low);
+      }
+      index_scan = std::make_shared<IndexScanPlanNode>(filter_plan.output_schema_, *index_oid, std::move(low),
+                                                       std::move(high), false);
+    }
+    if (residual.empty()) {
+      return index_scan;
+    }
+    AbstractExpressionRef predicate = residual[0];
+    for (size_t i = 1; i < residual.size(); i++) {
+      predicate = std::make_shared<LogicExpression>(predicate, residual[i], LogicType::And);
+    }
+    return std::make_shared<FilterPlanNode>(filter_plan.output_schema_, predicate, index_scan);
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/schema.h"
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+void CollectColumns(const AbstractExpressionRef &expr, std::vector<uint32_t> *cols) {
+  if (const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(expr.get()); column_expr != nullptr) {
+    cols->push_back(column_expr->GetColIdx());
+    return;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    CollectColumns(child, cols);
+  }
+}
+
+/** Rewrite the columns of the table that expr refers to as the columns of the index entries that hold them. */
+auto RewriteForEntry(const AbstractExpressionRef &expr, const std::vector<uint32_t> &entry_attrs)
+    -> AbstractExpressionRef {
+  if (const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(expr.get()); column_expr != nullptr) {
+    auto entry_col = std::find(entry_attrs.begin(), entry_attrs.end(), column_expr->GetColIdx()) - entry_attrs.begin();
+    return std::make_shared<ColumnValueExpression>(0, entry_col, column_expr->GetReturnType());
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.emplace_back(RewriteForEntry(child, entry_attrs));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+/** Whether the entries of a b+ tree index hold every column of cols. A hash index has no entries to scan. */
+auto Covers(const IndexInfo &index_info, const std::vector<uint32_t> &cols) -> bool {
+  if (index_info.index_type_ != IndexType::BPlusTreeIndex) {
+    return false;
+  }
+  const auto &entry_attrs = index_info.index_->GetEntryAttrs();
+  return std::all_of(cols.begin(), cols.end(), [&entry_attrs](uint32_t col) {
+    return std::find(entry_attrs.begin(), entry_attrs.end(), col) != entry_attrs.end();
+  });
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeIndexOnlyScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeIndexOnlyScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::Projection) {
+    return optimized_plan;
+  }
+  const auto &projection = dynamic_cast<const ProjectionPlanNode &>(*optimized_plan);
+
+  // Match a projection of a scan, possibly through a filter, and collect the columns of the table they refer to.
+  std::vector<uint32_t> cols;
+  for (const auto &expr : projection.GetExpressions()) {
+    CollectColumns(expr, &cols);
+  }
+  const FilterPlanNode *filter = nullptr;
+  AbstractPlanNodeRef scan = projection.GetChildPlan();
+  if (scan->GetType() == PlanType::Filter) {
+    filter = dynamic_cast<const FilterPlanNode *>(scan.get());
+    CollectColumns(filter->GetPredicate(), &cols);
+    scan = filter->GetChildPlan();
+  }
+
+  // A sequential scan can read any index of the table that covers the columns, an index scan only its own index. A
+  // key lookup becomes the range of that single key.
+  const IndexInfo *index_info = nullptr;
+  IndexScanBound low;
+  IndexScanBound high;
+  bool reverse = false;
+  if (scan->GetType() == PlanType::SeqScan) {
+    const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*scan);
+    if (seq_scan.filter_predicate_ != nullptr) {
+      return optimized_plan;
+    }
+    for (const auto *candidate : catalog_.GetTableIndexes(seq_scan.table_name_)) {
+      if (Covers(*candidate, cols)) {
+        index_info = candidate;
+        break;
+      }
+    }
+  } else if (scan->GetType() == PlanType::IndexScan) {
+    const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(*scan);
+    if (index_scan.IsIndexOnly()) {
+      return optimized_plan;
+    }
+    const auto *candidate = catalog_.GetIndex(index_scan.GetIndexOid());
+    if (Covers(*candidate, cols)) {
+      index_info = candidate;
+    }
+    if (index_scan.KeyPredicate() != nullptr) {
+      low = IndexScanBound{index_scan.KeyPredicate(), true};
+      high = IndexScanBound{index_scan.KeyPredicate(), true};
+    } else {
+      low = index_scan.GetLow();
+      high = index_scan.GetHigh();
+      reverse = index_scan.IsReverse();
+    }
+  }
+  if (index_info == nullptr) {
+    return optimized_plan;
+  }
+
+  // The index-only scan returns the entries of the index, so the expressions above it refer to their columns instead.
+  const auto &entry_attrs = index_info->index_->GetEntryAttrs();
+  auto entry_schema = std::make_shared<Schema>(Schema::CopySchema(scan->output_schema_.get(), entry_attrs));
+  AbstractPlanNodeRef child = std::make_shared<IndexScanPlanNode>(entry_schema, index_info->index_oid_, std::move(low),
+                                                                  std::move(high), reverse, true);
+  if (filter != nullptr) {
+    child = std::make_shared<FilterPlanNode>(entry_schema, RewriteForEntry(filter->GetPredicate(), entry_attrs),
+                                             std::move(child));
+  }
+  std::vector<AbstractExpressionRef> expressions;
+  for (const auto &expr : projection.GetExpressions()) {
+    expressions.emplace_back(RewriteForEntry(expr, entry_attrs));
+  }
+  return std::make_shared<ProjectionPlanNode>(projection.output_schema_, std::move(expressions), std::move(child));
+}
+
+}  // namespace bustub
@@ -1,5 +1,8 @@
 #include <algorithm>
 #include <memory>
+#include <optional>
+#include <vector>
+
 #include "catalog/column.h"
 #include "catalog/schema.h"
 #include "common/exception.h"
@@ -7,6 +10,7 @@
 #include "execution/expressions/column_value_expression.h"
 #include "execution/expressions/comparison_expression.h"
 #include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
 #include "execution/plans/abstract_plan.h"
 #include "execution/plans/filter_plan.h"
 #include "execution/plans/hash_join_plan.h"
@@ -17,6 +21,76 @@
 
 namespace bustub {
 
+namespace {
+
+void SplitConjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *conjuncts) {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get());
+      logic_expr != nullptr && logic_expr->logic_type_ == LogicType::And) {
+    SplitConjuncts(logic_expr->children_[0], conjuncts);
+    SplitConjuncts(logic_expr->children_[1], conjuncts);
+    return;
+  }
+  conjuncts->push_back(expr);
+}
+
+auto JoinConjuncts(const std::vector<AbstractExpressionRef> &conjuncts) -> AbstractExpressionRef {
+  AbstractExpressionRef predicate = conjuncts[0];
+  for (size_t i = 1; i < conjuncts.size(); i++) {
+    predicate = std::make_shared<LogicExpression>(predicate, conjuncts[i], LogicType::And);
+  }
+  return predicate;
+}
+
+/** Collect which sides of the join, 0 for the left and 1 for the right, the columns of expr come from. */
+void CollectSides(const AbstractExpressionRef &expr, bool sides[2]) {
+  if (const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(expr.get()); column_expr != nullptr) {
+    sides[column_expr->GetTupleIdx()] = true;
+    return;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    CollectSides(child, sides);
+  }
+}
+
+/**
+ * Rewrite the columns of a join predicate as those of a single tuple: the left columns stay as they are, and the
+ * right ones come after right_offset columns.
+ */
+auto RewriteForTuple(const AbstractExpressionRef &expr, uint32_t right_offset) -> AbstractExpressionRef {
+  if (const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(expr.get()); column_expr != nullptr) {
+    uint32_t col_idx = column_expr->GetColIdx() + (column_expr->GetTupleIdx() == 1 ? right_offset : 0);
+    return std::make_shared<ColumnValueExpression>(0, col_idx, column_expr->GetReturnType());
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.emplace_back(RewriteForTuple(child, right_offset));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+/** Match <column_expr> = <column_expr> with one column from each side, as the keys of the left and right side. */
+auto MatchJoinKeys(const AbstractExpressionRef &expr)
+    -> std::optional<std::pair<AbstractExpressionRef, AbstractExpressionRef>> {
+  const auto *comparison = dynamic_cast<const ComparisonExpression *>(expr.get());
+  if (comparison == nullptr || comparison->comp_type_ != ComparisonType::Equal) {
+    return std::nullopt;
+  }
+  const auto *left_expr = dynamic_cast<const ColumnValueExpression *>(comparison->children_[0].get());
+  const auto *right_expr = dynamic_cast<const ColumnValueExpression *>(comparison->children_[1].get());
+  if (left_expr == nullptr || right_expr == nullptr || left_expr->GetTupleIdx() == right_expr->GetTupleIdx()) {
+    return std::nullopt;
+  }
+  if (left_expr->GetTupleIdx() == 1) {
+    std::swap(left_expr, right_expr);
+  }
+  // Ensure both exprs have tuple_id == 0
+  return std::make_pair(
+      std::make_shared<ColumnValueExpression>(0, left_expr->GetColIdx(), left_expr->GetReturnType()),
+      std::make_shared<ColumnValueExpression>(0, right_expr->GetColIdx(), right_expr->GetReturnType()));
+}
+
+}  // namespace
+
 auto Optimizer::OptimizeNLJAsHashJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
   std::vector<AbstractPlanNodeRef> children;
   for (const auto &child : plan->GetChildren()) {
@@ -24,42 +98,65 @@ auto Optimizer::OptimizeNLJAsHashJoin(const AbstractPlanNodeRef &plan) -> Abstra
   }
   auto optimized_plan = plan->CloneWithChildren(std::move(children));
 
-  if (optimized_plan->GetType() == PlanType::NestedLoopJoin) {
-    const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*optimized_plan);
-    // Has exactly two children
-    BUSTUB_ENSURE(nlj_plan.children_.size() == 2, "NLJ should have exactly 2 children.");
+  if (optimized_plan->GetType() != PlanType::NestedLoopJoin) {
+    return optimized_plan;
+  }
+  const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*optimized_plan);
+  // Has exactly two children
+  BUSTUB_ENSURE(nlj_plan.children_.size() == 2, "NLJ should have exactly 2 children.");
 
-    // Check if expr is equal condition where one is for the left table, and one is for the right table.
-    if (const auto *expr = dynamic_cast<const ComparisonExpression *>(&nlj_plan.Predicate()); expr != nullptr) {
-      if (expr->comp_type_ == ComparisonType::Equal) {
-        if (const auto *left_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[0].get());
-            left_expr != nullptr) {
-          if (const auto *right_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[1].get());
-              right_expr != nullptr) {
-            // Ensure both exprs have tuple_id == 0
-            auto left_expr_tuple_0 =
-                std::make_shared<ColumnValueExpression>(0, left_expr->GetColIdx(), left_expr->GetReturnType());
-            auto right_expr_tuple_0 =
-                std::make_shared<ColumnValueExpression>(0, right_expr->GetColIdx(), right_expr->GetReturnType());
-            // Now it's in form of <column_expr> = <column_expr>. Let's check if one of them is from the left table, and
-            // the other is from the right table.
-            if (left_expr->GetTupleIdx() == 0 && right_expr->GetTupleIdx() == 1) {
-              return std::make_shared<HashJoinPlanNode>(nlj_plan.output_schema_, nlj_plan.GetLeftPlan(),
-                                                        nlj_plan.GetRightPlan(), std::move(left_expr_tuple_0),
-                                                        std::move(right_expr_tuple_0), nlj_plan.GetJoinType());
-            }
-            if (left_expr->GetTupleIdx() == 1 && right_expr->GetTupleIdx() == 0) {
-              return std::make_shared<HashJoinPlanNode>(nlj_plan.output_schema_, nlj_plan.GetLeftPlan(),
-                                                        nlj_plan.GetRightPlan(), std::move(right_expr_tuple_0),
-                                                        std::move(left_expr_tuple_0), nlj_plan.GetJoinType());
-            }
-          }
-        }
-      }
-    }
+  // Any equality of a column from the left table with one from the right table can be the key of a hash join.
+  std::vector<AbstractExpressionRef> conjuncts;
+  SplitConjuncts(nlj_plan.predicate_, &conjuncts);
+  std::optional<std::pair<AbstractExpressionRef, AbstractExpressionRef>> keys;
+  size_t key_conjunct = 0;
+  for (; key_conjunct < conjuncts.size() && keys == std::nullopt; key_conjunct++) {
+    keys = MatchJoinKeys(conjuncts[key_conjunct]);
+  }
+  if (keys == std::nullopt) {
+    return optimized_plan;
+  }
+  key_conjunct--;
+  if (conjuncts.size() == 1) {
+    return std::make_shared<HashJoinPlanNode>(nlj_plan.output_schema_, nlj_plan.GetLeftPlan(), nlj_plan.GetRightPlan(),
+                                              std::move(keys->first), std::move(keys->second),
+                                              nlj_plan.GetJoinType());
+  }
+  // The rest of the predicate decides which tuples of a left join get NULLs, so it must stay in the join.
+  if (nlj_plan.GetJoinType() != JoinType::INNER) {
+    return optimized_plan;
   }
 
-  return optimized_plan;
+  // The conjuncts on a single side filter that side before the join, and the others filter the joined tuples.
+  std::vector<AbstractExpressionRef> side_conjuncts[2];
+  std::vector<AbstractExpressionRef> residual;
+  for (size_t i = 0; i < conjuncts.size(); i++) {
+    if (i == key_conjunct) {
+      continue;
+    }
+    bool sides[2] = {false, false};
+    CollectSides(conjuncts[i], sides);
+    if (sides[0] != sides[1]) {
+      side_conjuncts[sides[0] ? 0 : 1].push_back(RewriteForTuple(conjuncts[i], 0));
+    } else {
+      auto left_columns = nlj_plan.GetLeftPlan()->OutputSchema().GetColumnCount();
+      residual.push_back(RewriteForTuple(conjuncts[i], left_columns));
+    }
+  }
+  AbstractPlanNodeRef sides[2] = {nlj_plan.GetLeftPlan(), nlj_plan.GetRightPlan()};
+  for (size_t side = 0; side < 2; side++) {
+    if (!side_conjuncts[side].empty()) {
+      sides[side] = std::make_shared<FilterPlanNode>(sides[side]->output_schema_, JoinConjuncts(side_conjuncts[side]),
+                                                     sides[side]);
+    }
+  }
+  AbstractPlanNodeRef hash_join =
+      std::make_shared<HashJoinPlanNode>(nlj_plan.output_schema_, sides[0], sides[1], std::move(keys->first),
+                                         std::move(keys->second), nlj_plan.GetJoinType());
+  if (residual.empty()) {
+    return hash_join;
+  }
+  return std::make_shared<FilterPlanNode>(nlj_plan.output_schema_, JoinConjuncts(residual), std::move(hash_join));
 }
 
 }  // namespace bustub
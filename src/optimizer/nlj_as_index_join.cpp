@@ -21,15 +21,28 @@
 
 namespace bustub {
 
-auto Optimizer::MatchIndex(const std::string &table_name, uint32_t index_key_idx)
+auto Optimizer::MatchIndex(const std::string &table_name, uint32_t index_key_idx, bool ordered)
     -> std::optional<std::tuple<index_oid_t, std::string>> {
   const auto key_attrs = std::vector{index_key_idx};
+  const IndexInfo *match = nullptr;
   for (const auto *index_info : catalog_.GetTableIndexes(table_name)) {
-    if (key_attrs == index_info->index_->GetKeyAttrs()) {
+    if (key_attrs != index_info->index_->GetKeyAttrs()) {
+      continue;
+    }
+    if (index_info->index_type_ == IndexType::HashTableIndex) {
+      if (ordered) {
+        continue;
+      }
       return std::make_optional(std::make_tuple(index_info->index_oid_, index_info->name_));
     }
+    if (match == nullptr) {
+      match = index_info;
+    }
+  }
+  if (match == nullptr) {
+    return std::nullopt;
   }
-  return std::nullopt;
+  return std::make_optional(std::make_tuple(match->index_oid_, match->name_));
 }
 
 auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
@@ -12,8 +12,10 @@ auto Optimizer::OptimizeCustom(const AbstractPlanNodeRef &plan) -> AbstractPlanN
   p = OptimizeMergeProjection(p);
   p = OptimizeMergeFilterNLJ(p);
   p = OptimizeNLJAsIndexJoin(p);
-  // p = OptimizeNLJAsHashJoin(p);  // Enable this rule after you have implemented hash join.
+  p = OptimizeFilterAsIndexScan(p);
+  p = OptimizeNLJAsHashJoin(p);
   p = OptimizeOrderByAsIndexScan(p);
+  p = OptimizeIndexOnlyScan(p);
   p = OptimizeSortLimitAsTopN(p);
   return p;
 }
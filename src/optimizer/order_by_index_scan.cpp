@@ -1,5 +1,8 @@
 #include <algorithm>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "binder/bound_order_by.h"
 #include "catalog/catalog.h"
@@ -37,9 +40,16 @@ auto Optimizer::OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> A
       return optimized_plan;
     }
 
-    // Order type is asc or default
-    const auto &[order_type, expr] = order_bys[0];
-    if (!(order_type == OrderByType::ASC || order_type == OrderByType::DEFAULT)) {
+    // Order type is asc, desc or default; a descending order scans the index backward. NULL is the smallest key of
+    // the index, so NULLs must go first when ascending and last when descending, which is also where they go by
+    // default.
+    const auto &[order_type, null_type, expr] = order_bys[0];
+    if (!(order_type == OrderByType::ASC || order_type == OrderByType::DEFAULT || order_type == OrderByType::DESC)) {
+      return optimized_plan;
+    }
+    bool reverse = order_type == OrderByType::DESC;
+    if (null_type != OrderByNullType::DEFAULT &&
+        null_type != (reverse ? OrderByNullType::NULLS_LAST : OrderByNullType::NULLS_FIRST)) {
       return optimized_plan;
     }
 
@@ -55,19 +65,55 @@ auto Optimizer::OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> A
     BUSTUB_ENSURE(optimized_plan->children_.size() == 1, "Sort with multiple children?? Impossible!");
     const auto &child_plan = optimized_plan->children_[0];
 
-    if (child_plan->GetType() == PlanType::SeqScan) {
-      const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*child_plan);
-      const auto *table_info = catalog_.GetTable(seq_scan.GetTableOid());
-      const auto indices = catalog_.GetTableIndexes(table_info->name_);
-
-      for (const auto *index : indices) {
-        const auto &columns = index->key_schema_.GetColumns();
-        if (columns.size() == 1 &&
-            columns[0].GetName() == table_info->schema_.GetColumn(order_by_column_id).GetName()) {
-          // Index matched, return index scan instead
-          return std::make_shared<IndexScanPlanNode>(optimized_plan->output_schema_, index->index_oid_);
+    // Returns a plan of the same tuples as child in the order of column col, with the scan under it replaced by an
+    // index scan, or nullptr if there is no index on the column to scan the table with. Filters and projections of
+    // columns keep the order of their child.
+    std::function<AbstractPlanNodeRef(const AbstractPlanNodeRef &, uint32_t)> as_ordered_scan =
+        [&](const AbstractPlanNodeRef &child, uint32_t col) -> AbstractPlanNodeRef {
+      switch (child->GetType()) {
+        case PlanType::SeqScan: {
+          const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*child);
+          if (auto index = MatchIndex(seq_scan.table_name_, col, true); index != std::nullopt) {
+            // Index matched, return index scan instead
+            return std::make_shared<IndexScanPlanNode>(child->output_schema_, std::get<0>(*index), IndexScanBound{},
+                                                       IndexScanBound{}, reverse);
+          }
+          return nullptr;
+        }
+        case PlanType::IndexScan: {
+          const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(*child);
+          const auto *index_info = catalog_.GetIndex(index_scan.GetIndexOid());
+          // An index-only scan returns index entries, whose columns are not those of the table.
+          if (index_scan.IsIndexOnly() || index_info->index_->GetKeyAttrs() != std::vector<uint32_t>{col}) {
+            return nullptr;
+          }
+          // Every tuple of a key lookup has the same key, so they are already in order.
+          if (index_scan.KeyPredicate() != nullptr) {
+            return child;
+          }
+          return std::make_shared<IndexScanPlanNode>(child->output_schema_, index_scan.GetIndexOid(),
+                                                     index_scan.GetLow(), index_scan.GetHigh(), reverse);
         }
+        case PlanType::Filter: {
+          auto ordered_child = as_ordered_scan(child->children_[0], col);
+          return ordered_child != nullptr ? AbstractPlanNodeRef{child->CloneWithChildren({ordered_child})} : nullptr;
+        }
+        case PlanType::Projection: {
+          const auto &projection = dynamic_cast<const ProjectionPlanNode &>(*child);
+          const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(projection.GetExpressions()[col].get());
+          if (column_expr == nullptr) {
+            return nullptr;
+          }
+          auto ordered_child = as_ordered_scan(child->children_[0], column_expr->GetColIdx());
+          return ordered_child != nullptr ? AbstractPlanNodeRef{child->CloneWithChildren({ordered_child})} : nullptr;
+        }
+        default:
+          return nullptr;
       }
+    };
+
+    if (auto ordered_plan = as_ordered_scan(child_plan, order_by_column_id); ordered_plan != nullptr) {
+      return ordered_plan;
     }
   }
 
@@ -103,11 +103,11 @@ auto Planner::PlanSelect(const SelectStatement &statement) -> AbstractPlanNodeRe
 
   // Plan ORDER BY
   if (!statement.sort_.empty()) {
-    std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys;
+    std::vector<OrderBy> order_bys;
     for (const auto &order_by : statement.sort_) {
       auto [_, expr] = PlanExpression(*order_by->expr_, {plan});
       auto abstract_expr = std::move(expr);
-      order_bys.emplace_back(std::make_pair(order_by->type_, abstract_expr));
+      order_bys.emplace_back(order_by->type_, order_by->null_type_, abstract_expr);
     }
     plan = std::make_shared<SortPlanNode>(std::make_shared<Schema>(plan->OutputSchema()), plan, std::move(order_bys));
   }
@@ -10,11 +10,14 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <fcntl.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
-#include <mutex>  // NOLINT
+#include <memory>
 #include <string>
 #include <thread>  // NOLINT
 
@@ -29,8 +32,9 @@ static char *buffer_used;
 /**
  * Constructor: open/create a single database file & log file
  * @input db_file: database file name
+ * @input direct_io: open the database file with O_DIRECT, falling back to buffered I/O if unsupported
  */
-DiskManager::DiskManager(const std::string &db_file) : file_name_(db_file) {
+DiskManager::DiskManager(const std::string &db_file, bool direct_io) : file_name_(db_file) {
   std::string::size_type n = file_name_.rfind('.');
   if (n == std::string::npos) {
     LOG_DEBUG("wrong file format");
@@ -49,76 +53,108 @@ DiskManager::DiskManager(const std::string &db_file) : file_name_(db_file) {
     }
   }
 
-  std::scoped_lock scoped_db_io_latch(db_io_latch_);
-  db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
-  // directory or file does not exist
-  if (!db_io_.is_open()) {
-    db_io_.clear();
-    // create a new file
-    db_io_.open(db_file, std::ios::binary | std::ios::trunc | std::ios::out | std::ios::in);
-    if (!db_io_.is_open()) {
+  int flags = O_RDWR | O_CREAT;
+#ifdef O_DIRECT
+  if (direct_io) {
+    db_fd_ = open(db_file.c_str(), flags | O_DIRECT, 0644);
+    // some file systems (e.g. tmpfs) reject O_DIRECT, fall back to going through the page cache
+    direct_io_ = db_fd_ >= 0;
+  }
+#endif
+  if (db_fd_ < 0) {
+    db_fd_ = open(db_file.c_str(), flags, 0644);
+    if (db_fd_ < 0) {
       throw Exception("can't open db file");
     }
   }
+
+  struct stat stat_buf;
+  db_file_size_ = fstat(db_fd_, &stat_buf) == 0 ? static_cast<size_t>(stat_buf.st_size) : 0;
   buffer_used = nullptr;
 }
 
+DiskManager::~DiskManager() {
+  if (db_fd_ >= 0) {
+    close(db_fd_);
+  }
+}
+
 /**
  * Close all file streams
  */
 void DiskManager::ShutDown() {
-  {
-    std::scoped_lock scoped_db_io_latch(db_io_latch_);
-    db_io_.close();
+  if (db_fd_ >= 0) {
+    SyncDb();
+    close(db_fd_);
+    db_fd_ = -1;
   }
   log_io_.close();
 }
 
 /**
- * Write the contents of the specified page into disk file
+ * Write the contents of the specified page into disk file. The write is not synced, see SyncDb().
  */
 void DiskManager::WritePage(page_id_t page_id, const char *page_data) {
-  std::scoped_lock scoped_db_io_latch(db_io_latch_);
   size_t offset = static_cast<size_t>(page_id) * BUSTUB_PAGE_SIZE;
-  // set write cursor to offset
   num_writes_ += 1;
-  db_io_.seekp(offset);
-  db_io_.write(page_data, BUSTUB_PAGE_SIZE);
+  const char *buf = page_data;
+  if (direct_io_ && !IsAligned(page_data)) {
+    buf = BounceBuffer();
+    memcpy(const_cast<char *>(buf), page_data, BUSTUB_PAGE_SIZE);
+  }
+  ssize_t written = pwrite(db_fd_, buf, BUSTUB_PAGE_SIZE, static_cast<off_t>(offset));
   // check for I/O error
-  if (db_io_.bad()) {
+  if (written != BUSTUB_PAGE_SIZE) {
     LOG_DEBUG("I/O error while writing");
     return;
   }
-  // needs to flush to keep disk file in sync
-  db_io_.flush();
+  // grow the in-memory file size if the write extended the file
+  size_t end = offset + BUSTUB_PAGE_SIZE;
+  size_t size = db_file_size_.load();
+  while (size < end && !db_file_size_.compare_exchange_weak(size, end)) {
+  }
 }
 
 /**
  * Read the contents of the specified page into the given memory area
  */
 void DiskManager::ReadPage(page_id_t page_id, char *page_data) {
-  std::scoped_lock scoped_db_io_latch(db_io_latch_);
-  int offset = page_id * BUSTUB_PAGE_SIZE;
+  size_t offset = static_cast<size_t>(page_id) * BUSTUB_PAGE_SIZE;
   // check if read beyond file length
-  if (offset > GetFileSize(file_name_)) {
+  if (offset > db_file_size_.load()) {
     LOG_DEBUG("I/O error reading past end of file");
     // std::cerr << "I/O error while reading" << std::endl;
-  } else {
-    // set read cursor to offset
-    db_io_.seekp(offset);
-    db_io_.read(page_data, BUSTUB_PAGE_SIZE);
-    if (db_io_.bad()) {
-      LOG_DEBUG("I/O error while reading");
-      return;
-    }
-    // if file ends before reading BUSTUB_PAGE_SIZE
-    int read_count = db_io_.gcount();
-    if (read_count < BUSTUB_PAGE_SIZE) {
-      LOG_DEBUG("Read less than a page");
-      db_io_.clear();
-      // std::cerr << "Read less than a page" << std::endl;
-      memset(page_data + read_count, 0, BUSTUB_PAGE_SIZE - read_count);
-    }
+    return;
+  }
+  char *buf = page_data;
+  if (direct_io_ && !IsAligned(page_data)) {
+    buf = BounceBuffer();
+  }
+  ssize_t read_count = pread(db_fd_, buf, BUSTUB_PAGE_SIZE, static_cast<off_t>(offset));
+  if (read_count < 0) {
+    LOG_DEBUG("I/O error while reading");
+    return;
+  }
+  // if file ends before reading BUSTUB_PAGE_SIZE
+  if (read_count < BUSTUB_PAGE_SIZE) {
+    LOG_DEBUG("Read less than a page");
+    memset(buf + read_count, 0, BUSTUB_PAGE_SIZE - read_count);
+  }
+  if (buf != page_data) {
+    memcpy(page_data, buf, BUSTUB_PAGE_SIZE);
+  }
+}
+
+/**
+ * Flush all written pages of the database file to stable storage
+ */
+void DiskManager::SyncDb() {
+  if (db_fd_ < 0) {
+    return;
+  }
+  num_syncs_ += 1;
+  if (fdatasync(db_fd_) != 0) {
+    LOG_DEBUG("I/O error while syncing db file");
   }
 }
 
@@ -194,11 +230,35 @@ auto DiskManager::GetNumFlushes() const -> int { return num_flushes_; }
  */
 auto DiskManager::GetNumWrites() const -> int { return num_writes_; }
 
+/**
+ * Returns number of fdatasync calls made so far
+ */
+auto DiskManager::GetNumSyncs() const -> int { return num_syncs_; }
+
 /**
  * Returns true if the log is currently being flushed
  */
 auto DiskManager::GetFlushState() const -> bool { return flush_log_; }
 
+/**
+ * Private helper function to check whether a buffer can be handed to an O_DIRECT read or write
+ */
+auto DiskManager::IsAligned(const char *data) -> bool {
+  return reinterpret_cast<uintptr_t>(data) % BUSTUB_PAGE_ALIGNMENT == 0;
+}
+
+/**
+ * Private helper function returning an aligned per-thread page buffer. In O_DIRECT mode, it stands in for caller
+ * buffers that are not aligned (e.g. stack arrays); pages of the buffer pool are aligned and never need it.
+ */
+auto DiskManager::BounceBuffer() -> char * {
+  struct AlignedPage {
+    alignas(BUSTUB_PAGE_ALIGNMENT) char data_[BUSTUB_PAGE_SIZE];
+  };
+  thread_local auto bounce = std::make_unique<AlignedPage>();
+  return bounce->data_;
+}
+
 /**
  * Private helper function to get disk file size
  */
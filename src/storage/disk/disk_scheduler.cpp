@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// disk_scheduler.cpp
+//
+// Identification: src/storage/disk/disk_scheduler.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/disk/disk_scheduler.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace bustub {
+
+void DiskManagerBackend::Execute(std::vector<DiskRequest> *batch) {
+  for (auto &r : *batch) {
+    if (r.is_write_) {
+      disk_manager_->WritePage(r.page_id_, r.data_);
+    } else {
+      disk_manager_->ReadPage(r.page_id_, r.data_);
+    }
+    r.callback_.set_value(true);
+  }
+}
+
+DiskScheduler::DiskScheduler(DiskManager *disk_manager, size_t num_workers)
+    : DiskScheduler(std::make_unique<DiskManagerBackend>(disk_manager), num_workers) {}
+
+DiskScheduler::DiskScheduler(std::unique_ptr<DiskSchedulerBackend> backend, size_t num_workers)
+    : backend_(std::move(backend)) {
+  BUSTUB_ASSERT(num_workers > 0, "the disk scheduler needs at least one worker");
+  for (size_t i = 0; i < num_workers; i++) {
+    queues_.emplace_back(std::make_unique<RequestQueue>());
+  }
+  for (size_t i = 0; i < num_workers; i++) {
+    workers_.emplace_back([this, i] { RunWorker(queues_[i].get()); });
+  }
+}
+
+DiskScheduler::~DiskScheduler() {
+  for (auto &queue : queues_) {
+    {
+      std::scoped_lock<std::mutex> lock(queue->latch_);
+      queue->stop_ = true;
+    }
+    queue->cv_.notify_one();
+  }
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void DiskScheduler::Schedule(DiskRequest r) {
+  auto &queue = queues_[static_cast<size_t>(r.page_id_) % queues_.size()];
+  {
+    std::scoped_lock<std::mutex> lock(queue->latch_);
+    queue->requests_.emplace_back(std::move(r));
+  }
+  queue->cv_.notify_one();
+}
+
+auto DiskScheduler::ScheduleRead(page_id_t page_id, char *data) -> std::future<bool> {
+  auto promise = CreatePromise();
+  auto future = promise.get_future();
+  Schedule({/*is_write=*/false, data, page_id, std::move(promise)});
+  return future;
+}
+
+auto DiskScheduler::ScheduleWrite(page_id_t page_id, const char *data) -> std::future<bool> {
+  auto promise = CreatePromise();
+  auto future = promise.get_future();
+  // The backend never writes through the buffer of a write request.
+  Schedule({/*is_write=*/true, const_cast<char *>(data), page_id, std::move(promise)});  // NOLINT
+  return future;
+}
+
+void DiskScheduler::RunWorker(RequestQueue *queue) {
+  std::vector<DiskRequest> batch;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(queue->latch_);
+      queue->cv_.wait(lock, [queue] { return queue->stop_ || !queue->requests_.empty(); });
+      if (queue->requests_.empty()) {
+        return;
+      }
+      std::move(queue->requests_.begin(), queue->requests_.end(), std::back_inserter(batch));
+      queue->requests_.clear();
+    }
+    // Issue the batch in file order. Stable sort keeps the scheduling order of requests on the same page.
+    std::stable_sort(batch.begin(), batch.end(),
+                     [](const DiskRequest &a, const DiskRequest &b) { return a.page_id_ < b.page_id_; });
+    backend_->Execute(&batch);
+    batch.clear();
+  }
+}
+
+}  // namespace bustub
@@ -1,38 +1,240 @@
+#include <algorithm>
 #include <string>
+#include <thread>  // NOLINT
 
 #include "common/exception.h"
 #include "common/logger.h"
+#include "common/macros.h"
 #include "common/rid.h"
 #include "storage/index/b_plus_tree.h"
 #include "storage/page/header_page.h"
 
 namespace bustub {
-INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TEMPLATE_ARGUMENTS
 BPLUSTREE_TYPE::BPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
                           int leaf_max_size, int internal_max_size)
     : index_name_(std::move(name)),
       root_page_id_(INVALID_PAGE_ID),
       buffer_pool_manager_(buffer_pool_manager),
-      comparator_(comparator),
+      codec_(comparator),
+      comparator_(codec_.GetStoredComparator()),
       leaf_max_size_(leaf_max_size),
       internal_max_size_(internal_max_size) {}
 
 /*
  * Helper function to decide whether current b+tree is empty
  */
-INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::IsEmpty() const -> bool { return true; }
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::IsEmpty() const -> bool { return root_page_id_ == INVALID_PAGE_ID; }
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
 /*
- * Return the only value that associated with input key
+ * Return the values that are associated with input key: the only one if keys
+ * are unique, or every value of its posting list otherwise
  * This method is used for point query
  * @return : true means key exists
  */
-INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *transaction) -> bool {
-  return false;
+  const StoredKey &stored_key = codec_.Encode(key);
+  Page *leaf_page = FindLeafOptimistic(&stored_key, false);
+  if (leaf_page == nullptr) {
+    return false;
+  }
+  LeafValue value;
+  bool found = reinterpret_cast<LeafPage *>(leaf_page->GetData())->Lookup(stored_key, &value, comparator_);
+  if (found) {
+    if constexpr (Unique) {
+      result->push_back(value);
+    } else {
+      // the overflow pages of the posting list are protected by the latch of the leaf
+      value.GetValues(result, buffer_pool_manager_);
+    }
+  }
+  leaf_page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
+  return found;
+}
+
+/*****************************************************************************
+ * DESCENT
+ *****************************************************************************/
+/*
+ * Find the leaf page that covers key, or the leftmost leaf page if key is nullptr, with optimistic latch coupling. If
+ * before is true, find the leaf page that covers the greatest keys less than key instead, or the rightmost leaf page
+ * if key is nullptr. Restarts until the descent does not conflict with a writer.
+ * @return : the pinned leaf page, read latched or write latched as asked, or nullptr if the tree is empty
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FindLeafOptimistic(const StoredKey *key, bool exclusive, bool before) -> Page * {
+  Page *leaf_page;
+  while (!TryFindLeafOptimistic(key, exclusive, before, &leaf_page)) {
+    std::this_thread::yield();
+  }
+  return leaf_page;
+}
+
+/*
+ * One optimistic descent. Every internal page is read between two reads of its version; the child page id read from
+ * it is trusted only if the version did not change, and the child's own version is read before the parent is checked
+ * a second time and unpinned, so the child was the right page as of that version. The leaf is latched and its version
+ * checked once more, which leaves it latched in the state the descent saw.
+ * @return : false if the descent conflicted with a writer and must restart
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::TryFindLeafOptimistic(const StoredKey *key, bool exclusive, bool before, Page **leaf_page)
+    -> bool {
+  *leaf_page = nullptr;
+  page_id_t root_page_id = root_page_id_;
+  if (root_page_id == INVALID_PAGE_ID) {
+    return true;
+  }
+  Page *page = FetchPageOrThrow(root_page_id);
+  uint64_t version = page->GetVersion();
+  // the page must still be the root once its version is known, or it may have been split or merged away since
+  if ((version & 1) != 0 || root_page_id_ != root_page_id) {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    return false;
+  }
+
+  while (true) {
+    auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    bool is_leaf = node->IsLeafPage();
+    int size = node->GetSize();
+    if (!page->ValidateVersion(version)) {
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+      return false;
+    }
+
+    if (is_leaf) {
+      if (exclusive) {
+        page->WLatch();
+      } else {
+        page->RLatch();
+      }
+      // the write latch bumps the version once
+      if (page->GetVersion() != version + (exclusive ? 1 : 0)) {
+        if (exclusive) {
+          page->WUnlatch();
+        } else {
+          page->RUnlatch();
+        }
+        buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+        return false;
+      }
+      *leaf_page = page;
+      return true;
+    }
+
+    // a size out of bounds can only be a torn read, and would make the lookup below read past the page
+    page_id_t child_page_id = INVALID_PAGE_ID;
+    if (size >= 1 && size <= InternalPage::MAX_ENTRIES) {
+      auto *internal = reinterpret_cast<InternalPage *>(node);
+      if (key == nullptr) {
+        child_page_id = internal->ValueAt(before ? size - 1 : 0);
+      } else {
+        child_page_id = before ? internal->LookupBefore(*key, comparator_) : internal->Lookup(*key, comparator_);
+      }
+    }
+    if (child_page_id == INVALID_PAGE_ID || !page->ValidateVersion(version)) {
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+      return false;
+    }
+
+    Page *child_page = FetchPageOrThrow(child_page_id);
+    uint64_t child_version = child_page->GetVersion();
+    bool valid = (child_version & 1) == 0 && page->ValidateVersion(version);
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    if (!valid) {
+      buffer_pool_manager_->UnpinPage(child_page_id, false);
+      return false;
+    }
+    page = child_page;
+    version = child_version;
+  }
+}
+
+/*
+ * Find the leaf page that covers key with latch crabbing: write latch each page on the way down and release the
+ * ancestors of every page that is safe for op. The caller holds the root latch and the tree is not empty.
+ * @return : the pinned and write latched leaf page, which is also the last page of the context
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FindLeafPessimistic(const StoredKey &key, Operation op, WriteContext *context) -> Page * {
+  Page *page = FetchPageOrThrow(root_page_id_);
+  page->WLatch();
+  context->pages_.push_back(page);
+  auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  if (IsSafe(node, key, op)) {
+    ReleaseAncestors(context);
+  }
+  while (!node->IsLeafPage()) {
+    page_id_t child_page_id = reinterpret_cast<InternalPage *>(node)->Lookup(key, comparator_);
+    page = FetchPageOrThrow(child_page_id);
+    page->WLatch();
+    context->pages_.push_back(page);
+    node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    if (IsSafe(node, key, op)) {
+      ReleaseAncestors(context);
+    }
+  }
+  return page;
+}
+
+/*
+ * A page is safe for an operation on key if the operation cannot propagate a split or a merge past it. An internal
+ * page is safe for an insertion only if it has room for any separator key that a split below may push up.
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::IsSafe(const BPlusTreePage *node, const StoredKey &key, Operation op) const -> bool {
+  if (op == Operation::Insert) {
+    return node->IsLeafPage() ? reinterpret_cast<const LeafPage *>(node)->HasRoomFor(key)
+                              : reinterpret_cast<const InternalPage *>(node)->HasRoomForAnyKey();
+  }
+  if (node->IsRootPage()) {
+    return node->IsLeafPage() ? node->GetSize() > 1 : node->GetSize() > 2;
+  }
+  return node->GetSize() > node->GetMinSize();
+}
+
+/*
+ * Release the root latch and every page of the context but the last one. None of them was modified.
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::ReleaseAncestors(WriteContext *context) {
+  if (context->root_latched_) {
+    context->root_latched_ = false;
+    root_latch_.WUnlock();
+  }
+  while (context->pages_.size() > 1) {
+    Page *page = context->pages_.front();
+    context->pages_.pop_front();
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  }
+}
+
+/*
+ * Release every latch of the context, then delete the pages that a merge emptied.
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::ReleaseAll(WriteContext *context) {
+  for (Page *page : context->pages_) {
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+  }
+  context->pages_.clear();
+  if (context->root_latched_) {
+    context->root_latched_ = false;
+    root_latch_.WUnlock();
+  }
+  // An optimistic reader may still hold a deleted page pinned, in which case the page is left to the replacer. It is
+  // unreachable from the tree, and page ids are never reused.
+  for (page_id_t page_id : context->deleted_pages_) {
+    buffer_pool_manager_->DeletePage(page_id);
+  }
+  context->deleted_pages_.clear();
 }
 
 /*****************************************************************************
@@ -41,13 +243,171 @@ auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result
 /*
  * Insert constant key & value pair into b+ tree
  * if current tree is empty, start new tree, update root page id and insert
- * entry, otherwise insert into leaf page.
- * @return: since we only support unique key, if user try to insert duplicate
- * keys return false, otherwise return true.
+ * entry, otherwise insert into leaf page. The value of a key that is already
+ * in a tree with duplicate keys goes to the posting list of the key.
+ * @return: false if keys are unique and key is already in the tree, otherwise
+ * true.
  */
-INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) -> bool {
-  return false;
+  const StoredKey &stored_key = codec_.Encode(key);
+  // Most inserts only change their leaf: try with the leaf as the only latched page first.
+  Page *leaf_page = FindLeafOptimistic(&stored_key, true);
+  if (leaf_page != nullptr) {
+    auto *leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+    bool exists = AddToExistingKey(leaf, stored_key, value);
+    bool safe = !exists && IsSafe(leaf, stored_key, Operation::Insert);
+    if (safe) {
+      leaf->Insert(stored_key, ToLeafValue(value), comparator_);
+    }
+    leaf_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), safe || (exists && !Unique));
+    if (exists || safe) {
+      return !exists || !Unique;
+    }
+  }
+
+  WriteContext context;
+  root_latch_.WLock();
+  context.root_latched_ = true;
+  if (root_page_id_ == INVALID_PAGE_ID) {
+    StartNewTree(stored_key, ToLeafValue(value));
+    ReleaseAll(&context);
+    return true;
+  }
+  leaf_page = FindLeafPessimistic(stored_key, Operation::Insert, &context);
+  auto *leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+  if (AddToExistingKey(leaf, stored_key, value)) {
+    ReleaseAll(&context);
+    return !Unique;
+  }
+  if (leaf->HasRoomFor(stored_key)) {
+    leaf->Insert(stored_key, ToLeafValue(value), comparator_);
+    ReleaseAll(&context);
+    return true;
+  }
+
+  page_id_t new_page_id;
+  Page *new_page = NewPageOrThrow(&new_page_id);
+  auto *new_leaf = reinterpret_cast<LeafPage *>(new_page->GetData());
+  new_leaf->Init(new_page_id, leaf->GetParentPageId(), leaf_max_size_);
+  leaf->SplitInsert(stored_key, ToLeafValue(value), new_leaf, comparator_);
+  // the new leaf is not latched, so it is linked both ways before a backward iterator can reach it from the next leaf
+  new_leaf->SetNextPageId(leaf->GetNextPageId());
+  new_leaf->SetPrevPageId(leaf->GetPageId());
+  if (leaf->GetNextPageId() != INVALID_PAGE_ID) {
+    SetPrevPageIdOf(leaf->GetNextPageId(), new_page_id);
+  }
+  leaf->SetNextPageId(new_page_id);
+  InsertIntoParent(static_cast<int>(context.pages_.size()) - 1,
+                   codec_.Separator(leaf->KeyAt(leaf->GetSize() - 1), new_leaf->KeyAt(0)), new_leaf, &context);
+  buffer_pool_manager_->UnpinPage(new_page_id, true);
+  ReleaseAll(&context);
+  return true;
+}
+
+/*
+ * Link the leaf page page_id back to prev_page_id, its new left sibling. The caller holds the left sibling write
+ * latched, and latches leaves left to right, which backward iterators only try to latch against.
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::SetPrevPageIdOf(page_id_t page_id, page_id_t prev_page_id) {
+  Page *page = FetchPageOrThrow(page_id);
+  page->WLatch();
+  reinterpret_cast<LeafPage *>(page->GetData())->SetPrevPageId(prev_page_id);
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, true);
+}
+
+/*
+ * If leaf has an entry for key, add value to it: a tree with unique keys leaves the entry as it is, while a tree with
+ * duplicate keys adds value to the posting list of the key, which never changes the size of leaf.
+ * @return true if leaf has an entry for key
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::AddToExistingKey(LeafPage *leaf, const StoredKey &key, const ValueType &value) -> bool {
+  LeafValue leaf_value;
+  if (!leaf->Lookup(key, &leaf_value, comparator_)) {
+    return false;
+  }
+  if constexpr (!Unique) {
+    leaf_value.Add(value, buffer_pool_manager_);
+    leaf->SetValueAt(leaf->KeyIndex(key, comparator_), leaf_value);
+  }
+  return true;
+}
+
+/*
+ * The leaf entry of a key that has a single value.
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::ToLeafValue(const ValueType &value) -> LeafValue {
+  if constexpr (Unique) {
+    return value;
+  } else {
+    return PostingList<ValueType>::Of(value);
+  }
+}
+
+/*
+ * Insert key & value pair into an empty tree
+ * User needs to first ask for new page from buffer pool manager, then update b+
+ * tree's root page id and insert entry directly into leaf page.
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::StartNewTree(const StoredKey &key, const LeafValue &value) {
+  page_id_t page_id;
+  Page *page = NewPageOrThrow(&page_id);
+  auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  leaf->Init(page_id, INVALID_PAGE_ID, leaf_max_size_);
+  leaf->Insert(key, value, comparator_);
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  root_page_id_ = page_id;
+  UpdateRootPageId(1);
+}
+
+/*
+ * Insert the separator key of new_node, the new right sibling of the index-th page of the context, into their parent.
+ * Splits the parent, recursively, if it has no room for the key; such a page is never safe, so its parent is in the
+ * context too. If the split page is the root, a new root is created.
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::InsertIntoParent(int index, const StoredKey &key, BPlusTreePage *new_node,
+                                      WriteContext *context) {
+  auto *old_node = reinterpret_cast<BPlusTreePage *>(context->pages_[index]->GetData());
+  if (index == 0) {
+    BUSTUB_ASSERT(old_node->IsRootPage() && context->root_latched_, "only the root may split without a parent");
+    page_id_t root_page_id;
+    Page *root_page = NewPageOrThrow(&root_page_id);
+    auto *root = reinterpret_cast<InternalPage *>(root_page->GetData());
+    root->Init(root_page_id, INVALID_PAGE_ID, internal_max_size_);
+    root->PopulateNewRoot(old_node->GetPageId(), key, new_node->GetPageId());
+    old_node->SetParentPageId(root_page_id);
+    new_node->SetParentPageId(root_page_id);
+    buffer_pool_manager_->UnpinPage(root_page_id, true);
+    root_page_id_ = root_page_id;
+    UpdateRootPageId();
+    return;
+  }
+
+  auto *parent = reinterpret_cast<InternalPage *>(context->pages_[index - 1]->GetData());
+  int insert_index = parent->ValueIndex(old_node->GetPageId()) + 1;
+  // the split below moves new_node to the parent's new sibling if it ends up there
+  new_node->SetParentPageId(parent->GetPageId());
+  if (parent->HasRoomFor(key)) {
+    parent->InsertAt(insert_index, key, new_node->GetPageId());
+    return;
+  }
+
+  // The parent has no room for the new pair, so split it around the pair.
+  page_id_t sibling_page_id;
+  Page *sibling_page = NewPageOrThrow(&sibling_page_id);
+  auto *sibling = reinterpret_cast<InternalPage *>(sibling_page->GetData());
+  sibling->Init(sibling_page_id, parent->GetParentPageId(), internal_max_size_);
+  const StoredKey middle_key =
+      parent->SplitInsert(insert_index, key, new_node->GetPageId(), sibling, buffer_pool_manager_);
+  InsertIntoParent(index - 1, middle_key, sibling, context);
+  buffer_pool_manager_->UnpinPage(sibling_page_id, true);
 }
 
 /*****************************************************************************
@@ -60,8 +420,373 @@ auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transact
  * delete entry from leaf page. Remember to deal with redistribute or merge if
  * necessary.
  */
-INDEX_TEMPLATE_ARGUMENTS
-void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {}
+BPLUSTREE_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) { RemovePair(codec_.Encode(key), nullptr); }
+
+/*
+ * Delete the pair of key and value. The entry of key stays in the tree as long as a tree with duplicate keys has
+ * other values for it. Nothing happens if the pair is not in the tree.
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::Remove(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  RemovePair(codec_.Encode(key), &value);
+}
+
+/*
+ * Delete value, or every value if value is nullptr, from the entry of key, and the entry once it has no value left.
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::RemovePair(const StoredKey &key, const ValueType *value) {
+  // Most removals only change their leaf: try with the leaf as the only latched page first.
+  Page *leaf_page = FindLeafOptimistic(&key, true);
+  if (leaf_page == nullptr) {
+    return;
+  }
+  auto *leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+  bool dirty;
+  bool remove_entry = RemoveFromExistingKey(leaf, key, value, &dirty);
+  bool safe = remove_entry && IsSafe(leaf, key, Operation::Remove);
+  if (safe) {
+    RemoveEntry(leaf, key);
+  }
+  leaf_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), dirty || safe);
+  if (!remove_entry || safe) {
+    return;
+  }
+
+  WriteContext context;
+  root_latch_.WLock();
+  context.root_latched_ = true;
+  if (root_page_id_ == INVALID_PAGE_ID) {
+    ReleaseAll(&context);
+    return;
+  }
+  leaf_page = FindLeafPessimistic(key, Operation::Remove, &context);
+  leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+  if (RemoveFromExistingKey(leaf, key, value, &dirty)) {
+    RemoveEntry(leaf, key);
+    CoalesceOrRedistribute(static_cast<int>(context.pages_.size()) - 1, &context);
+  }
+  ReleaseAll(&context);
+}
+
+/*
+ * Find out whether removing value, or every value if value is nullptr, removes the entry of key from leaf. A tree with
+ * duplicate keys removes a value that is not the last one of its key from the posting list here, and sets dirty.
+ * @return true if the entry of key must be removed from leaf, which is left to the caller
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::RemoveFromExistingKey(LeafPage *leaf, const StoredKey &key, const ValueType *value, bool *dirty)
+    -> bool {
+  *dirty = false;
+  LeafValue leaf_value;
+  if (!leaf->Lookup(key, &leaf_value, comparator_)) {
+    return false;
+  }
+  if (value == nullptr) {
+    return true;
+  }
+  if constexpr (Unique) {
+    return leaf_value == *value;
+  } else {
+    if (leaf_value.GetSize() == 1) {
+      return leaf_value.HoldsOnly(*value);
+    }
+    *dirty = leaf_value.Remove(*value, buffer_pool_manager_);
+    if (*dirty) {
+      leaf->SetValueAt(leaf->KeyIndex(key, comparator_), leaf_value);
+    }
+    return false;
+  }
+}
+
+/*
+ * Remove the entry of key from leaf, and the overflow pages of its posting list if keys are not unique.
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::RemoveEntry(LeafPage *leaf, const StoredKey &key) {
+  if constexpr (!Unique) {
+    LeafValue leaf_value;
+    leaf->Lookup(key, &leaf_value, comparator_);
+    leaf_value.Free(buffer_pool_manager_);
+  }
+  leaf->RemoveAndDeleteRecord(key, comparator_);
+}
+
+/*
+ * Fix the index-th page of the context if it underflowed: merge it with a sibling if the two fit in one page, or
+ * borrow a pair from the sibling otherwise. A merge removes a pair from the parent, which is fixed in turn; an unsafe
+ * page keeps its parent in the context, so the parent is always there when needed. The new separator of a
+ * redistribution may be longer than the old one in a compressed parent; if the parent has no room for it, the page is
+ * left under min size, which only costs space.
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::CoalesceOrRedistribute(int index, WriteContext *context) {
+  auto *node = reinterpret_cast<BPlusTreePage *>(context->pages_[index]->GetData());
+  if (node->IsRootPage()) {
+    AdjustRoot(node, context);
+    return;
+  }
+  if (node->GetSize() >= node->GetMinSize()) {
+    return;
+  }
+
+  auto *parent = reinterpret_cast<InternalPage *>(context->pages_[index - 1]->GetData());
+  int node_index = parent->ValueIndex(node->GetPageId());
+  // borrow from or merge with the left sibling, or the right one for the first child
+  bool node_is_left = node_index == 0;
+  int right_index = node_is_left ? 1 : node_index;
+  page_id_t sibling_page_id = parent->ValueAt(node_is_left ? 1 : node_index - 1);
+  Page *sibling_page = FetchPageOrThrow(sibling_page_id);
+  sibling_page->WLatch();
+  auto *sibling = reinterpret_cast<BPlusTreePage *>(sibling_page->GetData());
+  BPlusTreePage *left = node_is_left ? node : sibling;
+  BPlusTreePage *right = node_is_left ? sibling : node;
+
+  bool merge;
+  if (node->IsLeafPage()) {
+    auto *leaf = reinterpret_cast<LeafPage *>(node);
+    auto *sibling_leaf = reinterpret_cast<LeafPage *>(sibling);
+    merge = reinterpret_cast<LeafPage *>(left)->CanAbsorb(reinterpret_cast<LeafPage *>(right));
+    if (merge) {
+      reinterpret_cast<LeafPage *>(right)->MoveAllTo(reinterpret_cast<LeafPage *>(left));
+      if (reinterpret_cast<LeafPage *>(left)->GetNextPageId() != INVALID_PAGE_ID) {
+        SetPrevPageIdOf(reinterpret_cast<LeafPage *>(left)->GetNextPageId(), left->GetPageId());
+      }
+    } else {
+      // the separator between the pages once the pair has moved
+      int size = sibling_leaf->GetSize();
+      const StoredKey separator = node_is_left ? codec_.Separator(sibling_leaf->KeyAt(0), sibling_leaf->KeyAt(1))
+                                               : codec_.Separator(sibling_leaf->KeyAt(size - 2),
+                                                                  sibling_leaf->KeyAt(size - 1));
+      if (parent->CanSetKeyAt(right_index, separator)) {
+        if (node_is_left) {
+          sibling_leaf->MoveFirstToEndOf(leaf);
+        } else {
+          sibling_leaf->MoveLastToFrontOf(leaf);
+        }
+        parent->SetKeyAt(right_index, separator);
+      }
+    }
+  } else {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    auto *sibling_internal = reinterpret_cast<InternalPage *>(sibling);
+    const StoredKey middle_key = parent->KeyAt(right_index);
+    merge = reinterpret_cast<InternalPage *>(left)->CanAbsorb(reinterpret_cast<InternalPage *>(right), middle_key);
+    if (merge) {
+      reinterpret_cast<InternalPage *>(right)->MoveAllTo(reinterpret_cast<InternalPage *>(left), middle_key,
+                                                         buffer_pool_manager_);
+    } else {
+      // the key that moves up from the sibling once its child has moved
+      const StoredKey separator =
+          sibling_internal->KeyAt(node_is_left ? 1 : sibling_internal->GetSize() - 1);
+      if (parent->CanSetKeyAt(right_index, separator)) {
+        if (node_is_left) {
+          sibling_internal->MoveFirstToEndOf(internal, middle_key, buffer_pool_manager_);
+        } else {
+          sibling_internal->MoveLastToFrontOf(internal, middle_key, buffer_pool_manager_);
+        }
+        parent->SetKeyAt(right_index, separator);
+      }
+    }
+  }
+  if (merge) {
+    parent->Remove(right_index);
+    context->deleted_pages_.push_back(right->GetPageId());
+  }
+  sibling_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(sibling_page_id, true);
+  if (merge) {
+    CoalesceOrRedistribute(index - 1, context);
+  }
+}
+
+/*
+ * Update root page if necessary
+ * NOTE: size of root page can be less than min size and this method is only
+ * called within coalesceOrRedistribute() method
+ * case 1: when you delete the last element in root page, but root page still
+ * has one last child
+ * case 2: when you delete the last element in whole b+ tree
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::AdjustRoot(BPlusTreePage *old_root, WriteContext *context) {
+  if (old_root->IsLeafPage()) {
+    if (old_root->GetSize() == 0) {
+      root_page_id_ = INVALID_PAGE_ID;
+      UpdateRootPageId();
+      context->deleted_pages_.push_back(old_root->GetPageId());
+    }
+    return;
+  }
+  if (old_root->GetSize() == 1) {
+    page_id_t child_page_id = reinterpret_cast<InternalPage *>(old_root)->ValueAt(0);
+    Page *child_page = FetchPageOrThrow(child_page_id);
+    reinterpret_cast<BPlusTreePage *>(child_page->GetData())->SetParentPageId(INVALID_PAGE_ID);
+    buffer_pool_manager_->UnpinPage(child_page_id, true);
+    root_page_id_ = child_page_id;
+    UpdateRootPageId();
+    context->deleted_pages_.push_back(old_root->GetPageId());
+  }
+}
+
+/*****************************************************************************
+ * BULK LOAD
+ *****************************************************************************/
+/*
+ * Build an empty tree bottom-up from a stream of key & value pairs sorted by key: fill the leaves left to right, then
+ * build each internal level from the separator keys of the level below, until a single root is left. Every page is
+ * filled up to fill_factor of its capacity, but never below its min size, and the last page of each level takes pairs
+ * from or is merged into its left neighbour so that it is not under min size either. A tree with unique keys keeps only
+ * the first pair of every key, while a tree with duplicate keys adds the values of a key to its posting list.
+ * @param next : stores the next pair into its argument, or returns false at the end of the stream
+ * @return : false if the tree is not empty, in which case nothing is read from the stream
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::BulkLoad(const std::function<bool(MappingType *)> &next, double fill_factor,
+                              Transaction *transaction) -> bool {
+  root_latch_.WLock();
+  if (root_page_id_ != INVALID_PAGE_ID) {
+    root_latch_.WUnlock();
+    return false;
+  }
+
+  // The separator key before and the page id of every page of the level being built.
+  std::vector<std::pair<StoredKey, page_id_t>> level;
+
+  Page *prev_page = nullptr;
+  Page *page = nullptr;
+  LeafPage *leaf = nullptr;
+  MappingType item;
+  while (next(&item)) {
+    const StoredKey &key = codec_.Encode(item.first);
+    if (leaf != nullptr) {
+      int order = comparator_(leaf->KeyAt(leaf->GetSize() - 1), key);
+      if (order > 0) {
+        // the pages built so far are unreachable and left to the replacer
+        for (Page *built_page : {prev_page, page}) {
+          if (built_page != nullptr) {
+            buffer_pool_manager_->UnpinPage(built_page->GetPageId(), true);
+          }
+        }
+        root_latch_.WUnlock();
+        throw Exception(ExceptionType::INVALID, "bulk load input is not sorted");
+      }
+      if (order == 0) {
+        if constexpr (!Unique) {
+          LeafValue leaf_value = leaf->ValueAt(leaf->GetSize() - 1);
+          leaf_value.Add(item.second, buffer_pool_manager_);
+          leaf->SetValueAt(leaf->GetSize() - 1, leaf_value);
+        }
+        continue;
+      }
+    }
+    if (leaf == nullptr || leaf->ReachedFillFactor(fill_factor) || !leaf->HasRoomFor(key)) {
+      page_id_t new_page_id;
+      Page *new_page = NewPageOrThrow(&new_page_id);
+      auto *new_leaf = reinterpret_cast<LeafPage *>(new_page->GetData());
+      new_leaf->Init(new_page_id, INVALID_PAGE_ID, leaf_max_size_);
+      if (leaf != nullptr) {
+        leaf->SetNextPageId(new_page_id);
+        new_leaf->SetPrevPageId(leaf->GetPageId());
+        level.emplace_back(codec_.Separator(leaf->KeyAt(leaf->GetSize() - 1), key), new_page_id);
+      } else {
+        level.emplace_back(key, new_page_id);
+      }
+      if (prev_page != nullptr) {
+        buffer_pool_manager_->UnpinPage(prev_page->GetPageId(), true);
+      }
+      prev_page = page;
+      page = new_page;
+      leaf = new_leaf;
+    }
+    leaf->Append(key, ToLeafValue(item.second));
+  }
+  if (page == nullptr) {
+    root_latch_.WUnlock();
+    return true;
+  }
+
+  page_id_t merged_page_id = INVALID_PAGE_ID;
+  if (prev_page != nullptr) {
+    auto *prev_leaf = reinterpret_cast<LeafPage *>(prev_page->GetData());
+    if (leaf->GetSize() < leaf->GetMinSize()) {
+      if (prev_leaf->CanAbsorb(leaf)) {
+        leaf->MoveAllTo(prev_leaf);
+        merged_page_id = leaf->GetPageId();
+        level.pop_back();
+      } else {
+        while (leaf->GetSize() < leaf->GetMinSize()) {
+          prev_leaf->MoveLastToFrontOf(leaf);
+        }
+        level.back().first = codec_.Separator(prev_leaf->KeyAt(prev_leaf->GetSize() - 1), leaf->KeyAt(0));
+      }
+    }
+    buffer_pool_manager_->UnpinPage(prev_page->GetPageId(), true);
+  }
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+  if (merged_page_id != INVALID_PAGE_ID) {
+    buffer_pool_manager_->DeletePage(merged_page_id);
+  }
+
+  while (level.size() > 1) {
+    std::vector<std::pair<StoredKey, page_id_t>> parents;
+    prev_page = nullptr;
+    page = nullptr;
+    InternalPage *internal = nullptr;
+    for (const auto &[key, child_page_id] : level) {
+      if (internal == nullptr || internal->ReachedFillFactor(fill_factor) || !internal->HasRoomFor(key)) {
+        page_id_t new_page_id;
+        Page *new_page = NewPageOrThrow(&new_page_id);
+        internal = reinterpret_cast<InternalPage *>(new_page->GetData());
+        internal->Init(new_page_id, INVALID_PAGE_ID, internal_max_size_);
+        parents.emplace_back(key, new_page_id);
+        if (prev_page != nullptr) {
+          buffer_pool_manager_->UnpinPage(prev_page->GetPageId(), true);
+        }
+        prev_page = page;
+        page = new_page;
+      }
+      internal->InsertAt(internal->GetSize(), key, child_page_id);
+      Page *child_page = FetchPageOrThrow(child_page_id);
+      reinterpret_cast<BPlusTreePage *>(child_page->GetData())->SetParentPageId(internal->GetPageId());
+      buffer_pool_manager_->UnpinPage(child_page_id, true);
+    }
+
+    // do not leave the last page of the level under min size
+    merged_page_id = INVALID_PAGE_ID;
+    if (prev_page != nullptr) {
+      auto *prev_internal = reinterpret_cast<InternalPage *>(prev_page->GetData());
+      StoredKey middle_key = parents.back().first;
+      if (internal->GetSize() < internal->GetMinSize()) {
+        if (prev_internal->CanAbsorb(internal, middle_key)) {
+          internal->MoveAllTo(prev_internal, middle_key, buffer_pool_manager_);
+          merged_page_id = internal->GetPageId();
+          parents.pop_back();
+        } else {
+          while (internal->GetSize() < internal->GetMinSize()) {
+            StoredKey last_key = prev_internal->KeyAt(prev_internal->GetSize() - 1);
+            prev_internal->MoveLastToFrontOf(internal, middle_key, buffer_pool_manager_);
+            middle_key = last_key;
+          }
+          parents.back().first = middle_key;
+        }
+      }
+      buffer_pool_manager_->UnpinPage(prev_page->GetPageId(), true);
+    }
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+    if (merged_page_id != INVALID_PAGE_ID) {
+      buffer_pool_manager_->DeletePage(merged_page_id);
+    }
+    level = std::move(parents);
+  }
+
+  root_page_id_ = level[0].second;
+  UpdateRootPageId(1);
+  root_latch_.WUnlock();
+  return true;
+}
 
 /*****************************************************************************
  * INDEX ITERATOR
@@ -71,34 +796,116 @@ void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {}
  * index iterator
  * @return : index iterator
  */
-INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::Begin() -> INDEXITERATOR_TYPE { return INDEXITERATOR_TYPE(); }
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::Begin() -> INDEXITERATOR_TYPE { return Range(nullptr, nullptr); }
 
 /*
  * Input parameter is low key, find the leaf page that contains the input key
  * first, then construct index iterator
  * @return : index iterator
  */
-INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::Begin(const KeyType &key) -> INDEXITERATOR_TYPE { return INDEXITERATOR_TYPE(); }
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::Begin(const KeyType &key) -> INDEXITERATOR_TYPE { return Range(&key, nullptr); }
+
+/*
+ * Construct an index iterator that starts at the last pair of the rightmost leaf page and moves backward
+ * @return : index iterator
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::RBegin() -> INDEXITERATOR_TYPE { return Range(nullptr, nullptr, ScanDirection::BACKWARD); }
+
+/*
+ * Construct an index iterator over the keys in [low, high), which starts at the first key of the range if direction
+ * is forward and at its last key otherwise. The leaf page that holds the other end of the range is looked up too, so
+ * that the iterator can stop there without reading past it (see IndexIterator).
+ * @param low, high : the ends of the range, where nullptr leaves an end open
+ * @param prefetch : whether the iterator prefetches the next leaf page whenever it moves to a new one
+ * @return : index iterator
+ */
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::Range(const KeyType *low, const KeyType *high, ScanDirection direction, bool prefetch)
+    -> INDEXITERATOR_TYPE {
+  // the keys may be encoded into temporaries, so keep copies
+  StoredKey stored_low;
+  StoredKey stored_high;
+  if (low != nullptr) {
+    stored_low = codec_.Encode(*low);
+  }
+  if (high != nullptr) {
+    stored_high = codec_.Encode(*high);
+  }
+  const StoredKey *low_key = low != nullptr ? &stored_low : nullptr;
+  const StoredKey *high_key = high != nullptr ? &stored_high : nullptr;
+  if (low_key != nullptr && high_key != nullptr && comparator_(*low_key, *high_key) >= 0) {
+    return End();
+  }
+
+  // a forward scan starts at the leaf of low and stops at the leaf before high, and a backward scan the other way round
+  bool forward = direction == ScanDirection::FORWARD;
+  const StoredKey *start_key = forward ? low_key : high_key;
+  const StoredKey *stop_key = forward ? high_key : low_key;
+  Page *leaf_page = FindLeafOptimistic(start_key, false, !forward);
+  if (leaf_page == nullptr) {
+    return End();
+  }
+  auto *leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+  int index;
+  if (forward) {
+    index = low_key != nullptr ? leaf->KeyIndex(*low_key, comparator_) : 0;
+  } else {
+    index = high_key != nullptr ? leaf->KeyIndex(*high_key, comparator_) - 1 : leaf->GetSize() - 1;
+  }
+  uint64_t version = leaf_page->GetVersion();
+  leaf_page->RUnlatch();
+
+  Page *stop_page = nullptr;
+  uint64_t stop_version = 0;
+  if (stop_key != nullptr) {
+    stop_page = FindLeafOptimistic(stop_key, false, forward);
+    if (stop_page != nullptr) {
+      stop_version = stop_page->GetVersion();
+      stop_page->RUnlatch();
+    }
+  }
+  return INDEXITERATOR_TYPE(this, leaf_page, index, version, direction, low_key, high_key, stop_page, stop_version,
+                            prefetch);
+}
 
 /*
  * Input parameter is void, construct an index iterator representing the end
  * of the key/value pair in the leaf node
  * @return : index iterator
  */
-INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::End() -> INDEXITERATOR_TYPE { return INDEXITERATOR_TYPE(); }
 
 /**
  * @return Page id of the root of this tree
  */
-INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::GetRootPageId() -> page_id_t { return 0; }
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::GetRootPageId() -> page_id_t { return root_page_id_; }
 
 /*****************************************************************************
  * UTILITIES AND DEBUG
  *****************************************************************************/
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FetchPageOrThrow(page_id_t page_id) -> Page * {
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch a b+ tree page");
+  }
+  return page;
+}
+
+BPLUSTREE_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::NewPageOrThrow(page_id_t *page_id) -> Page * {
+  Page *page = buffer_pool_manager_->NewPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate a b+ tree page");
+  }
+  return page;
+}
+
 /*
  * Update/Insert root page id in header page(where page_id = 0, header_page is
  * defined under include/page/header_page.h)
@@ -107,12 +914,15 @@ auto BPLUSTREE_TYPE::GetRootPageId() -> page_id_t { return 0; }
  * insert a record <index_name, root_page_id> into header page instead of
  * updating it.
  */
-INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::UpdateRootPageId(int insert_record) {
   auto *header_page = static_cast<HeaderPage *>(buffer_pool_manager_->FetchPage(HEADER_PAGE_ID));
   if (insert_record != 0) {
     // create a new record<index_name + root_page_id> in header_page
-    header_page->InsertRecord(index_name_, root_page_id_);
+    // a tree that became empty and then grew again already has its record
+    if (!header_page->InsertRecord(index_name_, root_page_id_)) {
+      header_page->UpdateRecord(index_name_, root_page_id_);
+    }
   } else {
     // update root_page_id in header_page
     header_page->UpdateRecord(index_name_, root_page_id_);
@@ -124,7 +934,7 @@ void BPLUSTREE_TYPE::UpdateRootPageId(int insert_record) {
  * This method is used for test only
  * Read data from file and insert one by one
  */
-INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::InsertFromFile(const std::string &file_name, Transaction *transaction) {
   int64_t key;
   std::ifstream input(file_name);
@@ -141,7 +951,7 @@ void BPLUSTREE_TYPE::InsertFromFile(const std::string &file_name, Transaction *t
  * This method is used for test only
  * Read data from file and remove one by one
  */
-INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::RemoveFromFile(const std::string &file_name, Transaction *transaction) {
   int64_t key;
   std::ifstream input(file_name);
@@ -156,7 +966,7 @@ void BPLUSTREE_TYPE::RemoveFromFile(const std::string &file_name, Transaction *t
 /**
  * This method is used for debug only, You don't need to modify
  */
-INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::Draw(BufferPoolManager *bpm, const std::string &outf) {
   if (IsEmpty()) {
     LOG_WARN("Draw an empty tree");
@@ -173,7 +983,7 @@ void BPLUSTREE_TYPE::Draw(BufferPoolManager *bpm, const std::string &outf) {
 /**
  * This method is used for debug only, You don't need to modify
  */
-INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::Print(BufferPoolManager *bpm) {
   if (IsEmpty()) {
     LOG_WARN("Print an empty tree");
@@ -191,7 +1001,7 @@ void BPLUSTREE_TYPE::Print(BufferPoolManager *bpm) {
  * @param bpm
  * @param out
  */
-INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::ToGraph(BPlusTreePage *page, BufferPoolManager *bpm, std::ofstream &out) const {
   std::string leaf_prefix("LEAF_");
   std::string internal_prefix("INT_");
@@ -282,7 +1092,7 @@ void BPLUSTREE_TYPE::ToGraph(BPlusTreePage *page, BufferPoolManager *bpm, std::o
  * @param page
  * @param bpm
  */
-INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::ToString(BPlusTreePage *page, BufferPoolManager *bpm) const {
   if (page->IsLeafPage()) {
     auto *leaf = reinterpret_cast<LeafPage *>(page);
@@ -314,4 +1124,37 @@ template class BPlusTree<GenericKey<16>, RID, GenericComparator<16>>;
 template class BPlusTree<GenericKey<32>, RID, GenericComparator<32>>;
 template class BPlusTree<GenericKey<64>, RID, GenericComparator<64>>;
 
+template class BPlusTree<GenericKey<4>, RID, GenericComparator<4>,
+                         CompressedKeyCodec<GenericKey<4>, GenericComparator<4>>>;
+template class BPlusTree<GenericKey<8>, RID, GenericComparator<8>,
+                         CompressedKeyCodec<GenericKey<8>, GenericComparator<8>>>;
+template class BPlusTree<GenericKey<16>, RID, GenericComparator<16>,
+                         CompressedKeyCodec<GenericKey<16>, GenericComparator<16>>>;
+template class BPlusTree<GenericKey<32>, RID, GenericComparator<32>,
+                         CompressedKeyCodec<GenericKey<32>, GenericComparator<32>>>;
+template class BPlusTree<GenericKey<64>, RID, GenericComparator<64>,
+                         CompressedKeyCodec<GenericKey<64>, GenericComparator<64>>>;
+
+template class BPlusTree<GenericKey<4>, RID, GenericComparator<4>,
+                         VerbatimKeyCodec<GenericKey<4>, GenericComparator<4>>, false>;
+template class BPlusTree<GenericKey<8>, RID, GenericComparator<8>,
+                         VerbatimKeyCodec<GenericKey<8>, GenericComparator<8>>, false>;
+template class BPlusTree<GenericKey<16>, RID, GenericComparator<16>,
+                         VerbatimKeyCodec<GenericKey<16>, GenericComparator<16>>, false>;
+template class BPlusTree<GenericKey<32>, RID, GenericComparator<32>,
+                         VerbatimKeyCodec<GenericKey<32>, GenericComparator<32>>, false>;
+template class BPlusTree<GenericKey<64>, RID, GenericComparator<64>,
+                         VerbatimKeyCodec<GenericKey<64>, GenericComparator<64>>, false>;
+
+template class BPlusTree<GenericKey<4>, RID, GenericComparator<4>,
+                         CompressedKeyCodec<GenericKey<4>, GenericComparator<4>>, false>;
+template class BPlusTree<GenericKey<8>, RID, GenericComparator<8>,
+                         CompressedKeyCodec<GenericKey<8>, GenericComparator<8>>, false>;
+template class BPlusTree<GenericKey<16>, RID, GenericComparator<16>,
+                         CompressedKeyCodec<GenericKey<16>, GenericComparator<16>>, false>;
+template class BPlusTree<GenericKey<32>, RID, GenericComparator<32>,
+                         CompressedKeyCodec<GenericKey<32>, GenericComparator<32>>, false>;
+template class BPlusTree<GenericKey<64>, RID, GenericComparator<64>,
+                         CompressedKeyCodec<GenericKey<64>, GenericComparator<64>>, false>;
+
 }  // namespace bustub
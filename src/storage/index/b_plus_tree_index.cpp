@@ -9,16 +9,51 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+
 #include "storage/index/b_plus_tree_index.h"
+#include "type/value_factory.h"
 
 namespace bustub {
+
+namespace {
+
+/** A cursor over a range of a BPlusTreeIndex, which decodes the entries of the tree as it goes. */
+template <typename Iterator>
+class BPlusTreeIndexCursor : public IndexCursor {
+ public:
+  BPlusTreeIndexCursor(Iterator iterator, Schema *entry_schema)
+      : iterator_(std::move(iterator)), entry_schema_(entry_schema) {}
+
+  auto IsEnd() -> bool override { return iterator_.IsEnd(); }
+
+  auto GetEntry() -> Tuple override {
+    std::vector<Value> values;
+    values.reserve(entry_schema_->GetColumnCount());
+    for (uint32_t i = 0; i < entry_schema_->GetColumnCount(); i++) {
+      values.push_back((*iterator_).first.ToValue(entry_schema_, i));
+    }
+    return {values, entry_schema_};
+  }
+
+  auto GetRID() -> RID override { return (*iterator_).second; }
+
+  void Next() override { ++iterator_; }
+
+ private:
+  Iterator iterator_;
+  Schema *entry_schema_;
+};
+
+}  // namespace
 /*
  * Constructor
  */
 INDEX_TEMPLATE_ARGUMENTS
 BPLUSTREE_INDEX_TYPE::BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager)
     : Index(std::move(metadata)),
-      comparator_(GetMetadata()->GetKeySchema()),
+      comparator_(GetMetadata()->GetEntrySchema()),
+      key_comparator_(GetMetadata()->GetKeySchema()),
       container_(GetMetadata()->GetName(), buffer_pool_manager, comparator_) {}
 
 INDEX_TEMPLATE_ARGUMENTS
@@ -36,26 +71,83 @@ void BPLUSTREE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *t
   KeyType index_key;
   index_key.SetFromKey(key);
 
-  container_.Remove(index_key, transaction);
+  container_.Remove(index_key, rid, transaction);
 }
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
   // construct scan index key
+  KeyType index_key = LowestEntryOf(key);
+  if (GetIncludeAttrs().empty()) {
+    container_.GetValue(index_key, result, transaction);
+    return;
+  }
+  for (auto iterator = container_.Range(&index_key, nullptr);
+       !iterator.IsEnd() && key_comparator_((*iterator).first, index_key) == 0; ++iterator) {
+    result->push_back((*iterator).second);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::ScanRange(const Tuple *low, const Tuple *high, ScanDirection direction)
+    -> std::unique_ptr<IndexCursor> {
+  KeyType low_key;
+  KeyType high_key;
+  if (low != nullptr) {
+    low_key = LowestEntryOf(*low);
+  }
+  if (high != nullptr) {
+    high_key = LowestEntryOf(*high);
+  }
+  return std::make_unique<BPlusTreeIndexCursor<Iterator>>(
+      container_.Range(low != nullptr ? &low_key : nullptr, high != nullptr ? &high_key : nullptr, direction, true),
+      GetEntrySchema());
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::LowestEntryOf(const Tuple &key) -> KeyType {
   KeyType index_key;
-  index_key.SetFromKey(key);
+  if (GetIncludeAttrs().empty()) {
+    index_key.SetFromKey(key);
+    return index_key;
+  }
+  const Schema *key_schema = GetKeySchema();
+  const Schema *entry_schema = GetEntrySchema();
+  std::vector<Value> values;
+  for (uint32_t i = 0; i < entry_schema->GetColumnCount(); i++) {
+    values.push_back(i < key_schema->GetColumnCount()
+                         ? key.GetValue(key_schema, i)
+                         : ValueFactory::GetNullValueByType(entry_schema->GetColumn(i).GetType()));
+  }
+  index_key.SetFromKey(Tuple{values, entry_schema});
+  return index_key;
+}
 
-  container_.GetValue(index_key, result, transaction);
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::BulkLoad(std::vector<MappingType> *entries, Transaction *transaction) {
+  std::stable_sort(entries->begin(), entries->end(), [this](const MappingType &left, const MappingType &right) {
+    return comparator_(left.first, right.first) < 0;
+  });
+  auto it = entries->begin();
+  container_.BulkLoad(
+      [&it, entries](MappingType *entry) {
+        if (it == entries->end()) {
+          return false;
+        }
+        *entry = *it++;
+        return true;
+      },
+      INDEX_FILL_FACTOR, transaction);
 }
 
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_INDEX_TYPE::GetBeginIterator() -> INDEXITERATOR_TYPE { return container_.Begin(); }
+auto BPLUSTREE_INDEX_TYPE::GetBeginIterator() -> Iterator { return container_.Begin(); }
 
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_INDEX_TYPE::GetBeginIterator(const KeyType &key) -> INDEXITERATOR_TYPE { return container_.Begin(key); }
+auto BPLUSTREE_INDEX_TYPE::GetBeginIterator(const KeyType &key) -> Iterator { return container_.Begin(key); }
 
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_INDEX_TYPE::GetEndIterator() -> INDEXITERATOR_TYPE { return container_.End(); }
+auto BPLUSTREE_INDEX_TYPE::GetEndIterator() -> Iterator { return container_.End(); }
 
 template class BPlusTreeIndex<GenericKey<4>, RID, GenericComparator<4>>;
 template class BPlusTreeIndex<GenericKey<8>, RID, GenericComparator<8>>;
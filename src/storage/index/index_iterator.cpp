@@ -2,29 +2,277 @@
  * index_iterator.cpp
  */
 #include <cassert>
+#include <utility>
 
+#include "common/exception.h"
+#include "storage/index/b_plus_tree.h"
 #include "storage/index/index_iterator.h"
 
 namespace bustub {
 
-/*
- * NOTE: you can change the destructor/constructor method here
- * set your own input parameters
- */
-INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE::IndexIterator() = default;
 
-INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE::~IndexIterator() = default;  // NOLINT
+INDEXITERATOR_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::IndexIterator(Tree *tree, Page *page, int index, uint64_t page_version, ScanDirection direction,
+                                  const StoredKey *low, const StoredKey *high, Page *stop_page, uint64_t stop_version,
+                                  bool prefetch)
+    : tree_(tree),
+      page_(page),
+      index_(index),
+      page_version_(page_version),
+      direction_(direction),
+      stop_page_(stop_page),
+      stop_version_(stop_version),
+      prefetch_(prefetch) {
+  const StoredKey *bound = direction == ScanDirection::FORWARD ? high : low;
+  if (bound != nullptr) {
+    has_bound_ = true;
+    bound_ = *bound;
+  }
+  const StoredKey *start = direction == ScanDirection::FORWARD ? low : high;
+  if (start != nullptr) {
+    has_resume_key_ = true;
+    resume_key_ = *start;
+  }
+  if (prefetch_) {
+    page_->RLatch();
+    PrefetchSibling(reinterpret_cast<LeafPage *>(page_->GetData()));
+    page_->RUnlatch();
+  }
+  Settle();
+}
+
+INDEXITERATOR_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::~IndexIterator() {  // NOLINT
+  Release();
+}
+
+INDEXITERATOR_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::IndexIterator(IndexIterator &&other) noexcept
+    : tree_(other.tree_),
+      page_(other.page_),
+      index_(other.index_),
+      page_version_(other.page_version_),
+      value_index_(other.value_index_),
+      values_(std::move(other.values_)),
+      item_(other.item_),
+      direction_(other.direction_),
+      has_bound_(other.has_bound_),
+      bound_(other.bound_),
+      has_resume_key_(other.has_resume_key_),
+      resume_key_(other.resume_key_),
+      resume_past_(other.resume_past_),
+      stop_page_(other.stop_page_),
+      stop_version_(other.stop_version_),
+      prefetch_(other.prefetch_) {
+  other.page_ = nullptr;
+  other.index_ = 0;
+  other.value_index_ = 0;
+  other.stop_page_ = nullptr;
+}
+
+INDEXITERATOR_TEMPLATE_ARGUMENTS
+auto INDEXITERATOR_TYPE::operator=(IndexIterator &&other) noexcept -> INDEXITERATOR_TYPE & {
+  if (this != &other) {
+    Release();
+    tree_ = other.tree_;
+    page_ = other.page_;
+    index_ = other.index_;
+    page_version_ = other.page_version_;
+    value_index_ = other.value_index_;
+    values_ = std::move(other.values_);
+    item_ = other.item_;
+    direction_ = other.direction_;
+    has_bound_ = other.has_bound_;
+    bound_ = other.bound_;
+    has_resume_key_ = other.has_resume_key_;
+    resume_key_ = other.resume_key_;
+    resume_past_ = other.resume_past_;
+    stop_page_ = other.stop_page_;
+    stop_version_ = other.stop_version_;
+    prefetch_ = other.prefetch_;
+    other.page_ = nullptr;
+    other.index_ = 0;
+    other.value_index_ = 0;
+    other.stop_page_ = nullptr;
+  }
+  return *this;
+}
+
+INDEXITERATOR_TEMPLATE_ARGUMENTS
+auto INDEXITERATOR_TYPE::IsEnd() -> bool { return page_ == nullptr; }
+
+INDEXITERATOR_TEMPLATE_ARGUMENTS
+auto INDEXITERATOR_TYPE::operator*() -> const MappingType & {
+  assert(page_ != nullptr);
+  return item_;
+}
+
+INDEXITERATOR_TEMPLATE_ARGUMENTS
+auto INDEXITERATOR_TYPE::operator++() -> INDEXITERATOR_TYPE & {
+  assert(page_ != nullptr);
+  if (!Unique && value_index_ + 1 < static_cast<int>(values_.size())) {
+    item_.second = values_[++value_index_];
+    return *this;
+  }
+  value_index_ = 0;
+  index_ += direction_ == ScanDirection::FORWARD ? 1 : -1;
+  Settle();
+  return *this;
+}
 
-INDEX_TEMPLATE_ARGUMENTS
-auto INDEXITERATOR_TYPE::IsEnd() -> bool { throw std::runtime_error("unimplemented"); }
+INDEXITERATOR_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::Settle() {
+  if (page_ == nullptr) {
+    return;
+  }
+  const auto &comparator = tree_->comparator_;
+  page_->RLatch();
+  // a writer may have moved the pairs of the leaf around since the iterator was last here
+  if (page_->GetVersion() != page_version_ && !Relocate()) {
+    Release();
+    return;
+  }
+  while (true) {
+    auto *leaf = reinterpret_cast<LeafPage *>(page_->GetData());
+    if (index_ >= 0 && index_ < leaf->GetSize()) {
+      const StoredKey key = leaf->KeyAt(index_);
+      if (has_bound_ && (direction_ == ScanDirection::FORWARD ? comparator(key, bound_) >= 0
+                                                               : comparator(key, bound_) < 0)) {
+        break;
+      }
+      if constexpr (Unique) {
+        item_ = {tree_->codec_.Decode(key), leaf->ValueAt(index_)};
+      } else {
+        // the overflow pages of the posting list are protected by the latch of the leaf
+        values_.clear();
+        leaf->ValueAt(index_).GetValues(&values_, tree_->buffer_pool_manager_);
+        item_ = {tree_->codec_.Decode(key), values_[0]};
+      }
+      has_resume_key_ = true;
+      resume_key_ = key;
+      resume_past_ = true;
+      page_->RUnlatch();
+      return;
+    }
+    // No writer changed the leaf at the far end of the range since the range was looked up, so every key past it is
+    // out of the range.
+    if (page_ == stop_page_ && page_->GetVersion() == stop_version_) {
+      break;
+    }
+    if (!(direction_ == ScanDirection::FORWARD ? MoveToNextLeaf(leaf) : MoveToPrevLeaf(leaf))) {
+      break;
+    }
+  }
+  if (page_ != nullptr) {
+    page_->RUnlatch();
+  }
+  Release();
+}
 
-INDEX_TEMPLATE_ARGUMENTS
-auto INDEXITERATOR_TYPE::operator*() -> const MappingType & { throw std::runtime_error("unimplemented"); }
+INDEXITERATOR_TEMPLATE_ARGUMENTS
+auto INDEXITERATOR_TYPE::MoveToNextLeaf(LeafPage *leaf) -> bool {
+  page_id_t next_page_id = leaf->GetNextPageId();
+  if (next_page_id == INVALID_PAGE_ID) {
+    return false;
+  }
+  // Writers may latch a leaf and then its left sibling, so never wait for the next leaf while holding this one. The
+  // next leaf is still the next one as long as no writer changes it after its version is read under this leaf.
+  Page *next_page = tree_->buffer_pool_manager_->FetchPage(next_page_id);
+  if (next_page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch the next leaf page of an index iterator");
+  }
+  uint64_t next_version = next_page->GetVersion();
+  page_->RUnlatch();
+  tree_->buffer_pool_manager_->UnpinPage(page_->GetPageId(), false);
+  page_ = next_page;
+  page_->RLatch();
+  if (page_->GetVersion() != next_version || next_version % 2 == 1) {
+    return Relocate();
+  }
+  index_ = 0;
+  page_version_ = next_version;
+  PrefetchSibling(reinterpret_cast<LeafPage *>(page_->GetData()));
+  return true;
+}
 
-INDEX_TEMPLATE_ARGUMENTS
-auto INDEXITERATOR_TYPE::operator++() -> INDEXITERATOR_TYPE & { throw std::runtime_error("unimplemented"); }
+INDEXITERATOR_TEMPLATE_ARGUMENTS
+auto INDEXITERATOR_TYPE::MoveToPrevLeaf(LeafPage *leaf) -> bool {
+  page_id_t prev_page_id = leaf->GetPrevPageId();
+  if (prev_page_id == INVALID_PAGE_ID) {
+    return false;
+  }
+  BufferPoolManager *buffer_pool_manager = tree_->buffer_pool_manager_;
+  // A writer that holds the previous leaf may be waiting for this one, so only try to latch it. Holding this leaf
+  // while latching the previous one keeps the link between them from changing in between.
+  Page *prev_page = buffer_pool_manager->FetchPage(prev_page_id);
+  if (prev_page != nullptr && prev_page->TryRLatch()) {
+    page_->RUnlatch();
+    buffer_pool_manager->UnpinPage(page_->GetPageId(), false);
+    page_ = prev_page;
+    auto *prev_leaf = reinterpret_cast<LeafPage *>(page_->GetData());
+    index_ = prev_leaf->GetSize() - 1;
+    page_version_ = page_->GetVersion();
+    PrefetchSibling(prev_leaf);
+    return true;
+  }
+  if (prev_page != nullptr) {
+    buffer_pool_manager->UnpinPage(prev_page_id, false);
+  }
+  // Let go of this leaf, and find the leaf that holds the keys below the last one visited from the root.
+  return Relocate();
+}
+
+INDEXITERATOR_TEMPLATE_ARGUMENTS
+auto INDEXITERATOR_TYPE::Relocate() -> bool {
+  bool forward = direction_ == ScanDirection::FORWARD;
+  page_->RUnlatch();
+  tree_->buffer_pool_manager_->UnpinPage(page_->GetPageId(), false);
+  page_ = nullptr;
+  page_ = tree_->FindLeafOptimistic(has_resume_key_ ? &resume_key_ : nullptr, false, !forward);
+  if (page_ == nullptr) {
+    return false;
+  }
+  page_version_ = page_->GetVersion();
+  auto *leaf = reinterpret_cast<LeafPage *>(page_->GetData());
+  if (!has_resume_key_) {
+    index_ = forward ? 0 : leaf->GetSize() - 1;
+  } else if (forward) {
+    index_ = leaf->KeyIndex(resume_key_, tree_->comparator_);
+    if (resume_past_ && index_ < leaf->GetSize() && tree_->comparator_(leaf->KeyAt(index_), resume_key_) == 0) {
+      index_++;
+    }
+  } else {
+    index_ = leaf->KeyIndex(resume_key_, tree_->comparator_) - 1;
+  }
+  PrefetchSibling(leaf);
+  return true;
+}
+
+INDEXITERATOR_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::PrefetchSibling(LeafPage *leaf) {
+  // the iterator may end in the stop page without reading past it
+  if (!prefetch_ || page_ == stop_page_) {
+    return;
+  }
+  page_id_t page_id = direction_ == ScanDirection::FORWARD ? leaf->GetNextPageId() : leaf->GetPrevPageId();
+  if (page_id != INVALID_PAGE_ID) {
+    tree_->buffer_pool_manager_->PrefetchPages(page_id, 1);
+  }
+}
+
+INDEXITERATOR_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::Release() {
+  for (Page **page : {&page_, &stop_page_}) {
+    if (*page != nullptr) {
+      tree_->buffer_pool_manager_->UnpinPage((*page)->GetPageId(), false);
+      *page = nullptr;
+    }
+  }
+  index_ = 0;
+  value_index_ = 0;
+}
 
 template class IndexIterator<GenericKey<4>, RID, GenericComparator<4>>;
 
@@ -36,4 +284,49 @@ template class IndexIterator<GenericKey<32>, RID, GenericComparator<32>>;
 
 template class IndexIterator<GenericKey<64>, RID, GenericComparator<64>>;
 
+template class IndexIterator<GenericKey<4>, RID, GenericComparator<4>,
+                             CompressedKeyCodec<GenericKey<4>, GenericComparator<4>>>;
+
+template class IndexIterator<GenericKey<8>, RID, GenericComparator<8>,
+                             CompressedKeyCodec<GenericKey<8>, GenericComparator<8>>>;
+
+template class IndexIterator<GenericKey<16>, RID, GenericComparator<16>,
+                             CompressedKeyCodec<GenericKey<16>, GenericComparator<16>>>;
+
+template class IndexIterator<GenericKey<32>, RID, GenericComparator<32>,
+                             CompressedKeyCodec<GenericKey<32>, GenericComparator<32>>>;
+
+template class IndexIterator<GenericKey<64>, RID, GenericComparator<64>,
+                             CompressedKeyCodec<GenericKey<64>, GenericComparator<64>>>;
+
+template class IndexIterator<GenericKey<4>, RID, GenericComparator<4>,
+                             VerbatimKeyCodec<GenericKey<4>, GenericComparator<4>>, false>;
+
+template class IndexIterator<GenericKey<8>, RID, GenericComparator<8>,
+                             VerbatimKeyCodec<GenericKey<8>, GenericComparator<8>>, false>;
+
+template class IndexIterator<GenericKey<16>, RID, GenericComparator<16>,
+                             VerbatimKeyCodec<GenericKey<16>, GenericComparator<16>>, false>;
+
+template class IndexIterator<GenericKey<32>, RID, GenericComparator<32>,
+                             VerbatimKeyCodec<GenericKey<32>, GenericComparator<32>>, false>;
+
+template class IndexIterator<GenericKey<64>, RID, GenericComparator<64>,
+                             VerbatimKeyCodec<GenericKey<64>, GenericComparator<64>>, false>;
+
+template class IndexIterator<GenericKey<4>, RID, GenericComparator<4>,
+                             CompressedKeyCodec<GenericKey<4>, GenericComparator<4>>, false>;
+
+template class IndexIterator<GenericKey<8>, RID, GenericComparator<8>,
+                             CompressedKeyCodec<GenericKey<8>, GenericComparator<8>>, false>;
+
+template class IndexIterator<GenericKey<16>, RID, GenericComparator<16>,
+                             CompressedKeyCodec<GenericKey<16>, GenericComparator<16>>, false>;
+
+template class IndexIterator<GenericKey<32>, RID, GenericComparator<32>,
+                             CompressedKeyCodec<GenericKey<32>, GenericComparator<32>>, false>;
+
+template class IndexIterator<GenericKey<64>, RID, GenericComparator<64>,
+                             CompressedKeyCodec<GenericKey<64>, GenericComparator<64>>, false>;
+
 }  // namespace bustub
@@ -0,0 +1,130 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// key_codec.cpp
+//
+// Identification: src/storage/index/key_codec.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/index/key_codec.h"
+
+#include <cstring>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+namespace {
+
+/** How a column is encoded. */
+enum class ColumnEncoding { Unsigned, Signed, Decimal };
+
+auto EncodingOf(TypeId type) -> ColumnEncoding {
+  switch (type) {
+    case TypeId::TIMESTAMP:
+      return ColumnEncoding::Unsigned;
+    case TypeId::DECIMAL:
+      return ColumnEncoding::Decimal;
+    default:
+      return ColumnEncoding::Signed;
+  }
+}
+
+/** Encode the size bytes of a little-endian column at in into big-endian bytes at out, which sort with memcmp. */
+void EncodeColumn(ColumnEncoding encoding, const char *in, char *out, uint32_t size) {
+  uint64_t bits = 0;
+  memcpy(&bits, in, size);
+  uint64_t sign = uint64_t{1} << (size * 8 - 1);
+  if (encoding == ColumnEncoding::Signed) {
+    bits ^= sign;
+  } else if (encoding == ColumnEncoding::Decimal) {
+    bits = (bits & sign) != 0 ? ~bits : bits ^ sign;
+  }
+  for (uint32_t i = 0; i < size; i++) {
+    out[i] = static_cast<char>(bits >> ((size - 1 - i) * 8));
+  }
+}
+
+void DecodeColumn(ColumnEncoding encoding, const char *in, char *out, uint32_t size) {
+  uint64_t bits = 0;
+  for (uint32_t i = 0; i < size; i++) {
+    bits = (bits << 8) | static_cast<uint8_t>(in[i]);
+  }
+  uint64_t sign = uint64_t{1} << (size * 8 - 1);
+  if (encoding == ColumnEncoding::Signed) {
+    bits ^= sign;
+  } else if (encoding == ColumnEncoding::Decimal) {
+    bits = (bits & sign) != 0 ? bits ^ sign : ~bits;
+  }
+  memcpy(out, &bits, size);
+}
+
+}  // namespace
+
+template <size_t KeySize>
+CompressedKeyCodec<GenericKey<KeySize>, GenericComparator<KeySize>>::CompressedKeyCodec(
+    const GenericComparator<KeySize> &comparator)
+    : key_schema_(comparator.GetKeySchema()) {
+  for (const auto &column : key_schema_->GetColumns()) {
+    if (!column.IsInlined()) {
+      throw NotImplementedException("compressed b+ tree keys must only have fixed-length columns");
+    }
+  }
+}
+
+template <size_t KeySize>
+auto CompressedKeyCodec<GenericKey<KeySize>, GenericComparator<KeySize>>::Encode(const GenericKey<KeySize> &key) const
+    -> StoredKey {
+  StoredKey stored_key;
+  memset(stored_key.data_, 0, KeySize);
+  for (const auto &column : key_schema_->GetColumns()) {
+    uint32_t offset = column.GetOffset();
+    EncodeColumn(EncodingOf(column.GetType()), key.data_ + offset, stored_key.data_ + offset,
+                 column.GetFixedLength());
+  }
+  return stored_key;
+}
+
+template <size_t KeySize>
+auto CompressedKeyCodec<GenericKey<KeySize>, GenericComparator<KeySize>>::Decode(const StoredKey &stored_key) const
+    -> GenericKey<KeySize> {
+  GenericKey<KeySize> key;
+  memset(key.data_, 0, KeySize);
+  for (const auto &column : key_schema_->GetColumns()) {
+    uint32_t offset = column.GetOffset();
+    DecodeColumn(EncodingOf(column.GetType()), stored_key.data_ + offset, key.data_ + offset,
+                 column.GetFixedLength());
+  }
+  return key;
+}
+
+/*
+ * The bytes of right up to and including the first byte where it differs from left: any shorter prefix of right is
+ * also a prefix of left, and is not greater than left once padded with zero bytes.
+ */
+template <size_t KeySize>
+auto CompressedKeyCodec<GenericKey<KeySize>, GenericComparator<KeySize>>::Separator(const StoredKey &left,
+                                                                                    const StoredKey &right) const
+    -> StoredKey {
+  size_t size = 0;
+  while (size < KeySize && left.data_[size] == right.data_[size]) {
+    size++;
+  }
+  size = std::min(size + 1, KeySize);
+  StoredKey separator;
+  memcpy(separator.data_, right.data_, size);
+  memset(separator.data_ + size, 0, KeySize - size);
+  return separator;
+}
+
+template class CompressedKeyCodec<GenericKey<4>, GenericComparator<4>>;
+template class CompressedKeyCodec<GenericKey<8>, GenericComparator<8>>;
+template class CompressedKeyCodec<GenericKey<16>, GenericComparator<16>>;
+template class CompressedKeyCodec<GenericKey<32>, GenericComparator<32>>;
+template class CompressedKeyCodec<GenericKey<64>, GenericComparator<64>>;
+
+}  // namespace bustub
@@ -1,5 +1,6 @@
 #include <vector>
 
+#include "common/exception.h"
 #include "storage/index/linear_probe_hash_table_index.h"
 
 namespace bustub {
@@ -20,7 +21,10 @@ void HASH_TABLE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *
   KeyType index_key;
   index_key.SetFromKey(key);
 
-  container_.Insert(transaction, index_key, rid);
+  // The executors never insert a pair twice, so a failed insert means the table is full and cannot grow any further.
+  if (!container_.Insert(transaction, index_key, rid)) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "hash index is full");
+  }
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
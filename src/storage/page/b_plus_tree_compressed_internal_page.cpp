@@ -0,0 +1,261 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_compressed_internal_page.cpp
+//
+// Identification: src/storage/page/b_plus_tree_compressed_internal_page.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <vector>
+
+#include "common/exception.h"
+#include "storage/index/key_codec.h"
+#include "storage/page/b_plus_tree_compressed_internal_page.h"
+
+namespace bustub {
+/*****************************************************************************
+ * HELPER METHODS AND UTILITIES
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::Init(page_id_t page_id, page_id_t parent_id, int max_size) {
+  this->InitCompressed(IndexPageType::INTERNAL_PAGE, page_id, parent_id, max_size);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::KeyAt(int index) const -> KeyType { return this->StoredKeyAt(index); }
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::SetKeyAt(int index, const KeyType &key) {
+  if (index == 0) {
+    return;
+  }
+  std::vector<MappingType> entries;
+  this->GetEntries(&entries);
+  entries[index].first = key;
+  this->Rebuild(entries.cbegin(), entries.cend());
+}
+
+/*
+ * @return true if the page still fits once its index-th key is replaced with key, see SetKeyAt()
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::CanSetKeyAt(int index, const KeyType &key) const -> bool {
+  std::vector<MappingType> entries;
+  this->GetEntries(&entries);
+  entries[index].first = key;
+  return CompressedPage::RequiredBytes(entries.cbegin(), entries.cend(), 1) <= CompressedPage::DATA_SIZE;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::ValueAt(int index) const -> ValueType {
+  return this->StoredValueAt(index);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::SetValueAt(int index, const ValueType &value) {
+  this->SetStoredValueAt(index, value);
+}
+
+/*
+ * @return : the index of the child whose page id is value, or -1 if no child of this page has that value
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::ValueIndex(const ValueType &value) const -> int {
+  for (int i = 0; i < this->GetSize(); i++) {
+    if (ValueAt(i) == value) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/*****************************************************************************
+ * LOOKUP
+ *****************************************************************************/
+/*
+ * Find and return the child pointer(page_id) which points to the child page
+ * that contains input "key"
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::Lookup(const KeyType &key,
+                                                       const KeyComparator &comparator __attribute__((unused))) const
+    -> ValueType {
+  // the child before the first key that is greater than key
+  return ValueAt(this->Search(key, true) - 1);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::LookupBefore(const KeyType &key,
+                                                             const KeyComparator &comparator __attribute__((unused)))
+    const -> ValueType {
+  // the child before the first key that is not less than key
+  return ValueAt(this->Search(key, false) - 1);
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+/*
+ * @return true if key fits in the page, that is if the page does not need to split to take it
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::HasRoomFor(const KeyType &key) const -> bool {
+  return this->BytesAfterInsert(key) <= CompressedPage::DATA_SIZE;
+}
+
+/*
+ * @return true if any key fits in the page: even a whole key that empties the prefix, which lengthens every stored key
+ * by at most the size of the prefix
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::HasRoomForAnyKey() const -> bool {
+  return this->UsedBytes() + this->GetSize() * this->PrefixSize() + CompressedPage::MAX_ENTRY_SIZE <=
+         CompressedPage::DATA_SIZE;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::PopulateNewRoot(const ValueType &old_value, const KeyType &new_key,
+                                                                const ValueType &new_value) {
+  std::vector<MappingType> entries{{new_key, old_value}, {new_key, new_value}};
+  this->Rebuild(entries.cbegin(), entries.cend());
+}
+
+/*
+ * Insert new_key & new_value pair at the given index. The caller makes sure that the page has room for the pair.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::InsertAt(int index, const KeyType &new_key,
+                                                         const ValueType &new_value) {
+  this->InsertEntry(index, new_key, new_value);
+}
+
+/*
+ * A bulk load moves on to the next page once a page holds at least its min size and fill_factor of its bytes.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::ReachedFillFactor(double fill_factor) const -> bool {
+  return this->GetSize() >= std::max(2, this->GetMinSize()) &&
+         this->UsedBytes() >= fill_factor * CompressedPage::DATA_SIZE;
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::Remove(int index) { this->RemoveEntry(index); }
+
+/*****************************************************************************
+ * SPLIT, MERGE AND REDISTRIBUTE
+ *****************************************************************************/
+/*
+ * Insert new_key & new_value pair at the given index of this page, which has no room for it, by moving the upper part
+ * of its pairs to recipient, an empty page that becomes its right sibling.
+ * @return : the first key of recipient, the separator key that moves up to the parent
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::SplitInsert(int index, const KeyType &new_key,
+                                                            const ValueType &new_value,
+                                                            BPlusTreeCompressedInternalPage *recipient,
+                                                            BufferPoolManager *buffer_pool_manager) -> KeyType {
+  std::vector<MappingType> entries;
+  this->GetEntries(&entries);
+  entries.insert(entries.begin() + index, {new_key, new_value});
+  int split = CompressedPage::SplitPoint(entries, 1, this->GetMinSize());
+  this->Rebuild(entries.cbegin(), entries.cbegin() + split);
+  recipient->Rebuild(entries.cbegin() + split, entries.cend());
+  for (auto it = entries.cbegin() + split; it != entries.cend(); ++it) {
+    recipient->AdoptChild(it->second, buffer_pool_manager);
+  }
+  return entries[split].first;
+}
+
+/*
+ * @return true if the pairs of right, the right sibling of this page, fit in this page with middle_key pulled down
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::CanAbsorb(const BPlusTreeCompressedInternalPage *right,
+                                                          const KeyType &middle_key) const -> bool {
+  std::vector<MappingType> entries;
+  this->GetEntries(&entries);
+  int size = this->GetSize();
+  right->GetEntries(&entries);
+  entries[size].first = middle_key;
+  return CompressedPage::RequiredBytes(entries.cbegin(), entries.cend(), 1) <= CompressedPage::DATA_SIZE;
+}
+
+/*
+ * Move all of key & value pairs from this page to the end of recipient page, pulling middle_key (the separator of the
+ * two pages in their parent) down as the key of the first moved child.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::MoveAllTo(BPlusTreeCompressedInternalPage *recipient,
+                                                          const KeyType &middle_key,
+                                                          BufferPoolManager *buffer_pool_manager) {
+  std::vector<MappingType> entries;
+  recipient->GetEntries(&entries);
+  int size = recipient->GetSize();
+  this->GetEntries(&entries);
+  entries[size].first = middle_key;
+  recipient->Rebuild(entries.cbegin(), entries.cend());
+  for (auto it = entries.cbegin() + size; it != entries.cend(); ++it) {
+    recipient->AdoptChild(it->second, buffer_pool_manager);
+  }
+  this->Rebuild(entries.cend(), entries.cend());
+}
+
+/*
+ * Move the first child of this page to the tail of recipient page, its left sibling. middle_key is the separator of
+ * the two pages in their parent; the caller replaces it with the second key of this page, read before the move.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::MoveFirstToEndOf(BPlusTreeCompressedInternalPage *recipient,
+                                                                 const KeyType &middle_key,
+                                                                 BufferPoolManager *buffer_pool_manager) {
+  ValueType child = ValueAt(0);
+  recipient->InsertEntry(recipient->GetSize(), middle_key, child);
+  recipient->AdoptChild(child, buffer_pool_manager);
+  this->RemoveEntry(0);
+}
+
+/*
+ * Move the last key & value pair from this page to the head of recipient page, its right sibling. middle_key is the
+ * separator of the two pages in their parent; the caller replaces it with the last key of this page, read before the
+ * move.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::MoveLastToFrontOf(BPlusTreeCompressedInternalPage *recipient,
+                                                                  const KeyType &middle_key,
+                                                                  BufferPoolManager *buffer_pool_manager) {
+  int last = this->GetSize() - 1;
+  std::vector<MappingType> entries{{KeyAt(last), ValueAt(last)}};
+  recipient->GetEntries(&entries);
+  entries[1].first = middle_key;
+  recipient->Rebuild(entries.cbegin(), entries.cend());
+  recipient->AdoptChild(entries[0].second, buffer_pool_manager);
+  this->RemoveEntry(last);
+}
+
+/*
+ * Point the parent page id of a child that moved to this page at this page.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_INTERNAL_PAGE_TYPE::AdoptChild(const ValueType &child,
+                                                           BufferPoolManager *buffer_pool_manager) {
+  Page *page = buffer_pool_manager->FetchPage(child);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch the child of a b+ tree internal page");
+  }
+  reinterpret_cast<BPlusTreePage *>(page->GetData())->SetParentPageId(this->GetPageId());
+  buffer_pool_manager->UnpinPage(child, true);
+}
+
+template class BPlusTreeCompressedInternalPage<EncodedKey<4>, page_id_t, EncodedComparator<4>>;
+template class BPlusTreeCompressedInternalPage<EncodedKey<8>, page_id_t, EncodedComparator<8>>;
+template class BPlusTreeCompressedInternalPage<EncodedKey<16>, page_id_t, EncodedComparator<16>>;
+template class BPlusTreeCompressedInternalPage<EncodedKey<32>, page_id_t, EncodedComparator<32>>;
+template class BPlusTreeCompressedInternalPage<EncodedKey<64>, page_id_t, EncodedComparator<64>>;
+}  // namespace bustub
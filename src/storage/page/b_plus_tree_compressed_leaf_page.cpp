@@ -0,0 +1,217 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_compressed_leaf_page.cpp
+//
+// Identification: src/storage/page/b_plus_tree_compressed_leaf_page.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <vector>
+
+#include "common/rid.h"
+#include "storage/index/key_codec.h"
+#include "storage/page/b_plus_tree_compressed_leaf_page.h"
+#include "storage/page/b_plus_tree_posting_page.h"
+
+namespace bustub {
+
+/*****************************************************************************
+ * HELPER METHODS AND UTILITIES
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::Init(page_id_t page_id, page_id_t parent_id, int max_size) {
+  this->InitCompressed(IndexPageType::LEAF_PAGE, page_id, parent_id, max_size);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::GetNextPageId() const -> page_id_t { return this->next_page_id_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::SetNextPageId(page_id_t next_page_id) {
+  this->next_page_id_ = next_page_id;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::GetPrevPageId() const -> page_id_t { return this->prev_page_id_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::SetPrevPageId(page_id_t prev_page_id) {
+  this->prev_page_id_ = prev_page_id;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::KeyAt(int index) const -> KeyType { return this->StoredKeyAt(index); }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::ValueAt(int index) const -> ValueType {
+  return this->StoredValueAt(index);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::SetValueAt(int index, const ValueType &value) {
+  this->SetStoredValueAt(index, value);
+}
+
+/*
+ * Find the first index i so that the i-th key >= key
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::KeyIndex(const KeyType &key,
+                                                     const KeyComparator &comparator __attribute__((unused))) const
+    -> int {
+  return this->Search(key, false);
+}
+
+/*****************************************************************************
+ * LOOKUP
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::Lookup(const KeyType &key, ValueType *value,
+                                                   const KeyComparator &comparator) const -> bool {
+  int index = KeyIndex(key, comparator);
+  if (index == this->GetSize() || !this->KeyEqualsAt(index, key)) {
+    return false;
+  }
+  *value = ValueAt(index);
+  return true;
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+/*
+ * @return true if key fits in the page, that is if the page does not need to split to take it
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::HasRoomFor(const KeyType &key) const -> bool {
+  return this->BytesAfterInsert(key) <= CompressedPage::DATA_SIZE;
+}
+
+/*
+ * Insert key & value pair into leaf page ordered by key
+ * The caller makes sure that the page has room for the pair.
+ * @return page size after insertion
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::Insert(const KeyType &key, const ValueType &value,
+                                                   const KeyComparator &comparator) -> int {
+  int index = KeyIndex(key, comparator);
+  if (index < this->GetSize() && this->KeyEqualsAt(index, key)) {
+    return this->GetSize();
+  }
+  this->InsertEntry(index, key, value);
+  return this->GetSize();
+}
+
+/*
+ * Append key & value pair at the end of the leaf page. The caller makes sure that the key is greater than every key
+ * of the page and that the page has room for the pair.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::Append(const KeyType &key, const ValueType &value) {
+  this->InsertEntry(this->GetSize(), key, value);
+}
+
+/*
+ * A bulk load moves on to the next page once a page holds at least its min size and fill_factor of its bytes.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::ReachedFillFactor(double fill_factor) const -> bool {
+  return this->GetSize() >= this->GetMinSize() && this->UsedBytes() >= fill_factor * CompressedPage::DATA_SIZE;
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::RemoveAndDeleteRecord(const KeyType &key, const KeyComparator &comparator)
+    -> int {
+  int index = KeyIndex(key, comparator);
+  if (index == this->GetSize() || !this->KeyEqualsAt(index, key)) {
+    return this->GetSize();
+  }
+  this->RemoveEntry(index);
+  return this->GetSize();
+}
+
+/*****************************************************************************
+ * SPLIT, MERGE AND REDISTRIBUTE
+ *****************************************************************************/
+/*
+ * Insert key & value pair into this page, which has no room for it, by moving the upper part of its pairs to
+ * recipient, an empty page that becomes its right sibling; the caller links the two pages.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::SplitInsert(const KeyType &key, const ValueType &value,
+                                                        BPlusTreeCompressedLeafPage *recipient,
+                                                        const KeyComparator &comparator) {
+  std::vector<MappingType> entries;
+  this->GetEntries(&entries);
+  entries.insert(entries.begin() + KeyIndex(key, comparator), {key, value});
+  int split = CompressedPage::SplitPoint(entries, 0, this->GetMinSize());
+  this->Rebuild(entries.cbegin(), entries.cbegin() + split);
+  recipient->Rebuild(entries.cbegin() + split, entries.cend());
+}
+
+/*
+ * @return true if the pairs of right, the right sibling of this page, fit in this page
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::CanAbsorb(const BPlusTreeCompressedLeafPage *right) const -> bool {
+  std::vector<MappingType> entries;
+  this->GetEntries(&entries);
+  right->GetEntries(&entries);
+  return CompressedPage::RequiredBytes(entries.cbegin(), entries.cend(), 0) <= CompressedPage::DATA_SIZE;
+}
+
+/*
+ * Move all of key & value pairs from this page to the end of recipient page, its left sibling, and unlink this page.
+ * The caller links the next page back to recipient.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::MoveAllTo(BPlusTreeCompressedLeafPage *recipient) {
+  std::vector<MappingType> entries;
+  recipient->GetEntries(&entries);
+  this->GetEntries(&entries);
+  recipient->Rebuild(entries.cbegin(), entries.cend());
+  recipient->SetNextPageId(GetNextPageId());
+  this->Rebuild(entries.cend(), entries.cend());
+}
+
+/*
+ * Move the first key & value pair from this page to the tail of recipient page, its left sibling. The caller updates
+ * the separator key in the parent.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::MoveFirstToEndOf(BPlusTreeCompressedLeafPage *recipient) {
+  recipient->Append(KeyAt(0), ValueAt(0));
+  this->RemoveEntry(0);
+}
+
+/*
+ * Move the last key & value pair from this page to the head of recipient page, its right sibling. The caller updates
+ * the separator key in the parent.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_LEAF_PAGE_TYPE::MoveLastToFrontOf(BPlusTreeCompressedLeafPage *recipient) {
+  int last = this->GetSize() - 1;
+  recipient->InsertEntry(0, KeyAt(last), ValueAt(last));
+  this->RemoveEntry(last);
+}
+
+template class BPlusTreeCompressedLeafPage<EncodedKey<4>, RID, EncodedComparator<4>>;
+template class BPlusTreeCompressedLeafPage<EncodedKey<8>, RID, EncodedComparator<8>>;
+template class BPlusTreeCompressedLeafPage<EncodedKey<16>, RID, EncodedComparator<16>>;
+template class BPlusTreeCompressedLeafPage<EncodedKey<32>, RID, EncodedComparator<32>>;
+template class BPlusTreeCompressedLeafPage<EncodedKey<64>, RID, EncodedComparator<64>>;
+
+template class BPlusTreeCompressedLeafPage<EncodedKey<4>, PostingList<RID>, EncodedComparator<4>>;
+template class BPlusTreeCompressedLeafPage<EncodedKey<8>, PostingList<RID>, EncodedComparator<8>>;
+template class BPlusTreeCompressedLeafPage<EncodedKey<16>, PostingList<RID>, EncodedComparator<16>>;
+template class BPlusTreeCompressedLeafPage<EncodedKey<32>, PostingList<RID>, EncodedComparator<32>>;
+template class BPlusTreeCompressedLeafPage<EncodedKey<64>, PostingList<RID>, EncodedComparator<64>>;
+}  // namespace bustub
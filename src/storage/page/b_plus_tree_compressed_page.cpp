@@ -0,0 +1,335 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_compressed_page.cpp
+//
+// Identification: src/storage/page/b_plus_tree_compressed_page.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/macros.h"
+#include "common/rid.h"
+#include "storage/index/key_codec.h"
+#include "storage/page/b_plus_tree_compressed_page.h"
+#include "storage/page/b_plus_tree_posting_page.h"
+
+namespace bustub {
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_PAGE_TYPE::InitCompressed(IndexPageType page_type, page_id_t page_id, page_id_t parent_id,
+                                                      int max_size) {
+  SetPageType(page_type);
+  SetSize(0);
+  SetPageId(page_id);
+  SetParentPageId(parent_id);
+  SetMaxSize(std::min(max_size, MIN_CAPACITY));
+  next_page_id_ = INVALID_PAGE_ID;
+  prev_page_id_ = INVALID_PAGE_ID;
+  prefix_size_ = 0;
+  heap_offset_ = DATA_SIZE;
+  entry_bytes_ = 0;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::UsedBytes() const -> int { return entry_bytes_ + GetSize() * SLOT_SIZE; }
+
+/*****************************************************************************
+ * SLOTS AND ENTRIES
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::PrefixSize() const -> int { return std::min<int>(prefix_size_, KEY_SIZE); }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::SlotAt(int index) const -> int {
+  uint16_t offset;
+  memcpy(&offset, data_ + index * SLOT_SIZE, SLOT_SIZE);
+  return std::min<int>(offset, DATA_SIZE - MIN_ENTRY_SIZE + SLOT_SIZE);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_PAGE_TYPE::SetSlotAt(int index, int offset) {
+  auto slot = static_cast<uint16_t>(offset);
+  memcpy(data_ + index * SLOT_SIZE, &slot, SLOT_SIZE);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::SuffixSizeAt(int index) const -> int {
+  int offset = SlotAt(index);
+  int room = DATA_SIZE - offset - (MIN_ENTRY_SIZE - SLOT_SIZE);
+  return std::min({static_cast<int>(static_cast<uint8_t>(data_[offset])), KEY_SIZE - PrefixSize(), room});
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::SuffixAt(int index) const -> const char * { return data_ + SlotAt(index) + 1; }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::EntrySizeAt(int index) const -> int {
+  return MIN_ENTRY_SIZE - SLOT_SIZE + SuffixSizeAt(index);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::StoredKeyAt(int index) const -> KeyType {
+  KeyType key;
+  int prefix_size = PrefixSize();
+  int suffix_size = SuffixSizeAt(index);
+  memcpy(key.data_, prefix_, prefix_size);
+  memcpy(key.data_ + prefix_size, SuffixAt(index), suffix_size);
+  memset(key.data_ + prefix_size + suffix_size, 0, KEY_SIZE - prefix_size - suffix_size);
+  return key;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::StoredValueAt(int index) const -> ValueType {
+  ValueType value;
+  memcpy(reinterpret_cast<char *>(&value), SuffixAt(index) + SuffixSizeAt(index), sizeof(ValueType));
+  return value;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_PAGE_TYPE::SetStoredValueAt(int index, const ValueType &value) {
+  memcpy(data_ + SlotAt(index) + 1 + SuffixSizeAt(index), reinterpret_cast<const char *>(&value), sizeof(ValueType));
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::CompareSuffixAt(int index, const KeyType &key, int key_size) const -> int {
+  int prefix_size = PrefixSize();
+  int suffix_size = SuffixSizeAt(index);
+  int order = memcmp(SuffixAt(index), key.data_ + prefix_size, suffix_size);
+  if (order != 0) {
+    return order;
+  }
+  // the stored key continues with zero bytes, so it is less than key if key has more significant bytes
+  return key_size > prefix_size + suffix_size ? -1 : 0;
+}
+
+/*
+ * Binary search over the valid keys. The prefix is compared once: a key that does not share it is before or after
+ * every key of the page.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::Search(const KeyType &key, bool upper) const -> int {
+  int low = FirstKey();
+  int high = GetSize();
+  int prefix_order = memcmp(prefix_, key.data_, PrefixSize());
+  if (prefix_order != 0 || low == high) {
+    return prefix_order > 0 ? low : high;
+  }
+  int key_size = SignificantSize(key.data_, KEY_SIZE);
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    int order = CompareSuffixAt(mid, key, key_size);
+    if (order < 0 || (upper && order == 0)) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::KeyEqualsAt(int index, const KeyType &key) const -> bool {
+  return memcmp(prefix_, key.data_, PrefixSize()) == 0 &&
+         CompareSuffixAt(index, key, SignificantSize(key.data_, KEY_SIZE)) == 0;
+}
+
+/*****************************************************************************
+ * INSERTION AND REMOVAL
+ *****************************************************************************/
+/*
+ * A key that does not share the prefix shortens it, which lengthens the suffix of every key by the bytes the prefix
+ * loses, but never past the significant bytes of the key.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::BytesAfterInsert(const KeyType &key) const -> int {
+  int key_size = SignificantSize(key.data_, KEY_SIZE);
+  if (GetSize() == FirstKey()) {
+    return UsedBytes() + MIN_ENTRY_SIZE;
+  }
+  int prefix_size = PrefixSize();
+  int new_prefix_size = CommonPrefixSize(prefix_, key.data_, prefix_size);
+  int bytes = UsedBytes() + MIN_ENTRY_SIZE + std::max(0, key_size - new_prefix_size);
+  if (new_prefix_size < prefix_size) {
+    // the keys without suffix are the prefix followed by zero bytes
+    int prefix_only_growth = std::max(0, SignificantSize(prefix_, prefix_size) - new_prefix_size);
+    for (int i = FirstKey(); i < GetSize(); i++) {
+      bytes += SuffixSizeAt(i) > 0 ? prefix_size - new_prefix_size : prefix_only_growth;
+    }
+  }
+  return bytes;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_PAGE_TYPE::InsertEntry(int index, const KeyType &key, const ValueType &value) {
+  bool stored = index >= FirstKey();
+  if (stored && GetSize() == FirstKey()) {
+    // the only key of the page is its own prefix
+    memcpy(prefix_, key.data_, KEY_SIZE);
+    prefix_size_ = KEY_SIZE;
+  }
+  bool fits_prefix = !stored || memcmp(prefix_, key.data_, PrefixSize()) == 0;
+  if (!fits_prefix || heap_offset_ - (GetSize() + 1) * SLOT_SIZE < EntrySizeOf(key, stored)) {
+    std::vector<MappingType> entries;
+    GetEntries(&entries);
+    entries.insert(entries.begin() + index, {key, value});
+    Rebuild(entries.cbegin(), entries.cend());
+    return;
+  }
+  WriteEntry(index, key, value, stored);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::EntrySizeOf(const KeyType &key, bool stored) const -> int {
+  int suffix_size = stored ? std::max(0, SignificantSize(key.data_, KEY_SIZE) - PrefixSize()) : 0;
+  return MIN_ENTRY_SIZE - SLOT_SIZE + suffix_size;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_PAGE_TYPE::WriteEntry(int index, const KeyType &key, const ValueType &value, bool stored) {
+  int prefix_size = PrefixSize();
+  int entry_size = EntrySizeOf(key, stored);
+  int suffix_size = entry_size - (MIN_ENTRY_SIZE - SLOT_SIZE);
+  heap_offset_ -= entry_size;
+  char *entry = data_ + heap_offset_;
+  entry[0] = static_cast<char>(suffix_size);
+  memcpy(entry + 1, key.data_ + prefix_size, suffix_size);
+  memcpy(entry + 1 + suffix_size, reinterpret_cast<const char *>(&value), sizeof(ValueType));
+  memmove(data_ + (index + 1) * SLOT_SIZE, data_ + index * SLOT_SIZE, (GetSize() - index) * SLOT_SIZE);
+  SetSlotAt(index, heap_offset_);
+  entry_bytes_ += entry_size;
+  IncreaseSize(1);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_PAGE_TYPE::RemoveEntry(int index) {
+  entry_bytes_ -= EntrySizeAt(index);
+  memmove(data_ + index * SLOT_SIZE, data_ + (index + 1) * SLOT_SIZE, (GetSize() - index - 1) * SLOT_SIZE);
+  IncreaseSize(-1);
+  if (GetSize() == 0) {
+    heap_offset_ = DATA_SIZE;
+  }
+}
+
+/*****************************************************************************
+ * REBUILD
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_PAGE_TYPE::GetEntries(std::vector<MappingType> *entries) const {
+  entries->reserve(entries->size() + GetSize());
+  for (int i = 0; i < GetSize(); i++) {
+    entries->emplace_back(StoredKeyAt(i), StoredValueAt(i));
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_COMPRESSED_PAGE_TYPE::Rebuild(typename std::vector<MappingType>::const_iterator begin,
+                                               typename std::vector<MappingType>::const_iterator end) {
+  int first_key = FirstKey();
+  int size = static_cast<int>(end - begin);
+  BUSTUB_ASSERT(RequiredBytes(begin, end, first_key) <= DATA_SIZE, "the entries do not fit in the page");
+  int prefix_size = 0;
+  if (size > first_key) {
+    const char *first = begin[first_key].first.data_;
+    prefix_size = CommonPrefixSize(first, end[-1].first.data_, KEY_SIZE);
+    memcpy(prefix_, first, prefix_size);
+  }
+  prefix_size_ = prefix_size;
+  heap_offset_ = DATA_SIZE;
+  entry_bytes_ = 0;
+  SetSize(0);
+  for (auto it = begin; it != end; ++it) {
+    WriteEntry(GetSize(), it->first, it->second, GetSize() >= first_key);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::RequiredBytes(typename std::vector<MappingType>::const_iterator begin,
+                                                     typename std::vector<MappingType>::const_iterator end,
+                                                     int first_key) -> int {
+  int size = static_cast<int>(end - begin);
+  int bytes = size * MIN_ENTRY_SIZE;
+  if (size > first_key) {
+    int prefix_size = CommonPrefixSize(begin[first_key].first.data_, end[-1].first.data_, KEY_SIZE);
+    for (auto it = begin + first_key; it != end; ++it) {
+      bytes += std::max(0, SignificantSize(it->first.data_, KEY_SIZE) - prefix_size);
+    }
+  }
+  return bytes;
+}
+
+/*
+ * Prefer halves of about the same number of bytes. When the entries only fit in two pages because most of them share
+ * a long prefix, a half of min_size entries fits whatever its keys, and the other half is a part of a page that fit.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::SplitPoint(const std::vector<MappingType> &entries, int first_key,
+                                                  int min_size) -> int {
+  int size = static_cast<int>(entries.size());
+  int low = std::max(min_size, first_key + 1);
+  int high = size - min_size;
+  BUSTUB_ASSERT(low <= high, "too few entries to split");
+
+  int total = 0;
+  for (const auto &entry : entries) {
+    total += MIN_ENTRY_SIZE + SignificantSize(entry.first.data_, KEY_SIZE);
+  }
+  int balanced = 0;
+  for (int half = 0; balanced < size && half < total / 2; balanced++) {
+    half += MIN_ENTRY_SIZE + SignificantSize(entries[balanced].first.data_, KEY_SIZE);
+  }
+
+  for (int split : {balanced, size / 2, low, high}) {
+    split = std::clamp(split, low, high);
+    if (RequiredBytes(entries.cbegin(), entries.cbegin() + split, first_key) <= DATA_SIZE &&
+        RequiredBytes(entries.cbegin() + split, entries.cend(), first_key) <= DATA_SIZE) {
+      return split;
+    }
+  }
+  UNREACHABLE("no split point fits both halves");
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::CommonPrefixSize(const char *lhs, const char *rhs, int size) -> int {
+  int i = 0;
+  while (i < size && lhs[i] == rhs[i]) {
+    i++;
+  }
+  return i;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_COMPRESSED_PAGE_TYPE::SignificantSize(const char *data, int size) -> int {
+  while (size > 0 && data[size - 1] == 0) {
+    size--;
+  }
+  return size;
+}
+
+template class BPlusTreeCompressedPage<EncodedKey<4>, RID, EncodedComparator<4>>;
+template class BPlusTreeCompressedPage<EncodedKey<8>, RID, EncodedComparator<8>>;
+template class BPlusTreeCompressedPage<EncodedKey<16>, RID, EncodedComparator<16>>;
+template class BPlusTreeCompressedPage<EncodedKey<32>, RID, EncodedComparator<32>>;
+template class BPlusTreeCompressedPage<EncodedKey<64>, RID, EncodedComparator<64>>;
+
+template class BPlusTreeCompressedPage<EncodedKey<4>, PostingList<RID>, EncodedComparator<4>>;
+template class BPlusTreeCompressedPage<EncodedKey<8>, PostingList<RID>, EncodedComparator<8>>;
+template class BPlusTreeCompressedPage<EncodedKey<16>, PostingList<RID>, EncodedComparator<16>>;
+template class BPlusTreeCompressedPage<EncodedKey<32>, PostingList<RID>, EncodedComparator<32>>;
+template class BPlusTreeCompressedPage<EncodedKey<64>, PostingList<RID>, EncodedComparator<64>>;
+
+template class BPlusTreeCompressedPage<EncodedKey<4>, page_id_t, EncodedComparator<4>>;
+template class BPlusTreeCompressedPage<EncodedKey<8>, page_id_t, EncodedComparator<8>>;
+template class BPlusTreeCompressedPage<EncodedKey<16>, page_id_t, EncodedComparator<16>>;
+template class BPlusTreeCompressedPage<EncodedKey<32>, page_id_t, EncodedComparator<32>>;
+template class BPlusTreeCompressedPage<EncodedKey<64>, page_id_t, EncodedComparator<64>>;
+
+}  // namespace bustub
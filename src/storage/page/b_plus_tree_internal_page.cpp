@@ -9,11 +9,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
 #include "common/exception.h"
 #include "storage/page/b_plus_tree_internal_page.h"
+#include "storage/page/b_plus_tree_key_search.h"
 
 namespace bustub {
 /*****************************************************************************
@@ -25,27 +27,246 @@ namespace bustub {
  * max page size
  */
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_INTERNAL_PAGE_TYPE::Init(page_id_t page_id, page_id_t parent_id, int max_size) {}
+void B_PLUS_TREE_INTERNAL_PAGE_TYPE::Init(page_id_t page_id, page_id_t parent_id, int max_size) {
+  SetPageType(IndexPageType::INTERNAL_PAGE);
+  SetSize(0);
+  SetPageId(page_id);
+  SetParentPageId(parent_id);
+  SetMaxSize(max_size);
+}
 /*
  * Helper method to get/set the key associated with input "index"(a.k.a
  * array offset)
  */
 INDEX_TEMPLATE_ARGUMENTS
-auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::KeyAt(int index) const -> KeyType {
-  // replace with your own code
-  KeyType key{};
-  return key;
-}
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::KeyAt(int index) const -> KeyType { return array_[index].first; }
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_INTERNAL_PAGE_TYPE::SetKeyAt(int index, const KeyType &key) { array_[index].first = key; }
 
+/*
+ * Keys have a fixed size, so a key can always be replaced.
+ */
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_INTERNAL_PAGE_TYPE::SetKeyAt(int index, const KeyType &key) {}
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::CanSetKeyAt(int index __attribute__((unused)),
+                                                 const KeyType &key __attribute__((unused))) const -> bool {
+  return true;
+}
 
 /*
- * Helper method to get the value associated with input "index"(a.k.a array
+ * Helper method to get/set the value associated with input "index"(a.k.a array
  * offset)
  */
 INDEX_TEMPLATE_ARGUMENTS
-auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::ValueAt(int index) const -> ValueType { return 0; }
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::ValueAt(int index) const -> ValueType { return array_[index].second; }
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_INTERNAL_PAGE_TYPE::SetValueAt(int index, const ValueType &value) { array_[index].second = value; }
+
+/*
+ * Helper method to find and return array index(or offset), so that its value
+ * equals to input "value"
+ * @return : the index, or -1 if no child of this page has that value
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::ValueIndex(const ValueType &value) const -> int {
+  for (int i = 0; i < GetSize(); i++) {
+    if (array_[i].second == value) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/*****************************************************************************
+ * LOOKUP
+ *****************************************************************************/
+/*
+ * Find and return the child pointer(page_id) which points to the child page
+ * that contains input "key"
+ * Start the search from the second key(the first key should always be invalid)
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::Lookup(const KeyType &key, const KeyComparator &comparator) const -> ValueType {
+  // the child before the first key, past the invalid one, that is greater than key
+  int index = 1 + KeySearch<KeyType, KeyComparator>::UpperBound(array_ + 1, GetSize() - 1, key, comparator);
+  return array_[index - 1].second;
+}
+
+/*
+ * Find and return the child pointer which points to the child page that contains the greatest keys less than key, so
+ * that a key equal to a separator goes to the child before it
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::LookupBefore(const KeyType &key, const KeyComparator &comparator) const
+    -> ValueType {
+  // the child before the first key, past the invalid one, that is not less than key
+  int index = 1 + KeySearch<KeyType, KeyComparator>::LowerBound(array_ + 1, GetSize() - 1, key, comparator);
+  return array_[index - 1].second;
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+/*
+ * An internal page splits before an insertion when it is full, so it has room for a key, whatever the key, if it is
+ * not full.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::HasRoomFor(const KeyType &key __attribute__((unused))) const -> bool {
+  return HasRoomForAnyKey();
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::HasRoomForAnyKey() const -> bool { return GetSize() < GetMaxSize(); }
+
+/*
+ * Populate new root page with old_value + new_key & new_value
+ * When the insertion cause overflow from leaf page all the way upto the root
+ * page, you should create a new root page and populate its elements.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_INTERNAL_PAGE_TYPE::PopulateNewRoot(const ValueType &old_value, const KeyType &new_key,
+                                                     const ValueType &new_value) {
+  array_[0].second = old_value;
+  array_[1] = {new_key, new_value};
+  SetSize(2);
+}
+
+/*
+ * Insert new_key & new_value pair at the given index, shifting the pairs after it one slot to the right.
+ * The caller makes sure that the page has room for one more pair.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_INTERNAL_PAGE_TYPE::InsertAt(int index, const KeyType &new_key, const ValueType &new_value) {
+  std::move_backward(array_ + index, array_ + GetSize(), array_ + GetSize() + 1);
+  array_[index] = {new_key, new_value};
+  IncreaseSize(1);
+}
+
+/*
+ * A bulk load moves on to the next page once a page holds fill_factor of the pairs it has room for, but at least its
+ * min size and two children.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::ReachedFillFactor(double fill_factor) const -> bool {
+  int capacity = GetMaxSize();
+  return GetSize() >= std::clamp(static_cast<int>(fill_factor * capacity), std::max(2, GetMinSize()), capacity);
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+/*
+ * Remove the key & value pair in internal page according to input index(a.k.a
+ * array offset)
+ * NOTE: store key&value pair continuously after deletion
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_INTERNAL_PAGE_TYPE::Remove(int index) {
+  std::move(array_ + index + 1, array_ + GetSize(), array_ + index);
+  IncreaseSize(-1);
+}
+
+/*****************************************************************************
+ * SPLIT, MERGE AND REDISTRIBUTE
+ *****************************************************************************/
+/*
+ * Insert new_key & new_value pair at the given index of this page, which is full, by moving the upper half of its
+ * pairs to recipient, an empty page that becomes its right sibling.
+ * @return : the first key of recipient, the separator key that moves up to the parent
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::SplitInsert(int index, const KeyType &new_key, const ValueType &new_value,
+                                                 BPlusTreeInternalPage *recipient,
+                                                 BufferPoolManager *buffer_pool_manager) -> KeyType {
+  int left_size = (GetSize() + 2) / 2;
+  if (index < left_size) {
+    MoveTailTo(recipient, left_size - 1, buffer_pool_manager);
+    InsertAt(index, new_key, new_value);
+  } else {
+    MoveTailTo(recipient, left_size, buffer_pool_manager);
+    recipient->InsertAt(index - left_size, new_key, new_value);
+    recipient->AdoptChild(new_value, buffer_pool_manager);
+  }
+  return recipient->KeyAt(0);
+}
+
+/*
+ * @return true if the pairs of right, the right sibling of this page, fit in this page with the separator of the two
+ * pages pulled down
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::CanAbsorb(const BPlusTreeInternalPage *right,
+                                               const KeyType &middle_key __attribute__((unused))) const -> bool {
+  return GetSize() + right->GetSize() <= GetMaxSize();
+}
+
+/*
+ * Move the pairs from from_index to the end of this page to the end of recipient page. Used to split a full page into
+ * an empty recipient, whose first key then becomes the separator key that moves up to the parent.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_INTERNAL_PAGE_TYPE::MoveTailTo(BPlusTreeInternalPage *recipient, int from_index,
+                                                BufferPoolManager *buffer_pool_manager) {
+  int count = GetSize() - from_index;
+  std::copy(array_ + from_index, array_ + GetSize(), recipient->array_ + recipient->GetSize());
+  for (int i = recipient->GetSize(); i < recipient->GetSize() + count; i++) {
+    recipient->AdoptChild(recipient->array_[i].second, buffer_pool_manager);
+  }
+  recipient->IncreaseSize(count);
+  IncreaseSize(-count);
+}
+
+/*
+ * Move all of key & value pairs from this page to the end of recipient page, pulling middle_key (the separator of the
+ * two pages in their parent) down as the key of the first moved child.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_INTERNAL_PAGE_TYPE::MoveAllTo(BPlusTreeInternalPage *recipient, const KeyType &middle_key,
+                                               BufferPoolManager *buffer_pool_manager) {
+  SetKeyAt(0, middle_key);
+  MoveTailTo(recipient, 0, buffer_pool_manager);
+}
+
+/*
+ * Move the first key & value pair from this page to the tail of recipient page, its left sibling. middle_key is the
+ * separator of the two pages in their parent; the caller replaces it with the new first key of this page.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_INTERNAL_PAGE_TYPE::MoveFirstToEndOf(BPlusTreeInternalPage *recipient, const KeyType &middle_key,
+                                                      BufferPoolManager *buffer_pool_manager) {
+  recipient->array_[recipient->GetSize()] = {middle_key, array_[0].second};
+  recipient->IncreaseSize(1);
+  recipient->AdoptChild(array_[0].second, buffer_pool_manager);
+  Remove(0);
+}
+
+/*
+ * Move the last key & value pair from this page to the head of recipient page, its right sibling. middle_key is the
+ * separator of the two pages in their parent; the caller replaces it with the new first key of recipient.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_INTERNAL_PAGE_TYPE::MoveLastToFrontOf(BPlusTreeInternalPage *recipient, const KeyType &middle_key,
+                                                       BufferPoolManager *buffer_pool_manager) {
+  recipient->SetKeyAt(0, middle_key);
+  recipient->InsertAt(0, array_[GetSize() - 1].first, array_[GetSize() - 1].second);
+  recipient->AdoptChild(array_[GetSize() - 1].second, buffer_pool_manager);
+  IncreaseSize(-1);
+}
+
+/*
+ * Point the parent page id of a child that moved to this page at this page.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_INTERNAL_PAGE_TYPE::AdoptChild(const ValueType &child, BufferPoolManager *buffer_pool_manager) {
+  Page *page = buffer_pool_manager->FetchPage(child);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch the child of a b+ tree internal page");
+  }
+  reinterpret_cast<BPlusTreePage *>(page->GetData())->SetParentPageId(GetPageId());
+  buffer_pool_manager->UnpinPage(child, true);
+}
 
 // valuetype for internalNode should be page id_t
 template class BPlusTreeInternalPage<GenericKey<4>, page_id_t, GenericComparator<4>>;
@@ -0,0 +1,128 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_key_search.cpp
+//
+// Identification: src/storage/page/b_plus_tree_key_search.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/b_plus_tree_key_search.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace bustub {
+
+namespace {
+
+/** The binary search stops once this many keys are left, and the window is counted at once. */
+constexpr int SEARCH_WINDOW = 16;
+
+template <typename Int>
+inline auto LoadKey(const char *key) -> Int {
+  Int value;
+  memcpy(&value, key, sizeof(Int));
+  return value;
+}
+
+/** Count the keys of the window that are below the bound, one at a time. */
+template <typename Int>
+auto CountBelowScalar(const char *keys, size_t stride, int size, Int key, bool upper) -> int {
+  int count = 0;
+  for (int i = 0; i < size; i++) {
+    Int value = LoadKey<Int>(keys + i * stride);
+    count += static_cast<int>(upper ? value <= key : value < key);
+  }
+  return count;
+}
+
+#if defined(__x86_64__)
+
+/** Count the keys of the window that are below the bound, gathering four 8-byte keys at a time. */
+__attribute__((target("avx2"))) auto CountBelowAvx2(const char *keys, size_t stride, int size, int64_t key, bool upper)
+    -> int {
+  auto step = static_cast<int64_t>(stride);
+  const __m256i offsets = _mm256_set_epi64x(3 * step, 2 * step, step, 0);
+  const __m256i probe = _mm256_set1_epi64x(key);
+  int count = 0;
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    __m256i values =
+        _mm256_i64gather_epi64(reinterpret_cast<const long long *>(keys + i * stride), offsets, 1);  // NOLINT
+    // value < key is key > value; value <= key is not value > key
+    __m256i mask = upper ? _mm256_cmpgt_epi64(values, probe) : _mm256_cmpgt_epi64(probe, values);
+    int matches = __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+    count += upper ? 4 - matches : matches;
+  }
+  return count + CountBelowScalar<int64_t>(keys + i * stride, stride, size - i, key, upper);
+}
+
+/** Count the keys of the window that are below the bound, gathering eight 4-byte keys at a time. */
+__attribute__((target("avx2"))) auto CountBelowAvx2(const char *keys, size_t stride, int size, int32_t key, bool upper)
+    -> int {
+  auto step = static_cast<int32_t>(stride);
+  const __m256i offsets = _mm256_set_epi32(7 * step, 6 * step, 5 * step, 4 * step, 3 * step, 2 * step, step, 0);
+  const __m256i probe = _mm256_set1_epi32(key);
+  int count = 0;
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256i values = _mm256_i32gather_epi32(reinterpret_cast<const int *>(keys + i * stride), offsets, 1);
+    __m256i mask = upper ? _mm256_cmpgt_epi32(values, probe) : _mm256_cmpgt_epi32(probe, values);
+    int matches = __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+    count += upper ? 8 - matches : matches;
+  }
+  return count + CountBelowScalar<int32_t>(keys + i * stride, stride, size - i, key, upper);
+}
+
+auto CpuHasAvx2() -> bool {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+}
+
+const bool HAS_AVX2 = CpuHasAvx2();
+
+#endif
+
+template <typename Int>
+auto CountBelow(const char *keys, size_t stride, int size, Int key, bool upper) -> int {
+#if defined(__x86_64__)
+  if (HAS_AVX2) {
+    return CountBelowAvx2(keys, stride, size, key, upper);
+  }
+#endif
+  return CountBelowScalar<Int>(keys, stride, size, key, upper);
+}
+
+/*
+ * Branchless binary search: the answer stays within [first, first + size], and every step halves size by moving
+ * first with a conditional move instead of a branch the CPU cannot predict.
+ */
+template <typename Int>
+auto Search(const char *keys, size_t stride, int size, Int key, bool upper) -> int {
+  const char *first = keys;
+  while (size > SEARCH_WINDOW) {
+    int half = size / 2;
+    Int value = LoadKey<Int>(first + half * stride);
+    bool below = upper ? value <= key : value < key;
+    first += below ? half * stride : 0;
+    size -= half;
+  }
+  return static_cast<int>((first - keys) / stride) + CountBelow<Int>(first, stride, size, key, upper);
+}
+
+}  // namespace
+
+auto IntegerKeySearch(const char *keys, size_t stride, int size, int32_t key, bool upper) -> int {
+  return Search<int32_t>(keys, stride, size, key, upper);
+}
+
+auto IntegerKeySearch(const char *keys, size_t stride, int size, int64_t key, bool upper) -> int {
+  return Search<int64_t>(keys, stride, size, key, upper);
+}
+
+}  // namespace bustub
@@ -9,11 +9,14 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <sstream>
 
 #include "common/exception.h"
 #include "common/rid.h"
+#include "storage/page/b_plus_tree_key_search.h"
 #include "storage/page/b_plus_tree_leaf_page.h"
+#include "storage/page/b_plus_tree_posting_page.h"
 
 namespace bustub {
 
@@ -24,29 +27,224 @@ namespace bustub {
 /**
  * Init method after creating a new leaf page
  * Including set page type, set current size to zero, set page id/parent id, set
- * next page id and set max size
+ * next/prev page id and set max size, which is at most the number of pairs that fit in the page
  */
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_LEAF_PAGE_TYPE::Init(page_id_t page_id, page_id_t parent_id, int max_size) {}
+void B_PLUS_TREE_LEAF_PAGE_TYPE::Init(page_id_t page_id, page_id_t parent_id, int max_size) {
+  SetPageType(IndexPageType::LEAF_PAGE);
+  SetSize(0);
+  SetPageId(page_id);
+  SetParentPageId(parent_id);
+  SetMaxSize(std::min(max_size, static_cast<int>(LEAF_PAGE_SIZE)));
+  next_page_id_ = INVALID_PAGE_ID;
+  prev_page_id_ = INVALID_PAGE_ID;
+}
 
 /**
- * Helper methods to set/get next page id
+ * Helper methods to set/get next/prev page id
  */
 INDEX_TEMPLATE_ARGUMENTS
-auto B_PLUS_TREE_LEAF_PAGE_TYPE::GetNextPageId() const -> page_id_t { return INVALID_PAGE_ID; }
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::GetNextPageId() const -> page_id_t { return next_page_id_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
 
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_LEAF_PAGE_TYPE::SetNextPageId(page_id_t next_page_id) {}
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::GetPrevPageId() const -> page_id_t { return prev_page_id_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::SetPrevPageId(page_id_t prev_page_id) { prev_page_id_ = prev_page_id; }
 
 /*
  * Helper method to find and return the key associated with input "index"(a.k.a
  * array offset)
  */
 INDEX_TEMPLATE_ARGUMENTS
-auto B_PLUS_TREE_LEAF_PAGE_TYPE::KeyAt(int index) const -> KeyType {
-  // replace with your own code
-  KeyType key{};
-  return key;
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::KeyAt(int index) const -> KeyType { return array_[index].first; }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::ValueAt(int index) const -> ValueType { return array_[index].second; }
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::SetValueAt(int index, const ValueType &value) { array_[index].second = value; }
+
+/*
+ * Helper method to find and return the key & value pair associated with input
+ * "index"(a.k.a array offset)
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::GetItem(int index) -> const MappingType & { return array_[index]; }
+
+/*
+ * Helper method to find the first index i so that array_[i].first >= key, with the search kernel of the comparator
+ * (see KeySearch)
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::KeyIndex(const KeyType &key, const KeyComparator &comparator) const -> int {
+  return KeySearch<KeyType, KeyComparator>::LowerBound(array_, GetSize(), key, comparator);
+}
+
+/*****************************************************************************
+ * LOOKUP
+ *****************************************************************************/
+/*
+ * For the given key, check to see whether it exists in the leaf page. If it
+ * does, then store its corresponding value in input "value" and return true.
+ * If the key does not exist, then return false
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::Lookup(const KeyType &key, ValueType *value, const KeyComparator &comparator) const
+    -> bool {
+  int index = KeyIndex(key, comparator);
+  if (index == GetSize() || !KeySearch<KeyType, KeyComparator>::Equals(array_[index].first, key, comparator)) {
+    return false;
+  }
+  *value = array_[index].second;
+  return true;
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+/*
+ * A leaf splits as soon as it is full, so it has room for a key if it is not full once the key is inserted.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::HasRoomFor(const KeyType &key __attribute__((unused))) const -> bool {
+  return GetSize() + 1 < GetMaxSize();
+}
+
+/*
+ * Insert key & value pair into leaf page ordered by key
+ * The caller makes sure that the page has room for one more pair.
+ * @return page size after insertion
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::Insert(const KeyType &key, const ValueType &value, const KeyComparator &comparator)
+    -> int {
+  int index = KeyIndex(key, comparator);
+  if (index < GetSize() && KeySearch<KeyType, KeyComparator>::Equals(array_[index].first, key, comparator)) {
+    return GetSize();
+  }
+  std::move_backward(array_ + index, array_ + GetSize(), array_ + GetSize() + 1);
+  array_[index] = {key, value};
+  IncreaseSize(1);
+  return GetSize();
+}
+
+/*
+ * Append key & value pair at the end of the leaf page, skipping the search for its position. The caller makes sure
+ * that the key is greater than every key of the page and that the page has room for one more pair.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::Append(const KeyType &key, const ValueType &value) {
+  array_[GetSize()] = {key, value};
+  IncreaseSize(1);
+}
+
+/*
+ * A bulk load moves on to the next page once a page holds fill_factor of the pairs it has room for, but at least its
+ * min size.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::ReachedFillFactor(double fill_factor) const -> bool {
+  int capacity = GetMaxSize() - 1;
+  return GetSize() >= std::clamp(static_cast<int>(fill_factor * capacity), std::max(1, GetMinSize()), capacity);
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+/*
+ * First look through leaf page to see whether delete key exist or not. If
+ * exist, perform deletion, otherwise return immediately.
+ * NOTE: store key&value pair continuously after deletion
+ * @return  page size after deletion
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::RemoveAndDeleteRecord(const KeyType &key, const KeyComparator &comparator) -> int {
+  int index = KeyIndex(key, comparator);
+  if (index == GetSize() || !KeySearch<KeyType, KeyComparator>::Equals(array_[index].first, key, comparator)) {
+    return GetSize();
+  }
+  std::move(array_ + index + 1, array_ + GetSize(), array_ + index);
+  IncreaseSize(-1);
+  return GetSize();
+}
+
+/*****************************************************************************
+ * SPLIT, MERGE AND REDISTRIBUTE
+ *****************************************************************************/
+/*
+ * Insert key & value pair into this page, which has no room for it, by moving the upper half of its pairs to
+ * recipient, an empty page that becomes its right sibling; the caller links the two pages.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::SplitInsert(const KeyType &key, const ValueType &value, BPlusTreeLeafPage *recipient,
+                                             const KeyComparator &comparator) {
+  int left_size = (GetSize() + 1) / 2;
+  if (KeyIndex(key, comparator) < left_size) {
+    MoveTailTo(recipient, left_size - 1);
+    Insert(key, value, comparator);
+  } else {
+    MoveTailTo(recipient, left_size);
+    recipient->Insert(key, value, comparator);
+  }
+}
+
+/*
+ * @return true if the pairs of right, the right sibling of this page, fit in this page
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::CanAbsorb(const BPlusTreeLeafPage *right) const -> bool {
+  return GetSize() + right->GetSize() < GetMaxSize();
+}
+
+/*
+ * Move the pairs from from_index to the end of this page to the end of recipient page. Used to split a full page into
+ * an empty recipient that becomes its right sibling; the caller links the two pages.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveTailTo(BPlusTreeLeafPage *recipient, int from_index) {
+  int count = GetSize() - from_index;
+  std::copy(array_ + from_index, array_ + GetSize(), recipient->array_ + recipient->GetSize());
+  recipient->IncreaseSize(count);
+  IncreaseSize(-count);
+}
+
+/*
+ * Move all of key & value pairs from this page to the end of recipient page, its left sibling, and unlink this page.
+ * The caller links the next page back to recipient.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveAllTo(BPlusTreeLeafPage *recipient) {
+  MoveTailTo(recipient, 0);
+  recipient->SetNextPageId(GetNextPageId());
+}
+
+/*
+ * Move the first key & value pair from this page to the tail of recipient page, its left sibling. The caller updates
+ * the separator key in the parent.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveFirstToEndOf(BPlusTreeLeafPage *recipient) {
+  recipient->array_[recipient->GetSize()] = array_[0];
+  recipient->IncreaseSize(1);
+  std::move(array_ + 1, array_ + GetSize(), array_);
+  IncreaseSize(-1);
+}
+
+/*
+ * Move the last key & value pair from this page to the head of recipient page, its right sibling. The caller updates
+ * the separator key in the parent.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveLastToFrontOf(BPlusTreeLeafPage *recipient) {
+  std::move_backward(recipient->array_, recipient->array_ + recipient->GetSize(),
+                     recipient->array_ + recipient->GetSize() + 1);
+  recipient->array_[0] = array_[GetSize() - 1];
+  recipient->IncreaseSize(1);
+  IncreaseSize(-1);
 }
 
 template class BPlusTreeLeafPage<GenericKey<4>, RID, GenericComparator<4>>;
@@ -54,4 +252,10 @@ template class BPlusTreeLeafPage<GenericKey<8>, RID, GenericComparator<8>>;
 template class BPlusTreeLeafPage<GenericKey<16>, RID, GenericComparator<16>>;
 template class BPlusTreeLeafPage<GenericKey<32>, RID, GenericComparator<32>>;
 template class BPlusTreeLeafPage<GenericKey<64>, RID, GenericComparator<64>>;
+
+template class BPlusTreeLeafPage<GenericKey<4>, PostingList<RID>, GenericComparator<4>>;
+template class BPlusTreeLeafPage<GenericKey<8>, PostingList<RID>, GenericComparator<8>>;
+template class BPlusTreeLeafPage<GenericKey<16>, PostingList<RID>, GenericComparator<16>>;
+template class BPlusTreeLeafPage<GenericKey<32>, PostingList<RID>, GenericComparator<32>>;
+template class BPlusTreeLeafPage<GenericKey<64>, PostingList<RID>, GenericComparator<64>>;
 }  // namespace bustub
@@ -0,0 +1,175 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_posting_page.cpp
+//
+// Identification: src/storage/page/b_plus_tree_posting_page.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+
+#include "common/exception.h"
+#include "common/macros.h"
+#include "common/rid.h"
+#include "storage/page/b_plus_tree_posting_page.h"
+
+namespace bustub {
+
+template <typename ValueType>
+void BPlusTreePostingPage<ValueType>::Init(page_id_t next_page_id) {
+  next_page_id_ = next_page_id;
+  size_ = 0;
+}
+
+template <typename ValueType>
+auto PostingList<ValueType>::Of(const ValueType &value) -> PostingList {
+  PostingList list;
+  list.size_ = 1;
+  list.overflow_page_id_ = INVALID_PAGE_ID;
+  list.values_[0] = value;
+  return list;
+}
+
+/*
+ * Values go inline until the entry is full, then to the first overflow page, which is replaced with a new first page
+ * once it is full.
+ */
+template <typename ValueType>
+void PostingList<ValueType>::Add(const ValueType &value, BufferPoolManager *buffer_pool_manager) {
+  if (size_ < POSTING_LIST_INLINE_SIZE) {
+    values_[size_++] = value;
+    return;
+  }
+  Page *page = nullptr;
+  if (overflow_page_id_ != INVALID_PAGE_ID) {
+    page = FetchPage(overflow_page_id_, buffer_pool_manager);
+    if (reinterpret_cast<PostingPage *>(page->GetData())->IsFull()) {
+      buffer_pool_manager->UnpinPage(overflow_page_id_, false);
+      page = nullptr;
+    }
+  }
+  if (page == nullptr) {
+    page_id_t page_id;
+    page = buffer_pool_manager->NewPage(&page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate a posting list page");
+    }
+    reinterpret_cast<PostingPage *>(page->GetData())->Init(overflow_page_id_);
+    overflow_page_id_ = page_id;
+  }
+  reinterpret_cast<PostingPage *>(page->GetData())->Append(value);
+  buffer_pool_manager->UnpinPage(overflow_page_id_, true);
+  size_++;
+}
+
+/*
+ * The hole left by value is filled with the last value of the list: the last inline value if the list has no overflow
+ * page, or the last value of the first overflow page, which is deleted once it is empty.
+ */
+template <typename ValueType>
+auto PostingList<ValueType>::Remove(const ValueType &value, BufferPoolManager *buffer_pool_manager) -> bool {
+  BUSTUB_ASSERT(size_ > 1, "the last value of a posting list goes with its entry");
+  // find value, inline or in an overflow page, which is then kept pinned
+  int inline_size = std::min(size_, POSTING_LIST_INLINE_SIZE);
+  int index = static_cast<int>(std::find(values_, values_ + inline_size, value) - values_);
+  Page *page = nullptr;
+  if (index == inline_size) {
+    index = -1;
+    page_id_t page_id = overflow_page_id_;
+    while (index < 0 && page_id != INVALID_PAGE_ID) {
+      page = FetchPage(page_id, buffer_pool_manager);
+      auto *posting_page = reinterpret_cast<PostingPage *>(page->GetData());
+      for (int i = 0; i < posting_page->GetSize() && index < 0; i++) {
+        if (posting_page->ValueAt(i) == value) {
+          index = i;
+        }
+      }
+      if (index < 0) {
+        page_id_t next_page_id = posting_page->GetNextPageId();
+        buffer_pool_manager->UnpinPage(page_id, false);
+        page = nullptr;
+        page_id = next_page_id;
+      }
+    }
+    if (index < 0) {
+      return false;
+    }
+  }
+
+  if (overflow_page_id_ == INVALID_PAGE_ID) {
+    values_[index] = values_[size_ - 1];
+    size_--;
+    return true;
+  }
+  Page *first_page = page != nullptr && page->GetPageId() == overflow_page_id_
+                         ? page
+                         : FetchPage(overflow_page_id_, buffer_pool_manager);
+  auto *first = reinterpret_cast<PostingPage *>(first_page->GetData());
+  const ValueType last = first->ValueAt(first->GetSize() - 1);
+  if (page == nullptr) {
+    values_[index] = last;
+  } else {
+    reinterpret_cast<PostingPage *>(page->GetData())->SetValueAt(index, last);
+  }
+  first->RemoveLast();
+  page_id_t first_page_id = overflow_page_id_;
+  bool empty = first->GetSize() == 0;
+  if (empty) {
+    overflow_page_id_ = first->GetNextPageId();
+  }
+  if (page != nullptr && page != first_page) {
+    buffer_pool_manager->UnpinPage(page->GetPageId(), true);
+  }
+  buffer_pool_manager->UnpinPage(first_page_id, true);
+  if (empty) {
+    buffer_pool_manager->DeletePage(first_page_id);
+  }
+  size_--;
+  return true;
+}
+
+template <typename ValueType>
+void PostingList<ValueType>::GetValues(std::vector<ValueType> *result, BufferPoolManager *buffer_pool_manager) const {
+  result->insert(result->end(), values_, values_ + std::min(size_, POSTING_LIST_INLINE_SIZE));
+  page_id_t page_id = overflow_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    Page *page = FetchPage(page_id, buffer_pool_manager);
+    auto *posting_page = reinterpret_cast<PostingPage *>(page->GetData());
+    for (int i = 0; i < posting_page->GetSize(); i++) {
+      result->push_back(posting_page->ValueAt(i));
+    }
+    page_id_t next_page_id = posting_page->GetNextPageId();
+    buffer_pool_manager->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+template <typename ValueType>
+void PostingList<ValueType>::Free(BufferPoolManager *buffer_pool_manager) {
+  while (overflow_page_id_ != INVALID_PAGE_ID) {
+    Page *page = FetchPage(overflow_page_id_, buffer_pool_manager);
+    page_id_t next_page_id = reinterpret_cast<PostingPage *>(page->GetData())->GetNextPageId();
+    buffer_pool_manager->UnpinPage(overflow_page_id_, false);
+    buffer_pool_manager->DeletePage(overflow_page_id_);
+    overflow_page_id_ = next_page_id;
+  }
+  size_ = std::min(size_, POSTING_LIST_INLINE_SIZE);
+}
+
+template <typename ValueType>
+auto PostingList<ValueType>::FetchPage(page_id_t page_id, BufferPoolManager *buffer_pool_manager) -> Page * {
+  Page *page = buffer_pool_manager->FetchPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch a posting list page");
+  }
+  return page;
+}
+
+template class BPlusTreePostingPage<RID>;
+template class PostingList<RID>;
+
+}  // namespace bustub
@@ -13,22 +13,51 @@
 #include "storage/page/hash_table_header_page.h"
 
 namespace bustub {
-auto HashTableHeaderPage::GetBlockPageId(size_t index) -> page_id_t { return 0; }
+auto HashTableHeaderPage::GetBlockPageId(size_t index) -> page_id_t {
+  assert(index < next_ind_);
+  return block_page_ids_[index];
+}
 
-auto HashTableHeaderPage::GetPageId() const -> page_id_t { return 0; }
+auto HashTableHeaderPage::GetPageId() const -> page_id_t { return page_id_; }
 
-void HashTableHeaderPage::SetPageId(bustub::page_id_t page_id) {}
+void HashTableHeaderPage::SetPageId(bustub::page_id_t page_id) { page_id_ = page_id; }
 
-auto HashTableHeaderPage::GetLSN() const -> lsn_t { return 0; }
+auto HashTableHeaderPage::GetLSN() const -> lsn_t { return lsn_; }
 
-void HashTableHeaderPage::SetLSN(lsn_t lsn) {}
+void HashTableHeaderPage::SetLSN(lsn_t lsn) { lsn_ = lsn; }
 
-void HashTableHeaderPage::AddBlockPageId(page_id_t page_id) {}
+void HashTableHeaderPage::AddBlockPageId(page_id_t page_id) {
+  assert(next_ind_ < HEADER_ARRAY_SIZE);
+  block_page_ids_[next_ind_++] = page_id;
+}
 
-auto HashTableHeaderPage::NumBlocks() -> size_t { return 0; }
+auto HashTableHeaderPage::NumBlocks() -> size_t { return next_ind_; }
 
-void HashTableHeaderPage::SetSize(size_t size) {}
+void HashTableHeaderPage::SetSize(size_t size) { size_ = size; }
 
-auto HashTableHeaderPage::GetSize() const -> size_t { return 0; }
+auto HashTableHeaderPage::GetSize() const -> size_t { return size_; }
+
+auto HashTableHeaderPage::GetResizePageId() const -> page_id_t { return resize_page_id_; }
+
+void HashTableHeaderPage::SetResizePageId(page_id_t page_id) { resize_page_id_ = page_id; }
+
+auto HashTableHeaderPage::GetMigrated() const -> size_t { return migrated_; }
+
+void HashTableHeaderPage::SetMigrated(size_t migrated) { migrated_ = migrated; }
+
+auto HashTableHeaderPage::GetNumReadable() const -> size_t { return __atomic_load_n(&num_readable_, __ATOMIC_RELAXED); }
+
+void HashTableHeaderPage::AddNumReadable(int64_t delta) {
+  __atomic_fetch_add(&num_readable_, static_cast<size_t>(delta), __ATOMIC_RELAXED);
+}
+
+auto HashTableHeaderPage::GetNumOccupied() const -> size_t { return __atomic_load_n(&num_occupied_, __ATOMIC_RELAXED); }
+
+auto HashTableHeaderPage::AddNumOccupied(int64_t delta) -> size_t {
+  return __atomic_fetch_add(&num_occupied_, static_cast<size_t>(delta), __ATOMIC_RELAXED);
+}
+
+static_assert(sizeof(HashTableHeaderPage) == 64 + sizeof(page_id_t) + 4,
+              "the fields of the header page should take 64 bytes, as HEADER_ARRAY_SIZE assumes");
 
 }  // namespace bustub
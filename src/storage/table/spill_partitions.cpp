@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// spill_partitions.cpp
+//
+// Identification: src/storage/table/spill_partitions.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/spill_partitions.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace bustub {
+
+SpillPartitions::SpillPartitions(BufferPoolManager *bpm, size_t num_files)
+    : bpm_(bpm),
+      num_files_(num_files),
+      fanout_(bpm == nullptr ? 0 : std::clamp<size_t>(bpm->GetPoolSize() / 4, 2, MAX_FANOUT)) {}
+
+auto SpillPartitions::MakePartitions(size_t depth) const -> std::vector<Partition> {
+  std::vector<Partition> parts(fanout_);
+  for (auto &part : parts) {
+    for (size_t i = 0; i < num_files_; i++) {
+      part.files_.emplace_back(std::make_unique<TmpTupleFile>(bpm_));
+    }
+    part.depth_ = depth;
+  }
+  return parts;
+}
+
+auto SpillPartitions::PartitionOf(hash_t hash, size_t depth) const -> size_t {
+  // The seed keeps the partitions of every depth, and the slots of a hash table, independent of each other.
+  hash_t seed = (depth + 1) * 0x9e3779b97f4a7c15ULL;
+  return HashUtil::MixHash(hash + seed) % fanout_;
+}
+
+void SpillPartitions::AddPending(std::vector<Partition> *parts, const std::function<bool(const Partition &)> &keep) {
+  for (auto &part : *parts) {
+    for (auto &file : part.files_) {
+      file->FinishAppending();
+    }
+    if (keep(part)) {
+      pending_.push_back(std::move(part));
+    }
+  }
+}
+
+auto SpillPartitions::PopPending(Partition *part) -> bool {
+  if (pending_.empty()) {
+    return false;
+  }
+  *part = std::move(pending_.back());
+  pending_.pop_back();
+  return true;
+}
+
+}  // namespace bustub
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cassert>
 
 #include "common/logger.h"
@@ -23,7 +24,9 @@ TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_m
     : buffer_pool_manager_(buffer_pool_manager),
       lock_manager_(lock_manager),
       log_manager_(log_manager),
-      first_page_id_(first_page_id) {}
+      first_page_id_(first_page_id),
+      page_ids_{first_page_id},
+      page_positions_{{first_page_id, 0}} {}
 
 TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager, LogManager *log_manager,
                      Transaction *txn)
@@ -34,15 +37,17 @@ TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_m
                 "Couldn't create a page for the table heap. Have you completed the buffer pool manager project?");
   first_page->Init(first_page_id_, BUSTUB_PAGE_SIZE, INVALID_LSN, log_manager_, txn);
   buffer_pool_manager_->UnpinPage(first_page_id_, true);
+  page_ids_.push_back(first_page_id_);
+  page_positions_[first_page_id_] = 0;
 }
 
-auto TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> bool {
+auto TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn, BufferRing *ring) -> bool {
   if (tuple.size_ + 32 > BUSTUB_PAGE_SIZE) {  // larger than one page size
     txn->SetState(TransactionState::ABORTED);
     return false;
   }
 
-  auto cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(first_page_id_));
+  auto cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPageWithRing(first_page_id_, ring));
   if (cur_page == nullptr) {
     txn->SetState(TransactionState::ABORTED);
     return false;
@@ -56,7 +61,7 @@ auto TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> b
     auto next_page_id = cur_page->GetNextPageId();
     // If the next page is a valid page,
     if (next_page_id != INVALID_PAGE_ID) {
-      auto next_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
+      auto next_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPageWithRing(next_page_id, ring));
       next_page->WLatch();
       // Unlatch and unpin the current page.
       cur_page->WUnlatch();
@@ -64,7 +69,7 @@ auto TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> b
       cur_page = next_page;
     } else {
       // Otherwise we have run out of valid pages. We need to create a new page.
-      auto new_page = static_cast<TablePage *>(buffer_pool_manager_->NewPage(&next_page_id));
+      auto new_page = static_cast<TablePage *>(buffer_pool_manager_->NewPageWithRing(&next_page_id, ring));
       // If we could not create a new page,
       if (new_page == nullptr) {
         // Then life sucks and we abort the transaction.
@@ -77,6 +82,7 @@ auto TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> b
       new_page->WLatch();
       cur_page->SetNextPageId(next_page_id);
       new_page->Init(next_page_id, BUSTUB_PAGE_SIZE, cur_page->GetTablePageId(), log_manager_, txn);
+      AppendPageId(cur_page->GetTablePageId(), next_page_id);
       cur_page->WUnlatch();
       buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), true);
       cur_page = new_page;
@@ -156,9 +162,10 @@ void TableHeap::RollbackDelete(const RID &rid, Transaction *txn) {
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
 }
 
-auto TableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, bool acquire_read_lock) -> bool {
+auto TableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, bool acquire_read_lock, BufferRing *ring)
+    -> bool {
   // Find the page which contains the tuple.
-  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPageWithRing(rid.GetPageId(), ring));
   // If the page could not be found, then abort the transaction.
   if (page == nullptr) {
     txn->SetState(TransactionState::ABORTED);
@@ -176,26 +183,47 @@ auto TableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, bool ac
   return res;
 }
 
-auto TableHeap::Begin(Transaction *txn) -> TableIterator {
+auto TableHeap::Begin(Transaction *txn, BufferRing *ring) -> TableIterator {
   // Start an iterator from the first page.
   // TODO(Wuwen): Hacky fix for now. Removing empty pages is a better way to handle this.
   RID rid;
   auto page_id = first_page_id_;
   while (page_id != INVALID_PAGE_ID) {
-    auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPageWithRing(page_id, ring));
     page->RLatch();
     // If this fails because there is no tuple, then RID will be the default-constructed value, which means EOF.
     auto found_tuple = page->GetFirstTupleRid(&rid);
+    // The frame may be reused as soon as the page is unpinned, read the link to the next page before that.
+    auto next_page_id = page->GetNextPageId();
     page->RUnlatch();
     buffer_pool_manager_->UnpinPage(page_id, false);
     if (found_tuple) {
       break;
     }
-    page_id = page->GetNextPageId();
+    page_id = next_page_id;
   }
-  return {this, rid, txn};
+  return {this, rid, txn, ring};
 }
 
 auto TableHeap::End() -> TableIterator { return {this, RID(INVALID_PAGE_ID, 0), nullptr}; }
 
+void TableHeap::AppendPageId(page_id_t prev_page_id, page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(page_ids_latch_);
+  if (page_ids_.back() != prev_page_id || page_positions_.count(page_id) > 0) {
+    return;
+  }
+  page_positions_[page_id] = page_ids_.size();
+  page_ids_.push_back(page_id);
+}
+
+auto TableHeap::GetNextPageIds(page_id_t page_id, size_t count) -> std::vector<page_id_t> {
+  std::scoped_lock<std::mutex> lock(page_ids_latch_);
+  auto position = page_positions_.find(page_id);
+  if (position == page_positions_.end()) {
+    return {};
+  }
+  auto begin = page_ids_.begin() + position->second + 1;
+  return {begin, begin + std::min<size_t>(count, page_ids_.end() - begin)};
+}
+
 }  // namespace bustub
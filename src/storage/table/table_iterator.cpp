@@ -10,7 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 #include "common/exception.h"
 #include "concurrency/transaction.h"
@@ -18,10 +20,10 @@
 
 namespace bustub {
 
-TableIterator::TableIterator(TableHeap *table_heap, RID rid, Transaction *txn)
-    : table_heap_(table_heap), tuple_(new Tuple(rid)), txn_(txn) {
+TableIterator::TableIterator(TableHeap *table_heap, RID rid, Transaction *txn, BufferRing *ring)
+    : table_heap_(table_heap), tuple_(new Tuple(rid)), txn_(txn), ring_(ring) {
   if (rid.GetPageId() != INVALID_PAGE_ID) {
-    if (!table_heap_->GetTuple(tuple_->rid_, tuple_, txn_)) {
+    if (!table_heap_->GetTuple(tuple_->rid_, tuple_, txn_, true, ring_)) {
       throw bustub::Exception("read non-existing tuple");
     }
   }
@@ -39,7 +41,7 @@ auto TableIterator::operator->() -> Tuple * {
 
 auto TableIterator::operator++() -> TableIterator & {
   BufferPoolManager *buffer_pool_manager = table_heap_->buffer_pool_manager_;
-  auto cur_page = static_cast<TablePage *>(buffer_pool_manager->FetchPage(tuple_->rid_.GetPageId()));
+  auto cur_page = static_cast<TablePage *>(buffer_pool_manager->FetchPageWithRing(tuple_->rid_.GetPageId(), ring_));
   BUSTUB_ENSURE(cur_page != nullptr, "BPM full");  // all pages are pinned
 
   cur_page->RLatch();
@@ -47,7 +49,10 @@ auto TableIterator::operator++() -> TableIterator & {
   if (!cur_page->GetNextTupleRid(tuple_->rid_,
                                  &next_tuple_rid)) {  // end of this page
     while (cur_page->GetNextPageId() != INVALID_PAGE_ID) {
-      auto next_page = static_cast<TablePage *>(buffer_pool_manager->FetchPage(cur_page->GetNextPageId()));
+      table_heap_->AppendPageId(cur_page->GetTablePageId(), cur_page->GetNextPageId());
+      ReadAhead(cur_page->GetNextPageId());
+      auto next_page =
+          static_cast<TablePage *>(buffer_pool_manager->FetchPageWithRing(cur_page->GetNextPageId(), ring_));
       cur_page->RUnlatch();
       buffer_pool_manager->UnpinPage(cur_page->GetTablePageId(), false);
       cur_page = next_page;
@@ -62,7 +67,7 @@ auto TableIterator::operator++() -> TableIterator & {
   if (*this != table_heap_->End()) {
     // DO NOT ACQUIRE READ LOCK twice in a single thread otherwise it may deadlock.
     // See https://users.rust-lang.org/t/how-bad-is-the-potential-deadlock-mentioned-in-rwlocks-document/67234
-    if (!table_heap_->GetTuple(tuple_->rid_, tuple_, txn_, false)) {
+    if (!table_heap_->GetTuple(tuple_->rid_, tuple_, txn_, false, ring_)) {
       cur_page->RUnlatch();
       buffer_pool_manager->UnpinPage(cur_page->GetTablePageId(), false);
       throw bustub::Exception("read non-existing tuple");
@@ -74,6 +79,38 @@ auto TableIterator::operator++() -> TableIterator & {
   return *this;
 }
 
+void TableIterator::ReadAhead(page_id_t next_page_id) {
+  if (ring_ != nullptr) {
+    return;
+  }
+  if (read_ahead_pending_ > 0) {
+    read_ahead_pending_--;
+  }
+  // refill once less than half of the window is still ahead of the scan
+  if (read_ahead_pending_ > read_ahead_window_ / 2) {
+    return;
+  }
+  BufferPoolManager *buffer_pool_manager = table_heap_->buffer_pool_manager_;
+  size_t max_window = std::min<size_t>(READ_AHEAD_MAX_PAGES, buffer_pool_manager->GetPoolSize() / 4);
+  read_ahead_window_ = std::min(std::max<size_t>(read_ahead_window_ * 2, READ_AHEAD_MIN_PAGES), max_window);
+  if (read_ahead_pending_ >= read_ahead_window_) {
+    return;
+  }
+  // only pages of the heap are read ahead, in the order of its page chain; runs of consecutive ids are one prefetch
+  std::vector<page_id_t> page_ids = table_heap_->GetNextPageIds(
+      read_ahead_pending_ > 0 ? read_ahead_end_ : next_page_id, read_ahead_window_ - read_ahead_pending_);
+  for (size_t begin = 0, end = 1; begin < page_ids.size(); begin = end++) {
+    while (end < page_ids.size() && page_ids[end] == page_ids[end - 1] + 1) {
+      end++;
+    }
+    buffer_pool_manager->PrefetchPages(page_ids[begin], end - begin);
+  }
+  if (!page_ids.empty()) {
+    read_ahead_pending_ += page_ids.size();
+    read_ahead_end_ = page_ids.back();
+  }
+}
+
 auto TableIterator::operator++(int) -> TableIterator {
   TableIterator clone(*this);
   ++(*this);
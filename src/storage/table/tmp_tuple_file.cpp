@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.cpp
+//
+// Identification: src/storage/table/tmp_tuple_file.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/tmp_tuple_file.h"
+
+#include "common/exception.h"
+
+namespace bustub {
+
+TmpTupleFile::~TmpTupleFile() {
+  FinishAppending();
+  for (page_id_t page_id : page_ids_) {
+    bpm_->DeletePage(page_id);
+  }
+}
+
+void TmpTupleFile::Append(const Tuple &tuple) {
+  TmpTuple out;
+  if (append_page_ != nullptr && append_page_->Insert(tuple, &out)) {
+    size_++;
+    return;
+  }
+  FinishAppending();
+  page_id_t page_id;
+  auto *page = static_cast<TmpTuplePage *>(bpm_->NewPage(&page_id));
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "no frame in the buffer pool to spill tuples to");
+  }
+  page->Init(page_id, BUSTUB_PAGE_SIZE);
+  page_ids_.push_back(page_id);
+  append_page_ = page;
+  if (!append_page_->Insert(tuple, &out)) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "tuple too large to spill");
+  }
+  size_++;
+}
+
+void TmpTupleFile::FinishAppending() {
+  if (append_page_ != nullptr) {
+    bpm_->UnpinPage(append_page_->GetTablePageId(), true);
+    append_page_ = nullptr;
+  }
+}
+
+TmpTupleFile::Reader::~Reader() {
+  if (page_ != nullptr) {
+    file_->bpm_->UnpinPage(page_->GetTablePageId(), false);
+  }
+}
+
+auto TmpTupleFile::Reader::Next(Tuple *tuple) -> bool {
+  while (offsets_.empty()) {
+    if (page_ != nullptr) {
+      file_->bpm_->UnpinPage(page_->GetTablePageId(), false);
+      page_ = nullptr;
+    }
+    if (next_page_ == file_->page_ids_.size()) {
+      return false;
+    }
+    page_ = static_cast<TmpTuplePage *>(file_->bpm_->FetchPage(file_->page_ids_[next_page_++]));
+    if (page_ == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "no frame in the buffer pool to read spilled tuples into");
+    }
+    // A page holds its tuples from the end backward, so the one appended first is found last.
+    for (uint32_t offset = page_->GetFreeSpacePointer(); offset < BUSTUB_PAGE_SIZE;
+         offset += sizeof(uint32_t) + *reinterpret_cast<uint32_t *>(page_->GetData() + offset)) {
+      offsets_.push_back(offset);
+    }
+  }
+  page_->Get(TmpTuple(page_->GetTablePageId(), offsets_.back()), tuple);
+  offsets_.pop_back();
+  return true;
+}
+
+}  // namespace bustub
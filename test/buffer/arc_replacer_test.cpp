@@ -0,0 +1,63 @@
+/**
+ * arc_replacer_test.cpp
+ */
+
+#include "buffer/arc_replacer.h"
+
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+TEST(ARCReplacerTest, SampleTest) {
+  ARCReplacer replacer(4);
+  frame_id_t value;
+
+  // Scenario: load pages 1..4 into frames 0..3, then access frames 0 and 1 again. T1 = {2, 3}, T2 = {0, 1}.
+  for (frame_id_t fid = 0; fid < 4; fid++) {
+    replacer.RecordAccess(fid, fid + 1);
+    replacer.SetEvictable(fid, true);
+  }
+  replacer.RecordAccess(0, 1);
+  replacer.RecordAccess(1, 2);
+  ASSERT_EQ(4, replacer.Size());
+  ASSERT_EQ(0, replacer.GetTargetT1Size());
+
+  // Scenario: T1 is above its target, its least recently used page goes to B1.
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(2, value);
+
+  // Scenario: page 3 comes back from B1, so T1 should have been larger. It enters T2.
+  replacer.RecordAccess(2, 3);
+  replacer.SetEvictable(2, true);
+  ASSERT_EQ(1, replacer.GetTargetT1Size());
+
+  // Scenario: T1 = {3} is not above its target, the least recently used page of T2 goes to B2.
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(0, value);
+
+  // Scenario: page 1 comes back from B2, so T2 should have been larger.
+  replacer.RecordAccess(0, 1);
+  replacer.SetEvictable(0, true);
+  ASSERT_EQ(0, replacer.GetTargetT1Size());
+
+  // Scenario: a pinned T1 page yields to T2.
+  replacer.SetEvictable(3, false);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(1, value);
+  replacer.SetEvictable(3, true);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(3, value);
+
+  // Scenario: removed pages are not remembered, page 3 enters T1 again and goes before T2 = {0}.
+  replacer.Remove(2);
+  ASSERT_EQ(1, replacer.Size());
+  replacer.RecordAccess(2, 3);
+  replacer.SetEvictable(2, true);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(2, value);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(0, value);
+  ASSERT_FALSE(replacer.Evict(&value));
+}
+
+}  // namespace bustub
@@ -12,18 +12,24 @@
 
 #include "buffer/buffer_pool_manager_instance.h"
 
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
 #include <cstdio>
+#include <future>  // NOLINT
 #include <random>
 #include <string>
+#include <thread>  // NOLINT
 
 #include "buffer/buffer_pool_manager.h"
 #include "gtest/gtest.h"
+#include "recovery/log_manager.h"
+#include "storage/disk/disk_manager_memory.h"
 
 namespace bustub {
 
 // NOLINTNEXTLINE
 // Check whether pages containing terminal characters can be recovered
-TEST(BufferPoolManagerInstanceTest, DISABLED_BinaryDataTest) {
+TEST(BufferPoolManagerInstanceTest, BinaryDataTest) {
   const std::string db_name = "test.db";
   const size_t buffer_pool_size = 10;
   const size_t k = 5;
@@ -89,7 +95,7 @@ TEST(BufferPoolManagerInstanceTest, DISABLED_BinaryDataTest) {
 }
 
 // NOLINTNEXTLINE
-TEST(BufferPoolManagerInstanceTest, DISABLED_SampleTest) {
+TEST(BufferPoolManagerInstanceTest, SampleTest) {
   const std::string db_name = "test.db";
   const size_t buffer_pool_size = 10;
   const size_t k = 5;
@@ -145,4 +151,397 @@ TEST(BufferPoolManagerInstanceTest, DISABLED_SampleTest) {
   delete disk_manager;
 }
 
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerInstanceTest, PageCleanerTest) {
+  const size_t buffer_pool_size = 10;
+  const size_t k = 2;
+
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *log_manager = new LogManager(disk_manager);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, k, log_manager);
+
+  page_id_t page_id;
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    auto *page = bpm->NewPage(&page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), BUSTUB_PAGE_SIZE, "page %d", page_id);
+    // pinned pages are never cleaned
+    if (i > 0) {
+      EXPECT_TRUE(bpm->UnpinPage(page_id, true));
+    }
+  }
+
+  // Scenario: each round writes back at most the requested number of dirty, unpinned pages.
+  EXPECT_EQ(4, bpm->CleanDirtyPages(4));
+  EXPECT_EQ(4, bpm->CleanDirtyPages(4));
+  EXPECT_EQ(1, bpm->CleanDirtyPages(4));
+  EXPECT_EQ(0, bpm->CleanDirtyPages(4));
+  EXPECT_EQ(9, bpm->GetNumPagesCleaned());
+
+  // Scenario: evicting the cleaned pages does not write them in the foreground.
+  EXPECT_TRUE(bpm->UnpinPage(0, true));
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(&page_id));
+    EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+  }
+  EXPECT_EQ(9, bpm->GetNumDirtyEvictionsAvoided());
+  EXPECT_EQ(1, bpm->GetNumDirtyEvictions());
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+    auto *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(0, strcmp(page->GetData(), ("page " + std::to_string(i)).c_str()));
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+
+  // Scenario: with logging enabled, a page is not written before the log records up to its LSN are persistent.
+  enable_logging = true;
+  auto *page = bpm->FetchPage(0);
+  ASSERT_NE(nullptr, page);
+  page->SetLSN(5);
+  EXPECT_TRUE(bpm->UnpinPage(0, true));
+  EXPECT_EQ(0, bpm->CleanDirtyPages(buffer_pool_size));
+  log_manager->SetPersistentLSN(5);
+  EXPECT_EQ(1, bpm->CleanDirtyPages(buffer_pool_size));
+  enable_logging = false;
+
+  // Scenario: the background cleaner writes dirty pages back on its own.
+  page = bpm->FetchPage(1);
+  ASSERT_NE(nullptr, page);
+  EXPECT_TRUE(bpm->UnpinPage(1, true));
+  bpm->StartPageCleaner(page_cleaner_interval, PAGE_CLEANER_BATCH_SIZE);
+  for (int i = 0; i < 500 && page->IsDirty(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  bpm->StopPageCleaner();
+  EXPECT_FALSE(page->IsDirty());
+
+  delete bpm;
+  delete log_manager;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerInstanceTest, PrefetchPagesTest) {
+  const size_t buffer_pool_size = 10;
+  const size_t k = 2;
+
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, k);
+
+  page_id_t page_id;
+  for (size_t i = 0; i < 2 * buffer_pool_size; ++i) {
+    auto *page = bpm->NewPage(&page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), BUSTUB_PAGE_SIZE, "page %d", page_id);
+    EXPECT_TRUE(bpm->UnpinPage(page_id, true));
+  }
+
+  // Scenario: pages 0-9 were evicted, pages 10-19 are buffered. Reading ahead 5-9 evicts 10-14, after which 15-19
+  // are still buffered and are skipped, as are page ids that were never allocated.
+  bpm->PrefetchPages(5, 5);
+  EXPECT_EQ(5, bpm->GetNumPagesPrefetched());
+  bpm->PrefetchPages(15, 5);
+  bpm->PrefetchPages(100, 10);
+  EXPECT_EQ(5, bpm->GetNumPagesPrefetched());
+
+  for (page_id_t i = 5; i < 10; ++i) {
+    auto *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(0, strcmp(page->GetData(), ("page " + std::to_string(i)).c_str()));
+  }
+  EXPECT_EQ(5, bpm->GetNumPrefetchHits());
+
+  // Scenario: read-ahead never evicts pinned pages.
+  for (page_id_t i = 0; i < 5; ++i) {
+    ASSERT_NE(nullptr, bpm->FetchPage(i));
+  }
+  bpm->PrefetchPages(10, 10);
+  EXPECT_EQ(5, bpm->GetNumPagesPrefetched());
+  for (page_id_t i = 0; i < 10; ++i) {
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerInstanceTest, BufferRingTest) {
+  const size_t buffer_pool_size = 10;
+  const size_t k = 2;
+  const page_id_t num_hot_pages = 4;
+  const page_id_t num_pages = 30;
+
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, k);
+
+  page_id_t page_id;
+  for (page_id_t i = 0; i < num_pages; ++i) {
+    auto *page = bpm->NewPage(&page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), BUSTUB_PAGE_SIZE, "page %d", page_id);
+    EXPECT_TRUE(bpm->UnpinPage(page_id, true));
+  }
+  auto count_frames = [&](page_id_t begin, page_id_t end) {
+    size_t count = 0;
+    for (size_t i = 0; i < buffer_pool_size; ++i) {
+      page_id_t frame_page_id = bpm->GetPages()[i].GetPageId();
+      count += static_cast<size_t>(frame_page_id >= begin && frame_page_id < end);
+    }
+    return count;
+  };
+
+  // Scenario: a scan through a ring only takes as many frames as the ring has, the rest of the buffer pool is kept.
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+    ASSERT_NE(nullptr, bpm->FetchPage(i));
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+  BufferRing ring(2);
+  for (page_id_t i = buffer_pool_size; i < num_pages; ++i) {
+    auto *page = bpm->FetchPageWithRing(i, &ring);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(0, strcmp(page->GetData(), ("page " + std::to_string(i)).c_str()));
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+  EXPECT_EQ(2, ring.GetNumPages());
+  EXPECT_EQ(buffer_pool_size - 2, count_frames(0, buffer_pool_size));
+
+  // Scenario: pages reached through a ring are not promoted. Page 6 is the least recently used page with a single
+  // access, no matter how often it is fetched through the ring.
+  for (page_id_t i = 0; i < num_hot_pages; ++i) {
+    ASSERT_NE(nullptr, bpm->FetchPage(i));
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+  for (int round = 0; round < 3; ++round) {
+    ASSERT_NE(nullptr, bpm->FetchPageWithRing(6, &ring));
+    EXPECT_TRUE(bpm->UnpinPage(6, false));
+  }
+  EXPECT_EQ(1, count_frames(6, 7));
+  ASSERT_NE(nullptr, bpm->NewPage(&page_id));
+  EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+  EXPECT_EQ(0, count_frames(6, 7));
+  EXPECT_EQ(num_hot_pages, count_frames(0, num_hot_pages));
+
+  // Scenario: a page that is pinned outside of the ring is not recycled by it.
+  BufferRing small_ring(1);
+  auto *pinned = bpm->FetchPageWithRing(20, &small_ring);
+  ASSERT_NE(nullptr, pinned);
+  ASSERT_NE(nullptr, bpm->FetchPageWithRing(21, &small_ring));
+  EXPECT_EQ(20, pinned->GetPageId());
+  EXPECT_TRUE(bpm->UnpinPage(20, false));
+  EXPECT_TRUE(bpm->UnpinPage(21, false));
+
+  delete bpm;
+  delete disk_manager;
+}
+
+TEST(BufferPoolManagerInstanceTest, ReplacerPolicyTest) {
+  const size_t buffer_pool_size = 8;
+  const page_id_t num_pages = 40;
+
+  for (auto policy : {ReplacerPolicy::LRUK, ReplacerPolicy::LRU, ReplacerPolicy::Clock, ReplacerPolicy::TwoQueue,
+                      ReplacerPolicy::ARC, ReplacerPolicy::ClockPro}) {
+    auto *disk_manager = new DiskManagerUnlimitedMemory();
+    auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, 2, nullptr, policy);
+    PageAccessTrace trace;
+    bpm->SetPageAccessTrace(&trace);
+
+    // Scenario: create more pages than there are frames, then read them back in a skewed order.
+    page_id_t page_id;
+    for (page_id_t i = 0; i < num_pages; ++i) {
+      auto *page = bpm->NewPage(&page_id);
+      ASSERT_NE(nullptr, page) << ReplacerPolicyToString(policy);
+      snprintf(page->GetData(), BUSTUB_PAGE_SIZE, "page %d", page_id);
+      EXPECT_TRUE(bpm->UnpinPage(page_id, true));
+    }
+    std::mt19937 gen(15445);
+    std::uniform_int_distribution<page_id_t> hot(0, 3);
+    std::uniform_int_distribution<page_id_t> any(0, num_pages - 1);
+    for (int i = 0; i < 200; ++i) {
+      page_id = i % 2 == 0 ? hot(gen) : any(gen);
+      auto *page = bpm->FetchPage(page_id);
+      ASSERT_NE(nullptr, page) << ReplacerPolicyToString(policy);
+      EXPECT_EQ(0, strcmp(page->GetData(), ("page " + std::to_string(page_id)).c_str()));
+      EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+    }
+
+    // Scenario: with every frame pinned, no page can be brought in.
+    for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+      ASSERT_NE(nullptr, bpm->FetchPage(i));
+    }
+    EXPECT_EQ(nullptr, bpm->FetchPage(buffer_pool_size));
+    for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+      EXPECT_TRUE(bpm->UnpinPage(i, false));
+    }
+
+    // Scenario: every NewPage and FetchPage call was traced, up to the point recording stopped.
+    bpm->SetPageAccessTrace(nullptr);
+    ASSERT_NE(nullptr, bpm->FetchPage(0));
+    EXPECT_TRUE(bpm->UnpinPage(0, false));
+    auto page_ids = trace.GetPageIds();
+    ASSERT_EQ(num_pages + 200 + buffer_pool_size + 1, page_ids.size());
+    EXPECT_EQ(num_pages - 1, page_ids[num_pages - 1]);
+    EXPECT_EQ(static_cast<page_id_t>(buffer_pool_size), page_ids.back());
+
+    delete bpm;
+    delete disk_manager;
+  }
+}
+
+TEST(BufferPoolManagerInstanceTest, LockFreeFetchTest) {
+  const size_t buffer_pool_size = 16;
+  const page_id_t num_hot_pages = 8;
+  const int num_readers = 4;
+  const int num_rounds = 2000;
+
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, 2);
+
+  page_id_t page_id;
+  for (page_id_t i = 0; i < num_hot_pages; ++i) {
+    auto *page = bpm->NewPage(&page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), BUSTUB_PAGE_SIZE, "page %d", page_id);
+    EXPECT_TRUE(bpm->UnpinPage(page_id, true));
+  }
+
+  // Scenario: fetches of resident pages do not take the latch once the page was fetched through it.
+  for (page_id_t i = 0; i < num_hot_pages; ++i) {
+    ASSERT_NE(nullptr, bpm->FetchPage(i));
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+  EXPECT_EQ(num_hot_pages, bpm->GetNumLockFreeHits());
+
+  // Scenario: readers keep fetching pages while a writer keeps creating pages, which evicts the pages the readers are
+  // not holding. A fetched page must always be the requested one.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_readers; ++t) {
+    threads.emplace_back([bpm, t] {
+      std::mt19937 gen(t);
+      std::uniform_int_distribution<page_id_t> dist(0, num_hot_pages - 1);
+      for (int i = 0; i < num_rounds; ++i) {
+        page_id_t fetch_id = dist(gen);
+        auto *page = bpm->FetchPage(fetch_id);
+        if (page == nullptr) {
+          continue;
+        }
+        page->RLatch();
+        EXPECT_EQ(fetch_id, page->GetPageId());
+        EXPECT_EQ(0, strcmp(page->GetData(), ("page " + std::to_string(fetch_id)).c_str()));
+        page->RUnlatch();
+        EXPECT_TRUE(bpm->UnpinPage(fetch_id, false));
+      }
+    });
+  }
+  threads.emplace_back([bpm] {
+    for (int i = 0; i < num_rounds / 4; ++i) {
+      page_id_t new_page_id;
+      auto *page = bpm->NewPage(&new_page_id);
+      if (page == nullptr) {
+        continue;
+      }
+      snprintf(page->GetData(), BUSTUB_PAGE_SIZE, "page %d", new_page_id);
+      EXPECT_TRUE(bpm->UnpinPage(new_page_id, true));
+    }
+  });
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_GT(bpm->GetNumLockFreeHits(), static_cast<size_t>(num_hot_pages));
+
+  // Scenario: pages pinned through the lock-free path are never evicted.
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+    ASSERT_NE(nullptr, bpm->FetchPage(i));
+  }
+  EXPECT_EQ(nullptr, bpm->NewPage(&page_id));
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+    EXPECT_EQ(i, bpm->GetPages()[bpm->FetchPage(i) - bpm->GetPages()].GetPageId());
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+
+  delete bpm;
+  delete disk_manager;
+}
+
+/** Blocks reads of one page until it is opened, to keep the read in flight. */
+class GatedDiskManager : public DiskManagerUnlimitedMemory {
+ public:
+  explicit GatedDiskManager(page_id_t gated_page_id) : gated_page_id_(gated_page_id) {}
+
+  void ReadPage(page_id_t page_id, char *page_data) override {
+    if (page_id == gated_page_id_) {
+      std::unique_lock<std::mutex> lock(gate_latch_);
+      num_waiting_++;
+      gate_cv_.notify_all();
+      gate_cv_.wait(lock, [this] { return open_; });
+    }
+    DiskManagerUnlimitedMemory::ReadPage(page_id, page_data);
+  }
+
+  void WaitForReader() {
+    std::unique_lock<std::mutex> lock(gate_latch_);
+    gate_cv_.wait(lock, [this] { return num_waiting_ > 0; });
+  }
+
+  void Open() {
+    std::scoped_lock<std::mutex> lock(gate_latch_);
+    open_ = true;
+    gate_cv_.notify_all();
+  }
+
+ private:
+  const page_id_t gated_page_id_;
+  std::mutex gate_latch_;
+  std::condition_variable gate_cv_;
+  int num_waiting_{0};
+  bool open_{false};
+};
+
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerInstanceTest, IoOutsideLatchTest) {
+  const size_t buffer_pool_size = 4;
+  const page_id_t num_pages = 6;
+
+  auto *disk_manager = new GatedDiskManager(0);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, 2);
+
+  page_id_t page_id;
+  for (page_id_t i = 0; i < num_pages; ++i) {
+    auto *page = bpm->NewPage(&page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), BUSTUB_PAGE_SIZE, "page %d", page_id);
+    EXPECT_TRUE(bpm->UnpinPage(page_id, true));
+  }
+
+  // Scenario: while a fetch waits for its read, other calls that need the latch go ahead.
+  std::vector<Page *> fetched(2, nullptr);
+  std::thread reader([bpm, &fetched] { fetched[0] = bpm->FetchPage(0); });
+  disk_manager->WaitForReader();
+  auto other_calls = std::async(std::launch::async, [bpm] {
+    EXPECT_FALSE(bpm->UnpinPage(num_pages - 1, false));
+    EXPECT_TRUE(bpm->DeletePage(num_pages - 1));
+  });
+  bool latch_free = other_calls.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+
+  // Scenario: a second fetch of the page waits for the read in flight rather than reading the page again.
+  std::thread second_reader([bpm, &fetched] { fetched[1] = bpm->FetchPage(0); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  disk_manager->Open();
+  reader.join();
+  second_reader.join();
+  other_calls.get();
+  EXPECT_TRUE(latch_free);
+
+  ASSERT_NE(nullptr, fetched[0]);
+  EXPECT_EQ(fetched[0], fetched[1]);
+  EXPECT_EQ(0, strcmp(fetched[0]->GetData(), "page 0"));
+  EXPECT_EQ(2, fetched[0]->GetPinCount());
+  EXPECT_TRUE(bpm->UnpinPage(0, false));
+  EXPECT_TRUE(bpm->UnpinPage(0, false));
+
+  delete bpm;
+  delete disk_manager;
+}
+
 }  // namespace bustub
@@ -0,0 +1,57 @@
+/**
+ * clock_pro_replacer_test.cpp
+ */
+
+#include "buffer/clock_pro_replacer.h"
+
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+TEST(ClockProReplacerTest, SampleTest) {
+  // 4 frames, at most 2 hot pages to begin with.
+  ClockProReplacer replacer(4);
+  frame_id_t value;
+
+  // Scenario: load pages 10..13 into frames 0..3. They are cold and in their test period.
+  for (frame_id_t fid = 0; fid < 4; fid++) {
+    replacer.RecordAccess(fid, 10 + fid);
+    replacer.SetEvictable(fid, true);
+  }
+  ASSERT_EQ(4, replacer.Size());
+  ASSERT_EQ(0, replacer.GetNumHotPages());
+
+  // Scenario: unreferenced cold pages are evicted in clock order and stay non-resident while in test.
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(0, value);
+  ASSERT_EQ(1, replacer.GetNumNonResidentPages());
+
+  // Scenario: page 10 is reloaded within its test period and becomes hot.
+  replacer.RecordAccess(0, 10);
+  replacer.SetEvictable(0, true);
+  ASSERT_EQ(1, replacer.GetNumHotPages());
+  ASSERT_EQ(0, replacer.GetNumNonResidentPages());
+
+  // Scenario: page 11 is referenced within its test period, HAND_cold promotes it instead of evicting it.
+  replacer.RecordAccess(1, 11);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(2, value);
+  ASSERT_LE(replacer.GetNumHotPages(), 2);
+
+  // Scenario: hot pages are never evicted directly, pinned pages are never evicted.
+  replacer.SetEvictable(3, false);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_NE(3, value);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_NE(3, value);
+  ASSERT_FALSE(replacer.Evict(&value));
+  ASSERT_EQ(0, replacer.Size());
+
+  // Scenario: removed pages leave no trace.
+  replacer.SetEvictable(3, true);
+  replacer.Remove(3);
+  ASSERT_EQ(0, replacer.Size());
+  ASSERT_FALSE(replacer.Evict(&value));
+}
+
+}  // namespace bustub
@@ -0,0 +1,86 @@
+/**
+ * lock_free_page_table_test.cpp
+ */
+
+#include "buffer/lock_free_page_table.h"
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+TEST(LockFreePageTableTest, SampleTest) {
+  LockFreePageTable table(16);
+  ASSERT_EQ(32, table.GetCapacity());
+
+  frame_id_t frame_id;
+  for (page_id_t page_id = 0; page_id < 16; page_id++) {
+    table.Insert(page_id, static_cast<frame_id_t>(15 - page_id));
+  }
+  ASSERT_EQ(16, table.Size());
+  for (page_id_t page_id = 0; page_id < 16; page_id++) {
+    ASSERT_TRUE(table.Find(page_id, frame_id));
+    ASSERT_EQ(15 - page_id, frame_id);
+  }
+  ASSERT_FALSE(table.Find(16, frame_id));
+
+  // Scenario: re-inserting a page updates its frame.
+  table.Insert(3, 100);
+  ASSERT_TRUE(table.Find(3, frame_id));
+  ASSERT_EQ(100, frame_id);
+  ASSERT_EQ(16, table.Size());
+
+  // Scenario: a buffer pool keeps replacing pages. Tombstones are cleaned up and never fill the table.
+  for (page_id_t page_id = 0; page_id < 10000; page_id++) {
+    ASSERT_TRUE(table.Remove(page_id));
+    ASSERT_FALSE(table.Remove(page_id));
+    ASSERT_FALSE(table.Find(page_id, frame_id));
+    table.Insert(page_id + 16, static_cast<frame_id_t>(page_id % 16));
+    ASSERT_TRUE(table.Find(page_id + 16, frame_id));
+    ASSERT_EQ(page_id % 16, frame_id);
+  }
+  ASSERT_EQ(16, table.Size());
+}
+
+TEST(LockFreePageTableTest, ConcurrentFindTest) {
+  const size_t num_frames = 64;
+  const int num_readers = 4;
+  LockFreePageTable table(num_frames);
+
+  // Page p is always mapped to frame p % num_frames, so any hit can be checked.
+  for (page_id_t page_id = 0; page_id < static_cast<page_id_t>(num_frames); page_id++) {
+    table.Insert(page_id, page_id % num_frames);
+  }
+  std::atomic<bool> done{false};
+  std::atomic<page_id_t> low{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < num_readers; i++) {
+    readers.emplace_back([&] {
+      while (!done) {
+        page_id_t base = low;
+        for (page_id_t page_id = base; page_id < base + static_cast<page_id_t>(num_frames) * 2; page_id++) {
+          frame_id_t frame_id;
+          if (table.Find(page_id, frame_id)) {
+            ASSERT_EQ(page_id % num_frames, frame_id);
+          }
+        }
+      }
+    });
+  }
+  // The single writer slides the window of mapped pages forward.
+  for (page_id_t page_id = 0; page_id < 20000; page_id++) {
+    table.Remove(page_id);
+    table.Insert(page_id + num_frames, (page_id + num_frames) % num_frames);
+    low = page_id + 1;
+  }
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(num_frames, table.Size());
+}
+
+}  // namespace bustub
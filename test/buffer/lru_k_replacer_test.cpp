@@ -16,7 +16,7 @@
 
 namespace bustub {
 
-TEST(LRUKReplacerTest, DISABLED_SampleTest) {
+TEST(LRUKReplacerTest, SampleTest) {
   LRUKReplacer lru_replacer(7, 2);
 
   // Scenario: add six elements to the replacer. We have [1,2,3,4,5]. Frame 6 is non-evictable.
@@ -97,4 +97,46 @@ TEST(LRUKReplacerTest, DISABLED_SampleTest) {
   lru_replacer.Remove(1);
   ASSERT_EQ(0, lru_replacer.Size());
 }
+TEST(LRUKReplacerTest, EvictionOrderTest) {
+  LRUKReplacer lru_replacer(8, 3);
+  int value;
+
+  // Frames 0..5 each get one access, then frames 0..2 reach k = 3 accesses in the order 2, 0, 1.
+  for (frame_id_t fid = 0; fid < 6; fid++) {
+    lru_replacer.RecordAccess(fid);
+    lru_replacer.SetEvictable(fid, true);
+  }
+  for (frame_id_t fid : {2, 2, 0, 0, 1, 1}) {
+    lru_replacer.RecordAccess(fid);
+  }
+  ASSERT_EQ(6, lru_replacer.Size());
+
+  // Pinning and unpinning a frame must not change its place in the eviction order.
+  lru_replacer.SetEvictable(3, false);
+  lru_replacer.SetEvictable(3, true);
+  lru_replacer.Remove(4);
+  ASSERT_EQ(5, lru_replacer.Size());
+
+  // Frames with fewer than k accesses go first, oldest first access first; frame 4's history is gone.
+  lru_replacer.RecordAccess(4);
+  lru_replacer.SetEvictable(4, true);
+  ASSERT_TRUE(lru_replacer.Evict(&value));
+  ASSERT_EQ(3, value);
+  ASSERT_TRUE(lru_replacer.Evict(&value));
+  ASSERT_EQ(5, value);
+  ASSERT_TRUE(lru_replacer.Evict(&value));
+  ASSERT_EQ(4, value);
+
+  // Then frames with k accesses, smallest k-th most recent timestamp first. A new access to frame 2 moves it last.
+  lru_replacer.RecordAccess(2);
+  ASSERT_TRUE(lru_replacer.Evict(&value));
+  ASSERT_EQ(0, value);
+  ASSERT_TRUE(lru_replacer.Evict(&value));
+  ASSERT_EQ(1, value);
+  ASSERT_TRUE(lru_replacer.Evict(&value));
+  ASSERT_EQ(2, value);
+  ASSERT_FALSE(lru_replacer.Evict(&value));
+  ASSERT_EQ(0, lru_replacer.Size());
+}
+
 }  // namespace bustub
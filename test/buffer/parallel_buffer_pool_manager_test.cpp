@@ -0,0 +1,198 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_buffer_pool_manager_test.cpp
+//
+// Identification: test/buffer/parallel_buffer_pool_manager_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/parallel_buffer_pool_manager.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(ParallelBufferPoolManagerTest, BinaryDataTest) {
+  const std::string db_name = "test.db";
+  const size_t buffer_pool_size = 5;
+  const size_t num_instances = 5;
+  const size_t k = 5;
+
+  std::random_device r;
+  std::default_random_engine rng(r());
+  std::uniform_int_distribution<char> uniform_dist(0);
+
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new ParallelBufferPoolManager(num_instances, buffer_pool_size, disk_manager, k);
+
+  page_id_t page_id_temp;
+  auto *page0 = bpm->NewPage(&page_id_temp);
+
+  // Scenario: The buffer pool is empty. We should be able to create a new page.
+  ASSERT_NE(nullptr, page0);
+  EXPECT_EQ(0, page_id_temp);
+
+  char random_binary_data[BUSTUB_PAGE_SIZE];
+  // Generate random binary data
+  for (char &i : random_binary_data) {
+    i = uniform_dist(rng);
+  }
+
+  // Insert terminal characters both in the middle and at end
+  random_binary_data[BUSTUB_PAGE_SIZE / 2] = '\0';
+  random_binary_data[BUSTUB_PAGE_SIZE - 1] = '\0';
+
+  // Scenario: Once we have a page, we should be able to read and write content.
+  std::memcpy(page0->GetData(), random_binary_data, BUSTUB_PAGE_SIZE);
+  EXPECT_EQ(0, std::memcmp(page0->GetData(), random_binary_data, BUSTUB_PAGE_SIZE));
+
+  // Scenario: We should be able to create new pages until we fill up the buffer pool.
+  for (size_t i = 1; i < buffer_pool_size * num_instances; ++i) {
+    EXPECT_NE(nullptr, bpm->NewPage(&page_id_temp));
+  }
+
+  // Scenario: Once the buffer pool is full, we should not be able to create any new pages.
+  for (size_t i = buffer_pool_size * num_instances; i < buffer_pool_size * num_instances * 2; ++i) {
+    EXPECT_EQ(nullptr, bpm->NewPage(&page_id_temp));
+  }
+
+  // Scenario: After unpinning pages {0, 1, 2, 3, 4} we should be able to create 5 new pages
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(true, bpm->UnpinPage(i, true));
+    bpm->FlushPage(i);
+  }
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_NE(nullptr, bpm->NewPage(&page_id_temp));
+    bpm->UnpinPage(page_id_temp, false);
+  }
+  // Scenario: We should be able to fetch the data we wrote a while ago.
+  page0 = bpm->FetchPage(0);
+  EXPECT_EQ(0, memcmp(page0->GetData(), random_binary_data, BUSTUB_PAGE_SIZE));
+  EXPECT_EQ(true, bpm->UnpinPage(0, true));
+
+  // Shutdown the disk manager and remove the temporary file we created.
+  disk_manager->ShutDown();
+  remove("test.db");
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(ParallelBufferPoolManagerTest, SampleTest) {
+  const std::string db_name = "test.db";
+  const size_t buffer_pool_size = 5;
+  const size_t num_instances = 2;
+  const size_t k = 5;
+
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new ParallelBufferPoolManager(num_instances, buffer_pool_size, disk_manager, k);
+  EXPECT_EQ(buffer_pool_size * num_instances, bpm->GetPoolSize());
+
+  page_id_t page_id_temp;
+  auto *page0 = bpm->NewPage(&page_id_temp);
+
+  // Scenario: The buffer pool is empty. We should be able to create a new page.
+  ASSERT_NE(nullptr, page0);
+  EXPECT_EQ(0, page_id_temp);
+
+  // Scenario: Once we have a page, we should be able to read and write content.
+  snprintf(page0->GetData(), BUSTUB_PAGE_SIZE, "Hello");
+  EXPECT_EQ(0, strcmp(page0->GetData(), "Hello"));
+
+  // Scenario: New pages are allocated round-robin, so every page id maps back to the instance that created it.
+  for (size_t i = 1; i < buffer_pool_size * num_instances; ++i) {
+    EXPECT_NE(nullptr, bpm->NewPage(&page_id_temp));
+    EXPECT_EQ(static_cast<page_id_t>(i), page_id_temp);
+  }
+
+  // Scenario: Once every instance is full, we should not be able to create any new pages.
+  for (size_t i = buffer_pool_size * num_instances; i < buffer_pool_size * num_instances * 2; ++i) {
+    EXPECT_EQ(nullptr, bpm->NewPage(&page_id_temp));
+  }
+
+  // Scenario: After unpinning pages {0, 1, 2, 3, 4} and pinning another 4 new pages,
+  // there would still be one buffer page left for reading page 0.
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(true, bpm->UnpinPage(i, true));
+  }
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_NE(nullptr, bpm->NewPage(&page_id_temp));
+  }
+
+  // Scenario: We should be able to fetch the data we wrote a while ago.
+  page0 = bpm->FetchPage(0);
+  EXPECT_EQ(0, strcmp(page0->GetData(), "Hello"));
+
+  // Scenario: If we unpin page 0 and then make a new page, all the buffer pages should
+  // now be pinned. Fetching page 0 should fail.
+  EXPECT_EQ(true, bpm->UnpinPage(0, true));
+  EXPECT_NE(nullptr, bpm->NewPage(&page_id_temp));
+  EXPECT_EQ(nullptr, bpm->FetchPage(0));
+
+  // Shutdown the disk manager and remove the temporary file we created.
+  disk_manager->ShutDown();
+  remove("test.db");
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(ParallelBufferPoolManagerTest, ConcurrencyTest) {
+  const size_t num_threads = 8;
+  const size_t num_pages_per_thread = 100;
+  const size_t buffer_pool_size = 16;
+  const size_t num_instances = 4;
+
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new ParallelBufferPoolManager(num_instances, buffer_pool_size, disk_manager);
+
+  // Scenario: every thread writes its own pages. The pool is much smaller than the working set, so pages keep
+  // getting evicted from every instance and read back.
+  std::vector<std::thread> threads;
+  std::vector<std::vector<page_id_t>> page_ids(num_threads);
+  for (size_t tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([&, tid] {
+      for (size_t i = 0; i < num_pages_per_thread; i++) {
+        page_id_t page_id;
+        Page *page = nullptr;
+        while (page == nullptr) {
+          page = bpm->NewPage(&page_id);
+        }
+        snprintf(page->GetData(), BUSTUB_PAGE_SIZE, "%d", page_id);
+        EXPECT_TRUE(bpm->UnpinPage(page_id, true));
+        page_ids[tid].push_back(page_id);
+      }
+      for (auto page_id : page_ids[tid]) {
+        Page *page = nullptr;
+        while (page == nullptr) {
+          page = bpm->FetchPage(page_id);
+        }
+        EXPECT_EQ(std::to_string(page_id), std::string(page->GetData()));
+        EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  delete bpm;
+  delete disk_manager;
+}
+
+}  // namespace bustub
@@ -0,0 +1,63 @@
+/**
+ * two_queue_replacer_test.cpp
+ */
+
+#include "buffer/two_queue_replacer.h"
+
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+TEST(TwoQueueReplacerTest, SampleTest) {
+  // 8 frames: A1in is preferred for eviction beyond 2 pages, A1out remembers 4 pages.
+  TwoQueueReplacer replacer(8);
+  frame_id_t value;
+
+  // Scenario: load pages 100..107 into frames 0..7. They all enter A1in.
+  for (frame_id_t fid = 0; fid < 8; fid++) {
+    replacer.RecordAccess(fid, 100 + fid);
+    replacer.SetEvictable(fid, true);
+  }
+  ASSERT_EQ(8, replacer.Size());
+
+  // Scenario: A1in is a FIFO, a second access to frame 0 does not save it. Page 100 moves to A1out.
+  replacer.RecordAccess(0, 100);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(0, value);
+
+  // Scenario: page 100 comes back while it is in A1out, so it enters Am.
+  replacer.RecordAccess(0, 100);
+  replacer.SetEvictable(0, true);
+
+  // Scenario: A1in pages go first while A1in holds more than 2 pages. Pages 101..105 move to A1out, which only keeps
+  // the last 4 of them.
+  for (frame_id_t fid = 1; fid <= 5; fid++) {
+    ASSERT_TRUE(replacer.Evict(&value));
+    ASSERT_EQ(fid, value);
+  }
+  ASSERT_EQ(3, replacer.Size());
+
+  // Scenario: A1in is small now, so Am pages go. A pinned Am page yields to A1in.
+  replacer.SetEvictable(0, false);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(6, value);
+  replacer.SetEvictable(0, true);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(0, value);
+
+  // Scenario: page 101 was forgotten by A1out and enters A1in again, page 105 was remembered and enters Am.
+  replacer.RecordAccess(1, 101);
+  replacer.SetEvictable(1, true);
+  replacer.RecordAccess(5, 105);
+  replacer.SetEvictable(5, true);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(5, value);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(7, value);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(1, value);
+  ASSERT_FALSE(replacer.Evict(&value));
+  ASSERT_EQ(0, replacer.Size());
+}
+
+}  // namespace bustub
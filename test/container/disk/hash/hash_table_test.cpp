@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <atomic>
 #include <thread>  // NOLINT
 #include <vector>
 
@@ -18,13 +20,14 @@
 #include "container/disk/hash/disk_extendible_hash_table.h"
 #include "gtest/gtest.h"
 #include "murmur3/MurmurHash3.h"
+#include "storage/disk/disk_manager_memory.h"
 
 namespace bustub {
 
 // NOLINTNEXTLINE
 
 // NOLINTNEXTLINE
-TEST(HashTableTest, DISABLED_SampleTest) {
+TEST(HashTableTest, SampleTest) {
   auto *disk_manager = new DiskManager("test.db");
   auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
   DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
@@ -117,4 +120,128 @@ TEST(HashTableTest, DISABLED_SampleTest) {
   delete bpm;
 }
 
+// NOLINTNEXTLINE
+TEST(HashTableTest, OverflowTest) {
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  // Scenario: a single key has the values of several bucket pages, among other keys that split its bucket.
+  const int num_values = 2000;
+  const int num_keys = 1000;
+  for (int value = 0; value < num_values; value++) {
+    ASSERT_TRUE(ht.Insert(nullptr, 0, value)) << value;
+    if (value < num_keys) {
+      ASSERT_TRUE(ht.Insert(nullptr, value + 1, value));
+    }
+  }
+  ht.VerifyIntegrity();
+  EXPECT_FALSE(ht.Insert(nullptr, 0, num_values - 1));
+  std::vector<int> result;
+  ASSERT_TRUE(ht.GetValue(nullptr, 0, &result));
+  std::sort(result.begin(), result.end());
+  ASSERT_EQ(num_values, result.size());
+  for (int value = 0; value < num_values; value++) {
+    ASSERT_EQ(value, result[value]);
+  }
+  for (int key = 1; key <= num_keys; key++) {
+    result.clear();
+    ht.GetValue(nullptr, key, &result);
+    ASSERT_EQ(std::vector<int>{key - 1}, result) << key;
+  }
+
+  // Scenario: removing the values empties the overflow pages again, and the buckets merge.
+  for (int value = 0; value < num_values; value++) {
+    ASSERT_TRUE(ht.Remove(nullptr, 0, value)) << value;
+    if (value < num_keys) {
+      ASSERT_TRUE(ht.Remove(nullptr, value + 1, value));
+    }
+  }
+  ht.VerifyIntegrity();
+  result.clear();
+  EXPECT_FALSE(ht.GetValue(nullptr, 0, &result));
+  EXPECT_EQ(0, ht.GetGlobalDepth());
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, ConcurrentInsertRemoveTest) {
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(100, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  // Scenario: threads insert disjoint keys, which splits buckets and doubles the directory under them, while readers
+  // look up keys that are always in the table. Every key ends up in the table exactly once.
+  const int num_threads = 4;
+  const int keys_per_thread = 5000;
+  const int stable_keys = 100;
+  for (int key = 0; key < stable_keys; key++) {
+    ASSERT_TRUE(ht.Insert(nullptr, -key - 1, key));
+  }
+  std::atomic<bool> done{false};
+  std::atomic<int> lost_lookups{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 2; t++) {
+    readers.emplace_back([&ht, &done, &lost_lookups, t] {
+      std::vector<int> result;
+      for (int i = t; !done; i++) {
+        result.clear();
+        int key = i % stable_keys;
+        if (!ht.GetValue(nullptr, -key - 1, &result) || result != std::vector<int>{key}) {
+          lost_lookups++;
+        }
+      }
+    });
+  }
+  std::vector<std::thread> writers;
+  for (int t = 0; t < num_threads; t++) {
+    writers.emplace_back([&ht, t] {
+      for (int key = t; key < num_threads * keys_per_thread; key += num_threads) {
+        ht.Insert(nullptr, key, key);
+      }
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  ht.VerifyIntegrity();
+  EXPECT_GT(ht.GetGlobalDepth(), 0);
+  for (int key = 0; key < num_threads * keys_per_thread; key++) {
+    std::vector<int> result;
+    ht.GetValue(nullptr, key, &result);
+    ASSERT_EQ(std::vector<int>{key}, result) << key;
+  }
+
+  // Scenario: threads remove the keys again, which merges buckets and shrinks the directory, while the readers go on.
+  for (int t = 0; t < num_threads; t++) {
+    writers[t] = std::thread([&ht, t] {
+      for (int key = t; key < num_threads * keys_per_thread; key += num_threads) {
+        ht.Remove(nullptr, key, key);
+      }
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(0, lost_lookups);
+  ht.VerifyIntegrity();
+  for (int key = 0; key < num_threads * keys_per_thread; key++) {
+    std::vector<int> result;
+    ASSERT_FALSE(ht.GetValue(nullptr, key, &result)) << key;
+  }
+  for (int key = 0; key < stable_keys; key++) {
+    ASSERT_TRUE(ht.Remove(nullptr, -key - 1, key));
+  }
+  EXPECT_EQ(0, ht.GetGlobalDepth());
+
+  delete bpm;
+  delete disk_manager;
+}
+
 }  // namespace bustub
@@ -0,0 +1,238 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// linear_probe_hash_table_test.cpp
+//
+// Identification: test/container/disk/hash/linear_probe_hash_table_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "container/disk/hash/linear_probe_hash_table.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, SampleTest) {
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1000, HashFunction<int>());
+
+  for (int i = 0; i < 5; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+    std::vector<int> res;
+    EXPECT_TRUE(ht.GetValue(nullptr, i, &res));
+    EXPECT_EQ(std::vector<int>{i}, res);
+  }
+
+  // a key can have several values, but not the same one twice
+  EXPECT_FALSE(ht.Insert(nullptr, 1, 1));
+  EXPECT_TRUE(ht.Insert(nullptr, 1, 10));
+  std::vector<int> res;
+  EXPECT_TRUE(ht.GetValue(nullptr, 1, &res));
+  std::sort(res.begin(), res.end());
+  EXPECT_EQ((std::vector<int>{1, 10}), res);
+
+  EXPECT_TRUE(ht.Remove(nullptr, 1, 1));
+  EXPECT_FALSE(ht.Remove(nullptr, 1, 1));
+  EXPECT_FALSE(ht.Remove(nullptr, 2, 3));
+  res.clear();
+  EXPECT_TRUE(ht.GetValue(nullptr, 1, &res));
+  EXPECT_EQ(std::vector<int>{10}, res);
+  res.clear();
+  EXPECT_FALSE(ht.GetValue(nullptr, 7, &res));
+  EXPECT_TRUE(res.empty());
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, GrowTest) {
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1, HashFunction<int>());
+  const size_t initial_size = ht.GetSize();
+
+  // Every pair stays visible while the table migrates to larger ones under the inserts.
+  const int num_keys = 10000;
+  for (int key = 0; key < num_keys; key++) {
+    ASSERT_TRUE(ht.Insert(nullptr, key, key));
+    if (key % 997 == 0) {
+      for (int old_key = 0; old_key <= key; old_key++) {
+        std::vector<int> res;
+        ASSERT_TRUE(ht.GetValue(nullptr, old_key, &res)) << old_key << " lost after inserting " << key;
+        ASSERT_EQ(std::vector<int>{old_key}, res);
+      }
+    }
+  }
+  EXPECT_GE(ht.GetSize(), 8 * initial_size);
+  EXPECT_GE(ht.GetSize(), static_cast<size_t>(num_keys));
+
+  for (int key = 0; key < num_keys; key += 2) {
+    ASSERT_TRUE(ht.Remove(nullptr, key, key));
+  }
+  for (int key = 0; key < num_keys; key++) {
+    std::vector<int> res;
+    ASSERT_EQ(key % 2 == 1, ht.GetValue(nullptr, key, &res)) << key;
+  }
+
+  // An explicit resize migrates incrementally too.
+  ht.Resize(4 * num_keys);
+  EXPECT_GE(ht.GetSize(), static_cast<size_t>(8 * num_keys));
+  for (int key = 1; key < num_keys; key += 2) {
+    std::vector<int> res;
+    ASSERT_TRUE(ht.GetValue(nullptr, key, &res)) << key;
+  }
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, TombstoneCompactionTest) {
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1, HashFunction<int>());
+  const size_t size = ht.GetSize();
+
+  // Removes leave tombstones, which fill the table as keys come and go. Only a few pairs are live at any time, so the
+  // table compacts them away into a table of the same size instead of growing.
+  const int live = 50;
+  for (int key = 0; key < live; key++) {
+    ASSERT_TRUE(ht.Insert(nullptr, key, key));
+  }
+  for (int key = live; key < 20 * static_cast<int>(size); key++) {
+    ASSERT_TRUE(ht.Remove(nullptr, key - live, key - live));
+    ASSERT_TRUE(ht.Insert(nullptr, key, key));
+  }
+  EXPECT_EQ(size, ht.GetSize());
+  for (int key = 20 * static_cast<int>(size) - live; key < 20 * static_cast<int>(size); key++) {
+    std::vector<int> res;
+    ASSERT_TRUE(ht.GetValue(nullptr, key, &res)) << key;
+  }
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, ConcurrentInsertRemoveTest) {
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(100, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1, HashFunction<int>());
+
+  // Scenario: threads insert disjoint keys, which makes the table grow under them, while readers look up keys that are
+  // always in the table. Then the threads remove every other key they inserted.
+  const int num_threads = 4;
+  const int keys_per_thread = 5000;
+  const int stable_keys = 100;
+  for (int key = 0; key < stable_keys; key++) {
+    ASSERT_TRUE(ht.Insert(nullptr, -key - 1, key));
+  }
+  std::atomic<bool> done{false};
+  std::atomic<int> lost_lookups{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 2; t++) {
+    readers.emplace_back([&ht, &done, &lost_lookups, t] {
+      std::vector<int> result;
+      for (int i = t; !done; i++) {
+        result.clear();
+        int key = i % stable_keys;
+        if (!ht.GetValue(nullptr, -key - 1, &result) || result != std::vector<int>{key}) {
+          lost_lookups++;
+        }
+      }
+    });
+  }
+  std::vector<std::thread> writers;
+  for (int t = 0; t < num_threads; t++) {
+    writers.emplace_back([&ht, t] {
+      for (int i = 0; i < keys_per_thread; i++) {
+        int key = i * num_threads + t;
+        EXPECT_TRUE(ht.Insert(nullptr, key, key));
+      }
+      for (int i = 0; i < keys_per_thread; i += 2) {
+        int key = i * num_threads + t;
+        EXPECT_TRUE(ht.Remove(nullptr, key, key));
+      }
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(0, lost_lookups);
+
+  for (int key = 0; key < num_threads * keys_per_thread; key++) {
+    std::vector<int> result;
+    bool found = ht.GetValue(nullptr, key, &result);
+    if ((key / num_threads) % 2 == 0) {
+      EXPECT_FALSE(found) << key;
+    } else {
+      EXPECT_TRUE(found) << key;
+      EXPECT_EQ(std::vector<int>{key}, result);
+    }
+  }
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, ConcurrentDuplicateInsertTest) {
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(100, disk_manager);
+
+  // Scenario: threads insert the same pairs into a table large enough not to grow, so that all inserts run under the
+  // read latch. Each pair is inserted by exactly one thread and found once.
+  const int num_threads = 8;
+  const int num_keys = 50;
+  const int num_pairs = 2000;
+  for (int round = 0; round < 5; round++) {
+    LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 4 * num_pairs,
+                                                     HashFunction<int>());
+    const size_t size = ht.GetSize();
+    std::atomic<int> num_inserted{0};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < num_threads; t++) {
+      writers.emplace_back([&ht, &num_inserted] {
+        for (int value = 0; value < num_pairs; value++) {
+          if (ht.Insert(nullptr, value % num_keys, value)) {
+            num_inserted++;
+          }
+        }
+      });
+    }
+    for (auto &writer : writers) {
+      writer.join();
+    }
+    EXPECT_EQ(size, ht.GetSize());
+    EXPECT_EQ(num_pairs, num_inserted);
+    for (int key = 0; key < num_keys; key++) {
+      std::vector<int> result;
+      ASSERT_TRUE(ht.GetValue(nullptr, key, &result));
+      std::sort(result.begin(), result.end());
+      ASSERT_EQ(num_pairs / num_keys, result.size()) << key;
+      for (size_t i = 0; i < result.size(); i++) {
+        ASSERT_EQ(key + static_cast<int>(i) * num_keys, result[i]);
+      }
+    }
+  }
+
+  delete bpm;
+  delete disk_manager;
+}
+
+}  // namespace bustub
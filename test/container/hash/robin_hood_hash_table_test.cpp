@@ -0,0 +1,90 @@
+/**
+ * robin_hood_hash_table_test.cpp
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "container/hash/robin_hood_hash_table.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+TEST(RobinHoodHashTableTest, FindOrInsertTest) {
+  auto table = std::make_unique<RobinHoodHashTable>(2, 1);
+
+  // Enough keys for the table to grow several times.
+  const size_t num_keys = 10000;
+  for (int i = 0; i < static_cast<int>(num_keys); i++) {
+    std::vector<Value> key{ValueFactory::GetIntegerValue(i % 100), ValueFactory::GetVarcharValue(std::to_string(i))};
+    auto [entry, inserted] = table->FindOrInsert(key);
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(static_cast<size_t>(i), entry);
+    *table->PayloadAt(entry) = ValueFactory::GetIntegerValue(i);
+  }
+  ASSERT_EQ(num_keys, table->Size());
+
+  for (int i = 0; i < static_cast<int>(num_keys); i++) {
+    std::vector<Value> key{ValueFactory::GetIntegerValue(i % 100), ValueFactory::GetVarcharValue(std::to_string(i))};
+    auto [entry, inserted] = table->FindOrInsert(key);
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(i, table->PayloadAt(entry)->GetAs<int32_t>());
+    ASSERT_EQ(entry, table->Find(key));
+    ASSERT_EQ(i % 100, table->KeyAt(entry)[0].GetAs<int32_t>());
+  }
+  ASSERT_EQ(num_keys, table->Size());
+
+  std::vector<Value> missing{ValueFactory::GetIntegerValue(1), ValueFactory::GetVarcharValue("2")};
+  EXPECT_EQ(RobinHoodHashTable::NO_ENTRY, table->Find(missing));
+
+  table->Clear();
+  EXPECT_EQ(0U, table->Size());
+  std::vector<Value> key{ValueFactory::GetIntegerValue(0), ValueFactory::GetVarcharValue("0")};
+  EXPECT_EQ(RobinHoodHashTable::NO_ENTRY, table->Find(key));
+  EXPECT_TRUE(table->FindOrInsert(key).second);
+}
+
+TEST(RobinHoodHashTableTest, DuplicateKeyTest) {
+  auto table = std::make_unique<RobinHoodHashTable>(1, 1);
+
+  const int num_keys = 500;
+  const int num_duplicates = 5;
+  for (int round = 0; round < num_duplicates; round++) {
+    for (int i = 0; i < num_keys; i++) {
+      auto entry = table->Insert({ValueFactory::GetIntegerValue(i)});
+      *table->PayloadAt(entry) = ValueFactory::GetIntegerValue(round);
+    }
+  }
+  ASSERT_EQ(static_cast<size_t>(num_keys * num_duplicates), table->Size());
+
+  // The entries of a key come back in the order they were inserted.
+  for (int i = 0; i < num_keys; i++) {
+    int round = 0;
+    for (auto entry = table->Find({ValueFactory::GetIntegerValue(i)}); entry != RobinHoodHashTable::NO_ENTRY;
+         entry = table->NextDuplicate(entry)) {
+      ASSERT_EQ(i, table->KeyAt(entry)[0].GetAs<int32_t>());
+      ASSERT_EQ(round, table->PayloadAt(entry)->GetAs<int32_t>());
+      round++;
+    }
+    ASSERT_EQ(num_duplicates, round);
+  }
+  EXPECT_EQ(RobinHoodHashTable::NO_ENTRY, table->Find({ValueFactory::GetIntegerValue(num_keys)}));
+}
+
+TEST(RobinHoodHashTableTest, NullKeyTest) {
+  auto table = std::make_unique<RobinHoodHashTable>(1, 0);
+
+  auto null_key = std::vector<Value>{ValueFactory::GetNullValueByType(TypeId::INTEGER)};
+  auto [entry, inserted] = table->FindOrInsert(null_key);
+  EXPECT_TRUE(inserted);
+  EXPECT_TRUE(table->KeyAt(entry)[0].IsNull());
+
+  // NULL keys make one group, apart from every other key.
+  EXPECT_EQ(std::make_pair(entry, false), table->FindOrInsert(null_key));
+  EXPECT_TRUE(table->FindOrInsert({ValueFactory::GetIntegerValue(0)}).second);
+  EXPECT_EQ(2U, table->Size());
+}
+
+}  // namespace bustub
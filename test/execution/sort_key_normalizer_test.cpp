@@ -0,0 +1,83 @@
+/**
+ * sort_key_normalizer_test.cpp
+ */
+
+#include <string>
+#include <vector>
+
+#include "execution/sort_key_normalizer.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** The key of a value, with NULLs where they go by default. */
+auto KeyOf(const Value &value, bool descending) -> std::string {
+  std::string key;
+  SortKeyNormalizer::NormalizeValue(value, descending, !descending, &key);
+  return key;
+}
+
+/** Check that the keys of values, which are in ascending order, are in ascending order, and descending if flipped. */
+void ExpectOrdered(const std::vector<Value> &values) {
+  for (size_t i = 1; i < values.size(); i++) {
+    EXPECT_LT(KeyOf(values[i - 1], false), KeyOf(values[i], false)) << values[i - 1].ToString();
+    EXPECT_GT(KeyOf(values[i - 1], true), KeyOf(values[i], true)) << values[i - 1].ToString();
+  }
+}
+
+}  // namespace
+
+TEST(SortKeyNormalizerTest, IntegerTest) {
+  ExpectOrdered({ValueFactory::GetNullValueByType(TypeId::INTEGER), ValueFactory::GetIntegerValue(-2147483647),
+                 ValueFactory::GetIntegerValue(-256), ValueFactory::GetIntegerValue(-1), ValueFactory::GetIntegerValue(0),
+                 ValueFactory::GetIntegerValue(1), ValueFactory::GetIntegerValue(255), ValueFactory::GetIntegerValue(256),
+                 ValueFactory::GetIntegerValue(2147483647)});
+  ExpectOrdered({ValueFactory::GetBigIntValue(-4294967296), ValueFactory::GetBigIntValue(-1),
+                 ValueFactory::GetBigIntValue(0), ValueFactory::GetBigIntValue(4294967296)});
+  ExpectOrdered({ValueFactory::GetSmallIntValue(-300), ValueFactory::GetSmallIntValue(-1),
+                 ValueFactory::GetSmallIntValue(300)});
+  ExpectOrdered({ValueFactory::GetBooleanValue(false), ValueFactory::GetBooleanValue(true)});
+}
+
+TEST(SortKeyNormalizerTest, DecimalTest) {
+  ExpectOrdered({ValueFactory::GetDecimalValue(-1e100), ValueFactory::GetDecimalValue(-2.5),
+                 ValueFactory::GetDecimalValue(-0.001), ValueFactory::GetDecimalValue(0),
+                 ValueFactory::GetDecimalValue(0.001), ValueFactory::GetDecimalValue(2.5),
+                 ValueFactory::GetDecimalValue(1e100)});
+}
+
+TEST(SortKeyNormalizerTest, VarcharTest) {
+  ExpectOrdered({ValueFactory::GetNullValueByType(TypeId::VARCHAR), ValueFactory::GetVarcharValue(""),
+                 ValueFactory::GetVarcharValue(std::string("\0", 1)), ValueFactory::GetVarcharValue(std::string("\0a", 2)),
+                 ValueFactory::GetVarcharValue("a"), ValueFactory::GetVarcharValue("ab"), ValueFactory::GetVarcharValue("b"),
+                 ValueFactory::GetVarcharValue("\xff")});
+
+  // A varchar key ends before the next column begins, so that a shorter string sorts first whatever follows it.
+  std::string shorter = KeyOf(ValueFactory::GetVarcharValue("a"), false);
+  shorter += KeyOf(ValueFactory::GetIntegerValue(2147483647), false);
+  std::string longer = KeyOf(ValueFactory::GetVarcharValue("ab"), false);
+  longer += KeyOf(ValueFactory::GetIntegerValue(-2147483647), false);
+  EXPECT_LT(shorter, longer);
+}
+
+TEST(SortKeyNormalizerTest, NullOrderTest) {
+  auto null_value = ValueFactory::GetNullValueByType(TypeId::INTEGER);
+  std::vector<Value> values{ValueFactory::GetIntegerValue(-2147483647), ValueFactory::GetIntegerValue(0),
+                            ValueFactory::GetIntegerValue(2147483647)};
+  for (bool descending : {false, true}) {
+    for (bool nulls_first : {false, true}) {
+      std::string null_key;
+      SortKeyNormalizer::NormalizeValue(null_value, descending, nulls_first, &null_key);
+      for (const auto &value : values) {
+        std::string key;
+        SortKeyNormalizer::NormalizeValue(value, descending, nulls_first, &key);
+        EXPECT_EQ(nulls_first, null_key < key) << descending;
+      }
+    }
+  }
+}
+
+}  // namespace bustub
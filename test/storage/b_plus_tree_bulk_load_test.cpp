@@ -0,0 +1,175 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_bulk_load_test.cpp
+//
+// Identification: test/storage/b_plus_tree_bulk_load_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_plus_tree.h"
+#include "test_util.h"  // NOLINT
+
+namespace bustub {
+
+using TreeType = BPlusTree<GenericKey<8>, RID, GenericComparator<8>>;
+using InternalPageType = BPlusTreeInternalPage<GenericKey<8>, page_id_t, GenericComparator<8>>;
+using LeafPageType = BPlusTreeLeafPage<GenericKey<8>, RID, GenericComparator<8>>;
+
+// Walk the subtree rooted at page_id, checking page sizes, parent links and leaf depths, and collect its keys in order.
+void CheckSubtree(BufferPoolManager *bpm, page_id_t page_id, page_id_t parent_page_id, int depth, int *leaf_depth,
+                  std::vector<int64_t> *keys) {
+  Page *page = bpm->FetchPage(page_id);
+  ASSERT_NE(nullptr, page);
+  auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  EXPECT_EQ(parent_page_id, node->GetParentPageId());
+  if (parent_page_id != INVALID_PAGE_ID) {
+    EXPECT_GE(node->GetSize(), node->GetMinSize());
+  }
+  if (node->IsLeafPage()) {
+    auto *leaf = reinterpret_cast<LeafPageType *>(node);
+    EXPECT_LT(leaf->GetSize(), leaf->GetMaxSize());
+    if (*leaf_depth == -1) {
+      *leaf_depth = depth;
+    }
+    EXPECT_EQ(*leaf_depth, depth);
+    for (int i = 0; i < leaf->GetSize(); i++) {
+      keys->push_back(leaf->ValueAt(i).GetSlotNum());
+    }
+  } else {
+    auto *internal = reinterpret_cast<InternalPageType *>(node);
+    EXPECT_LE(internal->GetSize(), internal->GetMaxSize());
+    EXPECT_GE(internal->GetSize(), 2);
+    for (int i = 0; i < internal->GetSize(); i++) {
+      CheckSubtree(bpm, internal->ValueAt(i), page_id, depth + 1, leaf_depth, keys);
+    }
+  }
+  bpm->UnpinPage(page_id, false);
+}
+
+// Check the shape of the tree and that it holds exactly the given keys.
+void CheckTree(BufferPoolManager *bpm, TreeType *tree, const std::vector<int64_t> &expected_keys) {
+  std::vector<int64_t> keys;
+  if (!tree->IsEmpty()) {
+    int leaf_depth = -1;
+    CheckSubtree(bpm, tree->GetRootPageId(), INVALID_PAGE_ID, 0, &leaf_depth, &keys);
+  }
+  EXPECT_EQ(expected_keys, keys);
+
+  std::vector<int64_t> iterated_keys;
+  for (auto iterator = tree->Begin(); iterator != tree->End(); ++iterator) {
+    iterated_keys.push_back((*iterator).second.GetSlotNum());
+  }
+  EXPECT_EQ(expected_keys, iterated_keys);
+
+  GenericKey<8> index_key;
+  std::vector<RID> rids;
+  for (auto key : expected_keys) {
+    rids.clear();
+    index_key.SetFromInteger(key);
+    EXPECT_TRUE(tree->GetValue(index_key, &rids));
+  }
+}
+
+// Bulk load the given sorted keys into an empty tree.
+auto BulkLoadKeys(TreeType *tree, const std::vector<int64_t> &keys, double fill_factor) -> bool {
+  size_t next = 0;
+  return tree->BulkLoad(
+      [&keys, &next](std::pair<GenericKey<8>, RID> *entry) {
+        if (next == keys.size()) {
+          return false;
+        }
+        entry->first.SetFromInteger(keys[next]);
+        entry->second.Set(static_cast<int32_t>(keys[next] >> 32), keys[next] & 0xFFFFFFFF);
+        next++;
+        return true;
+      },
+      fill_factor);
+}
+
+TEST(BPlusTreeBulkLoadTest, ShapeTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  for (auto [leaf_max_size, internal_max_size] : std::vector<std::pair<int, int>>{{2, 3}, {3, 4}, {5, 5}, {32, 16}}) {
+    for (double fill_factor : {0.0, 0.5, 0.9, 1.0}) {
+      for (int64_t num_keys : {0, 1, 2, 7, 100, 2000}) {
+        auto *disk_manager = new DiskManagerUnlimitedMemory();
+        BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+        page_id_t page_id;
+        bpm->NewPage(&page_id);
+        TreeType tree("foo_pk", bpm, comparator, leaf_max_size, internal_max_size);
+
+        // Scenario: the loaded tree is a valid tree that holds exactly the loaded keys.
+        std::vector<int64_t> keys;
+        for (int64_t key = 0; key < num_keys; key++) {
+          keys.push_back(key * 2);
+        }
+        ASSERT_TRUE(BulkLoadKeys(&tree, keys, fill_factor));
+        CheckTree(bpm, &tree, keys);
+
+        // Scenario: the loaded tree keeps working with regular inserts and removes.
+        GenericKey<8> index_key;
+        RID rid;
+        for (int64_t key = 0; key < num_keys; key += 3) {
+          index_key.SetFromInteger(key * 2 + 1);
+          rid.Set(0, key * 2 + 1);
+          ASSERT_TRUE(tree.Insert(index_key, rid));
+          keys.push_back(key * 2 + 1);
+        }
+        for (int64_t key = 0; key < num_keys; key += 2) {
+          index_key.SetFromInteger(key * 2);
+          tree.Remove(index_key);
+          keys.erase(std::find(keys.begin(), keys.end(), key * 2));
+        }
+        std::sort(keys.begin(), keys.end());
+        CheckTree(bpm, &tree, keys);
+
+        bpm->UnpinPage(HEADER_PAGE_ID, true);
+        delete bpm;
+        delete disk_manager;
+      }
+    }
+  }
+}
+
+TEST(BPlusTreeBulkLoadTest, InputTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  page_id_t page_id;
+  bpm->NewPage(&page_id);
+
+  // Scenario: only the first pair of a duplicate key is kept.
+  TreeType tree("foo_pk", bpm, comparator, 3, 3);
+  ASSERT_TRUE(BulkLoadKeys(&tree, {1, 2, 2, 2, 3, 4, 4, 5}, 1.0));
+  CheckTree(bpm, &tree, {1, 2, 3, 4, 5});
+
+  // Scenario: a tree that is not empty cannot be bulk loaded.
+  ASSERT_FALSE(BulkLoadKeys(&tree, {6, 7}, 1.0));
+  CheckTree(bpm, &tree, {1, 2, 3, 4, 5});
+
+  // Scenario: unsorted input is rejected, and the tree stays empty.
+  TreeType unsorted_tree("bar_pk", bpm, comparator, 3, 3);
+  ASSERT_THROW(BulkLoadKeys(&unsorted_tree, {1, 2, 3, 5, 4}, 1.0), Exception);
+  ASSERT_TRUE(unsorted_tree.IsEmpty());
+  CheckTree(bpm, &unsorted_tree, {});
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+}
+
+}  // namespace bustub
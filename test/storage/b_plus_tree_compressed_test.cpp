@@ -0,0 +1,311 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_compressed_test.cpp
+//
+// Identification: test/storage/b_plus_tree_compressed_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_plus_tree.h"
+#include "storage/table/tuple.h"
+#include "test_util.h"  // NOLINT
+#include "type/value_factory.h"
+
+namespace bustub {
+
+using Codec8 = CompressedKeyCodec<GenericKey<8>, GenericComparator<8>>;
+using CompressedTree8 = BPlusTree<GenericKey<8>, RID, GenericComparator<8>, Codec8>;
+using VerbatimTree8 = BPlusTree<GenericKey<8>, RID, GenericComparator<8>>;
+
+/** The shape of a tree: its height and the number of pages of each kind. */
+struct TreeShape {
+  int height_{0};
+  int leaf_pages_{0};
+  int internal_pages_{0};
+};
+
+// Walk the subtree rooted at page_id, checking page sizes, parent links and leaf depths, and count its pages.
+template <typename LeafPage, typename InternalPage>
+void CheckSubtree(BufferPoolManager *bpm, page_id_t page_id, page_id_t parent_page_id, int depth, TreeShape *shape) {
+  Page *page = bpm->FetchPage(page_id);
+  ASSERT_NE(nullptr, page);
+  auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  EXPECT_EQ(parent_page_id, node->GetParentPageId());
+  if (parent_page_id != INVALID_PAGE_ID) {
+    EXPECT_GE(node->GetSize(), node->GetMinSize());
+  }
+  if (node->IsLeafPage()) {
+    if (shape->height_ == 0) {
+      shape->height_ = depth + 1;
+    }
+    EXPECT_EQ(shape->height_, depth + 1);
+    shape->leaf_pages_++;
+  } else {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    EXPECT_GE(internal->GetSize(), 2);
+    shape->internal_pages_++;
+    for (int i = 0; i < internal->GetSize(); i++) {
+      CheckSubtree<LeafPage, InternalPage>(bpm, internal->ValueAt(i), page_id, depth + 1, shape);
+    }
+  }
+  bpm->UnpinPage(page_id, false);
+}
+
+// Check the shape of the tree and return it.
+template <typename Codec>
+auto CheckShape(BufferPoolManager *bpm, page_id_t root_page_id) -> TreeShape {
+  TreeShape shape;
+  if (root_page_id != INVALID_PAGE_ID) {
+    CheckSubtree<typename Codec::template LeafPage<RID>, typename Codec::InternalPage>(bpm, root_page_id,
+                                                                                       INVALID_PAGE_ID, 0, &shape);
+  }
+  return shape;
+}
+
+// Check that the tree holds exactly the given keys, with the RID of each key's slot set to the key.
+void CheckKeys(CompressedTree8 *tree, std::vector<int64_t> expected_keys) {
+  std::sort(expected_keys.begin(), expected_keys.end());
+  std::vector<int64_t> iterated_keys;
+  for (auto iterator = tree->Begin(); iterator != tree->End(); ++iterator) {
+    int64_t key;
+    memcpy(&key, (*iterator).first.data_, sizeof(key));
+    EXPECT_EQ(static_cast<uint32_t>(key), (*iterator).second.GetSlotNum());
+    iterated_keys.push_back(key);
+  }
+  EXPECT_EQ(expected_keys, iterated_keys);
+
+  GenericKey<8> index_key;
+  std::vector<RID> rids;
+  for (auto key : expected_keys) {
+    rids.clear();
+    index_key.SetFromInteger(key);
+    ASSERT_TRUE(tree->GetValue(index_key, &rids));
+    EXPECT_EQ(static_cast<uint32_t>(key), rids[0].GetSlotNum());
+  }
+}
+
+TEST(BPlusTreeCompressedTest, InsertRemoveTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  page_id_t page_id;
+  bpm->NewPage(&page_id);
+  CompressedTree8 tree("foo_pk", bpm, comparator);
+
+  // Scenario: random keys, negative ones included, keep their order through splits.
+  std::vector<int64_t> keys;
+  std::mt19937_64 random(15445);
+  for (int i = 0; i < 20000; i++) {
+    keys.push_back(static_cast<int64_t>(random() % 1000000) - 500000);
+  }
+  std::vector<int64_t> inserted_keys;
+  GenericKey<8> index_key;
+  for (auto key : keys) {
+    index_key.SetFromInteger(key);
+    bool inserted = tree.Insert(index_key, RID(0, static_cast<uint32_t>(key)));
+    EXPECT_EQ(std::find(inserted_keys.begin(), inserted_keys.end(), key) == inserted_keys.end(), inserted);
+    if (inserted) {
+      inserted_keys.push_back(key);
+    }
+  }
+  TreeShape shape = CheckShape<Codec8>(bpm, tree.GetRootPageId());
+  EXPECT_GE(shape.height_, 2);
+  CheckKeys(&tree, inserted_keys);
+
+  // Scenario: a key that is not in the tree is not found, and the iterator starts at the next key.
+  std::sort(inserted_keys.begin(), inserted_keys.end());
+  std::vector<RID> rids;
+  index_key.SetFromInteger(inserted_keys[100] + 1);
+  if (inserted_keys[101] != inserted_keys[100] + 1) {
+    EXPECT_FALSE(tree.GetValue(index_key, &rids));
+  }
+  EXPECT_EQ(static_cast<uint32_t>(inserted_keys[101]), (*tree.Begin(index_key)).second.GetSlotNum());
+
+  // Scenario: removing keys merges and redistributes pages until the tree is empty.
+  std::shuffle(inserted_keys.begin(), inserted_keys.end(), random);
+  while (!inserted_keys.empty()) {
+    size_t remaining = inserted_keys.size() > 2000 ? inserted_keys.size() - 2000 : 0;
+    for (size_t i = remaining; i < inserted_keys.size(); i++) {
+      index_key.SetFromInteger(inserted_keys[i]);
+      tree.Remove(index_key);
+    }
+    inserted_keys.resize(remaining);
+    CheckShape<Codec8>(bpm, tree.GetRootPageId());
+    CheckKeys(&tree, inserted_keys);
+  }
+  EXPECT_TRUE(tree.IsEmpty());
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+}
+
+TEST(BPlusTreeCompressedTest, CompositeKeyTest) {
+  auto key_schema = ParseCreateStatement("a smallint,b integer,c bigint");
+  GenericComparator<16> comparator(key_schema.get());
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  page_id_t page_id;
+  bpm->NewPage(&page_id);
+  BPlusTree<GenericKey<16>, RID, GenericComparator<16>, CompressedKeyCodec<GenericKey<16>, GenericComparator<16>>>
+      tree("foo_pk", bpm, comparator);
+  BPlusTree<GenericKey<16>, RID, GenericComparator<16>> verbatim_tree("bar_pk", bpm, comparator);
+
+  // Scenario: keys whose columns have mixed signs and widths sort as the verbatim tree sorts them.
+  std::mt19937 random(15445);
+  for (uint32_t i = 0; i < 5000; i++) {
+    std::vector<Value> values{ValueFactory::GetSmallIntValue(static_cast<int16_t>(random() % 7) - 3),
+                              ValueFactory::GetIntegerValue(static_cast<int32_t>(random() % 2001) - 1000),
+                              ValueFactory::GetBigIntValue(static_cast<int64_t>(random()) - (int64_t{1} << 31))};
+    Tuple tuple(values, key_schema.get());
+    GenericKey<16> index_key;
+    index_key.SetFromKey(tuple);
+    EXPECT_EQ(verbatim_tree.Insert(index_key, RID(0, i)), tree.Insert(index_key, RID(0, i)));
+  }
+  {
+    auto verbatim_iterator = verbatim_tree.Begin();
+    int count = 0;
+    for (auto iterator = tree.Begin(); iterator != tree.End(); ++iterator, ++verbatim_iterator, ++count) {
+      ASSERT_FALSE(verbatim_iterator.IsEnd());
+      EXPECT_EQ(0, comparator((*verbatim_iterator).first, (*iterator).first));
+      EXPECT_EQ((*verbatim_iterator).second, (*iterator).second);
+    }
+    EXPECT_TRUE(verbatim_iterator.IsEnd());
+    EXPECT_GT(count, 0);
+  }
+
+  // Scenario: a key with a variable-length column cannot be compressed.
+  auto varchar_schema = ParseCreateStatement("a varchar(8)");
+  GenericComparator<16> varchar_comparator(varchar_schema.get());
+  using VarcharTree =
+      BPlusTree<GenericKey<16>, RID, GenericComparator<16>, CompressedKeyCodec<GenericKey<16>, GenericComparator<16>>>;
+  EXPECT_THROW(VarcharTree("baz_pk", bpm, varchar_comparator), NotImplementedException);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+}
+
+TEST(BPlusTreeCompressedTest, BulkLoadShapeTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  page_id_t page_id;
+  bpm->NewPage(&page_id);
+  CompressedTree8 tree("foo_pk", bpm, comparator);
+  VerbatimTree8 verbatim_tree("bar_pk", bpm, comparator);
+
+  const int64_t num_keys = 100000;
+  auto next_key = [](int64_t *key) {
+    return [key](std::pair<GenericKey<8>, RID> *entry) {
+      if (*key == num_keys) {
+        return false;
+      }
+      entry->first.SetFromInteger(*key * 3);
+      entry->second.Set(0, static_cast<uint32_t>(*key * 3));
+      (*key)++;
+      return true;
+    };
+  };
+  int64_t key = 0;
+  ASSERT_TRUE(tree.BulkLoad(next_key(&key)));
+  key = 0;
+  ASSERT_TRUE(verbatim_tree.BulkLoad(next_key(&key)));
+
+  // Scenario: the compressed tree holds the same keys in fewer pages, and is no taller.
+  TreeShape shape = CheckShape<Codec8>(bpm, tree.GetRootPageId());
+  TreeShape verbatim_shape =
+      CheckShape<VerbatimKeyCodec<GenericKey<8>, GenericComparator<8>>>(bpm, verbatim_tree.GetRootPageId());
+  EXPECT_LE(shape.height_, verbatim_shape.height_);
+  EXPECT_LT(shape.leaf_pages_, verbatim_shape.leaf_pages_);
+  EXPECT_LE(shape.internal_pages_, verbatim_shape.internal_pages_);
+
+  std::vector<int64_t> keys;
+  for (int64_t i = 0; i < num_keys; i++) {
+    keys.push_back(i * 3);
+  }
+  CheckKeys(&tree, keys);
+
+  // Scenario: the loaded tree keeps working with regular inserts and removes.
+  GenericKey<8> index_key;
+  for (int64_t i = 0; i < num_keys; i += 7) {
+    index_key.SetFromInteger(i * 3 + 1);
+    ASSERT_TRUE(tree.Insert(index_key, RID(0, static_cast<uint32_t>(i * 3 + 1))));
+    keys.push_back(i * 3 + 1);
+  }
+  for (int64_t i = 0; i < num_keys; i += 2) {
+    index_key.SetFromInteger(i * 3);
+    tree.Remove(index_key);
+  }
+  keys.erase(std::remove_if(keys.begin(), keys.end(), [](int64_t k) { return k % 3 == 0 && (k / 3) % 2 == 0; }),
+             keys.end());
+  CheckShape<Codec8>(bpm, tree.GetRootPageId());
+  CheckKeys(&tree, keys);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+}
+
+TEST(BPlusTreeCompressedTest, ConcurrentTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  page_id_t page_id;
+  bpm->NewPage(&page_id);
+  CompressedTree8 tree("foo_pk", bpm, comparator);
+
+  // Scenario: threads insert and then remove interleaved keys.
+  const int num_threads = 4;
+  const int64_t keys_per_thread = 5000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&tree, t] {
+      GenericKey<8> index_key;
+      for (int64_t i = 0; i < keys_per_thread; i++) {
+        int64_t key = i * num_threads + t;
+        index_key.SetFromInteger(key);
+        tree.Insert(index_key, RID(0, static_cast<uint32_t>(key)));
+      }
+      for (int64_t i = 0; i < keys_per_thread; i += 2) {
+        index_key.SetFromInteger(i * num_threads + t);
+        tree.Remove(index_key);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::vector<int64_t> keys;
+  for (int64_t i = 1; i < keys_per_thread; i += 2) {
+    for (int t = 0; t < num_threads; t++) {
+      keys.push_back(i * num_threads + t);
+    }
+  }
+  CheckShape<Codec8>(bpm, tree.GetRootPageId());
+  CheckKeys(&tree, keys);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+}
+
+}  // namespace bustub
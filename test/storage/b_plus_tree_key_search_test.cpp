@@ -0,0 +1,168 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_key_search_test.cpp
+//
+// Identification: test/storage/b_plus_tree_key_search_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_plus_tree.h"
+#include "storage/page/b_plus_tree_key_search.h"
+#include "test_util.h"  // NOLINT
+
+namespace bustub {
+
+// Check that the search kernels of the comparator find what the comparator search finds, for every size of the sorted
+// entries and for probes that hit, miss and fall outside the keys.
+template <size_t KeySize, typename Int, typename ValueType>
+void CheckKernels(const std::string &key_column, std::vector<Int> values) {
+  auto key_schema = ParseCreateStatement(key_column);
+  GenericComparator<KeySize> comparator(key_schema.get());
+  ASSERT_EQ(sizeof(Int), comparator.GetIntegerKeySize());
+  using Search = KeySearch<GenericKey<KeySize>, GenericComparator<KeySize>>;
+  using Expected = ComparatorKeySearch<GenericKey<KeySize>, GenericComparator<KeySize>>;
+
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  auto to_key = [](Int value) {
+    GenericKey<KeySize> key;
+    memset(key.data_, 0, KeySize);
+    memcpy(key.data_, &value, sizeof(Int));
+    return key;
+  };
+  std::vector<std::pair<GenericKey<KeySize>, ValueType>> entries;
+  for (Int value : values) {
+    entries.emplace_back(to_key(value), ValueType());
+  }
+
+  std::vector<Int> probes{std::numeric_limits<Int>::max(), std::numeric_limits<Int>::min() + 1};
+  for (Int value : values) {
+    probes.push_back(value);
+    if (value > std::numeric_limits<Int>::min() + 1) {
+      probes.push_back(value - 1);
+    }
+    if (value < std::numeric_limits<Int>::max()) {
+      probes.push_back(value + 1);
+    }
+  }
+  for (int size = 0; size <= static_cast<int>(entries.size()); size++) {
+    for (Int probe : probes) {
+      auto key = to_key(probe);
+      ASSERT_EQ(Expected::LowerBound(entries.data(), size, key, comparator),
+                Search::LowerBound(entries.data(), size, key, comparator))
+          << "size " << size << " probe " << probe;
+      ASSERT_EQ(Expected::UpperBound(entries.data(), size, key, comparator),
+                Search::UpperBound(entries.data(), size, key, comparator))
+          << "size " << size << " probe " << probe;
+    }
+  }
+}
+
+TEST(BPlusTreeKeySearchTest, KernelTest) {
+  std::mt19937_64 random(15445);
+  std::vector<int64_t> bigints{std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min() + 1, -1, 0, 1};
+  std::vector<int32_t> integers{std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::min() + 1, -1, 0, 1};
+  for (int i = 0; i < 150; i++) {
+    bigints.push_back(static_cast<int64_t>(random()) >> (i % 40));
+    integers.push_back(static_cast<int32_t>(random()) >> (i % 20));
+  }
+
+  // Scenario: leaf entries (key & RID) and internal entries (key & page id) have different strides.
+  CheckKernels<8, int64_t, RID>("a bigint", bigints);
+  CheckKernels<8, int64_t, page_id_t>("a bigint", bigints);
+  CheckKernels<16, int64_t, RID>("a bigint", bigints);
+  CheckKernels<4, int32_t, RID>("a integer", integers);
+  CheckKernels<4, int32_t, page_id_t>("a integer", integers);
+  CheckKernels<8, int32_t, RID>("a integer", integers);
+}
+
+TEST(BPlusTreeKeySearchTest, ComparatorTest) {
+  // Scenario: keys that are not a single integer column go through the comparator.
+  auto composite_schema = ParseCreateStatement("a integer,b integer");
+  GenericComparator<8> composite_comparator(composite_schema.get());
+  EXPECT_EQ(0, composite_comparator.GetIntegerKeySize());
+  auto smallint_schema = ParseCreateStatement("a smallint");
+  GenericComparator<8> smallint_comparator(smallint_schema.get());
+  EXPECT_EQ(0, smallint_comparator.GetIntegerKeySize());
+
+  // Scenario: the kernels and the comparator agree on a NULL key, which sorts before every other key.
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  std::vector<std::pair<GenericKey<8>, RID>> entries(3);
+  for (int i = 0; i < 3; i++) {
+    entries[i].first.SetFromInteger(i);
+  }
+  GenericKey<8> null_key;
+  null_key.SetFromInteger(BUSTUB_INT64_NULL);
+  using Search = KeySearch<GenericKey<8>, GenericComparator<8>>;
+  using Expected = ComparatorKeySearch<GenericKey<8>, GenericComparator<8>>;
+  EXPECT_EQ(Expected::LowerBound(entries.data(), 3, null_key, comparator),
+            Search::LowerBound(entries.data(), 3, null_key, comparator));
+  EXPECT_EQ(Expected::UpperBound(entries.data(), 3, null_key, comparator),
+            Search::UpperBound(entries.data(), 3, null_key, comparator));
+  EXPECT_EQ(0, Search::LowerBound(entries.data(), 3, null_key, comparator));
+  EXPECT_FALSE(Search::Equals(entries[1].first, null_key, comparator));
+  EXPECT_TRUE(Search::Equals(null_key, null_key, comparator));
+  EXPECT_GT(0, comparator(null_key, entries[0].first));
+  EXPECT_TRUE(Search::Equals(entries[1].first, entries[1].first, comparator));
+  EXPECT_FALSE(Search::Equals(entries[1].first, entries[2].first, comparator));
+}
+
+TEST(BPlusTreeKeySearchTest, IntegerTreeTest) {
+  auto key_schema = ParseCreateStatement("a integer");
+  GenericComparator<4> comparator(key_schema.get());
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  page_id_t page_id;
+  bpm->NewPage(&page_id);
+  BPlusTree<GenericKey<4>, RID, GenericComparator<4>> tree("foo_pk", bpm, comparator);
+
+  // Scenario: a tree of 4-byte integer keys, negative ones included, finds every key it holds and only those.
+  std::vector<int32_t> keys;
+  for (int32_t key = -5000; key < 5000; key += 2) {
+    keys.push_back(key);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(15445));
+  GenericKey<4> index_key;
+  for (int32_t key : keys) {
+    memcpy(index_key.data_, &key, sizeof(key));
+    ASSERT_TRUE(tree.Insert(index_key, RID(0, static_cast<uint32_t>(key))));
+  }
+  std::vector<RID> rids;
+  for (int32_t key = -5001; key <= 5001; key++) {
+    rids.clear();
+    memcpy(index_key.data_, &key, sizeof(key));
+    bool found = tree.GetValue(index_key, &rids);
+    ASSERT_EQ(key % 2 == 0 && key >= -5000 && key < 5000, found) << key;
+    if (found) {
+      EXPECT_EQ(static_cast<uint32_t>(key), rids[0].GetSlotNum());
+    }
+  }
+  int32_t expected = -5000;
+  for (auto iterator = tree.Begin(); iterator != tree.End(); ++iterator) {
+    EXPECT_EQ(static_cast<uint32_t>(expected), (*iterator).second.GetSlotNum());
+    expected += 2;
+  }
+  EXPECT_EQ(5000, expected);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+}
+
+}  // namespace bustub
@@ -0,0 +1,268 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_posting_test.cpp
+//
+// Identification: test/storage/b_plus_tree_posting_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_plus_tree.h"
+#include "test_util.h"  // NOLINT
+
+namespace bustub {
+
+using Codec8 = VerbatimKeyCodec<GenericKey<8>, GenericComparator<8>>;
+using CompressedCodec8 = CompressedKeyCodec<GenericKey<8>, GenericComparator<8>>;
+using PostingTree8 = BPlusTree<GenericKey<8>, RID, GenericComparator<8>, Codec8, false>;
+using CompressedPostingTree8 = BPlusTree<GenericKey<8>, RID, GenericComparator<8>, CompressedCodec8, false>;
+
+using ExpectedValues = std::map<int64_t, std::vector<RID>>;
+
+// Most keys have a few values, inline or just past them; every tenth key has enough to fill several overflow pages.
+auto ValueCount(int64_t key) -> int { return key % 10 == 0 ? 1200 : static_cast<int>(key % 4) + 1; }
+
+// Every pair of the keys, in random order. The page id of a RID is its key.
+auto MakePairs(int64_t key_count) -> std::vector<std::pair<int64_t, RID>> {
+  std::vector<std::pair<int64_t, RID>> pairs;
+  for (int64_t key = 0; key < key_count; key++) {
+    for (int i = 0; i < ValueCount(key); i++) {
+      pairs.emplace_back(key, RID(static_cast<page_id_t>(key), i));
+    }
+  }
+  std::shuffle(pairs.begin(), pairs.end(), std::mt19937(15445));
+  return pairs;
+}
+
+void SortRids(std::vector<RID> *rids) {
+  std::sort(rids->begin(), rids->end(), [](const RID &lhs, const RID &rhs) { return lhs.Get() < rhs.Get(); });
+}
+
+// Check that GetValue and the iterator find exactly the expected values of every key, and nothing for other keys.
+template <typename TreeType>
+void CheckValues(TreeType *tree, ExpectedValues expected, int64_t key_count) {
+  GenericKey<8> index_key;
+  std::vector<RID> rids;
+  for (int64_t key = 0; key < key_count; key++) {
+    rids.clear();
+    index_key.SetFromInteger(key);
+    bool found = tree->GetValue(index_key, &rids);
+    auto it = expected.find(key);
+    ASSERT_EQ(it != expected.end(), found) << key;
+    if (found) {
+      SortRids(&rids);
+      SortRids(&it->second);
+      ASSERT_EQ(it->second, rids) << key;
+    }
+  }
+
+  // the iterator yields every value of a key before moving on to the next key
+  ExpectedValues iterated;
+  int64_t last_key = -1;
+  for (auto iterator = tree->Begin(); iterator != tree->End(); ++iterator) {
+    const RID &rid = (*iterator).second;
+    int64_t key = rid.GetPageId();
+    ASSERT_LE(last_key, key);
+    if (key != last_key) {
+      ASSERT_EQ(0, iterated.count(key));
+    }
+    last_key = key;
+    iterated[key].push_back(rid);
+  }
+  for (auto &[key, values] : iterated) {
+    SortRids(&values);
+  }
+  EXPECT_EQ(expected, iterated);
+}
+
+template <typename TreeType>
+void InsertRemove(int leaf_max_size, int internal_max_size) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  // a small pool: a pin leaked by a posting list soon makes the tree run out of frames
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  page_id_t page_id;
+  bpm->NewPage(&page_id);
+
+  {
+    TreeType tree("foo_pk", bpm, comparator, leaf_max_size, internal_max_size);
+    const int64_t key_count = 60;
+    GenericKey<8> index_key;
+    ExpectedValues expected;
+    auto pairs = MakePairs(key_count);
+
+    // Scenario: insert every pair; a key that is already there takes one more value.
+    for (const auto &[key, rid] : pairs) {
+      index_key.SetFromInteger(key);
+      ASSERT_TRUE(tree.Insert(index_key, rid));
+      expected[key].push_back(rid);
+    }
+    CheckValues(&tree, expected, key_count);
+
+    // Scenario: remove every other value of every key, which keeps the keys, and pairs that are not in the tree.
+    for (auto &[key, values] : expected) {
+      index_key.SetFromInteger(key);
+      std::vector<RID> kept;
+      for (size_t i = 0; i < values.size(); i++) {
+        if (i % 2 == 1) {
+          tree.Remove(index_key, values[i]);
+        } else {
+          kept.push_back(values[i]);
+        }
+      }
+      tree.Remove(index_key, RID(-1, 0));
+      values = kept;
+    }
+    CheckValues(&tree, expected, key_count);
+
+    // Scenario: remove whole keys, with all their values.
+    for (int64_t key = 0; key < key_count; key += 3) {
+      index_key.SetFromInteger(key);
+      tree.Remove(index_key);
+      expected.erase(key);
+    }
+    CheckValues(&tree, expected, key_count);
+
+    // Scenario: remove the remaining values one by one, which removes their keys with the last ones.
+    for (const auto &[key, values] : expected) {
+      index_key.SetFromInteger(key);
+      for (const auto &rid : values) {
+        tree.Remove(index_key, rid);
+      }
+    }
+    CheckValues(&tree, {}, key_count);
+    EXPECT_TRUE(tree.IsEmpty());
+  }
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+}
+
+TEST(BPlusTreePostingTest, InsertRemoveTest) {
+  // the leaf page clamps the size to the entries it can hold
+  InsertRemove<PostingTree8>(BUSTUB_PAGE_SIZE, 255);
+  // small pages split, merge and redistribute entries, posting lists included
+  InsertRemove<PostingTree8>(4, 4);
+  InsertRemove<CompressedPostingTree8>(BUSTUB_PAGE_SIZE, 255);
+}
+
+TEST(BPlusTreePostingTest, BulkLoadTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  page_id_t page_id;
+  bpm->NewPage(&page_id);
+
+  {
+    // Scenario: a bulk load keeps every value of a key, and the tree takes more values afterwards.
+    PostingTree8 tree("foo_pk", bpm, comparator, 5, 5);
+    const int64_t key_count = 100;
+    auto pairs = MakePairs(key_count);
+    std::stable_sort(pairs.begin(), pairs.end(),
+                     [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+    ExpectedValues expected;
+    for (const auto &[key, rid] : pairs) {
+      expected[key].push_back(rid);
+    }
+    auto it = pairs.begin();
+    ASSERT_TRUE(tree.BulkLoad([&it, &pairs](std::pair<GenericKey<8>, RID> *item) {
+      if (it == pairs.end()) {
+        return false;
+      }
+      item->first.SetFromInteger(it->first);
+      item->second = it->second;
+      ++it;
+      return true;
+    }));
+    CheckValues(&tree, expected, key_count);
+
+    GenericKey<8> index_key;
+    for (int64_t key = 0; key < key_count; key += 7) {
+      index_key.SetFromInteger(key);
+      RID rid(static_cast<page_id_t>(key), 5000);
+      ASSERT_TRUE(tree.Insert(index_key, rid));
+      expected[key].push_back(rid);
+    }
+    CheckValues(&tree, expected, key_count);
+  }
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+}
+
+TEST(BPlusTreePostingTest, ConcurrentTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  page_id_t page_id;
+  bpm->NewPage(&page_id);
+
+  {
+    // Scenario: threads add values to the same few keys at once, then remove some of them at once.
+    PostingTree8 tree("foo_pk", bpm, comparator, 4, 4);
+    const int thread_count = 4;
+    const int64_t key_count = 8;
+    const int values_per_thread = 300;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; t++) {
+      threads.emplace_back([&tree, t] {
+        GenericKey<8> index_key;
+        for (int i = 0; i < values_per_thread; i++) {
+          int64_t key = i % key_count;
+          index_key.SetFromInteger(key);
+          tree.Insert(index_key, RID(static_cast<page_id_t>(key), t * values_per_thread + i));
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    threads.clear();
+    for (int t = 0; t < thread_count; t++) {
+      threads.emplace_back([&tree, t] {
+        GenericKey<8> index_key;
+        for (int i = 0; i < values_per_thread; i += 2) {
+          int64_t key = i % key_count;
+          index_key.SetFromInteger(key);
+          tree.Remove(index_key, RID(static_cast<page_id_t>(key), t * values_per_thread + i));
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    ExpectedValues expected;
+    for (int t = 0; t < thread_count; t++) {
+      for (int i = 1; i < values_per_thread; i += 2) {
+        int64_t key = i % key_count;
+        expected[key].push_back(RID(static_cast<page_id_t>(key), t * values_per_thread + i));
+      }
+    }
+    CheckValues(&tree, expected, key_count);
+  }
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+}
+
+}  // namespace bustub
@@ -0,0 +1,230 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_range_iterator_test.cpp
+//
+// Identification: test/storage/b_plus_tree_range_iterator_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_plus_tree.h"
+#include "test_util.h"  // NOLINT
+
+namespace bustub {
+
+using Codec8 = VerbatimKeyCodec<GenericKey<8>, GenericComparator<8>>;
+using CompressedCodec8 = CompressedKeyCodec<GenericKey<8>, GenericComparator<8>>;
+using Tree8 = BPlusTree<GenericKey<8>, RID, GenericComparator<8>>;
+using CompressedTree8 = BPlusTree<GenericKey<8>, RID, GenericComparator<8>, CompressedCodec8>;
+using PostingTree8 = BPlusTree<GenericKey<8>, RID, GenericComparator<8>, Codec8, false>;
+
+// The keys of the range, in the order the tree iterates them. The slot number of a RID is its key.
+template <typename TreeType>
+auto Scan(TreeType *tree, std::optional<int64_t> low, std::optional<int64_t> high, ScanDirection direction)
+    -> std::vector<int64_t> {
+  GenericKey<8> low_key;
+  GenericKey<8> high_key;
+  if (low.has_value()) {
+    low_key.SetFromInteger(*low);
+  }
+  if (high.has_value()) {
+    high_key.SetFromInteger(*high);
+  }
+  std::vector<int64_t> keys;
+  for (auto iterator = tree->Range(low.has_value() ? &low_key : nullptr, high.has_value() ? &high_key : nullptr,
+                                   direction, true);
+       !iterator.IsEnd(); ++iterator) {
+    keys.push_back((*iterator).second.GetSlotNum());
+  }
+  return keys;
+}
+
+template <typename TreeType>
+void RangeScan(int leaf_max_size, int internal_max_size) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  page_id_t page_id;
+  bpm->NewPage(&page_id);
+
+  {
+    TreeType tree("foo_pk", bpm, comparator, leaf_max_size, internal_max_size);
+    const int64_t key_count = 300;
+    GenericKey<8> index_key;
+
+    // Scenario: an empty tree has nothing to scan in either direction.
+    EXPECT_TRUE(tree.RBegin().IsEnd());
+    EXPECT_TRUE(Scan(&tree, 3, 10, ScanDirection::BACKWARD).empty());
+
+    // the tree holds the even keys, so that the ends of a range may or may not be in the tree
+    for (int64_t key = 0; key < key_count; key += 2) {
+      index_key.SetFromInteger(key);
+      ASSERT_TRUE(tree.Insert(index_key, RID(0, static_cast<uint32_t>(key))));
+    }
+
+    // Scenario: every range of the tree, open or not at each end, holds the keys from low up to but not including
+    // high, forward and backward.
+    std::vector<std::optional<int64_t>> ends{std::nullopt, -5, 0, 1, 2, 7, 8, 99, 100, 151, 298, 299, 400};
+    for (const auto &low : ends) {
+      for (const auto &high : ends) {
+        std::vector<int64_t> expected;
+        for (int64_t key = 0; key < key_count; key += 2) {
+          if ((!low.has_value() || key >= *low) && (!high.has_value() || key < *high)) {
+            expected.push_back(key);
+          }
+        }
+        ASSERT_EQ(expected, Scan(&tree, low, high, ScanDirection::FORWARD));
+        std::vector<int64_t> reversed(expected.rbegin(), expected.rend());
+        ASSERT_EQ(reversed, Scan(&tree, low, high, ScanDirection::BACKWARD));
+      }
+    }
+
+    // Scenario: RBegin walks the whole tree backward.
+    int64_t expected_key = key_count - 2;
+    for (auto iterator = tree.RBegin(); !iterator.IsEnd(); ++iterator) {
+      ASSERT_EQ(expected_key, (*iterator).second.GetSlotNum());
+      expected_key -= 2;
+    }
+    EXPECT_EQ(-2, expected_key);
+
+    // Scenario: after removing keys, which merges leaves, the links between leaves still hold in both directions.
+    for (int64_t key = 0; key < key_count; key += 6) {
+      index_key.SetFromInteger(key);
+      tree.Remove(index_key);
+    }
+    std::vector<int64_t> expected;
+    for (int64_t key = 0; key < key_count; key += 2) {
+      if (key % 6 != 0) {
+        expected.push_back(key);
+      }
+    }
+    EXPECT_EQ(expected, Scan(&tree, std::nullopt, std::nullopt, ScanDirection::FORWARD));
+    std::vector<int64_t> reversed(expected.rbegin(), expected.rend());
+    EXPECT_EQ(reversed, Scan(&tree, std::nullopt, std::nullopt, ScanDirection::BACKWARD));
+  }
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+}
+
+TEST(BPlusTreeRangeIteratorTest, RangeScanTest) {
+  RangeScan<Tree8>(4, 4);
+  RangeScan<Tree8>(255, 255);
+  RangeScan<CompressedTree8>(4, 4);
+  RangeScan<PostingTree8>(4, 4);
+}
+
+TEST(BPlusTreeRangeIteratorTest, BulkLoadTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  page_id_t page_id;
+  bpm->NewPage(&page_id);
+
+  {
+    // Scenario: the leaves of a bulk loaded tree are linked backward too.
+    Tree8 tree("foo_pk", bpm, comparator, 5, 5);
+    const int64_t key_count = 200;
+    int64_t next_key = 0;
+    ASSERT_TRUE(tree.BulkLoad([&next_key](std::pair<GenericKey<8>, RID> *item) {
+      if (next_key == key_count) {
+        return false;
+      }
+      item->first.SetFromInteger(next_key);
+      item->second = RID(0, static_cast<uint32_t>(next_key));
+      next_key++;
+      return true;
+    }));
+    std::vector<int64_t> expected;
+    for (int64_t key = 149; key >= 20; key--) {
+      expected.push_back(key);
+    }
+    EXPECT_EQ(expected, Scan(&tree, 20, 150, ScanDirection::BACKWARD));
+  }
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+}
+
+TEST(BPlusTreeRangeIteratorTest, ConcurrentScanTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  page_id_t page_id;
+  bpm->NewPage(&page_id);
+
+  {
+    // Scenario: scans in both directions run while a writer inserts and removes the odd keys, which splits and merges
+    // the leaves under them. Every scan sees every even key exactly once, in order.
+    Tree8 tree("foo_pk", bpm, comparator, 4, 4);
+    const int64_t key_count = 1000;
+    GenericKey<8> index_key;
+    for (int64_t key = 0; key < key_count; key += 2) {
+      index_key.SetFromInteger(key);
+      ASSERT_TRUE(tree.Insert(index_key, RID(0, static_cast<uint32_t>(key))));
+    }
+
+    std::atomic<bool> done{false};
+    std::thread writer([&tree, &done] {
+      GenericKey<8> key;
+      for (int round = 0; round < 3; round++) {
+        for (int64_t odd_key = 1; odd_key < key_count; odd_key += 2) {
+          key.SetFromInteger(odd_key);
+          tree.Insert(key, RID(0, static_cast<uint32_t>(odd_key)));
+        }
+        for (int64_t odd_key = 1; odd_key < key_count; odd_key += 2) {
+          key.SetFromInteger(odd_key);
+          tree.Remove(key);
+        }
+      }
+      done = true;
+    });
+
+    // the scans only record a failure, since the writer must be joined before the test returns
+    int scans = 0;
+    bool in_order = true;
+    int64_t even_keys = 400;
+    while ((!done || scans == 0) && in_order && even_keys == 400) {
+      int64_t last_key = 900;
+      even_keys = 0;
+      // a forward scan is checked backward too
+      auto direction = scans % 2 == 0 ? ScanDirection::BACKWARD : ScanDirection::FORWARD;
+      std::vector<int64_t> keys = Scan(&tree, 100, 900, direction);
+      if (scans % 2 == 1) {
+        std::reverse(keys.begin(), keys.end());
+      }
+      for (int64_t key : keys) {
+        in_order = in_order && key < last_key && key >= 100;
+        last_key = key;
+        even_keys += key % 2 == 0 ? 1 : 0;
+      }
+      scans++;
+    }
+    writer.join();
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(400, even_keys);
+  }
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+}
+
+}  // namespace bustub
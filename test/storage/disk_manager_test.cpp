@@ -10,11 +10,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <cstdint>
 #include <cstring>
 
 #include "common/exception.h"
 #include "gtest/gtest.h"
 #include "storage/disk/disk_manager.h"
+#include "storage/page/page.h"
 
 namespace bustub {
 
@@ -55,6 +57,42 @@ TEST_F(DiskManagerTest, ReadWritePageTest) {
   dm.ShutDown();
 }
 
+// NOLINTNEXTLINE
+TEST_F(DiskManagerTest, DirectIOReadWritePageTest) {
+  // unaligned caller buffers must work even when the file is opened with O_DIRECT
+  char buf[BUSTUB_PAGE_SIZE + 1] = {0};
+  char data[BUSTUB_PAGE_SIZE + 1] = {0};
+  std::string db_file("test.db");
+  auto dm = DiskManager(db_file, true);
+  std::strncpy(data + 1, "A test string.", BUSTUB_PAGE_SIZE);
+
+  dm.WritePage(3, data + 1);
+  dm.ReadPage(3, buf + 1);
+  EXPECT_EQ(std::memcmp(buf + 1, data + 1, BUSTUB_PAGE_SIZE), 0);
+
+  // page buffers are aligned and go to disk as they are
+  Page page;
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(page.GetData()) % BUSTUB_PAGE_ALIGNMENT, 0);
+  dm.ReadPage(3, page.GetData());
+  EXPECT_EQ(std::memcmp(page.GetData(), data + 1, BUSTUB_PAGE_SIZE), 0);
+
+  // pages before the last written one read back as zeros
+  dm.ReadPage(1, page.GetData());
+  EXPECT_EQ(page.GetData()[0], 0);
+
+  dm.SyncDb();
+  EXPECT_EQ(dm.GetNumSyncs(), 1);
+  EXPECT_EQ(dm.GetNumWrites(), 1);
+  dm.ShutDown();
+
+  // the file size is picked up again when reopening
+  auto dm2 = DiskManager(db_file);
+  std::memset(buf, 0, sizeof(buf));
+  dm2.ReadPage(3, buf);
+  EXPECT_EQ(std::memcmp(buf, data + 1, BUSTUB_PAGE_SIZE), 0);
+  dm2.ShutDown();
+}
+
 // NOLINTNEXTLINE
 TEST_F(DiskManagerTest, ReadWriteLogTest) {
   char buf[16] = {0};
@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// disk_scheduler_test.cpp
+//
+// Identification: test/storage/disk_scheduler_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/disk/disk_scheduler.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(DiskSchedulerTest, ScheduleWriteReadPageTest) {
+  char buf[BUSTUB_PAGE_SIZE] = {0};
+  char data[BUSTUB_PAGE_SIZE] = {0};
+
+  auto dm = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto disk_scheduler = std::make_unique<DiskScheduler>(dm.get());
+
+  std::strncpy(data, "A test string.", sizeof(data));
+
+  auto promise1 = disk_scheduler->CreatePromise();
+  auto future1 = promise1.get_future();
+  auto promise2 = disk_scheduler->CreatePromise();
+  auto future2 = promise2.get_future();
+
+  disk_scheduler->Schedule({/*is_write=*/true, data, /*page_id=*/0, std::move(promise1)});
+  disk_scheduler->Schedule({/*is_write=*/false, buf, /*page_id=*/0, std::move(promise2)});
+
+  ASSERT_TRUE(future1.get());
+  ASSERT_TRUE(future2.get());
+  ASSERT_EQ(std::memcmp(buf, data, sizeof(buf)), 0);
+
+  disk_scheduler = nullptr;  // Call the DiskScheduler destructor to finish all scheduled jobs.
+  dm->ShutDown();
+}
+
+// NOLINTNEXTLINE
+TEST(DiskSchedulerTest, MultipleWorkersTest) {
+  const size_t num_pages = 64;
+  auto dm = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto disk_scheduler = std::make_unique<DiskScheduler>(dm.get(), 4);
+  ASSERT_EQ(4, disk_scheduler->GetNumWorkers());
+
+  // Scenario: a write followed by a read of the same page always observes the write, even though requests on
+  // different pages are executed by different workers.
+  std::vector<std::vector<char>> data(num_pages, std::vector<char>(BUSTUB_PAGE_SIZE));
+  std::vector<std::vector<char>> buf(num_pages, std::vector<char>(BUSTUB_PAGE_SIZE));
+  std::vector<std::future<bool>> futures;
+  for (size_t i = 0; i < num_pages; i++) {
+    snprintf(data[i].data(), BUSTUB_PAGE_SIZE, "page %zu", i);
+    futures.emplace_back(disk_scheduler->ScheduleWrite(static_cast<page_id_t>(i), data[i].data()));
+    futures.emplace_back(disk_scheduler->ScheduleRead(static_cast<page_id_t>(i), buf[i].data()));
+  }
+  for (auto &future : futures) {
+    ASSERT_TRUE(future.get());
+  }
+  for (size_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(data[i], buf[i]);
+  }
+}
+
+/** A backend that records the page ids of every batch it executes. */
+class RecordingBackend : public DiskSchedulerBackend {
+ public:
+  void Execute(std::vector<DiskRequest> *batch) override {
+    std::scoped_lock<std::mutex> lock(latch_);
+    for (auto &r : *batch) {
+      order_.push_back(r.page_id_);
+      r.callback_.set_value(true);
+    }
+  }
+
+  std::mutex latch_;
+  std::vector<page_id_t> order_;
+};
+
+// NOLINTNEXTLINE
+TEST(DiskSchedulerTest, BatchOrderTest) {
+  auto backend = std::make_unique<RecordingBackend>();
+  auto *recorder = backend.get();
+  auto disk_scheduler = std::make_unique<DiskScheduler>(std::move(backend));
+
+  char buf[BUSTUB_PAGE_SIZE] = {0};
+  std::vector<std::future<bool>> futures;
+  for (page_id_t page_id : {9, 3, 7, 1, 5}) {
+    futures.emplace_back(disk_scheduler->ScheduleRead(page_id, buf));
+  }
+  for (auto &future : futures) {
+    ASSERT_TRUE(future.get());
+  }
+
+  // Scenario: every request is executed exactly once. Requests that were pending at the same time are issued in
+  // page order, so the recorded order is sorted within each batch.
+  ASSERT_EQ(5, recorder->order_.size());
+  std::vector<page_id_t> sorted = recorder->order_;
+  std::sort(sorted.begin(), sorted.end());
+  ASSERT_EQ((std::vector<page_id_t>{1, 3, 5, 7, 9}), sorted);
+}
+
+}  // namespace bustub
@@ -0,0 +1,65 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// spill_partitions_test.cpp
+//
+// Identification: test/storage/spill_partitions_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/table/spill_partitions.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(SpillPartitionsTest, PartitionAndPopTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(16, disk_manager.get());
+  SpillPartitions partitions(bpm.get(), 2);
+  ASSERT_TRUE(partitions.CanSpill());
+  ASSERT_FALSE(SpillPartitions(nullptr, 2).CanSpill());
+
+  Schema schema({Column{"a", TypeId::INTEGER}});
+  auto parts = partitions.MakePartitions(0);
+  ASSERT_EQ(4U, parts.size());
+  const int num_tuples = 1000;
+  std::vector<size_t> sizes(parts.size());
+  for (int i = 0; i < num_tuples; i++) {
+    Value value = ValueFactory::GetIntegerValue(i);
+    size_t index = partitions.PartitionOf(HashUtil::HashValue(&value), 0);
+    ASSERT_LT(index, parts.size());
+    parts[index].files_[0]->Append(Tuple({value}, &schema));
+    sizes[index]++;
+  }
+  // Only the partition of key 0 has a tuple in its second file, so it is the only one kept.
+  Value zero = ValueFactory::GetIntegerValue(0);
+  size_t kept = partitions.PartitionOf(HashUtil::HashValue(&zero), 0);
+  parts[kept].files_[1]->Append(Tuple({zero}, &schema));
+  partitions.AddPending(&parts, [](const SpillPartitions::Partition &part) { return part.files_[1]->Size() > 0; });
+
+  // The keys of the partition are spread over several partitions at the next depth.
+  SpillPartitions::Partition part;
+  ASSERT_TRUE(partitions.PopPending(&part));
+  ASSERT_EQ(sizes[kept], part.files_[0]->Size());
+  std::set<size_t> deeper;
+  TmpTupleFile::Reader reader(part.files_[0].get());
+  Tuple tuple;
+  while (reader.Next(&tuple)) {
+    Value value = tuple.GetValue(&schema, 0);
+    ASSERT_EQ(kept, partitions.PartitionOf(HashUtil::HashValue(&value), 0));
+    deeper.insert(partitions.PartitionOf(HashUtil::HashValue(&value), 1));
+  }
+  ASSERT_GT(deeper.size(), 1U);
+  ASSERT_FALSE(partitions.PopPending(&part));
+}
+
+}  // namespace bustub
@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file_test.cpp
+//
+// Identification: test/storage/tmp_tuple_file_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/table/tmp_tuple_file.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(TmpTupleFileTest, AppendAndReadTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  // Fewer frames than the files have pages, so that the pages are written out and read back.
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(8, disk_manager.get());
+
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 128}});
+  const int num_tuples = 5000;
+  const int num_files = 4;
+  std::vector<std::unique_ptr<TmpTupleFile>> files;
+  for (int i = 0; i < num_files; i++) {
+    files.emplace_back(std::make_unique<TmpTupleFile>(bpm.get()));
+  }
+  for (int i = 0; i < num_tuples; i++) {
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::to_string(i))}, &schema);
+    files[i % num_files]->Append(tuple);
+  }
+  for (auto &file : files) {
+    file->FinishAppending();
+    ASSERT_EQ(static_cast<size_t>(num_tuples / num_files), file->Size());
+    ASSERT_GT(file->PageCount(), 8U);
+  }
+
+  // The tuples of a file come back in the order they were appended.
+  for (int f = 0; f < num_files; f++) {
+    TmpTupleFile::Reader reader(files[f].get());
+    Tuple tuple;
+    int expected = f;
+    while (reader.Next(&tuple)) {
+      ASSERT_EQ(expected, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+      ASSERT_EQ(std::to_string(expected), tuple.GetValue(&schema, 1).ToString());
+      expected += num_files;
+    }
+    ASSERT_EQ(num_tuples + f, expected);
+  }
+
+  // Deleting the files frees their pages, and every frame is free again.
+  files.clear();
+  for (int i = 0; i < 8; i++) {
+    page_id_t page_id;
+    ASSERT_NE(nullptr, bpm->NewPage(&page_id));
+  }
+}
+
+}  // namespace bustub
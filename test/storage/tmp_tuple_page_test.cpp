@@ -19,11 +19,7 @@
 namespace bustub {
 
 // NOLINTNEXTLINE
-TEST(TmpTuplePageTest, DISABLED_BasicTest) {
-  // There are many ways to do this assignment, and this is only one of them.
-  // If you don't like the TmpTuplePage idea, please feel free to delete this test case entirely.
-  // You will get full credit as long as you are correctly using a linear probe hash table.
-
+TEST(TmpTuplePageTest, BasicTest) {
   TmpTuplePage page{};
   page_id_t page_id = 15445;
   page.Init(page_id, BUSTUB_PAGE_SIZE);
@@ -46,6 +42,19 @@ TEST(TmpTuplePageTest, DISABLED_BasicTest) {
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + sizeof(page_id_t) + sizeof(lsn_t)), BUSTUB_PAGE_SIZE - 8);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + BUSTUB_PAGE_SIZE - 8), 4);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + BUSTUB_PAGE_SIZE - 4), 123);
+  ASSERT_EQ(page_id, tmp_tuple.GetPageId());
+  ASSERT_EQ(BUSTUB_PAGE_SIZE - 8, tmp_tuple.GetOffset());
+
+  Tuple result;
+  page.Get(tmp_tuple, &result);
+  ASSERT_EQ(123, result.GetValue(&schema, 0).GetAs<int32_t>());
+
+  // Fill the page up: every tuple takes 8 bytes after the 12 bytes of the header.
+  size_t inserted = 1;
+  while (page.Insert(tuple, &tmp_tuple)) {
+    inserted++;
+  }
+  ASSERT_EQ((BUSTUB_PAGE_SIZE - 12) / 8, inserted);
 }
 
 }  // namespace bustub
@@ -19,12 +19,13 @@
 #include "buffer/buffer_pool_manager_instance.h"
 #include "gtest/gtest.h"
 #include "logging/common.h"
+#include "storage/disk/disk_manager_memory.h"
 #include "storage/table/table_heap.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 // NOLINTNEXTLINE
-TEST(TupleTest, DISABLED_TableHeapTest) {
+TEST(TupleTest, TableHeapTest) {
   // test1: parse create sql statement
   std::string create_stmt = "a varchar(20), b smallint, c bigint, d bool, e varchar(16)";
   Column col1{"a", TypeId::VARCHAR, 20};
@@ -52,10 +53,13 @@ TEST(TupleTest, DISABLED_TableHeapTest) {
   }
 
   TableIterator itr = table->Begin(transaction);
+  size_t num_tuples = 0;
   while (itr != table->End()) {
     // std::cout << itr->ToString(schema) << std::endl;
     ++itr;
+    ++num_tuples;
   }
+  EXPECT_EQ(rid_v.size(), num_tuples);
 
   // int i = 0;
   std::shuffle(rid_v.begin(), rid_v.end(), std::default_random_engine(0));
@@ -68,7 +72,76 @@ TEST(TupleTest, DISABLED_TableHeapTest) {
   remove("test.log");
   delete table;
   delete buffer_pool_manager;
+  delete log_manager;
+  delete lock_manager;
   delete disk_manager;
+  delete transaction;
+}
+
+// NOLINTNEXTLINE
+TEST(TupleTest, TableHeapReadAheadTest) {
+  Column col1{"a", TypeId::VARCHAR, 20};
+  Column col2{"b", TypeId::BIGINT};
+  std::vector<Column> cols{col1, col2};
+  Schema schema{cols};
+  Tuple tuple = ConstructTuple(&schema);
+
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *buffer_pool_manager = new BufferPoolManagerInstance(16, disk_manager);
+  auto *lock_manager = new LockManager();
+  auto *log_manager = new LogManager(disk_manager);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, log_manager, transaction);
+
+  // fill a table that is three times as large as the buffer pool
+  RID rid;
+  size_t num_inserted = 0;
+  do {
+    ASSERT_TRUE(table->InsertTuple(tuple, &rid, transaction));
+    ++num_inserted;
+  } while (rid.GetPageId() < 48);
+
+  size_t num_tuples = 0;
+  for (auto itr = table->Begin(transaction); itr != table->End(); ++itr) {
+    ++num_tuples;
+  }
+  EXPECT_EQ(num_inserted, num_tuples);
+  // the pages of the heap have consecutive ids, so the scan finds most of them already read ahead
+  EXPECT_GT(buffer_pool_manager->GetNumPrefetchHits(), 24);
+
+  // the pages of a second heap interleave with pages of another heap and with pages that were deleted before they were
+  // ever written, the scan only reads ahead the pages of its own heap
+  auto *other_table = new TableHeap(buffer_pool_manager, lock_manager, log_manager, transaction);
+  auto *interleaved_table = new TableHeap(buffer_pool_manager, lock_manager, log_manager, transaction);
+  std::vector<page_id_t> interleaved_page_ids{interleaved_table->GetFirstPageId()};
+  while (interleaved_page_ids.size() < 48) {
+    ASSERT_TRUE(interleaved_table->InsertTuple(tuple, &rid, transaction));
+    if (rid.GetPageId() != interleaved_page_ids.back()) {
+      interleaved_page_ids.push_back(rid.GetPageId());
+      page_id_t temp_page_id;
+      ASSERT_NE(nullptr, buffer_pool_manager->NewPage(&temp_page_id));
+      ASSERT_TRUE(buffer_pool_manager->UnpinPage(temp_page_id, false));
+      ASSERT_TRUE(buffer_pool_manager->DeletePage(temp_page_id));
+      ASSERT_TRUE(other_table->InsertTuple(tuple, &rid, transaction));
+    }
+  }
+  size_t num_prefetched = buffer_pool_manager->GetNumPagesPrefetched();
+  size_t num_prefetch_hits = buffer_pool_manager->GetNumPrefetchHits();
+  for (auto itr = interleaved_table->Begin(transaction); itr != interleaved_table->End(); ++itr) {
+  }
+  EXPECT_LE(buffer_pool_manager->GetNumPagesPrefetched() - num_prefetched, interleaved_page_ids.size());
+  EXPECT_EQ(buffer_pool_manager->GetNumPagesPrefetched() - num_prefetched,
+            buffer_pool_manager->GetNumPrefetchHits() - num_prefetch_hits);
+  EXPECT_GT(buffer_pool_manager->GetNumPrefetchHits() - num_prefetch_hits, 24);
+
+  delete interleaved_table;
+  delete other_table;
+  delete table;
+  delete buffer_pool_manager;
+  delete log_manager;
+  delete lock_manager;
+  delete disk_manager;
+  delete transaction;
 }
 
 }  // namespace bustub
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "buffer/buffer_pool_manager_instance.h"
+#include "fmt/core.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_plus_tree.h"
+#include "storage/page/b_plus_tree_key_search.h"
+#include "test_util.h"  // NOLINT
+
+namespace {
+
+using KeyType = bustub::GenericKey<8>;
+using ComparatorType = bustub::GenericComparator<8>;
+using TreeType = bustub::BPlusTree<KeyType, bustub::RID, ComparatorType>;
+using CodecType = bustub::CompressedKeyCodec<KeyType, ComparatorType>;
+using CompressedTreeType = bustub::BPlusTree<KeyType, bustub::RID, ComparatorType, CodecType>;
+using InternalPage = bustub::BPlusTreeInternalPage<KeyType, bustub::page_id_t, ComparatorType>;
+using LeafPage = bustub::BPlusTreeLeafPage<KeyType, bustub::RID, ComparatorType>;
+
+/** The page sizes the tree uses by default: LEAF_PAGE_SIZE and INTERNAL_PAGE_SIZE for these key and value types. */
+constexpr int DEFAULT_LEAF_SIZE =
+    (bustub::BUSTUB_PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / sizeof(std::pair<KeyType, bustub::RID>);
+constexpr int DEFAULT_INTERNAL_SIZE =
+    (bustub::BUSTUB_PAGE_SIZE - INTERNAL_PAGE_HEADER_SIZE) / sizeof(std::pair<KeyType, bustub::page_id_t>);
+
+/**
+ * A point lookup the way BPlusTree::GetValue did it before optimistic latch coupling: read latch every page from the
+ * root down, releasing the parent once the child is latched. Kept here as the baseline GetValue is measured against.
+ */
+auto LatchCouplingLookup(bustub::BufferPoolManager *bpm, bustub::page_id_t root_page_id, const KeyType &key,
+                         const ComparatorType &comparator, bustub::RID *rid) -> bool {
+  bustub::Page *page = bpm->FetchPage(root_page_id);
+  page->RLatch();
+  auto *node = reinterpret_cast<bustub::BPlusTreePage *>(page->GetData());
+  while (!node->IsLeafPage()) {
+    bustub::page_id_t child_page_id = reinterpret_cast<InternalPage *>(node)->Lookup(key, comparator);
+    bustub::Page *child_page = bpm->FetchPage(child_page_id);
+    child_page->RLatch();
+    page->RUnlatch();
+    bpm->UnpinPage(page->GetPageId(), false);
+    page = child_page;
+    node = reinterpret_cast<bustub::BPlusTreePage *>(page->GetData());
+  }
+  bool found = reinterpret_cast<LeafPage *>(node)->Lookup(key, rid, comparator);
+  page->RUnlatch();
+  bpm->UnpinPage(page->GetPageId(), false);
+  return found;
+}
+
+/** The height and the number of leaf and internal pages of a tree. */
+struct TreeFootprint {
+  int height_{0};
+  size_t leaf_pages_{0};
+  size_t internal_pages_{0};
+};
+
+template <typename Leaf, typename Internal>
+void MeasureSubtree(bustub::BufferPoolManager *bpm, bustub::page_id_t page_id, int depth, TreeFootprint *footprint) {
+  bustub::Page *page = bpm->FetchPage(page_id);
+  auto *node = reinterpret_cast<bustub::BPlusTreePage *>(page->GetData());
+  if (node->IsLeafPage()) {
+    footprint->height_ = std::max(footprint->height_, depth + 1);
+    footprint->leaf_pages_++;
+  } else {
+    footprint->internal_pages_++;
+    auto *internal = reinterpret_cast<Internal *>(node);
+    for (int i = 0; i < internal->GetSize(); i++) {
+      MeasureSubtree<Leaf, Internal>(bpm, internal->ValueAt(i), depth + 1, footprint);
+    }
+  }
+  bpm->UnpinPage(page_id, false);
+}
+
+template <typename Leaf, typename Internal>
+auto Measure(bustub::BufferPoolManager *bpm, bustub::page_id_t root_page_id) -> TreeFootprint {
+  TreeFootprint footprint;
+  if (root_page_id != bustub::INVALID_PAGE_ID) {
+    MeasureSubtree<Leaf, Internal>(bpm, root_page_id, 0, &footprint);
+  }
+  return footprint;
+}
+
+/**
+ * Run num_threads threads that each look up num_lookups uniformly random keys out of [0, num_keys).
+ * @return the lookups per second over all threads
+ */
+template <typename Lookup>
+auto RunLookups(size_t num_threads, size_t num_lookups, int64_t num_keys, Lookup lookup) -> double {
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([t, num_lookups, num_keys, &lookup] {
+      std::mt19937_64 gen(t);
+      std::uniform_int_distribution<int64_t> key_dist(0, num_keys - 1);
+      KeyType key;
+      for (size_t i = 0; i < num_lookups; i++) {
+        int64_t k = key_dist(gen);
+        key.SetFromInteger(k);
+        if (!lookup(key)) {
+          std::cerr << "key " << k << " not found" << std::endl;
+          exit(1);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return static_cast<double>(num_threads * num_lookups) / elapsed;
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-btree-bench");
+  program.add_argument("--keys").help("keys in the tree, default 100000");
+  program.add_argument("--threads").help("comma-separated thread counts, default 1,2,4,8");
+  program.add_argument("--lookups").help("lookups per thread, default 200000");
+  program.add_argument("--leaf-size").help("leaf max size, default the page capacity");
+  program.add_argument("--internal-size").help("internal max size, default the page capacity");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  std::vector<size_t> thread_counts{1, 2, 4, 8};
+  if (program.present("--threads")) {
+    thread_counts.clear();
+    std::string threads = program.get("--threads");
+    size_t pos = 0;
+    while (pos < threads.size()) {
+      size_t comma = threads.find(',', pos);
+      if (comma == std::string::npos) {
+        comma = threads.size();
+      }
+      thread_counts.push_back(std::stoull(threads.substr(pos, comma - pos)));
+      pos = comma + 1;
+    }
+  }
+  int64_t num_keys = program.present("--keys") ? std::stoll(program.get("--keys")) : 100000;
+  size_t num_lookups = program.present("--lookups") ? std::stoull(program.get("--lookups")) : 200000;
+  int leaf_size = program.present("--leaf-size") ? std::stoi(program.get("--leaf-size")) : DEFAULT_LEAF_SIZE;
+  int internal_size =
+      program.present("--internal-size") ? std::stoi(program.get("--internal-size")) : DEFAULT_INTERNAL_SIZE;
+
+  // Keep both trees in the buffer pool, so that the benchmark measures latching and not I/O.
+  auto key_schema = bustub::ParseCreateStatement("a bigint");
+  ComparatorType comparator(key_schema.get());
+  size_t num_frames = 4 * num_keys / std::max(1, leaf_size / 2) + 64;
+  auto disk_manager = std::make_unique<bustub::DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<bustub::BufferPoolManagerInstance>(num_frames, disk_manager.get());
+  bustub::page_id_t header_page_id;
+  bpm->NewPage(&header_page_id);
+
+  // Build the same index twice from keys in table order: by inserting them one by one, and by sorting them and bulk
+  // loading the tree, as Catalog::CreateIndex does.
+  std::vector<int64_t> table_order(num_keys);
+  for (int64_t k = 0; k < num_keys; k++) {
+    table_order[k] = k;
+  }
+  std::shuffle(table_order.begin(), table_order.end(), std::mt19937_64(num_keys));
+
+  TreeType tree("bench_pk", bpm.get(), comparator, leaf_size, internal_size);
+  auto start = std::chrono::steady_clock::now();
+  KeyType key;
+  for (int64_t k : table_order) {
+    key.SetFromInteger(k);
+    tree.Insert(key, bustub::RID(k));
+  }
+  double insert_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  TreeType loaded_tree("bench_loaded_pk", bpm.get(), comparator, leaf_size, internal_size);
+  start = std::chrono::steady_clock::now();
+  std::vector<std::pair<KeyType, bustub::RID>> entries;
+  for (int64_t k : table_order) {
+    key.SetFromInteger(k);
+    entries.emplace_back(key, bustub::RID(k));
+  }
+  std::stable_sort(entries.begin(), entries.end(), [&comparator](const auto &left, const auto &right) {
+    return comparator(left.first, right.first) < 0;
+  });
+  auto it = entries.begin();
+  auto next_entry = [&it, &entries](std::pair<KeyType, bustub::RID> *entry) {
+    if (it == entries.end()) {
+      return false;
+    }
+    *entry = *it++;
+    return true;
+  };
+  loaded_tree.BulkLoad(next_entry);
+  double bulk_load_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  fmt::print("build {} keys: insert {:.0f} ms, sort and bulk load {:.0f} ms, speedup {:.2f}x\n\n", num_keys, insert_ms,
+             bulk_load_ms, insert_ms / bulk_load_ms);
+
+  // Load the same entries into a tree of compressed pages, and compare the pages each tree keeps in the buffer pool.
+  CompressedTreeType compressed_tree("bench_compressed_pk", bpm.get(), comparator, leaf_size, internal_size);
+  it = entries.begin();
+  compressed_tree.BulkLoad(next_entry);
+  auto verbatim = Measure<LeafPage, InternalPage>(bpm.get(), loaded_tree.GetRootPageId());
+  auto compressed = Measure<CodecType::LeafPage<bustub::RID>, CodecType::InternalPage>(
+      bpm.get(), compressed_tree.GetRootPageId());
+  fmt::print("{:>12} {:>8} {:>12} {:>16}\n", "pages", "height", "leaf pages", "internal pages");
+  fmt::print("{:>12} {:>8} {:>12} {:>16}\n", "verbatim", verbatim.height_, verbatim.leaf_pages_,
+             verbatim.internal_pages_);
+  fmt::print("{:>12} {:>8} {:>12} {:>16}\n\n", "compressed", compressed.height_, compressed.leaf_pages_,
+             compressed.internal_pages_);
+
+  // Search the keys of a full leaf with the comparator, and with the integer kernel KeySearch picks for this key.
+  std::vector<std::pair<KeyType, bustub::RID>> leaf_entries(entries.begin(),
+                                                            entries.begin() + std::min<int64_t>(num_keys, leaf_size));
+  auto time_search = [&](auto search) {
+    int64_t checksum = 0;
+    auto search_start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_lookups; i++) {
+      checksum += search(leaf_entries[i % leaf_entries.size()].first);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - search_start).count();
+    return std::make_pair(num_lookups / seconds, checksum);
+  };
+  auto [comparator_rate, comparator_checksum] = time_search([&](const KeyType &key) {
+    return bustub::ComparatorKeySearch<KeyType, ComparatorType>::LowerBound(
+        leaf_entries.data(), static_cast<int>(leaf_entries.size()), key, comparator);
+  });
+  auto [kernel_rate, kernel_checksum] = time_search([&](const KeyType &key) {
+    return bustub::KeySearch<KeyType, ComparatorType>::LowerBound(
+        leaf_entries.data(), static_cast<int>(leaf_entries.size()), key, comparator);
+  });
+  fmt::print("in-page search over {} keys: comparator {:.0f}/s, integer kernel {:.0f}/s, speedup {:.2f}x{}\n\n",
+             leaf_entries.size(), comparator_rate, kernel_rate, kernel_rate / comparator_rate,
+             comparator_checksum == kernel_checksum ? "" : " (MISMATCH)");
+
+  fmt::print("{:>8} {:>12} {:>16} {:>18} {:>10}\n", "threads", "lookups", "olc lookups/s", "coupling lookups/s",
+             "speedup");
+  for (size_t num_threads : thread_counts) {
+    double olc = RunLookups(num_threads, num_lookups, num_keys, [&tree](const KeyType &key) {
+      thread_local std::vector<bustub::RID> result;
+      result.clear();
+      return tree.GetValue(key, &result);
+    });
+    double coupling = RunLookups(num_threads, num_lookups, num_keys, [&](const KeyType &key) {
+      bustub::RID rid;
+      return LatchCouplingLookup(bpm.get(), tree.GetRootPageId(), key, comparator, &rid);
+    });
+    fmt::print("{:>8} {:>12} {:>16.0f} {:>18.0f} {:>9.2f}x\n", num_threads, num_threads * num_lookups, olc, coupling,
+               olc / coupling);
+  }
+  bpm->UnpinPage(header_page_id, true);
+  return 0;
+}
@@ -0,0 +1,210 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/bustub_instance.h"
+#include "container/hash/robin_hood_hash_table.h"
+#include "execution/plans/aggregation_plan.h"
+#include "fmt/core.h"
+#include "type/value_factory.h"
+
+namespace {
+
+using bustub::AggregateKey;
+using bustub::AggregateValue;
+using bustub::RobinHoodHashTable;
+using bustub::Value;
+using bustub::ValueFactory;
+
+template <class Work>
+auto Seconds(Work work) -> double {
+  auto start = std::chrono::steady_clock::now();
+  work();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/** The group keys of an aggregation of num_rows rows into num_groups groups, in random order. */
+auto GroupKeys(size_t num_rows, size_t num_groups) -> std::vector<int32_t> {
+  std::mt19937_64 gen(0);
+  std::uniform_int_distribution<int32_t> key_dist(0, static_cast<int32_t>(num_groups) - 1);
+  std::vector<int32_t> keys(num_rows);
+  for (auto &key : keys) {
+    key = key_dist(gen);
+  }
+  return keys;
+}
+
+/** Sum one column per group, the way the aggregation executor does, and return the rows per second. */
+auto AggregateRobinHood(const std::vector<int32_t> &keys) -> double {
+  RobinHoodHashTable table(1, 1);
+  std::vector<Value> key(1);
+  return keys.size() / Seconds([&]() {
+           for (int32_t k : keys) {
+             key[0] = ValueFactory::GetIntegerValue(k);
+             auto [entry, inserted] = table.FindOrInsert(key);
+             Value *sum = table.PayloadAt(entry);
+             *sum = inserted ? key[0] : sum->Add(key[0]);
+           }
+         });
+}
+
+auto AggregateUnorderedMap(const std::vector<int32_t> &keys) -> double {
+  std::unordered_map<AggregateKey, AggregateValue> table;
+  AggregateKey key;
+  key.group_bys_.resize(1);
+  return keys.size() / Seconds([&]() {
+           for (int32_t k : keys) {
+             key.group_bys_[0] = ValueFactory::GetIntegerValue(k);
+             auto it = table.find(key);
+             if (it == table.end()) {
+               table.emplace(key, AggregateValue{{key.group_bys_[0]}});
+             } else {
+               it->second.aggregates_[0] = it->second.aggregates_[0].Add(key.group_bys_[0]);
+             }
+           }
+         });
+}
+
+/** The rows per second of building a join table of the build keys, and of probing it with the probe keys. */
+struct JoinRates {
+  double build_{0};
+  double probe_{0};
+  size_t matches_{0};
+};
+
+auto JoinRobinHood(const std::vector<int32_t> &build_keys, const std::vector<int32_t> &probe_keys) -> JoinRates {
+  RobinHoodHashTable table(1, 2);
+  std::vector<Value> key(1);
+  JoinRates rates;
+  rates.build_ = build_keys.size() / Seconds([&]() {
+                   for (int32_t k : build_keys) {
+                     key[0] = ValueFactory::GetIntegerValue(k);
+                     Value *payload = table.PayloadAt(table.Insert(key));
+                     payload[0] = key[0];
+                     payload[1] = key[0];
+                   }
+                 });
+  rates.probe_ = probe_keys.size() / Seconds([&]() {
+                   for (int32_t k : probe_keys) {
+                     key[0] = ValueFactory::GetIntegerValue(k);
+                     for (auto entry = table.Find(key); entry != RobinHoodHashTable::NO_ENTRY;
+                          entry = table.NextDuplicate(entry)) {
+                       rates.matches_++;
+                     }
+                   }
+                 });
+  return rates;
+}
+
+auto JoinUnorderedMap(const std::vector<int32_t> &build_keys, const std::vector<int32_t> &probe_keys) -> JoinRates {
+  std::unordered_map<AggregateKey, std::vector<std::vector<Value>>> table;
+  AggregateKey key;
+  key.group_bys_.resize(1);
+  JoinRates rates;
+  rates.build_ = build_keys.size() / Seconds([&]() {
+                   for (int32_t k : build_keys) {
+                     key.group_bys_[0] = ValueFactory::GetIntegerValue(k);
+                     table[key].push_back({key.group_bys_[0], key.group_bys_[0]});
+                   }
+                 });
+  rates.probe_ = probe_keys.size() / Seconds([&]() {
+                   for (int32_t k : probe_keys) {
+                     key.group_bys_[0] = ValueFactory::GetIntegerValue(k);
+                     if (auto it = table.find(key); it != table.end()) {
+                       rates.matches_ += it->second.size();
+                     }
+                   }
+                 });
+  return rates;
+}
+
+/** Queries on the mock tables that run hash aggregations and hash joins. */
+const std::pair<const char *, const char *> QUERIES[] = {
+    {"group-agg", "select v1, v3, count(*), sum(v2), min(v4), max(v5) from __mock_agg_input_big group by v1, v3"},
+    {"hash-join", "select count(*), max(__mock_t1_50k.x), max(__mock_t2_100k.y), max(__mock_t3_1k.y) from "
+                  "(__mock_t1_50k inner join __mock_t2_100k on __mock_t1_50k.x = __mock_t2_100k.x) "
+                  "inner join __mock_t3_1k on __mock_t2_100k.y = __mock_t3_1k.y"},
+};
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-exec-hash-bench");
+  program.add_argument("--rows").help("rows aggregated, and rows on each side of the joins, default 1000000");
+  program.add_argument("--groups").help("comma-separated group counts, default 10,1000,100000,1000000");
+  program.add_argument("--duplicates").help("build rows per join key, default 4");
+  program.add_argument("--repeat").help("runs of each query, default 3");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t num_rows = program.present("--rows") ? std::stoull(program.get("--rows")) : 1000000;
+  std::vector<size_t> group_counts{10, 1000, 100000, 1000000};
+  if (program.present("--groups")) {
+    group_counts.clear();
+    std::string groups = program.get("--groups");
+    size_t pos = 0;
+    while (pos < groups.size()) {
+      size_t comma = groups.find(',', pos);
+      if (comma == std::string::npos) {
+        comma = groups.size();
+      }
+      group_counts.push_back(std::stoull(groups.substr(pos, comma - pos)));
+      pos = comma + 1;
+    }
+  }
+  size_t num_duplicates = program.present("--duplicates") ? std::stoull(program.get("--duplicates")) : 4;
+  int repeat = program.present("--repeat") ? std::stoi(program.get("--repeat")) : 3;
+
+  fmt::print("aggregation of {} rows, rows/s\n", num_rows);
+  fmt::print("{:>10} {:>14} {:>14} {:>8}\n", "groups", "robin hood", "unordered_map", "speedup");
+  for (size_t num_groups : group_counts) {
+    auto keys = GroupKeys(num_rows, num_groups);
+    double robin_hood = AggregateRobinHood(keys);
+    double unordered_map = AggregateUnorderedMap(keys);
+    fmt::print("{:>10} {:>14.0f} {:>14.0f} {:>7.2f}x\n", num_groups, robin_hood, unordered_map,
+               robin_hood / unordered_map);
+  }
+
+  // Half of the probe rows find no match, and the others find num_duplicates.
+  size_t num_join_keys = num_rows / num_duplicates;
+  auto build_keys = GroupKeys(num_rows, num_join_keys);
+  auto probe_keys = GroupKeys(num_rows, 2 * num_join_keys);
+  auto robin_hood = JoinRobinHood(build_keys, probe_keys);
+  auto unordered_map = JoinUnorderedMap(build_keys, probe_keys);
+  fmt::print("\njoin of {} build rows over {} keys with {} probe rows, rows/s\n", num_rows, num_join_keys, num_rows);
+  fmt::print("{:>10} {:>14} {:>14} {:>8}\n", "phase", "robin hood", "unordered_map", "speedup");
+  fmt::print("{:>10} {:>14.0f} {:>14.0f} {:>7.2f}x\n", "build", robin_hood.build_, unordered_map.build_,
+             robin_hood.build_ / unordered_map.build_);
+  fmt::print("{:>10} {:>14.0f} {:>14.0f} {:>7.2f}x\n", "probe", robin_hood.probe_, unordered_map.probe_,
+             robin_hood.probe_ / unordered_map.probe_);
+  if (robin_hood.matches_ != unordered_map.matches_) {
+    fmt::print("match counts differ: {} and {}\n", robin_hood.matches_, unordered_map.matches_);
+    return 1;
+  }
+
+  // The executors end to end, on the mock tables.
+  bustub::BustubInstance instance;
+  instance.GenerateMockTable();
+  fmt::print("\nqueries, ms per run\n");
+  for (const auto &[name, sql] : QUERIES) {
+    fmt::print("{:>10}", name);
+    for (int i = 0; i < repeat; i++) {
+      bustub::NoopWriter writer;
+      fmt::print(" {:>8.1f}", 1000 * Seconds([&]() { instance.ExecuteSql(sql, writer); }));
+    }
+    fmt::print("\n");
+  }
+  return 0;
+}
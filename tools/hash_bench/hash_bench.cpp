@@ -0,0 +1,140 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "buffer/parallel_buffer_pool_manager.h"
+#include "container/disk/hash/disk_extendible_hash_table.h"
+#include "fmt/core.h"
+#include "storage/disk/disk_manager_memory.h"
+
+namespace {
+
+using HashTable = bustub::DiskExtendibleHashTable<int, int, bustub::IntComparator>;
+
+/** The insert and lookup rates of one run, over all threads. */
+struct Rates {
+  double inserts_{0};
+  double lookups_{0};
+  size_t failed_{0};
+};
+
+/**
+ * Fill an empty table with num_keys keys, split among num_threads threads, then have every thread look up num_lookups
+ * uniformly random keys. With serialize set, every operation runs under one mutex, the way a table behaves whose
+ * writers exclude everyone else.
+ */
+auto Run(HashTable *table, size_t num_threads, int num_keys, size_t num_lookups, bool serialize) -> Rates {
+  std::mutex mutex;
+  auto run_threads = [num_threads](auto work) {
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < num_threads; t++) {
+      threads.emplace_back(work, t);
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  Rates rates;
+  std::atomic<size_t> failed{0};
+  double insert_seconds = run_threads([&](size_t t) {
+    for (int key = static_cast<int>(t); key < num_keys; key += static_cast<int>(num_threads)) {
+      std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+      if (serialize) {
+        lock.lock();
+      }
+      if (!table->Insert(nullptr, key, key)) {
+        failed++;
+      }
+    }
+  });
+  double lookup_seconds = run_threads([&](size_t t) {
+    std::mt19937_64 gen(t);
+    std::uniform_int_distribution<int> key_dist(0, num_keys - 1);
+    std::vector<int> result;
+    for (size_t i = 0; i < num_lookups; i++) {
+      result.clear();
+      std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+      if (serialize) {
+        lock.lock();
+      }
+      table->GetValue(nullptr, key_dist(gen), &result);
+    }
+  });
+  rates.inserts_ = num_keys / insert_seconds;
+  rates.lookups_ = static_cast<double>(num_threads * num_lookups) / lookup_seconds;
+  rates.failed_ = failed;
+  return rates;
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-hash-bench");
+  program.add_argument("--keys").help("keys inserted per run, default 100000");
+  program.add_argument("--threads").help("comma-separated thread counts, default 1,2,4,8,16,32");
+  program.add_argument("--lookups").help("lookups per thread, default 200000");
+  program.add_argument("--instances").help("buffer pool instances, default 16");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  std::vector<size_t> thread_counts{1, 2, 4, 8, 16, 32};
+  if (program.present("--threads")) {
+    thread_counts.clear();
+    std::string threads = program.get("--threads");
+    size_t pos = 0;
+    while (pos < threads.size()) {
+      size_t comma = threads.find(',', pos);
+      if (comma == std::string::npos) {
+        comma = threads.size();
+      }
+      thread_counts.push_back(std::stoull(threads.substr(pos, comma - pos)));
+      pos = comma + 1;
+    }
+  }
+  int num_keys = program.present("--keys") ? std::stoi(program.get("--keys")) : 100000;
+  size_t num_lookups = program.present("--lookups") ? std::stoull(program.get("--lookups")) : 200000;
+  size_t num_instances = program.present("--instances") ? std::stoull(program.get("--instances")) : 16;
+
+  // Keep every bucket in the buffer pool, and spread the pages over instances, so that the benchmark measures the
+  // latching of the table and not I/O or the latch of one buffer pool instance.
+  size_t bucket_capacity = 4 * bustub::BUSTUB_PAGE_SIZE / (4 * sizeof(std::pair<int, int>) + 1);
+  size_t pool_size = 8 * (num_keys / bucket_capacity + 1) / num_instances + 64;
+
+  // The scaling columns compare the rates of the table to those of its first run.
+  fmt::print("{:>8} {:>12} {:>8} {:>12} {:>8} {:>20} {:>20} {:>7}\n", "threads", "inserts/s", "scaling", "lookups/s",
+             "scaling", "one-latch inserts/s", "one-latch lookups/s", "failed");
+  Rates first;
+  for (size_t num_threads : thread_counts) {
+    Rates rates[2];
+    for (bool serialize : {false, true}) {
+      auto disk_manager = std::make_unique<bustub::DiskManagerUnlimitedMemory>();
+      auto bpm = std::make_unique<bustub::ParallelBufferPoolManager>(num_instances, pool_size, disk_manager.get());
+      HashTable table("bench", bpm.get(), bustub::IntComparator(), bustub::HashFunction<int>());
+      rates[serialize ? 1 : 0] = Run(&table, num_threads, num_keys, num_lookups, serialize);
+    }
+    if (first.inserts_ == 0) {
+      first = rates[0];
+    }
+    fmt::print("{:>8} {:>12.0f} {:>7.2f}x {:>12.0f} {:>7.2f}x {:>20.0f} {:>20.0f} {:>7}\n", num_threads,
+               rates[0].inserts_, rates[0].inserts_ / first.inserts_, rates[0].lookups_,
+               rates[0].lookups_ / first.lookups_, rates[1].inserts_, rates[1].lookups_,
+               rates[0].failed_ + rates[1].failed_);
+  }
+  return 0;
+}
@@ -0,0 +1,161 @@
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "buffer/lru_k_replacer.h"
+#include "fmt/core.h"
+
+namespace {
+
+/**
+ * The LRU-K replacer as it was before the node pool: a hash map of per-frame access lists that Evict scans in full.
+ * Kept here as the baseline the current replacer is measured against.
+ */
+class NaiveLRUKReplacer {
+ public:
+  NaiveLRUKReplacer(size_t num_frames, size_t k) : replacer_size_(num_frames), k_(k) {}
+
+  auto Evict(bustub::frame_id_t *frame_id) -> bool {
+    bool found = false;
+    bool found_inf = false;
+    size_t best_ts = 0;
+    bustub::frame_id_t victim = -1;
+    for (const auto &[fid, entry] : node_store_) {
+      if (!entry.evictable_) {
+        continue;
+      }
+      bool inf = entry.history_.size() < k_;
+      size_t ts = entry.history_.front();
+      if (!found || (inf && !found_inf) || (inf == found_inf && ts < best_ts)) {
+        found = true;
+        found_inf = inf;
+        best_ts = ts;
+        victim = fid;
+      }
+    }
+    if (!found) {
+      return false;
+    }
+    node_store_.erase(victim);
+    *frame_id = victim;
+    return true;
+  }
+
+  void RecordAccess(bustub::frame_id_t frame_id) {
+    auto &history = node_store_[frame_id].history_;
+    history.push_back(current_timestamp_++);
+    if (history.size() > k_) {
+      history.pop_front();
+    }
+  }
+
+  void SetEvictable(bustub::frame_id_t frame_id, bool set_evictable) {
+    auto it = node_store_.find(frame_id);
+    if (it != node_store_.end()) {
+      it->second.evictable_ = set_evictable;
+    }
+  }
+
+ private:
+  struct FrameEntry {
+    std::list<size_t> history_;
+    bool evictable_{false};
+  };
+
+  std::unordered_map<bustub::frame_id_t, FrameEntry> node_store_;
+  size_t current_timestamp_{0};
+  size_t replacer_size_;
+  size_t k_;
+};
+
+/**
+ * Drive a replacer the way the buffer pool does: every frame starts resident and unpinned, then each operation
+ * either pins and unpins a resident frame or, one time in `miss_every`, evicts a victim and loads a new page into it.
+ * @return the average nanoseconds per operation
+ */
+template <typename Replacer>
+auto RunWorkload(Replacer *replacer, size_t num_frames, size_t num_ops, size_t miss_every, uint64_t seed) -> double {
+  for (size_t i = 0; i < num_frames; i++) {
+    auto fid = static_cast<bustub::frame_id_t>(i);
+    replacer->RecordAccess(fid);
+    replacer->SetEvictable(fid, true);
+  }
+  std::mt19937_64 gen(seed);
+  std::uniform_int_distribution<size_t> frame_dist(0, num_frames - 1);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t op = 0; op < num_ops; op++) {
+    bustub::frame_id_t fid;
+    if (op % miss_every == 0) {
+      if (!replacer->Evict(&fid)) {
+        std::cerr << "replacer ran out of victims" << std::endl;
+        exit(1);
+      }
+    } else {
+      fid = static_cast<bustub::frame_id_t>(frame_dist(gen));
+      replacer->SetEvictable(fid, false);
+    }
+    replacer->RecordAccess(fid);
+    replacer->SetEvictable(fid, true);
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(num_ops);
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-replacer-bench");
+  program.add_argument("--frames").help("comma-separated frame counts, default 1000,100000,1000000");
+  program.add_argument("--ops").help("operations per run, default 1000000");
+  program.add_argument("--k").help("k of LRU-K, default 2");
+  program.add_argument("--miss-every").help("one eviction every n operations, default 4");
+  program.add_argument("--naive-budget").help("frames the baseline may scan per run, default 1000000000");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  std::vector<size_t> frame_counts{1000, 100000, 1000000};
+  if (program.present("--frames")) {
+    frame_counts.clear();
+    std::string frames = program.get("--frames");
+    size_t pos = 0;
+    while (pos < frames.size()) {
+      size_t comma = frames.find(',', pos);
+      if (comma == std::string::npos) {
+        comma = frames.size();
+      }
+      frame_counts.push_back(std::stoull(frames.substr(pos, comma - pos)));
+      pos = comma + 1;
+    }
+  }
+  size_t num_ops = program.present("--ops") ? std::stoull(program.get("--ops")) : 1000000;
+  size_t k = program.present("--k") ? std::stoull(program.get("--k")) : 2;
+  size_t miss_every = program.present("--miss-every") ? std::stoull(program.get("--miss-every")) : 4;
+  size_t naive_budget = program.present("--naive-budget") ? std::stoull(program.get("--naive-budget")) : 1000000000;
+
+  fmt::print("{:>10} {:>10} {:>14} {:>10} {:>14} {:>10}\n", "frames", "ops", "lru-k ns/op", "naive ops",
+             "naive ns/op", "speedup");
+  for (size_t num_frames : frame_counts) {
+    bustub::LRUKReplacer replacer(num_frames, k);
+    double ns = RunWorkload(&replacer, num_frames, num_ops, miss_every, num_frames);
+
+    // The baseline scans every frame on each eviction, so cap its run to keep large pools tractable.
+    size_t naive_ops = std::max<size_t>(miss_every, std::min(num_ops, naive_budget / num_frames * miss_every));
+    NaiveLRUKReplacer naive(num_frames, k);
+    double naive_ns = RunWorkload(&naive, num_frames, naive_ops, miss_every, num_frames);
+
+    fmt::print("{:>10} {:>10} {:>14.1f} {:>10} {:>14.1f} {:>9.1f}x\n", num_frames, num_ops, ns, naive_ops, naive_ns,
+               naive_ns / ns);
+  }
+  return 0;
+}
@@ -27,7 +27,10 @@ auto GetWidthOfUtf8(const void *beg, const void *end, size_t *width) -> int {
 auto main(int argc, char **argv) -> int {
   ft_set_u8strwid_func(&GetWidthOfUtf8);
 
-  auto bustub = std::make_unique<bustub::BustubInstance>("test.db");
+  // The shell runs on a database file, where writing dirty pages back ahead of their eviction pays off.
+  bustub::BustubInstanceConfig config;
+  config.page_cleaner_interval_ = bustub::page_cleaner_interval;
+  auto bustub = std::make_unique<bustub::BustubInstance>("test.db", config);
 
   auto default_prompt = "bustub> ";
   auto emoji_prompt = "\U0001f6c1> ";  // the bathtub emoji
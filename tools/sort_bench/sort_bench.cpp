@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "catalog/catalog.h"
+#include "common/bustub_instance.h"
+#include "concurrency/transaction_manager.h"
+#include "fmt/core.h"
+#include "type/value_factory.h"
+
+namespace {
+
+using bustub::ValueFactory;
+
+template <class Work>
+auto Seconds(Work work) -> double {
+  auto start = std::chrono::steady_clock::now();
+  work();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/** Fill the table sort_input with num_rows rows of random keys, and return the pages its tuples take. */
+auto CreateInput(bustub::BustubInstance *instance, size_t num_rows) -> size_t {
+  bustub::NoopWriter writer;
+  instance->ExecuteSql("create table sort_input(a int, b varchar(32), c int);", writer);
+  auto *table_info = instance->catalog_->GetTable("sort_input");
+  auto *txn = instance->txn_manager_->Begin();
+  std::mt19937_64 gen(0);
+  std::uniform_int_distribution<int32_t> key_dist(0, 999);
+  size_t bytes = 0;
+  for (size_t i = 0; i < num_rows; i++) {
+    bustub::Tuple tuple({ValueFactory::GetIntegerValue(static_cast<int32_t>(i)),
+                         ValueFactory::GetVarcharValue(fmt::format("key-{:08}", gen() % 100000000)),
+                         ValueFactory::GetIntegerValue(key_dist(gen))},
+                        &table_info->schema_);
+    bustub::RID rid;
+    table_info->table_->InsertTuple(tuple, &rid, txn);
+    bytes += tuple.GetLength();
+  }
+  instance->txn_manager_->Commit(txn);
+  delete txn;
+  return (bytes + bustub::BUSTUB_PAGE_SIZE - 1) / bustub::BUSTUB_PAGE_SIZE;
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-sort-bench");
+  program.add_argument("--rows").help("rows sorted, default 200000");
+  program.add_argument("--ratio").help("times the input outgrows the budget of the external sort, default 10");
+  program.add_argument("--repeat").help("runs of each sort, default 3");
+  program.add_argument("--threads").help("threads of the parallel sort, default 4");
+  program.add_argument("--buffer-pool-instances").help("buffer pool instances the pages are sharded over, default 1");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t num_rows = program.present("--rows") ? std::stoull(program.get("--rows")) : 200000;
+  size_t ratio = program.present("--ratio") ? std::stoull(program.get("--ratio")) : 10;
+  int repeat = program.present("--repeat") ? std::stoi(program.get("--repeat")) : 3;
+  size_t threads = program.present("--threads") ? std::stoull(program.get("--threads")) : 4;
+
+  bustub::BustubInstanceConfig config;
+  config.buffer_pool_size_ = 1024;
+  if (program.present("--buffer-pool-instances")) {
+    config.buffer_pool_instances_ = std::stoull(program.get("--buffer-pool-instances"));
+  }
+  bustub::BustubInstance instance(config);
+  size_t input_pages = CreateInput(&instance, num_rows);
+  size_t external_budget = std::max<size_t>(input_pages / ratio, 1);
+
+  // The filter drops every row, so that the queries time the scan and the sort, not the output.
+  const char *sql = "select * from (select * from sort_input order by c, b desc) where a < 0;";
+  fmt::print("sort of {} rows, {} pages of tuples, ms per run\n", num_rows, input_pages);
+  struct Mode {
+    const char *name_;
+    size_t budget_;
+    bool radix_sort_;
+    size_t threads_;
+  };
+  const Mode modes[] = {{"in-memory", input_pages * 4, false, 1},
+                        {"radix", input_pages * 4, true, 1},
+                        {"parallel", input_pages * 4, false, threads},
+                        {"external", external_budget, false, 1}};
+  for (const auto &[name, budget, radix_sort, sort_threads] : modes) {
+    bustub::NoopWriter writer;
+    instance.ExecuteSql(fmt::format("set executor_memory_budget={}", budget), writer);
+    instance.ExecuteSql(fmt::format("set enable_radix_sort={}", radix_sort), writer);
+    instance.ExecuteSql(fmt::format("set sort_parallelism={}", sort_threads), writer);
+    fmt::print("{:>10} {:>8} pages", name, budget);
+    for (int i = 0; i < repeat; i++) {
+      fmt::print(" {:>8.1f}", 1000 * Seconds([&]() { instance.ExecuteSql(sql, writer); }));
+    }
+    fmt::print("\n");
+  }
+  return 0;
+}
@@ -1,5 +1,6 @@
 #include <fstream>
 #include <ios>
+#include <chrono>  // NOLINT
 #include <iostream>
 #include <memory>
 #include <sstream>
@@ -73,6 +74,11 @@ auto ProcessExtraOptions(const std::string &sql, bustub::BustubInstance &instanc
           fmt::print("IndexScan not found\n");
           return false;
         }
+      } else if (opt == "ensure:index_only_scan") {
+        if (!bustub::StringUtil::Contains(result.str(), "index_only=true")) {
+          fmt::print("index-only IndexScan not found\n");
+          return false;
+        }
       } else if (opt == "ensure:topn") {
         if (!bustub::StringUtil::Contains(result.str(), "TopN")) {
           fmt::print("TopN not found\n");
@@ -147,6 +153,10 @@ auto main(int argc, char **argv) -> int {  // NOLINT
   program.add_argument("--verbose").help("increase output verbosity").default_value(false).implicit_value(true);
   program.add_argument("-d", "--diff").help("write diff file").default_value(false).implicit_value(true);
   program.add_argument("--in-memory").help("use in-memory backend").default_value(false).implicit_value(true);
+  program.add_argument("--replacer").help("buffer pool replacement policy: lru-k, lru, clock, 2q, arc or clock-pro");
+  program.add_argument("--page-trace").help("record the buffer pool page accesses to this file");
+  program.add_argument("--buffer-pool-instances").help("number of buffer pool instances the pages are sharded over");
+  program.add_argument("--page-cleaner-interval").help("run the page cleaner of the buffer pool every n milliseconds");
 
   try {
     program.parse_args(argc, argv);
@@ -171,12 +181,31 @@ auto main(int argc, char **argv) -> int {  // NOLINT
 
   auto result = bustub::SQLLogicTestParser::Parse(script);
 
+  bustub::BustubInstanceConfig config;
+  if (program.present("--replacer")) {
+    auto policy = bustub::ReplacerPolicyFromString(program.get("--replacer"));
+    if (!policy.has_value()) {
+      std::cerr << "Unknown replacer " << program.get("--replacer") << std::endl;
+      return 1;
+    }
+    config.replacer_policy_ = *policy;
+  }
+  if (program.present("--page-trace")) {
+    config.page_trace_file_ = program.get("--page-trace");
+  }
+  if (program.present("--buffer-pool-instances")) {
+    config.buffer_pool_instances_ = std::stoull(program.get("--buffer-pool-instances"));
+  }
+  if (program.present("--page-cleaner-interval")) {
+    config.page_cleaner_interval_ = std::chrono::milliseconds(std::stoll(program.get("--page-cleaner-interval")));
+  }
+
   std::unique_ptr<bustub::BustubInstance> bustub;
 
   if (program.get<bool>("--in-memory")) {
-    bustub = std::make_unique<bustub::BustubInstance>();
+    bustub = std::make_unique<bustub::BustubInstance>(config);
   } else {
-    bustub = std::make_unique<bustub::BustubInstance>("test.db");
+    bustub = std::make_unique<bustub::BustubInstance>("test.db", config);
   }
 
   bustub->GenerateMockTable();
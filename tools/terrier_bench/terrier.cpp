@@ -120,6 +120,7 @@ auto main(int argc, char **argv) -> int {
   program.add_argument("--duration").help("run terrier bench for n milliseconds");
   program.add_argument("--force-create-index").help("create index in terrier bench");
   program.add_argument("--force-enable-update").help("use update statement in terrier bench");
+  program.add_argument("--buffer-pool-instances").help("number of buffer pool instances the pages are sharded over");
 
   try {
     program.parse_args(argc, argv);
@@ -129,7 +130,11 @@ auto main(int argc, char **argv) -> int {
     return 1;
   }
 
-  auto bustub = std::make_unique<bustub::BustubInstance>();
+  bustub::BustubInstanceConfig config;
+  if (program.present("--buffer-pool-instances")) {
+    config.buffer_pool_instances_ = std::stoull(program.get("--buffer-pool-instances"));
+  }
+  auto bustub = std::make_unique<bustub::BustubInstance>(config);
   auto writer = bustub::SimpleStreamWriter(std::cerr);
 
   // create schema
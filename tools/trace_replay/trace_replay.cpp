@@ -0,0 +1,128 @@
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "buffer/page_access_trace.h"
+#include "buffer/replacer.h"
+#include "fmt/core.h"
+
+namespace {
+
+auto SplitList(const std::string &list) -> std::vector<std::string> {
+  std::vector<std::string> items;
+  size_t pos = 0;
+  while (pos <= list.size()) {
+    size_t comma = list.find(',', pos);
+    if (comma == std::string::npos) {
+      comma = list.size();
+    }
+    if (comma > pos) {
+      items.push_back(list.substr(pos, comma - pos));
+    }
+    pos = comma + 1;
+  }
+  return items;
+}
+
+/**
+ * Replay a page access trace against a replacer the way a buffer pool drives it: every access pins and unpins the
+ * page, a miss loads it into a free frame or evicts a victim first.
+ * @return the number of accesses that hit the buffer pool
+ */
+auto Replay(const std::vector<bustub::page_id_t> &trace, bustub::ReplacerPolicy policy, size_t num_frames, size_t k)
+    -> size_t {
+  auto replacer = bustub::MakeReplacer(policy, num_frames, k);
+  std::unordered_map<bustub::page_id_t, bustub::frame_id_t> page_table;
+  std::vector<bustub::page_id_t> frame_pages(num_frames, bustub::INVALID_PAGE_ID);
+  size_t num_used_frames = 0;
+  size_t hits = 0;
+  for (bustub::page_id_t page_id : trace) {
+    bustub::frame_id_t frame_id;
+    auto it = page_table.find(page_id);
+    if (it != page_table.end()) {
+      frame_id = it->second;
+      hits++;
+    } else {
+      if (num_used_frames < num_frames) {
+        frame_id = static_cast<bustub::frame_id_t>(num_used_frames++);
+      } else if (replacer->Evict(&frame_id)) {
+        page_table.erase(frame_pages[frame_id]);
+      } else {
+        std::cerr << "replacer found no victim" << std::endl;
+        exit(1);
+      }
+      frame_pages[frame_id] = page_id;
+      page_table[page_id] = frame_id;
+    }
+    replacer->RecordAccess(frame_id, page_id);
+    replacer->SetEvictable(frame_id, false);
+    replacer->SetEvictable(frame_id, true);
+  }
+  return hits;
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-trace-replay");
+  program.add_argument("trace").help("page access trace recorded with BustubInstanceConfig::page_trace_file_");
+  program.add_argument("--frames").help("comma-separated buffer pool sizes, default 16,64,128,512");
+  program.add_argument("--policies").help("comma-separated replacement policies, default all of them");
+  program.add_argument("--k").help("k of LRU-K, default LRUK_REPLACER_K");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  std::vector<bustub::page_id_t> trace;
+  if (!bustub::PageAccessTrace::Load(program.get("trace"), &trace)) {
+    std::cerr << "Failed to read " << program.get("trace") << std::endl;
+    return 1;
+  }
+
+  std::vector<size_t> frame_counts{16, 64, 128, 512};
+  if (program.present("--frames")) {
+    frame_counts.clear();
+    for (const auto &item : SplitList(program.get("--frames"))) {
+      frame_counts.push_back(std::stoull(item));
+    }
+  }
+  std::vector<bustub::ReplacerPolicy> policies{bustub::ReplacerPolicy::LRUK,  bustub::ReplacerPolicy::LRU,
+                                               bustub::ReplacerPolicy::Clock, bustub::ReplacerPolicy::TwoQueue,
+                                               bustub::ReplacerPolicy::ARC,   bustub::ReplacerPolicy::ClockPro};
+  if (program.present("--policies")) {
+    policies.clear();
+    for (const auto &item : SplitList(program.get("--policies"))) {
+      auto policy = bustub::ReplacerPolicyFromString(item);
+      if (!policy.has_value()) {
+        std::cerr << "Unknown replacer " << item << std::endl;
+        return 1;
+      }
+      policies.push_back(*policy);
+    }
+  }
+  size_t k = program.present("--k") ? std::stoull(program.get("--k")) : bustub::LRUK_REPLACER_K;
+
+  fmt::print("{} accesses\n", trace.size());
+  fmt::print("{:>10}", "frames");
+  for (auto policy : policies) {
+    fmt::print(" {:>10}", bustub::ReplacerPolicyToString(policy));
+  }
+  fmt::print("\n");
+  for (size_t num_frames : frame_counts) {
+    fmt::print("{:>10}", num_frames);
+    for (auto policy : policies) {
+      size_t hits = Replay(trace, policy, num_frames, k);
+      double ratio = trace.empty() ? 0 : static_cast<double>(hits) / static_cast<double>(trace.size());
+      fmt::print(" {:>9.2f}%", ratio * 100);
+    }
+    fmt::print("\n");
+  }
+  return 0;
+}